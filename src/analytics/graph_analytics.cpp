@@ -0,0 +1,331 @@
+#include "graph_analytics.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+namespace loredb::analytics {
+
+namespace {
+
+using Vertex = CsrGraph::Vertex;
+
+// Prefix sums of `counts` into CSR row offsets
+std::vector<size_t> row_offsets(const std::vector<size_t>& counts) {
+    std::vector<size_t> offsets(counts.size() + 1, 0);
+    for (size_t i = 0; i < counts.size(); ++i) {
+        offsets[i + 1] = offsets[i] + counts[i];
+    }
+    return offsets;
+}
+
+// Sums f(v) over every vertex in parallel
+template <typename F>
+double parallel_sum(size_t vertex_count, F f) {
+    return tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, vertex_count), 0.0,
+        [&](const tbb::blocked_range<size_t>& range, double sum) {
+            for (size_t v = range.begin(); v != range.end(); ++v) {
+                sum += f(static_cast<Vertex>(v));
+            }
+            return sum;
+        },
+        std::plus<>());
+}
+
+// Root of `v`, halving the path on the way. Parents only ever point at
+// smaller vertices, so a racing halving can never form a cycle.
+Vertex find_root(std::vector<std::atomic<Vertex>>& parent, Vertex v) {
+    while (true) {
+        Vertex p = parent[v].load(std::memory_order_relaxed);
+        if (p == v) {
+            return v;
+        }
+        const Vertex grandparent = parent[p].load(std::memory_order_relaxed);
+        if (grandparent != p) {
+            parent[v].compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+        }
+        v = grandparent;
+    }
+}
+
+void unite(std::vector<std::atomic<Vertex>>& parent, Vertex a, Vertex b) {
+    while (true) {
+        a = find_root(parent, a);
+        b = find_root(parent, b);
+        if (a == b) {
+            return;
+        }
+        if (a < b) {
+            std::swap(a, b);
+        }
+        // Another thread may have linked `a` meanwhile; retry from the new roots
+        Vertex expected = a;
+        if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+// Undirected neighbours of `v` without duplicates or `v` itself, ascending
+template <typename F>
+void for_each_undirected_neighbor(const CsrGraph& graph, Vertex v, F f) {
+    auto out = graph.out_neighbors(v);
+    auto in = graph.in_neighbors(v);
+    size_t i = 0, j = 0;
+    Vertex last = CsrGraph::NO_VERTEX;
+    while (i < out.size() || j < in.size()) {
+        Vertex next;
+        if (j == in.size() || (i < out.size() && out[i] <= in[j])) {
+            next = out[i++];
+        } else {
+            next = in[j++];
+        }
+        if (next != last && next != v) {
+            f(next);
+        }
+        last = next;
+    }
+}
+
+}  // namespace
+
+util::expected<CsrGraph, storage::Error> CsrGraph::snapshot(storage::GraphStore& store) {
+    CsrGraph graph;
+    graph.node_ids_ = store.get_node_ids();
+    if (graph.node_ids_.size() >= NO_VERTEX) {
+        return util::unexpected(storage::Error{storage::ErrorCode::INVALID_ARGUMENT,
+                                               "Graph has too many nodes for a CSR snapshot"});
+    }
+    // Ids are handed out sequentially, so a table by id is dense
+    const storage::NodeId max_id = graph.node_ids_.empty() ? 0 : graph.node_ids_.back();
+    graph.vertex_of_.assign(max_id + 1, NO_VERTEX);
+    for (size_t v = 0; v < graph.node_ids_.size(); ++v) {
+        graph.vertex_of_[graph.node_ids_[v]] = static_cast<Vertex>(v);
+    }
+
+    // Edges to nodes created after get_node_ids() are left out
+    std::vector<std::pair<Vertex, Vertex>> edges;
+    edges.reserve(store.get_edge_count());
+    store.for_each_edge_endpoints([&](storage::NodeId from_node, storage::NodeId to_node) {
+        const Vertex from = graph.vertex_of(from_node);
+        const Vertex to = graph.vertex_of(to_node);
+        if (from != NO_VERTEX && to != NO_VERTEX) {
+            edges.emplace_back(from, to);
+        }
+    });
+
+    const size_t n = graph.vertex_count();
+    std::vector<size_t> out_counts(n, 0), in_counts(n, 0);
+    for (const auto& [from, to] : edges) {
+        ++out_counts[from];
+        ++in_counts[to];
+    }
+    graph.out_offsets_ = row_offsets(out_counts);
+    graph.in_offsets_ = row_offsets(in_counts);
+    graph.out_targets_.resize(edges.size());
+    graph.in_sources_.resize(edges.size());
+    std::vector<size_t> out_next(graph.out_offsets_.begin(), graph.out_offsets_.end() - 1);
+    std::vector<size_t> in_next(graph.in_offsets_.begin(), graph.in_offsets_.end() - 1);
+    for (const auto& [from, to] : edges) {
+        graph.out_targets_[out_next[from]++] = to;
+        graph.in_sources_[in_next[to]++] = from;
+    }
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t v = range.begin(); v != range.end(); ++v) {
+            std::sort(graph.out_targets_.begin() + graph.out_offsets_[v],
+                      graph.out_targets_.begin() + graph.out_offsets_[v + 1]);
+            std::sort(graph.in_sources_.begin() + graph.in_offsets_[v],
+                      graph.in_sources_.begin() + graph.in_offsets_[v + 1]);
+        }
+    });
+    return graph;
+}
+
+std::vector<double> pagerank(const CsrGraph& graph, const PageRankOptions& options) {
+    const size_t n = graph.vertex_count();
+    if (n == 0) {
+        return {};
+    }
+    std::vector<double> rank(n, 1.0 / n);
+    std::vector<double> next(n);
+    std::vector<double> share(n);  // rank / out-degree, or 0 for dangling vertices
+
+    for (size_t iteration = 0; iteration < options.max_iterations; ++iteration) {
+        const double dangling = parallel_sum(n, [&](Vertex v) {
+            return graph.out_degree(v) == 0 ? rank[v] : 0.0;
+        });
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t v = range.begin(); v != range.end(); ++v) {
+                const size_t degree = graph.out_degree(static_cast<Vertex>(v));
+                share[v] = degree == 0 ? 0.0 : rank[v] / static_cast<double>(degree);
+            }
+        });
+
+        const double base = (1.0 - options.damping) / n + options.damping * dangling / n;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t v = range.begin(); v != range.end(); ++v) {
+                double incoming = 0.0;
+                for (Vertex u : graph.in_neighbors(static_cast<Vertex>(v))) {
+                    incoming += share[u];
+                }
+                next[v] = base + options.damping * incoming;
+            }
+        });
+
+        const double change = parallel_sum(n, [&](Vertex v) { return std::abs(next[v] - rank[v]); });
+        rank.swap(next);
+        if (change < options.tolerance) {
+            break;
+        }
+    }
+    return rank;
+}
+
+std::vector<CsrGraph::Vertex> weakly_connected_components(const CsrGraph& graph) {
+    const size_t n = graph.vertex_count();
+    std::vector<std::atomic<Vertex>> parent(n);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t v = range.begin(); v != range.end(); ++v) {
+            parent[v].store(static_cast<Vertex>(v), std::memory_order_relaxed);
+        }
+    });
+    // Every edge is in some out-list, so the out-lists alone cover the graph
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t v = range.begin(); v != range.end(); ++v) {
+            for (Vertex u : graph.out_neighbors(static_cast<Vertex>(v))) {
+                unite(parent, static_cast<Vertex>(v), u);
+            }
+        }
+    });
+
+    std::vector<Vertex> component(n);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t v = range.begin(); v != range.end(); ++v) {
+            component[v] = find_root(parent, static_cast<Vertex>(v));
+        }
+    });
+    return component;
+}
+
+TriangleCount count_triangles(const CsrGraph& graph) {
+    const size_t n = graph.vertex_count();
+    TriangleCount result;
+    result.per_vertex.assign(n, 0);
+    if (n == 0) {
+        return result;
+    }
+
+    std::vector<size_t> degree(n, 0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t v = range.begin(); v != range.end(); ++v) {
+            for_each_undirected_neighbor(graph, static_cast<Vertex>(v), [&](Vertex) { ++degree[v]; });
+        }
+    });
+    // Edges point from the lower to the higher (degree, vertex)
+    auto forward = [&](Vertex from, Vertex to) {
+        return degree[from] < degree[to] || (degree[from] == degree[to] && from < to);
+    };
+
+    std::vector<size_t> forward_counts(n, 0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t v = range.begin(); v != range.end(); ++v) {
+            for_each_undirected_neighbor(graph, static_cast<Vertex>(v), [&](Vertex u) {
+                forward_counts[v] += forward(static_cast<Vertex>(v), u);
+            });
+        }
+    });
+    const auto offsets = row_offsets(forward_counts);
+    std::vector<Vertex> targets(offsets.back());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t v = range.begin(); v != range.end(); ++v) {
+            size_t next = offsets[v];
+            for_each_undirected_neighbor(graph, static_cast<Vertex>(v), [&](Vertex u) {
+                if (forward(static_cast<Vertex>(v), u)) {
+                    targets[next++] = u;
+                }
+            });
+        }
+    });
+
+    std::vector<std::atomic<uint64_t>> per_vertex(n);
+    result.total = tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, n), uint64_t{0},
+        [&](const tbb::blocked_range<size_t>& range, uint64_t total) {
+            for (size_t v = range.begin(); v != range.end(); ++v) {
+                const Vertex* v_begin = targets.data() + offsets[v];
+                const Vertex* v_end = targets.data() + offsets[v + 1];
+                uint64_t at_v = 0;
+                for (const Vertex* u = v_begin; u != v_end; ++u) {
+                    // Common forward neighbours of v and u close a triangle
+                    const Vertex* a = v_begin;
+                    const Vertex* b = targets.data() + offsets[*u];
+                    const Vertex* b_end = targets.data() + offsets[*u + 1];
+                    uint64_t at_u = 0;
+                    while (a != v_end && b != b_end) {
+                        if (*a < *b) {
+                            ++a;
+                        } else if (*b < *a) {
+                            ++b;
+                        } else {
+                            per_vertex[*a].fetch_add(1, std::memory_order_relaxed);
+                            ++at_u;
+                            ++a;
+                            ++b;
+                        }
+                    }
+                    if (at_u > 0) {
+                        per_vertex[*u].fetch_add(at_u, std::memory_order_relaxed);
+                    }
+                    at_v += at_u;
+                }
+                if (at_v > 0) {
+                    per_vertex[v].fetch_add(at_v, std::memory_order_relaxed);
+                }
+                total += at_v;
+            }
+            return total;
+        },
+        std::plus<>());
+
+    for (size_t v = 0; v < n; ++v) {
+        result.per_vertex[v] = per_vertex[v].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+util::expected<void, storage::Error> write_property(storage::GraphStore& store, const CsrGraph& graph,
+                                                    const std::string& key,
+                                                    const std::function<storage::PropertyValue(CsrGraph::Vertex)>& value_of,
+                                                    transaction::TransactionId tx_id) {
+    const storage::PropertyKey property_key(key);
+    for (size_t v = 0; v < graph.vertex_count(); ++v) {
+        const auto vertex = static_cast<Vertex>(v);
+        const storage::NodeId node_id = graph.node_id(vertex);
+        auto node = store.has_mvcc() ? store.get_node(tx_id, node_id) : store.get_node(node_id);
+        if (!node.has_value()) {
+            continue;
+        }
+        auto properties = std::move(node.value().second);
+        auto value = value_of(vertex);
+        auto it = std::find_if(properties.begin(), properties.end(),
+                               [&](const storage::Property& prop) { return prop.key == property_key; });
+        if (it != properties.end()) {
+            it->value = std::move(value);
+        } else {
+            properties.emplace_back(property_key, std::move(value));
+        }
+        auto updated = store.has_mvcc() ? store.update_node(tx_id, node_id, properties)
+                                        : store.update_node(node_id, properties);
+        if (!updated.has_value()) {
+            return updated;
+        }
+    }
+    return {};
+}
+
+}  // namespace loredb::analytics
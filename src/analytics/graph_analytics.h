@@ -0,0 +1,107 @@
+/// \file graph_analytics.h
+/// \brief Parallel whole-graph analytics over a CSR snapshot: PageRank, components, triangles.
+/// \author LoreDB contributors
+/// \ingroup analytics
+#pragma once
+
+#include "../storage/graph_store.h"
+#include "../transaction/mvcc.h"
+#include "../util/expected.h"
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace loredb::analytics {
+
+/**
+ * @class CsrGraph
+ * @brief Immutable compressed-sparse-row snapshot of a GraphStore's topology.
+ *
+ * Nodes are renumbered to dense vertices 0..vertex_count() - 1 in ascending
+ * id order, and each vertex's outgoing and incoming neighbours are stored as
+ * contiguous sorted runs. Parallel edges are kept, so a vertex's degree is its
+ * number of edges as in GraphStore. The snapshot copies the adjacency lists
+ * under one lock and is independent of the store afterwards, so analytics
+ * run without holding up writers.
+ */
+class CsrGraph {
+public:
+    using Vertex = uint32_t;
+    static constexpr Vertex NO_VERTEX = UINT32_MAX;
+
+    // Snapshot of every node in `store` and the edges between them.
+    // INVALID_ARGUMENT if the nodes do not fit in 32-bit vertex numbers.
+    static util::expected<CsrGraph, storage::Error> snapshot(storage::GraphStore& store);
+
+    size_t vertex_count() const { return node_ids_.size(); }
+    size_t edge_count() const { return out_targets_.size(); }
+
+    storage::NodeId node_id(Vertex vertex) const { return node_ids_[vertex]; }
+    // NO_VERTEX for a node that is not in the snapshot
+    Vertex vertex_of(storage::NodeId node_id) const {
+        return node_id < vertex_of_.size() ? vertex_of_[node_id] : NO_VERTEX;
+    }
+
+    std::span<const Vertex> out_neighbors(Vertex vertex) const {
+        return {out_targets_.data() + out_offsets_[vertex], out_targets_.data() + out_offsets_[vertex + 1]};
+    }
+    std::span<const Vertex> in_neighbors(Vertex vertex) const {
+        return {in_sources_.data() + in_offsets_[vertex], in_sources_.data() + in_offsets_[vertex + 1]};
+    }
+    size_t out_degree(Vertex vertex) const { return out_offsets_[vertex + 1] - out_offsets_[vertex]; }
+    size_t in_degree(Vertex vertex) const { return in_offsets_[vertex + 1] - in_offsets_[vertex]; }
+
+private:
+    std::vector<storage::NodeId> node_ids_;  // By vertex, ascending
+    std::vector<Vertex> vertex_of_;          // By node id; NO_VERTEX for gaps
+    std::vector<size_t> out_offsets_;        // vertex_count() + 1 entries
+    std::vector<Vertex> out_targets_;
+    std::vector<size_t> in_offsets_;
+    std::vector<Vertex> in_sources_;
+};
+
+struct PageRankOptions {
+    double damping = 0.85;
+    size_t max_iterations = 100;
+    // Stop once the scores move by less than this in total (L1) in one iteration
+    double tolerance = 1e-9;
+};
+
+// Global PageRank by vertex, summing to 1. Each iteration pulls rank along
+// incoming edges in parallel; the rank of vertices without outgoing edges is
+// spread evenly over all vertices.
+std::vector<double> pagerank(const CsrGraph& graph, const PageRankOptions& options = {});
+
+// Weakly connected component of each vertex, named by its smallest vertex.
+// Computed by a lock-free parallel union-find that always links the larger
+// root under the smaller, so the names are deterministic.
+std::vector<CsrGraph::Vertex> weakly_connected_components(const CsrGraph& graph);
+
+struct TriangleCount {
+    uint64_t total = 0;
+    std::vector<uint64_t> per_vertex;  // Triangles through each vertex
+};
+
+// Triangles in the graph taken as undirected and simple: edge direction,
+// parallel edges and self-loops are ignored. Each edge is oriented from the
+// lower- to the higher-degree end, so every triangle is found exactly once by
+// intersecting two sorted forward lists and no list is longer than sqrt(2E).
+TriangleCount count_triangles(const CsrGraph& graph);
+
+/**
+ * @brief Store a per-vertex result as a node property.
+ *
+ * Sets `key` to value_of(vertex) on each node of the snapshot, keeping its
+ * other properties. On an MVCC store the updates are written by `tx_id`, which
+ * the caller commits. Nodes deleted since the snapshot are skipped. Property
+ * indexes over `key` are not maintained; declare them after the write-back.
+ * @return Success, or the first storage error.
+ */
+util::expected<void, storage::Error> write_property(storage::GraphStore& store, const CsrGraph& graph,
+                                                    const std::string& key,
+                                                    const std::function<storage::PropertyValue(CsrGraph::Vertex)>& value_of,
+                                                    transaction::TransactionId tx_id = 0);
+
+}  // namespace loredb::analytics
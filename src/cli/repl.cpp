@@ -1,4 +1,5 @@
 #include "repl.h"
+#include "../analytics/graph_analytics.h"
 #include "../util/logger.h"
 #include "../query/cypher/executor.h"
 #include "../storage/file_page_store.h"
@@ -6,6 +7,7 @@
 #include "../storage/simple_index_manager.h"
 #include "../query/executor.h"
 #include <iostream>
+#include <unordered_map>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -22,7 +24,11 @@ REPL::REPL(const std::string& db_path) : running_(true) {
     
     page_store_ = std::make_unique<storage::FilePageStore>(db_path);
     graph_store_ = std::make_shared<storage::GraphStore>(std::move(page_store_));
-    index_manager_ = std::make_shared<storage::SimpleIndexManager>();
+    index_manager_ = std::make_shared<storage::SimpleIndexManager>(graph_store_->page_store());
+    // Declared indexes reopen from the catalog persisted with the graph
+    if (auto attached = graph_store_->attach_index_manager(index_manager_); !attached.has_value()) {
+        LOG_ERROR("Failed to load the index catalog: {}", attached.error().message);
+    }
     query_executor_ = std::make_unique<query::QueryExecutor>(graph_store_, index_manager_);
     cypher_executor_ = std::make_unique<query::cypher::CypherExecutor>(graph_store_, index_manager_, std::make_shared<transaction::MVCCManager>(std::make_shared<transaction::TransactionManager>()));
     
@@ -113,11 +119,17 @@ void REPL::print_help() {
     std::cout << "  find-edges <key> <value>       - Find edges by property" << std::endl;
     std::cout << "  adjacent <id>                  - Get adjacent nodes" << std::endl;
     std::cout << "  path <from> <to>               - Find shortest path" << std::endl;
+    std::cout << "  wpath <from> <to> <key>        - Find least-weight path, weighting edges by a property" << std::endl;
+    std::cout << "  landmarks <key> [count]        - Precompute landmarks to speed up wpath for a weight key" << std::endl;
+    std::cout << "  khop <id> <k>                  - List nodes within k hops" << std::endl;
+    std::cout << "  reachable <from> <to> [max]    - Check reachability along edges" << std::endl;
     std::cout << "  count                          - Count nodes and edges" << std::endl;
-    std::cout << "  stats                          - Get database statistics" << std::endl;
+    std::cout << "  stats [histogram [in|out]]     - Get degree statistics or the degree histogram" << std::endl;
     std::cout << "  backlinks <id>                 - Get document backlinks" << std::endl;
     std::cout << "  outlinks <id>                  - Get document outlinks" << std::endl;
-    std::cout << "  related <id> [limit]           - Find related documents" << std::endl;
+    std::cout << "  related <id> [limit] [mode]    - Find related documents (adjacent|shared|semantic|blended)" << std::endl;
+    std::cout << "  important <id>[,<id>...] [k]   - Rank nodes by personalized PageRank" << std::endl;
+    std::cout << "  analyze <algorithm> [write]    - Run pagerank|components|triangles over the whole graph" << std::endl;
     std::cout << "  suggest <id> <content>         - Suggest links for document" << std::endl;
     std::cout << "  cypher <query>                 - Execute a Cypher query" << std::endl;
     std::cout << "  clear                          - Clear the screen" << std::endl;
@@ -154,6 +166,14 @@ void REPL::process_command(const std::string& command) {
         cmd_adjacent(args);
     } else if (cmd == "path") {
         cmd_path(args);
+    } else if (cmd == "wpath") {
+        cmd_wpath(args);
+    } else if (cmd == "landmarks") {
+        cmd_landmarks(args);
+    } else if (cmd == "khop") {
+        cmd_khop(args);
+    } else if (cmd == "reachable") {
+        cmd_reachable(args);
     } else if (cmd == "count") {
         cmd_count(args);
     } else if (cmd == "stats") {
@@ -164,6 +184,10 @@ void REPL::process_command(const std::string& command) {
         cmd_outlinks(args);
     } else if (cmd == "related") {
         cmd_related(args);
+    } else if (cmd == "important") {
+        cmd_important(args);
+    } else if (cmd == "analyze") {
+        cmd_analyze(args);
     } else if (cmd == "suggest") {
         cmd_suggest(args);
     } else if (cmd == "cypher") {
@@ -379,6 +403,98 @@ void REPL::cmd_path(const std::string& args) {
     }
 }
 
+void REPL::cmd_wpath(const std::string& args) {
+    auto tokens = tokenize(args);
+    if (tokens.size() < 3) {
+        std::cout << "Usage: wpath <from> <to> <key>" << std::endl;
+        return;
+    }
+    
+    try {
+        storage::NodeId from_node = std::stoull(tokens[0]);
+        storage::NodeId to_node = std::stoull(tokens[1]);
+        
+        auto result = query_executor_->find_weighted_shortest_path(from_node, to_node, tokens[2]);
+        
+        if (result.has_value()) {
+            print_query_result(result.value());
+        } else {
+            std::cout << "Failed to find path: " << result.error().message << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Invalid node ID format" << std::endl;
+    }
+}
+
+void REPL::cmd_landmarks(const std::string& args) {
+    auto tokens = tokenize(args);
+    if (tokens.empty()) {
+        std::cout << "Usage: landmarks <key> [count]" << std::endl;
+        return;
+    }
+    
+    try {
+        size_t count = tokens.size() > 1 ? std::stoull(tokens[1]) : query::LandmarkIndex::DEFAULT_LANDMARKS;
+        
+        auto result = query_executor_->build_path_landmarks(tokens[0], count);
+        
+        if (result.has_value()) {
+            print_query_result(result.value());
+        } else {
+            std::cout << "Failed to build landmarks: " << result.error().message << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Invalid landmark count" << std::endl;
+    }
+}
+
+void REPL::cmd_khop(const std::string& args) {
+    auto tokens = tokenize(args);
+    if (tokens.size() < 2) {
+        std::cout << "Usage: khop <id> <k>" << std::endl;
+        return;
+    }
+    
+    try {
+        storage::NodeId node_id = std::stoull(tokens[0]);
+        size_t max_hops = std::stoull(tokens[1]);
+        
+        auto result = query_executor_->get_k_hop_neighborhood(node_id, max_hops);
+        
+        if (result.has_value()) {
+            print_query_result(result.value());
+        } else {
+            std::cout << "Failed to traverse: " << result.error().message << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Invalid node ID format" << std::endl;
+    }
+}
+
+void REPL::cmd_reachable(const std::string& args) {
+    auto tokens = tokenize(args);
+    if (tokens.size() < 2) {
+        std::cout << "Usage: reachable <from> <to> [max]" << std::endl;
+        return;
+    }
+    
+    try {
+        storage::NodeId from_node = std::stoull(tokens[0]);
+        storage::NodeId to_node = std::stoull(tokens[1]);
+        size_t max_hops = tokens.size() > 2 ? std::stoull(tokens[2]) : SIZE_MAX;
+        
+        auto result = query_executor_->is_reachable(from_node, to_node, max_hops);
+        
+        if (result.has_value()) {
+            print_query_result(result.value());
+        } else {
+            std::cout << "Failed to traverse: " << result.error().message << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Invalid node ID format" << std::endl;
+    }
+}
+
 void REPL::cmd_count(const std::string& args) {
     auto nodes_result = query_executor_->count_nodes();
     auto edges_result = query_executor_->count_edges();
@@ -392,7 +508,17 @@ void REPL::cmd_count(const std::string& args) {
 }
 
 void REPL::cmd_stats(const std::string& args) {
-    auto result = query_executor_->get_node_degree_stats();
+    auto tokens = tokenize(args);
+    if (!tokens.empty() && tokens[0] != "histogram") {
+        std::cout << "Usage: stats [histogram [in|out]]" << std::endl;
+        return;
+    }
+    auto direction = storage::DegreeDirection::BOTH;
+    if (tokens.size() > 1) {
+        direction = tokens[1] == "in" ? storage::DegreeDirection::IN : storage::DegreeDirection::OUT;
+    }
+    auto result = tokens.empty() ? query_executor_->get_node_degree_stats()
+                                 : query_executor_->get_degree_histogram(direction);
     
     if (result.has_value()) {
         print_query_result(result.value());
@@ -444,7 +570,7 @@ void REPL::cmd_outlinks(const std::string& args) {
 void REPL::cmd_related(const std::string& args) {
     auto tokens = tokenize(args);
     if (tokens.empty()) {
-        std::cout << "Usage: related <id> [limit]" << std::endl;
+        std::cout << "Usage: related <id> [limit] [adjacent|shared|semantic|blended]" << std::endl;
         return;
     }
     
@@ -455,8 +581,24 @@ void REPL::cmd_related(const std::string& args) {
         if (tokens.size() > 1) {
             limit = std::stoull(tokens[1]);
         }
+
+        auto mode = query::QueryExecutor::RelatedMode::ADJACENT;
+        if (tokens.size() > 2) {
+            const std::unordered_map<std::string, query::QueryExecutor::RelatedMode> modes = {
+                {"adjacent", query::QueryExecutor::RelatedMode::ADJACENT},
+                {"shared", query::QueryExecutor::RelatedMode::SHARED_NEIGHBORS},
+                {"semantic", query::QueryExecutor::RelatedMode::SEMANTIC},
+                {"blended", query::QueryExecutor::RelatedMode::BLENDED},
+            };
+            auto it = modes.find(tokens[2]);
+            if (it == modes.end()) {
+                std::cout << "Unknown mode: " << tokens[2] << std::endl;
+                return;
+            }
+            mode = it->second;
+        }
         
-        auto result = query_executor_->find_related_documents(node_id, limit);
+        auto result = query_executor_->find_related_documents(node_id, limit, mode);
         
         if (result.has_value()) {
             print_query_result(result.value());
@@ -469,6 +611,109 @@ void REPL::cmd_related(const std::string& args) {
     }
 }
 
+void REPL::cmd_important(const std::string& args) {
+    auto tokens = tokenize(args);
+    if (tokens.empty()) {
+        std::cout << "Usage: important <id>[,<id>...] [k]" << std::endl;
+        return;
+    }
+    
+    try {
+        std::vector<storage::NodeId> sources;
+        std::stringstream ids(tokens[0]);
+        for (std::string id; std::getline(ids, id, ',');) {
+            sources.push_back(std::stoull(id));
+        }
+        size_t top_k = 10;
+        if (tokens.size() > 1) {
+            top_k = std::stoull(tokens[1]);
+        }
+        
+        auto result = query_executor_->personalized_pagerank(sources, 0.15, 1e-4, top_k);
+        
+        if (result.has_value()) {
+            print_query_result(result.value());
+        } else {
+            std::cout << "Failed to rank nodes: " << result.error().message << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Invalid node ID format" << std::endl;
+    }
+}
+
+void REPL::cmd_analyze(const std::string& args) {
+    auto tokens = tokenize(args);
+    const bool write = tokens.size() > 1 && tokens[1] == "write";
+    if (tokens.empty() || (tokens.size() > 1 && !write)) {
+        std::cout << "Usage: analyze <pagerank|components|triangles> [write]" << std::endl;
+        return;
+    }
+    const std::string& algorithm = tokens[0];
+    if (algorithm != "pagerank" && algorithm != "components" && algorithm != "triangles") {
+        std::cout << "Unknown algorithm: " << algorithm << std::endl;
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto graph = analytics::CsrGraph::snapshot(*graph_store_);
+    if (!graph.has_value()) {
+        std::cout << "Failed to snapshot graph: " << graph.error().message << std::endl;
+        return;
+    }
+    LOG_OPERATION("REPL", "analyze", "{} over {} nodes, {} edges", algorithm, graph->vertex_count(),
+                  graph->edge_count());
+
+    query::QueryResult result({"metric", "value"});
+    std::vector<double> scores;
+    std::vector<analytics::CsrGraph::Vertex> component;
+    analytics::TriangleCount triangles;
+    std::function<storage::PropertyValue(analytics::CsrGraph::Vertex)> value_of;
+    if (algorithm == "pagerank") {
+        scores = analytics::pagerank(*graph);
+        auto best = std::max_element(scores.begin(), scores.end());
+        if (best != scores.end()) {
+            const auto vertex = static_cast<analytics::CsrGraph::Vertex>(best - scores.begin());
+            result.add_row({"top_node", std::to_string(graph->node_id(vertex))});
+            result.add_row({"top_score", std::to_string(*best)});
+        }
+        value_of = [&](analytics::CsrGraph::Vertex v) { return storage::PropertyValue{scores[v]}; };
+    } else if (algorithm == "components") {
+        component = analytics::weakly_connected_components(*graph);
+        std::unordered_map<analytics::CsrGraph::Vertex, size_t> sizes;
+        for (auto root : component) {
+            ++sizes[root];
+        }
+        size_t largest = 0;
+        for (const auto& [root, size] : sizes) {
+            largest = std::max(largest, size);
+        }
+        result.add_row({"components", std::to_string(sizes.size())});
+        result.add_row({"largest_component", std::to_string(largest)});
+        // Components are named by the id of their first node
+        value_of = [&](analytics::CsrGraph::Vertex v) {
+            return storage::PropertyValue{static_cast<int64_t>(graph->node_id(component[v]))};
+        };
+    } else {
+        triangles = analytics::count_triangles(*graph);
+        result.add_row({"triangles", std::to_string(triangles.total)});
+        value_of = [&](analytics::CsrGraph::Vertex v) {
+            return storage::PropertyValue{static_cast<int64_t>(triangles.per_vertex[v])};
+        };
+    }
+
+    if (write) {
+        const std::string key = algorithm == "components" ? "component" : algorithm;
+        if (auto written = analytics::write_property(*graph_store_, *graph, key, value_of); !written.has_value()) {
+            std::cout << "Failed to write results: " << written.error().message << std::endl;
+            return;
+        }
+        result.add_row({"written_to", key});
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    result.add_row({"elapsed_ms", std::to_string(elapsed.count())});
+    print_query_result(result);
+}
+
 void REPL::cmd_suggest(const std::string& args) {
     auto tokens = tokenize(args);
     if (tokens.size() < 2) {
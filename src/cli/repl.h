@@ -56,11 +56,17 @@ private:
     void cmd_find_edges(const std::string& args);
     void cmd_adjacent(const std::string& args);
     void cmd_path(const std::string& args);
+    void cmd_wpath(const std::string& args);
+    void cmd_landmarks(const std::string& args);
+    void cmd_khop(const std::string& args);
+    void cmd_reachable(const std::string& args);
     void cmd_count(const std::string& args);
     void cmd_stats(const std::string& args);
     void cmd_backlinks(const std::string& args);
     void cmd_outlinks(const std::string& args);
     void cmd_related(const std::string& args);
+    void cmd_important(const std::string& args);
+    void cmd_analyze(const std::string& args);
     void cmd_suggest(const std::string& args);
     void cmd_cypher(const std::string& args);
     void cmd_help(const std::string& args);
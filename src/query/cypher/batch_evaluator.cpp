@@ -0,0 +1,264 @@
+#include "batch_evaluator.h"
+#include "expression_evaluator.h"
+#include "pattern_matcher.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+namespace loredb::query::cypher {
+
+namespace {
+
+// out[i] = cmp(left[i], right[i]); a stride of 0 broadcasts a scalar operand
+template <typename T, typename Cmp>
+void compare_columns(const T* left, size_t left_stride, const T* right, size_t right_stride,
+                     size_t n, uint8_t* out, Cmp cmp) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = cmp(left[i * left_stride], right[i * right_stride]);
+    }
+}
+
+template <typename T>
+void compare_typed(ComparisonOperator op, const std::vector<T>& left, bool left_scalar,
+                   const std::vector<T>& right, bool right_scalar, std::vector<uint8_t>& out) {
+    const T* l = left.data();
+    const T* r = right.data();
+    const size_t ls = left_scalar ? 0 : 1;
+    const size_t rs = right_scalar ? 0 : 1;
+    const size_t n = out.size();
+    switch (op) {
+        case ComparisonOperator::EQUAL: compare_columns(l, ls, r, rs, n, out.data(), std::equal_to<>{}); break;
+        case ComparisonOperator::NOT_EQUAL: compare_columns(l, ls, r, rs, n, out.data(), std::not_equal_to<>{}); break;
+        case ComparisonOperator::LESS_THAN: compare_columns(l, ls, r, rs, n, out.data(), std::less<>{}); break;
+        case ComparisonOperator::LESS_EQUAL: compare_columns(l, ls, r, rs, n, out.data(), std::less_equal<>{}); break;
+        case ComparisonOperator::GREATER_THAN: compare_columns(l, ls, r, rs, n, out.data(), std::greater<>{}); break;
+        case ComparisonOperator::GREATER_EQUAL: compare_columns(l, ls, r, rs, n, out.data(), std::greater_equal<>{}); break;
+    }
+}
+
+bool is_numeric(const storage::PropertyValue& value) {
+    return std::holds_alternative<int64_t>(value) || std::holds_alternative<double>(value);
+}
+
+double to_double(const storage::PropertyValue& value) {
+    return std::holds_alternative<int64_t>(value) ? static_cast<double>(std::get<int64_t>(value))
+                                                  : std::get<double>(value);
+}
+
+} // namespace
+
+PropertyValue BatchPredicate::Column::value_at(size_t i) const {
+    if (scalar) {
+        return values[0];
+    }
+    if (!sources.empty()) {
+        return from_storage_value(*sources[i]);
+    }
+    return strings[i];
+}
+
+util::expected<void, storage::Error> BatchPredicate::evaluate(const ResultSet& batch, ExecutionContext& ctx,
+                                                              SelectionVector& selection) {
+    batch_ = &batch;
+    ctx_ = &ctx;
+    fetched_.resize(layout_->size());
+    for (auto& slot : fetched_) {
+        slot.state.assign(batch.size(), 0);
+        if (slot.properties.size() < batch.size()) {
+            slot.properties.resize(batch.size());
+        }
+    }
+
+    auto result = evaluate_node(*predicate_, true, selection);
+    batch_ = nullptr;
+    ctx_ = nullptr;
+    return result;
+}
+
+util::expected<void, storage::Error> BatchPredicate::evaluate_node(const Expression& expr, bool top_level,
+                                                                   SelectionVector& selection) {
+    switch (expr.type()) {
+        case ExpressionType::COMPARISON:
+            evaluate_comparison(std::get<Comparison>(expr.content), selection);
+            return {};
+
+        case ExpressionType::LOGICAL_AND: {
+            const auto& and_expr = std::get<LogicalAnd>(expr.content);
+            evaluate_node(*and_expr.left, false, selection);
+            if (!selection.empty()) {
+                evaluate_node(*and_expr.right, false, selection);
+            }
+            return {};
+        }
+
+        case ExpressionType::LOGICAL_OR: {
+            const auto& or_expr = std::get<LogicalOr>(expr.content);
+            SelectionVector left = selection;
+            evaluate_node(*or_expr.left, false, left);
+
+            // Only rows the left side rejected need the right side
+            SelectionVector rest;
+            std::set_difference(selection.begin(), selection.end(), left.begin(), left.end(),
+                                std::back_inserter(rest));
+            if (!rest.empty()) {
+                evaluate_node(*or_expr.right, false, rest);
+            }
+
+            selection.clear();
+            std::merge(left.begin(), left.end(), rest.begin(), rest.end(), std::back_inserter(selection));
+            return {};
+        }
+
+        default:
+            // The row evaluator rejects these outright at the top and treats them as false below
+            if (top_level && !selection.empty()) {
+                return util::unexpected<storage::Error>(storage::Error{
+                    storage::ErrorCode::INVALID_ARGUMENT,
+                    "Boolean expression type not implemented"
+                });
+            }
+            selection.clear();
+            return {};
+    }
+}
+
+void BatchPredicate::evaluate_comparison(const Comparison& comp, SelectionVector& selection) {
+    const Column left = build_column(*comp.left, selection);
+    const Column right = build_column(*comp.right, selection);
+    const size_t n = selection.size();
+    std::vector<uint8_t> matches(n, 0);
+
+    if (left.type == Column::Type::NUMERIC && right.type == Column::Type::NUMERIC) {
+        compare_typed(comp.op, left.numbers, left.scalar, right.numbers, right.scalar, matches);
+    } else if (left.type == Column::Type::STRING && right.type == Column::Type::STRING) {
+        compare_typed(comp.op, left.strings, left.scalar, right.strings, right.scalar, matches);
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            if ((left.valid.empty() || left.valid[i]) && (right.valid.empty() || right.valid[i])) {
+                matches[i] = compare_values(comp.op, left.value_at(i), right.value_at(i));
+            }
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const bool keep = matches[i] && (left.valid.empty() || left.valid[i]) &&
+                          (right.valid.empty() || right.valid[i]);
+        selection[kept] = selection[i];
+        kept += keep;
+    }
+    selection.resize(kept);
+}
+
+BatchPredicate::Column BatchPredicate::build_column(const Expression& operand, const SelectionVector& selection) {
+    Column column;
+    const size_t n = selection.size();
+
+    switch (operand.type()) {
+        case ExpressionType::LITERAL: {
+            const auto& value = std::get<Literal>(operand.content).value;
+            column.scalar = true;
+            column.values.push_back(value);
+            if (std::holds_alternative<int64_t>(value)) {
+                column.type = Column::Type::NUMERIC;
+                column.numbers.push_back(static_cast<double>(std::get<int64_t>(value)));
+            } else if (std::holds_alternative<double>(value)) {
+                column.type = Column::Type::NUMERIC;
+                column.numbers.push_back(std::get<double>(value));
+            } else if (std::holds_alternative<std::string>(value)) {
+                column.type = Column::Type::STRING;
+                column.strings.push_back(std::get<std::string>(value));
+            }
+            return column;
+        }
+
+        case ExpressionType::IDENTIFIER: {
+            // Bound variables evaluate to their id as a string, as in the row evaluator
+            const size_t slot = layout_->find(std::get<Identifier>(operand.content).name);
+            column.type = Column::Type::STRING;
+            column.strings.resize(n);
+            column.valid.assign(n, 0);
+            for (size_t i = 0; i < n && slot != NO_SLOT; ++i) {
+                const Slot& binding = (*batch_)[selection[i]][slot];
+                if (binding.kind != Slot::Kind::EMPTY) {
+                    column.strings[i] = std::to_string(binding.id);
+                    column.valid[i] = 1;
+                }
+            }
+            return column;
+        }
+
+        case ExpressionType::PROPERTY_ACCESS: {
+            const auto& access = std::get<PropertyAccess>(operand.content);
+            const size_t slot = layout_->find(access.entity);
+            column.valid.assign(n, 0);
+            column.sources.assign(n, nullptr);
+
+            // Gather the stored values for the whole selection first...
+            bool all_numeric = true;
+            bool all_strings = true;
+            const auto key = storage::PropertyKey::find(access.property);
+            for (size_t i = 0; i < n && slot != NO_SLOT && key.has_value(); ++i) {
+                const auto* properties = node_properties(slot, selection[i]);
+                if (properties == nullptr) {
+                    continue;
+                }
+                for (const auto& prop : *properties) {
+                    if (prop.key == *key) {
+                        column.sources[i] = &prop.value;
+                        column.valid[i] = 1;
+                        all_numeric = all_numeric && is_numeric(prop.value);
+                        all_strings = all_strings && std::holds_alternative<std::string>(prop.value);
+                        break;
+                    }
+                }
+            }
+
+            // ...then lay them out as a typed column when they share a type
+            if (all_numeric) {
+                column.type = Column::Type::NUMERIC;
+                column.numbers.assign(n, 0.0);
+                for (size_t i = 0; i < n; ++i) {
+                    if (column.valid[i]) {
+                        column.numbers[i] = to_double(*column.sources[i]);
+                    }
+                }
+            } else if (all_strings) {
+                column.type = Column::Type::STRING;
+                column.strings.resize(n);
+                for (size_t i = 0; i < n; ++i) {
+                    if (column.valid[i]) {
+                        column.strings[i] = std::get<std::string>(*column.sources[i]);
+                    }
+                }
+            }
+            return column;
+        }
+
+        default:
+            // Not a value expression: the comparison fails for every row
+            column.valid.assign(n, 0);
+            return column;
+    }
+}
+
+const std::vector<storage::Property>* BatchPredicate::node_properties(size_t slot, uint32_t row) {
+    const Slot& binding = (*batch_)[row][slot];
+    if (binding.kind != Slot::Kind::NODE) {
+        return nullptr;
+    }
+
+    auto& cache = fetched_[slot];
+    if (cache.state[row] == 0) {
+        auto node_result = read_node(*ctx_, binding.id);
+        if (node_result.has_value()) {
+            cache.properties[row] = std::move(node_result.value().second);
+            cache.state[row] = 1;
+        } else {
+            cache.state[row] = 2;
+        }
+    }
+    return cache.state[row] == 1 ? &cache.properties[row] : nullptr;
+}
+
+} // namespace loredb::query::cypher
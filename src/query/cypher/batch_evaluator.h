@@ -0,0 +1,86 @@
+/// \file batch_evaluator.h
+/// \brief Vectorized WHERE evaluation over row batches using selection vectors.
+/// \author LoreDB contributors
+/// \ingroup query
+#pragma once
+
+#include "ast.h"
+#include "../query_types.h"
+#include "../../storage/page_store.h"
+#include "../../storage/record.h"
+#include "../../util/expected.h"
+#include <cstdint>
+#include <vector>
+
+namespace loredb::query::cypher {
+
+// Ascending indices of the batch rows that are still selected
+using SelectionVector = std::vector<uint32_t>;
+
+/**
+ * @class BatchPredicate
+ * @brief Evaluates a WHERE predicate over a whole batch of rows at once.
+ *
+ * Each node property the predicate references is fetched once per row per
+ * batch. Comparisons then run as tight loops over typed double or string
+ * columns and narrow a selection vector, instead of walking the expression tree
+ * per row. AND narrows the selection left to right and OR evaluates its right
+ * side only on rows the left side rejected. Results match
+ * evaluate_boolean_expression(): a comparison with an operand that cannot be
+ * evaluated is false.
+ */
+class BatchPredicate {
+public:
+    // `predicate` and `layout` are borrowed and must outlive this object
+    BatchPredicate(const Expression* predicate, const SlotLayout* layout)
+        : predicate_(predicate), layout_(layout) {}
+
+    // Narrows `selection` (row indices into `batch`) to the rows satisfying the predicate
+    util::expected<void, storage::Error> evaluate(const ResultSet& batch, ExecutionContext& ctx,
+                                                  SelectionVector& selection);
+
+private:
+    // Operand values for the selected rows, or a single value shared by all of them
+    struct Column {
+        enum class Type {
+            NUMERIC,    // every value is int64/double, widened to double
+            STRING,
+            MIXED       // anything else; compared value by value
+        };
+
+        Type type = Type::MIXED;
+        bool scalar = false;
+        std::vector<double> numbers;
+        std::vector<std::string> strings;
+        // The literal of a scalar column
+        std::vector<PropertyValue> values;
+        // Stored values behind a property column, for comparisons that need the original type
+        std::vector<const storage::PropertyValue*> sources;
+        // Per-row flag: operand could be evaluated (empty for scalars, which always can)
+        std::vector<uint8_t> valid;
+
+        PropertyValue value_at(size_t i) const;
+    };
+
+    util::expected<void, storage::Error> evaluate_node(const Expression& expr, bool top_level,
+                                                       SelectionVector& selection);
+    void evaluate_comparison(const Comparison& comp, SelectionVector& selection);
+    Column build_column(const Expression& operand, const SelectionVector& selection);
+
+    // Properties of the node in `slot` for batch row `row`, fetched on first use; nullptr if unreadable
+    const std::vector<storage::Property>* node_properties(size_t slot, uint32_t row);
+
+    const Expression* predicate_;
+    const SlotLayout* layout_;
+
+    // Per-batch state
+    const ResultSet* batch_ = nullptr;
+    ExecutionContext* ctx_ = nullptr;
+    struct SlotProperties {
+        std::vector<std::vector<storage::Property>> properties;
+        std::vector<uint8_t> state;     // 0 = not fetched, 1 = fetched, 2 = unreadable
+    };
+    std::vector<SlotProperties> fetched_;
+};
+
+} // namespace loredb::query::cypher
@@ -1,14 +1,41 @@
 #include "executor.h"
+#include "expression_compiler.h"
 #include "expression_evaluator.h"
+#include "pattern_matcher.h"
+#include "../planner.h"
 #include "../../util/logger.h"
 #include <algorithm>
 #include <sstream>
-#include <queue> // Added for BFS
 #include <cmath>
 #include <iostream>
+#include <unordered_map>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 namespace loredb::query::cypher {
 
+namespace {
+
+// Nodes read per task of an online index build
+constexpr storage::NodeId INDEX_BUILD_CHUNK = 1024;
+
+// Adapts a poster of one key's value to a node's whole property list
+std::function<util::expected<void, storage::Error>(storage::NodeId, const std::vector<storage::Property>&)>
+post_key_value(const std::string& key,
+               std::function<util::expected<void, storage::Error>(storage::NodeId, const storage::PropertyValue&)> post) {
+    const storage::PropertyKey key_id(key);
+    return [key_id, post = std::move(post)](storage::NodeId node_id, const std::vector<storage::Property>& properties) {
+        for (const auto& prop : properties) {
+            if (prop.key == key_id) {
+                return post(node_id, prop.value);
+            }
+        }
+        return util::expected<void, storage::Error>{};
+    };
+}
+
+}  // namespace
+
 CypherExecutor::CypherExecutor(std::shared_ptr<storage::GraphStore> graph_store,
                                std::shared_ptr<storage::SimpleIndexManager> index_manager,
                                std::shared_ptr<transaction::MVCCManager> mvcc_manager)
@@ -17,7 +44,10 @@ CypherExecutor::CypherExecutor(std::shared_ptr<storage::GraphStore> graph_store,
       mvcc_manager_(std::move(mvcc_manager)) {
 }
 
-CypherExecutor::~CypherExecutor() = default;
+CypherExecutor::~CypherExecutor() {
+    // Background builds use this executor's stores
+    wait_for_index_builds();
+}
 
 util::expected<QueryResult, storage::Error> CypherExecutor::execute_query(const std::string& cypher_query) {
     LOG_INFO("Executing Cypher query: {}", cypher_query);
@@ -37,29 +67,25 @@ util::expected<QueryResult, storage::Error> CypherExecutor::execute_query(const
     try {
         // Handle MATCH + SET/DELETE queries (write operations)
         if (query.match.has_value() && (query.set.has_value() || query.delete_clause.has_value())) {
-            // Run match to get bindings
-            auto match_result = execute_match(query.match.value(), ctx);
-            if (!match_result.has_value()) {
-                mvcc_manager_->get_transaction_manager().abort_transaction(tx);
-                mvcc_manager_->get_lock_manager().unlock_all(tx->id);
-                return util::unexpected<storage::Error>(match_result.error());
-            }
-
-            ResultSet result_set = std::move(match_result.value());
-
-            if (query.where.has_value()) {
-                auto where_result = apply_where(query.where.value(), result_set, ctx);
-                if (!where_result.has_value()) {
+            // Run match to get bindings; the plan's layout names their slots
+            Planner planner(graph_store_, index_manager_);
+            auto plan = planner.create_plan(query);
+            ResultSet result_set;
+            SlotLayout layout;
+            if (plan) {
+                auto match_result = plan->execute(ctx);
+                if (!match_result.has_value()) {
                     mvcc_manager_->get_transaction_manager().abort_transaction(tx);
                     mvcc_manager_->get_lock_manager().unlock_all(tx->id);
-                    return util::unexpected<storage::Error>(where_result.error());
+                    return util::unexpected<storage::Error>(match_result.error());
                 }
-                result_set = std::move(where_result.value());
+                result_set = std::move(match_result.value());
+                layout = plan->layout();
             }
 
             QueryResult write_result({"updated_nodes"});
             if (query.set.has_value()) {
-                auto set_res = execute_set(query.set.value(), result_set, ctx);
+                auto set_res = execute_set(query.set.value(), result_set, layout, ctx);
                 if (!set_res.has_value()) {
                     mvcc_manager_->get_transaction_manager().abort_transaction(tx);
                     mvcc_manager_->get_lock_manager().unlock_all(tx->id);
@@ -69,7 +95,7 @@ util::expected<QueryResult, storage::Error> CypherExecutor::execute_query(const
             }
 
             if (query.delete_clause.has_value()) {
-                auto del_res = execute_delete(query.delete_clause.value(), result_set, ctx);
+                auto del_res = execute_delete(query.delete_clause.value(), result_set, layout, ctx);
                 if (!del_res.has_value()) {
                     mvcc_manager_->get_transaction_manager().abort_transaction(tx);
                     mvcc_manager_->get_lock_manager().unlock_all(tx->id);
@@ -80,41 +106,26 @@ util::expected<QueryResult, storage::Error> CypherExecutor::execute_query(const
 
             mvcc_manager_->get_transaction_manager().commit_transaction(tx);
             mvcc_manager_->get_lock_manager().unlock_all(tx->id);
+            // A posting that cannot be removed is only stale: lookups re-check candidates
+            for (const auto& retired : ctx.retired_postings) {
+                retire_node_postings(ctx, retired);
+            }
             return write_result;
         }
         
         if (query.is_read_query()) {
-            ResultSet result_set;
-            
-            if (query.match.has_value()) {
-                auto match_result = execute_match(query.match.value(), ctx);
-                if (!match_result.has_value()) {
-                    mvcc_manager_->get_transaction_manager().abort_transaction(tx);
-                    mvcc_manager_->get_lock_manager().unlock_all(tx->id);
-                    return util::unexpected<storage::Error>(match_result.error());
-                }
-                result_set = std::move(match_result.value());
-            }
-            
-            if (query.where.has_value()) {
-                auto where_result = apply_where(query.where.value(), result_set, ctx);
-                if (!where_result.has_value()) {
-                    mvcc_manager_->get_transaction_manager().abort_transaction(tx);
-                    mvcc_manager_->get_lock_manager().unlock_all(tx->id);
-                    return util::unexpected<storage::Error>(where_result.error());
-                }
-                result_set = std::move(where_result.value());
-            }
-            
             if (query.return_clause.has_value()) {
-                auto return_result = execute_return(query.return_clause.value(), result_set, ctx);
+                // Rows stream from the plan straight into the projection, batch by batch
+                Planner planner(graph_store_, index_manager_);
+                auto plan = planner.create_plan(query);
+                auto return_result = execute_return(query.return_clause.value(), plan.get(), ctx);
                 if (!return_result.has_value()) {
                     mvcc_manager_->get_transaction_manager().abort_transaction(tx);
                     mvcc_manager_->get_lock_manager().unlock_all(tx->id);
                     return util::unexpected<storage::Error>(return_result.error());
                 }
                 
-                auto final_result = return_result.value();
+                auto final_result = std::move(return_result.value());
                 
                 if (query.order_by.has_value()) {
                     auto order_result = apply_order_by(final_result, query.order_by.value());
@@ -172,459 +183,8 @@ util::expected<QueryResult, storage::Error> CypherExecutor::execute_query(const
     }
 }
 
-util::expected<ResultSet, storage::Error> CypherExecutor::execute_match(const MatchClause& match_clause, 
-                                                                       ExecutionContext& ctx) {
-    ResultSet result_set;
-    
-    if (match_clause.patterns.empty()) {
-        return result_set;
-    }
-    
-    auto pattern_result = match_pattern(match_clause.patterns[0], ctx);
-    if (!pattern_result.has_value()) {
-        return util::unexpected<storage::Error>(pattern_result.error());
-    }
-    
-    result_set = std::move(pattern_result.value());
-    
-    // TODO: Handle multiple patterns with joins
-    
-    return result_set;
-}
-
-util::expected<ResultSet, storage::Error> CypherExecutor::match_pattern(const Pattern& pattern, 
-                                                                       ExecutionContext& ctx) {
-    if (pattern.nodes.empty()) {
-        return ResultSet{};
-    }
-
-    // Handle simple node patterns, e.g., MATCH (n)
-    if (pattern.nodes.size() == 1 && pattern.edges.empty()) {
-        return match_node(pattern.nodes[0], ctx);
-    }
-
-    // Handle variable-length paths
-    if (pattern.edges.size() == 1 && (pattern.edges[0].min_hops != 1 || pattern.edges[0].max_hops != 1)) {
-        return match_variable_length_path(pattern.nodes[0], pattern.edges[0], pattern.nodes[1], ctx);
-    }
-
-    // For patterns longer than a simple node match, we'll use an iterative approach.
-    // Start by finding all candidates for the first node in the pattern.
-    auto result_set_or_error = match_node(pattern.nodes[0], ctx);
-    if (!result_set_or_error.has_value()) {
-        return util::unexpected<storage::Error>(result_set_or_error.error());
-    }
-    auto result_set = result_set_or_error.value();
-
-    // Iteratively expand the match for each edge and subsequent node in the pattern.
-    for (size_t i = 0; i < pattern.edges.size(); ++i) {
-        const auto& from_node_pattern = pattern.nodes[i];
-        const auto& edge_pattern = pattern.edges[i];
-        const auto& to_node_pattern = pattern.nodes[i + 1];
-        
-        if (!from_node_pattern.variable.has_value()) {
-            return util::unexpected<storage::Error>(storage::Error{
-                storage::ErrorCode::INVALID_ARGUMENT,
-                "Path expansion requires intermediate nodes to be named."
-            });
-        }
-
-        auto expanded_result = expand_results(result_set, from_node_pattern, edge_pattern, to_node_pattern, ctx);
-        if (!expanded_result.has_value()) {
-            return util::unexpected<storage::Error>(expanded_result.error());
-        }
-        result_set = std::move(expanded_result.value());
-
-        if (result_set.empty()) {
-            break;
-        }
-    }
-    
-    return result_set;
-}
-
-util::expected<ResultSet, storage::Error> CypherExecutor::match_variable_length_path(const Node& from_node,
-                                                                                     const Edge& edge,
-                                                                                     const Node& to_node,
-                                                                                     ExecutionContext& ctx) {
-    ResultSet result_set;
-
-    auto from_node_ids_result = find_nodes_by_pattern(from_node, ctx);
-    if (!from_node_ids_result.has_value()) {
-        return util::unexpected<storage::Error>(from_node_ids_result.error());
-    }
-
-    int max_hops = (edge.max_hops == -1) ? 10 : edge.max_hops; // Limit search depth for safety
-
-    for (auto start_node_id : from_node_ids_result.value()) {
-        std::queue<std::vector<storage::NodeId>> queue;
-        queue.push({start_node_id});
-
-        while (!queue.empty()) {
-            std::vector<storage::NodeId> current_path = queue.front();
-            queue.pop();
-
-            if (current_path.size() - 1 > static_cast<size_t>(max_hops)) {
-                continue;
-            }
-
-            storage::NodeId last_node_id = current_path.back();
-
-            if (current_path.size() - 1 >= static_cast<size_t>(edge.min_hops)) {
-                if (matches_node_pattern(to_node, last_node_id, ctx)) {
-                    ResultRow row;
-                    if (from_node.variable.has_value()) {
-                        row.bindings[from_node.variable.value()] = VariableBinding(VariableBinding::Type::NODE, start_node_id);
-                    }
-                    if (to_node.variable.has_value()) {
-                        row.bindings[to_node.variable.value()] = VariableBinding(VariableBinding::Type::NODE, last_node_id);
-                    }
-                    // Note: path variable binding not implemented
-                    result_set.push_back(std::move(row));
-
-                }
-            }
-
-            // Expand to neighbors
-            if (current_path.size() - 1 < static_cast<size_t>(max_hops)) {
-                auto edge_ids_result = find_edges_by_pattern(edge, last_node_id, 0, ctx);
-                if (edge_ids_result.has_value()) {
-                    for (auto edge_id : edge_ids_result.value()) {
-                        auto edge_result = ctx.graph_store->has_mvcc()
-                            ? ctx.graph_store->get_edge(ctx.tx_id, edge_id)
-                            : ctx.graph_store->get_edge(edge_id);
-                        
-                        if (edge_result.has_value()) {
-                            auto neighbor_id = edge_result.value().first.to_node;
-                            // Avoid cycles in the path
-                            if (std::find(current_path.begin(), current_path.end(), neighbor_id) == current_path.end()) {
-                                std::vector<storage::NodeId> new_path = current_path;
-                                new_path.push_back(neighbor_id);
-                                queue.push(new_path);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    return result_set;
-}
-
-util::expected<ResultSet, storage::Error> CypherExecutor::match_node(const Node& node, 
-                                                                    ExecutionContext& ctx) {
-    auto node_ids_result = find_nodes_by_pattern(node, ctx);
-    if (!node_ids_result.has_value()) {
-        return util::unexpected<storage::Error>(node_ids_result.error());
-    }
-    
-    ResultSet result_set;
-    for (auto node_id : node_ids_result.value()) {
-        ResultRow row;
-        if (node.variable.has_value()) {
-            row.bindings[node.variable.value()] = VariableBinding(
-                VariableBinding::Type::NODE, 
-                node_id
-            );
-        }
-        result_set.push_back(std::move(row));
-    }
-    
-    return result_set;
-}
-
-util::expected<std::vector<storage::NodeId>, storage::Error> CypherExecutor::find_nodes_by_pattern(const Node& node, 
-                                                                                                   ExecutionContext& ctx) {
-    std::vector<storage::NodeId> result;
-    
-    if (!node.properties.empty()) {
-        // Search for nodes with specific properties
-        size_t node_count = ctx.graph_store->get_node_count();
-        for (storage::NodeId node_id = 1; node_id <= node_count; ++node_id) {
-            if (ctx.graph_store->has_mvcc()) {
-                auto node_result = ctx.graph_store->get_node(ctx.tx_id, node_id);
-                if (node_result.has_value()) {
-                    auto [node_record, properties] = node_result.value();
-                    if (matches_property_constraints(node.properties, properties)) {
-                        result.push_back(node_id);
-                    }
-                }
-            } else {
-                auto node_result = ctx.graph_store->get_node(node_id);
-                if (node_result.has_value()) {
-                    auto [node_record, properties] = node_result.value();
-                    if (matches_property_constraints(node.properties, properties)) {
-                        result.push_back(node_id);
-                    }
-                }
-            }
-        }
-    } else {
-        // Get all nodes by checking based on node count
-        // This is inefficient but works for now - better solution would be to add
-        // a get_all_node_ids() method to GraphStore
-        size_t node_count = ctx.graph_store->get_node_count();
-        for (storage::NodeId node_id = 1; node_id <= node_count; ++node_id) {
-            if (ctx.graph_store->has_mvcc()) {
-                auto node_result = ctx.graph_store->get_node(ctx.tx_id, node_id);
-                if (node_result.has_value()) {
-                    result.push_back(node_id);
-                }
-            } else {
-                auto node_result = ctx.graph_store->get_node(node_id);
-                if (node_result.has_value()) {
-                    result.push_back(node_id);
-                }
-            }
-        }
-    }
-    
-    return result;
-}
-
-util::expected<ResultSet, storage::Error> CypherExecutor::expand_results(const ResultSet& previous_results,
-                                                                       const Node& from_node_pattern,
-                                                                       const Edge& edge_pattern,
-                                                                       const Node& to_node_pattern,
-                                                                       ExecutionContext& ctx) {
-    ResultSet new_results;
-
-    if (!from_node_pattern.variable.has_value()) {
-        return util::unexpected<storage::Error>(storage::Error{
-            storage::ErrorCode::INVALID_ARGUMENT,
-            "Cannot expand from a node without a variable."
-        });
-    }
-
-    for (const auto& row : previous_results) {
-        auto it = row.bindings.find(from_node_pattern.variable.value());
-        if (it == row.bindings.end() || it->second.type != VariableBinding::Type::NODE) {
-            continue;
-        }
-        
-        storage::NodeId from_id = it->second.id_value;
-
-        auto edge_ids_result = find_edges_by_pattern(edge_pattern, from_id, 0, ctx);
-        if (!edge_ids_result.has_value()) {
-            continue;
-        }
-
-        for (auto edge_id : edge_ids_result.value()) {
-            auto edge_result = ctx.graph_store->has_mvcc()
-                ? ctx.graph_store->get_edge(ctx.tx_id, edge_id)
-                : ctx.graph_store->get_edge(edge_id);
-
-            if (!edge_result.has_value()) {
-                continue;
-            }
-
-            auto& [edge_record, edge_properties] = edge_result.value();
-            storage::NodeId to_id = edge_record.to_node;
-            
-            if (matches_node_pattern(to_node_pattern, to_id, ctx)) {
-                ResultRow new_row = row;
-
-                if (edge_pattern.variable.has_value()) {
-                    new_row.bindings[edge_pattern.variable.value()] = VariableBinding(
-                        VariableBinding::Type::EDGE, edge_id);
-                }
-                if (to_node_pattern.variable.has_value()) {
-                    auto to_var_it = new_row.bindings.find(to_node_pattern.variable.value());
-                    if (to_var_it != new_row.bindings.end()) {
-                        if (to_var_it->second.type == VariableBinding::Type::NODE && to_var_it->second.id_value == to_id) {
-                            // This path is a cycle, which is valid.
-                        } else {
-                            // This variable is already bound to a different node, so this path is not a match.
-                            continue;
-                        }
-                    } else {
-                        new_row.bindings[to_node_pattern.variable.value()] = VariableBinding(
-                            VariableBinding::Type::NODE, to_id);
-                    }
-                }
-                new_results.push_back(std::move(new_row));
-            }
-        }
-    }
-
-    return new_results;
-}
-
-util::expected<ResultSet, storage::Error> CypherExecutor::match_node_edge_node_pattern(const Node& from_node,
-                                                                                      const Edge& edge,
-                                                                                      const Node& to_node,
-                                                                                      ExecutionContext& ctx) {
-    ResultSet result_set;
-    
-    auto from_node_ids_result = find_nodes_by_pattern(from_node, ctx);
-    if (!from_node_ids_result.has_value()) {
-        return util::unexpected<storage::Error>(from_node_ids_result.error());
-    }
-    
-    for (auto from_id : from_node_ids_result.value()) {
-        auto edge_ids_result = find_edges_by_pattern(edge, from_id, 0, ctx);
-        if (!edge_ids_result.has_value()) {
-            continue;
-        }
-        
-        for (auto edge_id : edge_ids_result.value()) {
-            auto edge_result = ctx.graph_store->has_mvcc() 
-                ? ctx.graph_store->get_edge(ctx.tx_id, edge_id)
-                : ctx.graph_store->get_edge(edge_id);
-                
-            if (!edge_result.has_value()) {
-                continue;
-            }
-            
-            auto [edge_record, edge_properties] = edge_result.value();
-            auto to_id = edge_record.to_node;
-            
-            if (matches_node_pattern(to_node, to_id, ctx)) {
-                ResultRow row;
-                
-                if (from_node.variable.has_value()) {
-                    row.bindings[from_node.variable.value()] = VariableBinding(
-                        VariableBinding::Type::NODE, from_id);
-                }
-                
-                if (edge.variable.has_value()) {
-                    row.bindings[edge.variable.value()] = VariableBinding(
-                        VariableBinding::Type::EDGE, edge_id);
-                }
-                
-                if (to_node.variable.has_value()) {
-                    row.bindings[to_node.variable.value()] = VariableBinding(
-                        VariableBinding::Type::NODE, to_id);
-                }
-                
-                result_set.push_back(std::move(row));
-            }
-        }
-    }
-    
-    return result_set;
-}
-
-
-util::expected<std::vector<storage::EdgeId>, storage::Error> CypherExecutor::find_edges_by_pattern(const Edge& edge,
-                                                                                                   storage::NodeId from_node,
-                                                                                                   storage::NodeId to_node,
-                                                                                                   ExecutionContext& ctx) {
-    std::vector<storage::EdgeId> result;
-    
-    // Get outgoing edges from the source node using GraphStore directly
-    auto outgoing_edges_result = ctx.graph_store->get_outgoing_edges(from_node);
-    if (outgoing_edges_result.has_value()) {
-        auto outgoing_edges = outgoing_edges_result.value();
-        result.insert(result.end(), outgoing_edges.begin(), outgoing_edges.end());
-    }
-
-    // If the edge is undirected, also get incoming edges
-    if (!edge.directed) {
-        auto incoming_edges_result = ctx.graph_store->get_incoming_edges(from_node);
-        if (incoming_edges_result.has_value()) {
-            auto incoming_edges = incoming_edges_result.value();
-            result.insert(result.end(), incoming_edges.begin(), incoming_edges.end());
-        }
-    }
-    
-    std::vector<storage::EdgeId> filtered_result;
-    for (auto edge_id : result) {
-        // Get edge details
-        auto edge_result = ctx.graph_store->has_mvcc()
-            ? ctx.graph_store->get_edge(ctx.tx_id, edge_id)
-            : ctx.graph_store->get_edge(edge_id);
-            
-        if (!edge_result.has_value()) {
-            continue;
-        }
-        
-        auto [edge_record, edge_properties] = edge_result.value();
-        
-        // Check if this edge matches our pattern
-        if (matches_edge_pattern(edge, edge_record, edge_properties)) {
-            // If to_node is specified (non-zero), check it matches
-            if (to_node == 0 || edge_record.to_node == to_node || (!edge.directed && edge_record.from_node == to_node)) {
-                filtered_result.push_back(edge_id);
-            }
-        }
-    }
-    
-    return filtered_result;
-}
-
-bool CypherExecutor::matches_node_pattern(const Node& pattern, storage::NodeId node_id, ExecutionContext& ctx) {
-    auto node_result = ctx.graph_store->has_mvcc()
-        ? ctx.graph_store->get_node(ctx.tx_id, node_id)
-        : ctx.graph_store->get_node(node_id);
-        
-    if (!node_result.has_value()) {
-        return false;
-    }
-    
-    auto [node_record, properties] = node_result.value();
-    
-    return matches_property_constraints(pattern.properties, properties);
-}
-
-bool CypherExecutor::matches_edge_pattern(const Edge& pattern, 
-                                         const storage::EdgeRecord& /*edge_record*/,
-                                         const std::vector<storage::Property>& edge_properties) {
-    if (!pattern.types.empty()) {
-        bool type_matches = false;
-        for (const auto& prop : edge_properties) {
-            if (prop.key == "type") {
-                auto type_str = std::visit([](const auto& v) -> std::string {
-                    if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::string>) {
-                        return v;
-                    } else {
-                        return "unknown";
-                    }
-                }, prop.value);
-                
-                for (const auto& expected_type : pattern.types) {
-                    if (type_str == expected_type) {
-                        type_matches = true;
-                        break;
-                    }
-                }
-                break;
-            }
-        }
-        
-        if (!type_matches) {
-            return false;
-        }
-    }
-    
-    return matches_property_constraints(pattern.properties, edge_properties);
-}
-
-util::expected<ResultSet, storage::Error> CypherExecutor::apply_where(const WhereClause& where_clause, 
-                                                                     const ResultSet& input, 
-                                                                     ExecutionContext& ctx) {
-    ResultSet result_set;
-    
-
-    for (const auto& row : input) {
-        auto condition_result = evaluate_boolean_expression(*where_clause.condition, row.bindings, ctx);
-        if (!condition_result.has_value()) {
-            return util::unexpected<storage::Error>(condition_result.error());
-        }
-        
-
-        if (condition_result.value()) {
-            result_set.push_back(row);
-        }
-    }
-
-    
-    return result_set;
-}
-
 util::expected<QueryResult, storage::Error> CypherExecutor::execute_return(const ReturnClause& return_clause, 
-                                                                          const ResultSet& input, 
+                                                                          ExecutionPlan* plan, 
                                                                           ExecutionContext& ctx) {
     std::vector<std::string> columns;
     std::vector<std::vector<std::string>> rows;
@@ -653,19 +213,47 @@ util::expected<QueryResult, storage::Error> CypherExecutor::execute_return(const
         }
     }
     
-    for (const auto& row : input) {
-        std::vector<std::string> result_row;
-        
+    if (plan != nullptr) {
+        // Lower the projections once; each row is then a call per item
+        std::vector<CompiledExpression> projections;
+        projections.reserve(return_clause.items.size());
         for (const auto& item : return_clause.items) {
-            auto value_result = evaluate_expression(*item.expression, row.bindings, ctx);
-            if (!value_result.has_value()) {
-                return util::unexpected<storage::Error>(value_result.error());
+            projections.push_back(CompiledExpression::compile(*item.expression, plan->layout()));
+        }
+
+        auto opened = plan->open(ctx);
+        if (!opened.has_value()) {
+            return util::unexpected<storage::Error>(opened.error());
+        }
+
+        ResultSet batch;
+        while (true) {
+            auto pulled = plan->next_batch(ctx, batch);
+            if (!pulled.has_value()) {
+                plan->close();
+                return util::unexpected<storage::Error>(pulled.error());
+            }
+            if (batch.empty()) {
+                break;
+            }
+
+            for (size_t i = 0; i < batch.size(); ++i) {
+                std::vector<std::string> result_row;
+
+                for (const auto& projection : projections) {
+                    auto value_result = projection.evaluate(batch[i], ctx);
+                    if (!value_result.has_value()) {
+                        plan->close();
+                        return util::unexpected<storage::Error>(value_result.error());
+                    }
+
+                    result_row.push_back(property_value_to_string(value_result.value()));
+                }
+
+                rows.push_back(std::move(result_row));
             }
-            
-            result_row.push_back(property_value_to_string(value_result.value()));
         }
-        
-        rows.push_back(std::move(result_row));
+        plan->close();
     }
     
     QueryResult result(std::move(columns));
@@ -701,19 +289,22 @@ util::expected<QueryResult, storage::Error> CypherExecutor::execute_create(const
 
 util::expected<QueryResult, storage::Error> CypherExecutor::execute_set(const SetClause& set_clause,
                                                                        const ResultSet& input,
+                                                                       const SlotLayout& layout,
                                                                        ExecutionContext& ctx) {
     size_t updated_nodes = 0;
+    const size_t slot = layout.find(set_clause.variable);
+    const auto value_program = CompiledExpression::compile(*set_clause.value, layout);
 
-    for (const auto& row : input) {
-        auto it = row.bindings.find(set_clause.variable);
-        if (it == row.bindings.end() || it->second.type != VariableBinding::Type::NODE) {
+    for (size_t i = 0; slot != NO_SLOT && i < input.size(); ++i) {
+        RowView row = input[i];
+        if (row[slot].kind != Slot::Kind::NODE) {
             continue; // variable not bound to node in this row
         }
 
-        storage::NodeId node_id = it->second.id_value;
+        storage::NodeId node_id = row[slot].id;
 
         // Evaluate value expression in context of this row
-        auto val_result = evaluate_expression(*set_clause.value, row.bindings, ctx);
+        auto val_result = value_program.evaluate(row, ctx);
         if (!val_result.has_value()) {
             return util::unexpected<storage::Error>(val_result.error());
         }
@@ -729,33 +320,31 @@ util::expected<QueryResult, storage::Error> CypherExecutor::execute_set(const Se
 
         auto [node_record, properties] = node_res.value();
 
+        const storage::PropertyValue stored_value = std::visit([](const auto& v) -> storage::PropertyValue {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::string>) return v;
+            else if constexpr (std::is_same_v<T, int64_t>) return v;
+            else if constexpr (std::is_same_v<T, double>) return v;
+            else if constexpr (std::is_same_v<T, bool>) return v;
+            else return std::string("binary_data");
+        }, new_value);
+
         bool found = false;
         for (auto& prop : properties) {
             if (prop.key == set_clause.property) {
-                // update
-                prop.value = std::visit([](const auto& v) -> storage::PropertyValue {
-                    using T = std::decay_t<decltype(v)>;
-                    if constexpr (std::is_same_v<T, std::string>) return v;
-                    else if constexpr (std::is_same_v<T, int64_t>) return v;
-                    else if constexpr (std::is_same_v<T, double>) return v;
-                    else if constexpr (std::is_same_v<T, bool>) return v;
-                    else return std::string("binary_data");
-                }, new_value);
+                // update; postings of the old value are removed once the write commits
+                // (composite postings need the node's other values too)
+                if (index_value(prop.value) != index_value(stored_value)) {
+                    ctx.retired_postings.push_back({node_id, properties, set_clause.property});
+                }
+                prop.value = stored_value;
                 found = true;
                 break;
             }
         }
         if (!found) {
             // add new property
-            storage::PropertyValue sv = std::visit([](const auto& v) -> storage::PropertyValue {
-                using T = std::decay_t<decltype(v)>;
-                if constexpr (std::is_same_v<T, std::string>) return v;
-                else if constexpr (std::is_same_v<T, int64_t>) return v;
-                else if constexpr (std::is_same_v<T, double>) return v;
-                else if constexpr (std::is_same_v<T, bool>) return v;
-                else return std::string("binary_data");
-            }, new_value);
-            properties.emplace_back(set_clause.property, sv);
+            properties.emplace_back(set_clause.property, stored_value);
         }
 
         // Apply update
@@ -766,6 +355,11 @@ util::expected<QueryResult, storage::Error> CypherExecutor::execute_set(const Se
             return util::unexpected<storage::Error>(upd_res.error());
         }
 
+        // Post the new value; until the commit, lookups re-check and skip the old postings
+        if (auto indexed = update_node_indexes(ctx, node_id, properties, set_clause.property); !indexed.has_value()) {
+            return util::unexpected<storage::Error>(indexed.error());
+        }
+
         updated_nodes++;
     }
 
@@ -776,24 +370,41 @@ util::expected<QueryResult, storage::Error> CypherExecutor::execute_set(const Se
 
 util::expected<QueryResult, storage::Error> CypherExecutor::execute_delete(const DeleteClause& delete_clause,
                                                                           const ResultSet& input,
+                                                                          const SlotLayout& layout,
                                                                           ExecutionContext& ctx) {
     size_t deleted_nodes = 0;
     size_t deleted_edges = 0;
 
-    // For each row in bindings
-    for (const auto& row : input) {
-        for (const auto& var : delete_clause.variables) {
-            auto it = row.bindings.find(var);
-            if (it == row.bindings.end()) continue;
+    // Resolve the variables once; each row is then indexed directly
+    std::vector<size_t> slots;
+    for (const auto& var : delete_clause.variables) {
+        size_t slot = layout.find(var);
+        if (slot != NO_SLOT) {
+            slots.push_back(slot);
+        }
+    }
 
-            if (it->second.type == VariableBinding::Type::NODE) {
-                storage::NodeId node_id = it->second.id_value;
+    // For each row in bindings
+    for (size_t i = 0; i < input.size(); ++i) {
+        RowView row = input[i];
+        for (size_t slot : slots) {
+            const Slot& binding = row[slot];
+
+            if (binding.kind == Slot::Kind::NODE) {
+                storage::NodeId node_id = binding.id;
+                auto node_res = ctx.graph_store->has_mvcc() ? ctx.graph_store->get_node(ctx.tx_id, node_id)
+                                                            : ctx.graph_store->get_node(node_id);
                 auto del_res = ctx.graph_store->has_mvcc() ?
                     ctx.graph_store->delete_node(ctx.tx_id, node_id) :
                     ctx.graph_store->delete_node(node_id);
-                if (del_res.has_value()) deleted_nodes++;
-            } else if (it->second.type == VariableBinding::Type::EDGE) {
-                storage::EdgeId edge_id = it->second.id_value;
+                if (del_res.has_value()) {
+                    deleted_nodes++;
+                    if (node_res.has_value()) {
+                        ctx.retired_postings.push_back({node_id, std::move(node_res.value().second), std::nullopt});
+                    }
+                }
+            } else if (binding.kind == Slot::Kind::EDGE) {
+                storage::EdgeId edge_id = binding.id;
                 auto del_res = ctx.graph_store->has_mvcc() ?
                     ctx.graph_store->delete_edge(ctx.tx_id, edge_id) :
                     ctx.graph_store->delete_edge(edge_id);
@@ -807,65 +418,6 @@ util::expected<QueryResult, storage::Error> CypherExecutor::execute_delete(const
     return result;
 }
 
-bool CypherExecutor::matches_property_constraints(const PropertyMap& constraints,
-                                                 const std::vector<storage::Property>& node_properties) {
-    for (const auto& [key, expected_value] : constraints) {
-        bool found_match = false;
-        for (const auto& prop : node_properties) {
-            if (prop.key != key) continue;
-
-            // Convert storage::PropertyValue to AST PropertyValue
-            PropertyValue actual_value = std::visit([](const auto& v) -> PropertyValue {
-                using T = std::decay_t<decltype(v)>;
-                if constexpr (std::is_same_v<T, std::string>) return v;
-                else if constexpr (std::is_same_v<T, int64_t>) return v;
-                else if constexpr (std::is_same_v<T, double>) return v;
-                else if constexpr (std::is_same_v<T, bool>) return v;
-                else return std::string("binary_data");
-            }, prop.value);
-
-            // Compare based on contained types
-            if (actual_value.index() == expected_value.index()) {
-                // Same type – direct comparison via std::visit
-                bool equal = std::visit([](const auto& a, const auto& b) -> bool {
-                    using Ta = std::decay_t<decltype(a)>;
-                    using Tb = std::decay_t<decltype(b)>;
-                    if constexpr (std::is_same_v<Ta, Tb>) {
-                        return a == b;
-                    } else {
-                        // This case should not happen due to index check, but keep safe
-                        return false;
-                    }
-                }, actual_value, expected_value);
-                if (equal) {
-                    found_match = true;
-                    break;
-                }
-            } else {
-                // Handle numeric cross-type comparisons (int vs double)
-                bool actual_is_num = std::holds_alternative<int64_t>(actual_value) || std::holds_alternative<double>(actual_value);
-                bool expected_is_num = std::holds_alternative<int64_t>(expected_value) || std::holds_alternative<double>(expected_value);
-                if (actual_is_num && expected_is_num) {
-                    double act = std::holds_alternative<int64_t>(actual_value) ? static_cast<double>(std::get<int64_t>(actual_value)) : std::get<double>(actual_value);
-                    double exp = std::holds_alternative<int64_t>(expected_value) ? static_cast<double>(std::get<int64_t>(expected_value)) : std::get<double>(expected_value);
-                    if (std::abs(act - exp) < 1e-9) {
-                        found_match = true;
-                        break;
-                    }
-                } else {
-                    // Fallback to string comparison
-                    if (property_value_to_string(actual_value) == property_value_to_string(expected_value)) {
-                        found_match = true;
-                        break;
-                    }
-                }
-            }
-        }
-        if (!found_match) return false;
-    }
-    return true;
-}
-
 util::expected<storage::NodeId, storage::Error> CypherExecutor::create_node_from_pattern(const Node& node,
                                                                                         ExecutionContext& ctx) {
     std::vector<storage::Property> properties;
@@ -881,11 +433,175 @@ util::expected<storage::NodeId, storage::Error> CypherExecutor::create_node_from
         properties.emplace_back(key, storage_value);
     }
     
-    if (ctx.graph_store->has_mvcc()) {
-        return ctx.graph_store->create_node(ctx.tx_id, properties);
-    } else {
-        return ctx.graph_store->create_node(properties);
+    auto node_id = ctx.graph_store->has_mvcc()
+        ? ctx.graph_store->create_node(ctx.tx_id, properties, node.labels)
+        : ctx.graph_store->create_node(properties, node.labels);
+    if (node_id.has_value()) {
+        if (auto indexed = update_node_indexes(ctx, node_id.value(), properties); !indexed.has_value()) {
+            return util::unexpected<storage::Error>(indexed.error());
+        }
+    }
+    return node_id;
+}
+
+util::expected<void, storage::Error> CypherExecutor::create_node_property_index(const std::string& key) {
+    return start_node_property_index_build(key).get();
+}
+
+util::expected<void, storage::Error> CypherExecutor::create_node_range_index(const std::string& key) {
+    return start_node_range_index_build(key).get();
+}
+
+util::expected<void, storage::Error> CypherExecutor::create_node_composite_index(const std::vector<std::string>& keys) {
+    return start_node_composite_index_build(keys).get();
+}
+
+util::expected<void, storage::Error> CypherExecutor::create_text_index(const std::vector<std::string>& keys) {
+    return start_text_index_build(keys).get();
+}
+
+util::expected<void, storage::Error> CypherExecutor::create_vector_index(const std::string& key) {
+    return start_vector_index_build(key).get();
+}
+
+CypherExecutor::IndexBuild CypherExecutor::start_node_property_index_build(const std::string& key) {
+    return start_index_build(
+        storage::SimpleIndexManager::property_index_name(key),
+        [this, key] { index_manager_->create_node_property_index(key); },
+        post_key_value(key, [this, key](storage::NodeId node_id, const storage::PropertyValue& value) {
+            return index_manager_->index_node_property(node_id, key, index_value(value));
+        }),
+        [this, key] { index_manager_->drop_node_property_index(key); });
+}
+
+CypherExecutor::IndexBuild CypherExecutor::start_node_range_index_build(const std::string& key) {
+    return start_index_build(
+        storage::SimpleIndexManager::range_index_name(key),
+        [this, key] { index_manager_->create_node_range_index(key); },
+        post_key_value(key, [this, key](storage::NodeId node_id, const storage::PropertyValue& value) {
+            return index_manager_->index_node_range(node_id, key, value);
+        }),
+        [this, key] { index_manager_->drop_node_range_index(key); });
+}
+
+CypherExecutor::IndexBuild CypherExecutor::start_node_composite_index_build(const std::vector<std::string>& keys) {
+    return start_index_build(
+        storage::SimpleIndexManager::composite_index_name(keys),
+        [this, keys] { index_manager_->create_node_composite_index(keys); },
+        [this](storage::NodeId node_id, const std::vector<storage::Property>& properties) {
+            std::unordered_map<std::string, std::string> values;
+            for (const auto& prop : properties) {
+                values.emplace(prop.key.str(), index_value(prop.value));
+            }
+            return index_manager_->index_node_composites(node_id, values);
+        },
+        [this, keys] { index_manager_->drop_node_composite_index(keys); });
+}
+
+CypherExecutor::IndexBuild CypherExecutor::start_text_index_build(const std::vector<std::string>& keys) {
+    return start_index_build(
+        storage::SimpleIndexManager::text_index_name(keys),
+        [this, keys] { index_manager_->create_text_index(keys); },
+        [this](storage::NodeId node_id, const std::vector<storage::Property>& properties) {
+            index_manager_->index_node_text(node_id, properties);
+            return util::expected<void, storage::Error>{};
+        },
+        [this] { index_manager_->drop_text_index(); });
+}
+
+CypherExecutor::IndexBuild CypherExecutor::start_vector_index_build(const std::string& key) {
+    return start_index_build(
+        storage::SimpleIndexManager::vector_index_name(key),
+        [this, key] { index_manager_->create_vector_index(key); },
+        post_key_value(key, [this, key](storage::NodeId node_id, const storage::PropertyValue& value) {
+            auto vector = storage::vector_value(value);
+            return vector.has_value() ? index_manager_->index_node_vector(node_id, key, *vector)
+                                      : util::expected<void, storage::Error>{};
+        }),
+        [this, key] { index_manager_->drop_vector_index(key); });
+}
+
+util::expected<void, storage::Error> CypherExecutor::wait_for_index_builds() {
+    std::vector<IndexBuild> builds;
+    {
+        std::lock_guard<std::mutex> lock(builds_mutex_);
+        builds.swap(index_builds_);
+    }
+    util::expected<void, storage::Error> result;
+    for (auto& build : builds) {
+        if (auto built = build.get(); !built.has_value() && result.has_value()) {
+            result = built;
+        }
+    }
+    return result;
+}
+
+CypherExecutor::IndexBuild CypherExecutor::start_index_build(const std::string& index,
+                                                             const std::function<void()>& declare, NodePoster post,
+                                                             std::function<void()> drop) {
+    // Mark the build pending before declaring, so no reader sees the index
+    // declared and ready while it is empty; once declared, writers post to it
+    index_manager_->begin_index_build(index, 0);
+    declare();
+    IndexBuild build = std::async(std::launch::async, [this, index, post = std::move(post), drop = std::move(drop)] {
+        auto built = build_index(index, post);
+        if (!built.has_value()) {
+            drop();
+        }
+        index_manager_->finish_index_build(index, built.has_value() ? std::nullopt
+                                                                    : std::optional<storage::Error>(built.error()));
+        return built;
+    }).share();
+
+    std::lock_guard<std::mutex> lock(builds_mutex_);
+    index_builds_.push_back(build);
+    return build;
+}
+
+util::expected<void, storage::Error> CypherExecutor::build_index(const std::string& index, const NodePoster& post) {
+    auto& transactions = mvcc_manager_->get_transaction_manager();
+    auto tx = transactions.begin_transaction();
+
+    // Transactions that began before the index was declared may have skipped
+    // posting to it; once they have finished, their writes are visible to us
+    transactions.wait_for_transactions_before(tx->id);
+
+    // Nodes created from here on are posted by their writers. Deleted nodes leave
+    // gaps in the ids, so the scan covers every id handed out so far.
+    const storage::NodeId id_limit = graph_store_->get_node_id_limit();
+    index_manager_->begin_index_build(index, id_limit - 1);
+    std::mutex error_mutex;
+    std::optional<storage::Error> error;
+    std::atomic<bool> failed{false};
+    tbb::parallel_for(tbb::blocked_range<storage::NodeId>(1, id_limit, INDEX_BUILD_CHUNK),
+                      [&](const tbb::blocked_range<storage::NodeId>& chunk) {
+        if (failed.load(std::memory_order_relaxed)) {
+            return;
+        }
+        ExecutionContext ctx(graph_store_, index_manager_, tx->id);
+        for (storage::NodeId node_id = chunk.begin(); node_id != chunk.end(); ++node_id) {
+            auto node_result = read_node(ctx, node_id);
+            if (!node_result.has_value()) {
+                continue;
+            }
+            if (auto posted = post(node_id, node_result.value().second); !posted.has_value()) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error.has_value()) {
+                    error = posted.error();
+                }
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+        index_manager_->advance_index_build(index, chunk.size());
+    });
+
+    transactions.commit_transaction(tx);
+    mvcc_manager_->get_lock_manager().unlock_all(tx->id);
+    if (error.has_value()) {
+        return util::unexpected(*error);
     }
+    return {};
 }
 
 util::expected<QueryResult, storage::Error> CypherExecutor::apply_limit(const QueryResult& result, 
@@ -3,11 +3,15 @@
 #include "ast.h"
 #include "parser.h"
 #include "../query_types.h"
+#include "../execution_plan.h"
 #include "../../storage/graph_store.h"
 #include "../../storage/simple_index_manager.h"
 #include "../../transaction/mvcc.h"
 #include "../../util/expected.h"
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -27,67 +31,85 @@ public:
     // Execute a parsed query AST
     util::expected<QueryResult, storage::Error> execute_query(const Query& query);
 
+    using IndexBuild = std::shared_future<util::expected<void, storage::Error>>;
+
+    // Declares an equality index on node property `key` and posts the existing
+    // nodes' values. MATCH then seeks it for string constraints on `key`, and
+    // CREATE/SET through this executor keep it up to date.
+    util::expected<void, storage::Error> create_node_property_index(const std::string& key);
+
+    // Declares an ordered range index on node property `key` and posts the
+    // existing nodes' values. MATCH then seeks it for WHERE bounds
+    // (`<`, `<=`, `>`, `>=`) on `key`, and writes keep it up to date.
+    util::expected<void, storage::Error> create_node_range_index(const std::string& key);
+
+    // Declares a composite index over the ordered `keys` and posts the existing
+    // nodes. MATCH probes it once for string constraints on all of `keys` or on
+    // a leading subset of them.
+    util::expected<void, storage::Error> create_node_composite_index(const std::vector<std::string>& keys);
+
+    // Declares the full-text index over the string values of `keys` and posts
+    // the existing nodes' text. QueryExecutor::suggest_links_for_document ranks
+    // candidates with it, and CREATE/SET keep it up to date.
+    util::expected<void, storage::Error> create_text_index(const std::vector<std::string>& keys);
+
+    // Declares an HNSW vector index on node property `key` and posts the
+    // existing nodes' vectors. QueryExecutor::find_related_documents searches it
+    // in its semantic modes, and CREATE/SET keep it up to date.
+    util::expected<void, storage::Error> create_vector_index(const std::string& key);
+
+    // Online variants of the above: declare the index and return at once, posting
+    // the existing nodes on a background thread in parallel chunks of a snapshot.
+    // Writers post their own changes from the moment the index is declared, so the
+    // build only waits for transactions that were already running. MATCH uses the
+    // index once the build marks it ready; progress and failures are visible in
+    // the index manager's get_index_builds(). A failed build drops its index.
+    IndexBuild start_node_property_index_build(const std::string& key);
+    IndexBuild start_node_range_index_build(const std::string& key);
+    IndexBuild start_node_composite_index_build(const std::vector<std::string>& keys);
+    IndexBuild start_text_index_build(const std::vector<std::string>& keys);
+    IndexBuild start_vector_index_build(const std::string& key);
+    // Waits for every background build; returns the first failure
+    util::expected<void, storage::Error> wait_for_index_builds();
+
 private:
     std::shared_ptr<storage::GraphStore> graph_store_;
     std::shared_ptr<storage::SimpleIndexManager> index_manager_;
     std::shared_ptr<transaction::MVCCManager> mvcc_manager_;
     CypherParser parser_;
+
+    using NodePoster = std::function<util::expected<void, storage::Error>(storage::NodeId,
+                                                                          const std::vector<storage::Property>&)>;
+    // Declares `index` through `declare` and builds it in the background;
+    // `drop` removes the index if the build fails
+    IndexBuild start_index_build(const std::string& index, const std::function<void()>& declare, NodePoster post,
+                                 std::function<void()> drop);
+    // Posts every node visible to a fresh snapshot through `post`
+    util::expected<void, storage::Error> build_index(const std::string& index, const NodePoster& post);
+
+    std::mutex builds_mutex_;
+    std::vector<IndexBuild> index_builds_;
     
     // Query execution methods
-    util::expected<ResultSet, storage::Error> execute_match(const MatchClause& match_clause, 
-                                                           ExecutionContext& ctx);
-    util::expected<ResultSet, storage::Error> apply_where(const WhereClause& where_clause, 
-                                                         const ResultSet& input, 
-                                                         ExecutionContext& ctx);
+    // Pulls rows from `plan` (nullptr = no rows) and projects the RETURN items batch by batch
     util::expected<QueryResult, storage::Error> execute_return(const ReturnClause& return_clause, 
-                                                              const ResultSet& input, 
+                                                              ExecutionPlan* plan, 
                                                               ExecutionContext& ctx);
     util::expected<QueryResult, storage::Error> execute_create(const CreateClause& create_clause, 
                                                               ExecutionContext& ctx);
     util::expected<QueryResult, storage::Error> execute_set(const SetClause& set_clause,
                                                            const ResultSet& input,
+                                                           const SlotLayout& layout,
                                                            ExecutionContext& ctx);
     util::expected<QueryResult, storage::Error> execute_delete(const DeleteClause& delete_clause,
                                                               const ResultSet& input,
+                                                              const SlotLayout& layout,
                                                               ExecutionContext& ctx);
     
-    // Pattern matching
-    util::expected<ResultSet, storage::Error> match_pattern(const Pattern& pattern, 
-                                                           ExecutionContext& ctx);
-    util::expected<ResultSet, storage::Error> match_node(const Node& node, 
-                                                        ExecutionContext& ctx);
-    util::expected<ResultSet, storage::Error> match_node_edge_node_pattern(const Node& from_node,
-                                                                          const Edge& edge,
-                                                                          const Node& to_node,
-                                                                          ExecutionContext& ctx);
-    util::expected<ResultSet, storage::Error> match_variable_length_path(const Node& from_node,
-                                                                         const Edge& edge,
-                                                                         const Node& to_node,
-                                                                         ExecutionContext& ctx);
-    util::expected<ResultSet, storage::Error> expand_results(const ResultSet& previous_results,
-                                                             const Node& from_node_pattern,
-                                                             const Edge& edge_pattern,
-                                                             const Node& to_node_pattern,
-                                                             ExecutionContext& ctx);
-    util::expected<std::vector<storage::NodeId>, storage::Error> find_nodes_by_pattern(const Node& node, 
-                                                                                       ExecutionContext& ctx);
-    util::expected<std::vector<storage::EdgeId>, storage::Error> find_edges_by_pattern(const Edge& edge,
-                                                                                       storage::NodeId from_node,
-                                                                                       storage::NodeId to_node,
-                                                                                       ExecutionContext& ctx);
-    
     // Helper methods
     QueryResult result_set_to_query_result(const ResultSet& result_set, 
                                           const std::vector<std::string>& columns);
     
-    // Property matching
-    bool matches_property_constraints(const PropertyMap& constraints,
-                                    const std::vector<storage::Property>& node_properties);
-    bool matches_node_pattern(const Node& pattern, storage::NodeId node_id, ExecutionContext& ctx);
-    bool matches_edge_pattern(const Edge& pattern, 
-                             const storage::EdgeRecord& edge_record,
-                             const std::vector<storage::Property>& edge_properties);
-    
     // Node/edge creation
     util::expected<storage::NodeId, storage::Error> create_node_from_pattern(const Node& node,
                                                                             ExecutionContext& ctx);
@@ -0,0 +1,126 @@
+#include "expression_compiler.h"
+#include "expression_evaluator.h"
+#include "pattern_matcher.h"
+
+namespace loredb::query::cypher {
+
+namespace {
+
+util::unexpected<storage::Error> invalid_argument(std::string message) {
+    return util::unexpected<storage::Error>(storage::Error{storage::ErrorCode::INVALID_ARGUMENT, std::move(message)});
+}
+
+// Stored value of `name` on the node bound at `slot`, read through the context's transaction.
+// `key` is the id resolved at compile time; a key unknown then may have been stored since.
+std::optional<storage::PropertyValue> fetch_property(RowView row, size_t slot, const std::string& name,
+                                                     std::optional<storage::PropertyKey> key,
+                                                     ExecutionContext& ctx) {
+    if (slot == NO_SLOT || row[slot].kind != Slot::Kind::NODE) {
+        return std::nullopt;
+    }
+    if (!key.has_value() && !(key = storage::PropertyKey::find(name)).has_value()) {
+        return std::nullopt;
+    }
+    auto node_result = read_node(ctx, row[slot].id);
+    if (!node_result.has_value()) {
+        return std::nullopt;
+    }
+    for (auto& prop : node_result.value().second) {
+        if (prop.key == *key) {
+            return std::move(prop.value);
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<bool> fold(const Expression& expr, bool nested) {
+    switch (expr.type()) {
+        case ExpressionType::COMPARISON: {
+            const auto& comp = std::get<Comparison>(expr.content);
+            if (comp.left->type() == ExpressionType::LITERAL && comp.right->type() == ExpressionType::LITERAL) {
+                return compare_values(comp.op, std::get<Literal>(comp.left->content).value,
+                                      std::get<Literal>(comp.right->content).value);
+            }
+            return std::nullopt;
+        }
+
+        case ExpressionType::LOGICAL_AND:
+        case ExpressionType::LOGICAL_OR: {
+            const bool is_and = expr.type() == ExpressionType::LOGICAL_AND;
+            auto left = fold(is_and ? *std::get<LogicalAnd>(expr.content).left
+                                    : *std::get<LogicalOr>(expr.content).left, true);
+            auto right = fold(is_and ? *std::get<LogicalAnd>(expr.content).right
+                                     : *std::get<LogicalOr>(expr.content).right, true);
+
+            // The absorbing value (false for AND, true for OR) decides on its own
+            const bool absorbing = !is_and;
+            if (left == absorbing || right == absorbing) {
+                return absorbing;
+            }
+            if (left.has_value() && right.has_value()) {
+                return !absorbing;
+            }
+            return std::nullopt;
+        }
+
+        default:
+            // Rejected outright at the top level, false when nested under AND/OR
+            return nested ? std::optional<bool>(false) : std::nullopt;
+    }
+}
+
+} // namespace
+
+CompiledExpression CompiledExpression::compile(const Expression& expr, const SlotLayout& layout) {
+    CompiledExpression compiled;
+
+    switch (expr.type()) {
+        case ExpressionType::LITERAL: {
+            PropertyValue value = std::get<Literal>(expr.content).value;
+            compiled.program_ = [value = std::move(value)](RowView, ExecutionContext&)
+                -> util::expected<PropertyValue, storage::Error> { return value; };
+            break;
+        }
+
+        case ExpressionType::IDENTIFIER: {
+            const auto& id = std::get<Identifier>(expr.content);
+            compiled.program_ = [slot = layout.find(id.name), name = id.name](RowView row, ExecutionContext&)
+                -> util::expected<PropertyValue, storage::Error> {
+                if (slot != NO_SLOT && row[slot].kind != Slot::Kind::EMPTY) {
+                    return PropertyValue(std::to_string(row[slot].id));
+                }
+                return invalid_argument("Undefined variable: " + name);
+            };
+            break;
+        }
+
+        case ExpressionType::PROPERTY_ACCESS: {
+            const auto& access = std::get<PropertyAccess>(expr.content);
+            compiled.program_ = [slot = layout.find(access.entity), name = access.property,
+                                 key = storage::PropertyKey::find(access.property),
+                                 entity = access.entity](RowView row, ExecutionContext& ctx)
+                -> util::expected<PropertyValue, storage::Error> {
+                auto stored = fetch_property(row, slot, name, key, ctx);
+                if (stored.has_value()) {
+                    return from_storage_value(*stored);
+                }
+                return invalid_argument("Property not found: " + entity + "." + name);
+            };
+            break;
+        }
+
+        default:
+            compiled.program_ = [](RowView, ExecutionContext&) -> util::expected<PropertyValue, storage::Error> {
+                return invalid_argument("Expression type not implemented");
+            };
+            break;
+    }
+
+    return compiled;
+}
+
+std::optional<bool> fold_predicate(const Expression& expr) {
+    return fold(expr, false);
+}
+
+} // namespace loredb::query::cypher
@@ -0,0 +1,51 @@
+/// \file expression_compiler.h
+/// \brief Lowers Cypher value expressions to closures and folds constant predicates.
+/// \author LoreDB contributors
+/// \ingroup query
+#pragma once
+
+#include "ast.h"
+#include "../query_types.h"
+#include "../../storage/page_store.h"
+#include "../../util/expected.h"
+#include <functional>
+#include <optional>
+
+namespace loredb::query::cypher {
+
+/**
+ * @class CompiledExpression
+ * @brief A value expression compiled once per query against a slot layout.
+ *
+ * Variables are resolved to slot indices and property keys are captured once
+ * at compile time, so evaluating a row is a single indirect call per node of
+ * the expression with no variant dispatch or name lookups. Results match
+ * evaluate_expression().
+ */
+class CompiledExpression {
+public:
+    using Program = std::function<util::expected<PropertyValue, storage::Error>(RowView, ExecutionContext&)>;
+
+    static CompiledExpression compile(const Expression& expr, const SlotLayout& layout);
+
+    util::expected<PropertyValue, storage::Error> evaluate(RowView row, ExecutionContext& ctx) const {
+        return program_(row, ctx);
+    }
+
+private:
+    Program program_;
+};
+
+// Value of a WHERE predicate that does not depend on the row: comparisons of
+// literals, and AND/OR nodes with a constant side. Nested operands that are
+// not boolean count as false, as in evaluate_boolean_expression(). nullopt when
+// rows must be evaluated.
+//
+// Predicates are not compiled to per-row closures: PhysicalFilter evaluates
+// WHERE a batch at a time through BatchPredicate, which resolves each property
+// once per row and compares typed columns in tight loops. Folding here follows
+// the same rules, so a predicate the planner drops as always true is one
+// BatchPredicate would have passed on every row.
+std::optional<bool> fold_predicate(const Expression& expr);
+
+} // namespace loredb::query::cypher
@@ -8,7 +8,8 @@ namespace loredb::query::cypher {
 std::string property_value_to_string(const PropertyValue& value);
 
 util::expected<PropertyValue, storage::Error> evaluate_expression(const Expression& expr, 
-                                                                 const VariableMap& variables, 
+                                                                 RowView row,
+                                                                 const SlotLayout& layout,
                                                                  ExecutionContext& ctx) {
 
     switch (expr.type()) {
@@ -17,13 +18,9 @@ util::expected<PropertyValue, storage::Error> evaluate_expression(const Expressi
             
         case ExpressionType::IDENTIFIER: {
             const auto& id = std::get<Identifier>(expr.content);
-            auto it = variables.find(id.name);
-            if (it != variables.end()) {
-                if (it->second.type == VariableBinding::Type::LITERAL) {
-                    return it->second.literal_value;
-                } else {
-                    return PropertyValue(std::to_string(it->second.id_value));
-                }
+            size_t slot = layout.find(id.name);
+            if (slot != NO_SLOT && row[slot].kind != Slot::Kind::EMPTY) {
+                return PropertyValue(std::to_string(row[slot].id));
             }
             return util::unexpected<storage::Error>(storage::Error{
                 storage::ErrorCode::INVALID_ARGUMENT, 
@@ -34,9 +31,9 @@ util::expected<PropertyValue, storage::Error> evaluate_expression(const Expressi
         case ExpressionType::PROPERTY_ACCESS: {
             const auto& prop_access = std::get<PropertyAccess>(expr.content);
 
-            auto it = variables.find(prop_access.entity);
-            if (it != variables.end() && it->second.type == VariableBinding::Type::NODE) {
-                auto node_id = it->second.id_value;
+            size_t slot = layout.find(prop_access.entity);
+            if (slot != NO_SLOT && row[slot].kind == Slot::Kind::NODE) {
+                auto node_id = row[slot].id;
                 
                 if (ctx.graph_store->has_mvcc()) {
                     auto node_result = ctx.graph_store->get_node(ctx.tx_id, node_id);
@@ -44,14 +41,7 @@ util::expected<PropertyValue, storage::Error> evaluate_expression(const Expressi
                         auto [node_record, properties] = node_result.value();
                         for (const auto& prop : properties) {
                             if (prop.key == prop_access.property) {
-                                return std::visit([](const auto& v) -> PropertyValue {
-                                    using T = std::decay_t<decltype(v)>;
-                                    if constexpr (std::is_same_v<T, std::string>) return v;
-                                    else if constexpr (std::is_same_v<T, int64_t>) return v;
-                                    else if constexpr (std::is_same_v<T, double>) return v;
-                                    else if constexpr (std::is_same_v<T, bool>) return v;
-                                    else return std::string("binary_data");
-                                }, prop.value);
+                                return from_storage_value(prop.value);
                             }
                         }
                     }
@@ -61,14 +51,7 @@ util::expected<PropertyValue, storage::Error> evaluate_expression(const Expressi
                         auto [node_record, properties] = node_result.value();
                         for (const auto& prop : properties) {
                             if (prop.key == prop_access.property) {
-                                return std::visit([](const auto& v) -> PropertyValue {
-                                    using T = std::decay_t<decltype(v)>;
-                                    if constexpr (std::is_same_v<T, std::string>) return v;
-                                    else if constexpr (std::is_same_v<T, int64_t>) return v;
-                                    else if constexpr (std::is_same_v<T, double>) return v;
-                                    else if constexpr (std::is_same_v<T, bool>) return v;
-                                    else return std::string("binary_data");
-                                }, prop.value);
+                                return from_storage_value(prop.value);
                             }
                         }
                     }
@@ -89,73 +72,35 @@ util::expected<PropertyValue, storage::Error> evaluate_expression(const Expressi
 }
 
 util::expected<bool, storage::Error> evaluate_boolean_expression(const Expression& expr, 
-                                                                 const VariableMap& variables, 
+                                                                 RowView row,
+                                                                 const SlotLayout& layout,
                                                                  ExecutionContext& ctx) {
     switch (expr.type()) {
         case ExpressionType::COMPARISON: {
             const auto& comp = std::get<Comparison>(expr.content);
-            auto left_result = evaluate_expression(*comp.left, variables, ctx);
-            auto right_result = evaluate_expression(*comp.right, variables, ctx);
+            auto left_result = evaluate_expression(*comp.left, row, layout, ctx);
+            auto right_result = evaluate_expression(*comp.right, row, layout, ctx);
             
             if (!left_result.has_value() || !right_result.has_value()) {
                 return false;
             }
             
-            // Handle numeric comparisons properly
-            const auto& left_value = left_result.value();
-            const auto& right_value = right_result.value();
-            
-            // Check if both values are numeric (int64_t or double)
-            bool left_is_numeric = std::holds_alternative<int64_t>(left_value) || std::holds_alternative<double>(left_value);
-            bool right_is_numeric = std::holds_alternative<int64_t>(right_value) || std::holds_alternative<double>(right_value);
-            
-            if (left_is_numeric && right_is_numeric) {
-                // Both values are numeric - do numeric comparison
-                double left_num = std::holds_alternative<int64_t>(left_value) 
-                    ? static_cast<double>(std::get<int64_t>(left_value))
-                    : std::get<double>(left_value);
-                double right_num = std::holds_alternative<int64_t>(right_value)
-                    ? static_cast<double>(std::get<int64_t>(right_value))
-                    : std::get<double>(right_value);
-                    
-                switch (comp.op) {
-                    case ComparisonOperator::EQUAL: return left_num == right_num;
-                    case ComparisonOperator::NOT_EQUAL: return left_num != right_num;
-                    case ComparisonOperator::LESS_THAN: return left_num < right_num;
-                    case ComparisonOperator::LESS_EQUAL: return left_num <= right_num;
-                    case ComparisonOperator::GREATER_THAN: return left_num > right_num;
-                    case ComparisonOperator::GREATER_EQUAL: return left_num >= right_num;
-                }
-            } else {
-                // Fall back to string comparison for non-numeric values
-                std::string left_str = property_value_to_string(left_value);
-                std::string right_str = property_value_to_string(right_value);
-                
-                switch (comp.op) {
-                    case ComparisonOperator::EQUAL: return left_str == right_str;
-                    case ComparisonOperator::NOT_EQUAL: return left_str != right_str;
-                    case ComparisonOperator::LESS_THAN: return left_str < right_str;
-                    case ComparisonOperator::LESS_EQUAL: return left_str <= right_str;
-                    case ComparisonOperator::GREATER_THAN: return left_str > right_str;
-                    case ComparisonOperator::GREATER_EQUAL: return left_str >= right_str;
-                }
-            }
-            break;
+            return compare_values(comp.op, left_result.value(), right_result.value());
         }
         
         case ExpressionType::LOGICAL_AND: {
             const auto& and_expr = std::get<LogicalAnd>(expr.content);
-            auto left_result = evaluate_boolean_expression(*and_expr.left, variables, ctx);
+            auto left_result = evaluate_boolean_expression(*and_expr.left, row, layout, ctx);
             if (!left_result.has_value() || !left_result.value()) return false;
-            auto right_result = evaluate_boolean_expression(*and_expr.right, variables, ctx);
+            auto right_result = evaluate_boolean_expression(*and_expr.right, row, layout, ctx);
             return right_result.has_value() && right_result.value();
         }
         
         case ExpressionType::LOGICAL_OR: {
             const auto& or_expr = std::get<LogicalOr>(expr.content);
-            auto left_result = evaluate_boolean_expression(*or_expr.left, variables, ctx);
+            auto left_result = evaluate_boolean_expression(*or_expr.left, row, layout, ctx);
             if (left_result.has_value() && left_result.value()) return true;
-            auto right_result = evaluate_boolean_expression(*or_expr.right, variables, ctx);
+            auto right_result = evaluate_boolean_expression(*or_expr.right, row, layout, ctx);
             return right_result.has_value() && right_result.value();
         }
         
@@ -169,6 +114,61 @@ util::expected<bool, storage::Error> evaluate_boolean_expression(const Expressio
     return false;
 }
 
+bool compare_values(ComparisonOperator op, const PropertyValue& left_value, const PropertyValue& right_value) {
+    // Check if both values are numeric (int64_t or double)
+    bool left_is_numeric = std::holds_alternative<int64_t>(left_value) || std::holds_alternative<double>(left_value);
+    bool right_is_numeric = std::holds_alternative<int64_t>(right_value) || std::holds_alternative<double>(right_value);
+    
+    if (left_is_numeric && right_is_numeric) {
+        // Both values are numeric - do numeric comparison
+        double left_num = std::holds_alternative<int64_t>(left_value) 
+            ? static_cast<double>(std::get<int64_t>(left_value))
+            : std::get<double>(left_value);
+        double right_num = std::holds_alternative<int64_t>(right_value)
+            ? static_cast<double>(std::get<int64_t>(right_value))
+            : std::get<double>(right_value);
+            
+        switch (op) {
+            case ComparisonOperator::EQUAL: return left_num == right_num;
+            case ComparisonOperator::NOT_EQUAL: return left_num != right_num;
+            case ComparisonOperator::LESS_THAN: return left_num < right_num;
+            case ComparisonOperator::LESS_EQUAL: return left_num <= right_num;
+            case ComparisonOperator::GREATER_THAN: return left_num > right_num;
+            case ComparisonOperator::GREATER_EQUAL: return left_num >= right_num;
+        }
+    } else {
+        // Fall back to string comparison for non-numeric values
+        std::string left_str = property_value_to_string(left_value);
+        std::string right_str = property_value_to_string(right_value);
+        
+        switch (op) {
+            case ComparisonOperator::EQUAL: return left_str == right_str;
+            case ComparisonOperator::NOT_EQUAL: return left_str != right_str;
+            case ComparisonOperator::LESS_THAN: return left_str < right_str;
+            case ComparisonOperator::LESS_EQUAL: return left_str <= right_str;
+            case ComparisonOperator::GREATER_THAN: return left_str > right_str;
+            case ComparisonOperator::GREATER_EQUAL: return left_str >= right_str;
+        }
+    }
+    return false;
+}
+
+PropertyValue from_storage_value(const storage::PropertyValue& value) {
+    return std::visit([](const auto& v) -> PropertyValue {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::string>) return v;
+        else if constexpr (std::is_same_v<T, int64_t>) return v;
+        else if constexpr (std::is_same_v<T, double>) return v;
+        else if constexpr (std::is_same_v<T, bool>) return v;
+        else if constexpr (std::is_same_v<T, std::vector<float>>) return std::string("vector_data");
+        else return std::string("binary_data");
+    }, value);
+}
+
+storage::PropertyValue to_storage_value(const PropertyValue& value) {
+    return std::visit([](const auto& v) -> storage::PropertyValue { return v; }, value);
+}
+
 std::string property_value_to_string(const PropertyValue& value) {
     return std::visit([](const auto& v) -> std::string {
         if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::string>) return v;
@@ -179,15 +179,4 @@ std::string property_value_to_string(const PropertyValue& value) {
     }, value);
 }
 
-std::string variable_binding_to_string(const VariableBinding& binding) {
-    switch (binding.type) {
-        case VariableBinding::Type::NODE:
-        case VariableBinding::Type::EDGE:
-            return std::to_string(binding.id_value);
-        case VariableBinding::Type::LITERAL:
-            return property_value_to_string(binding.literal_value);
-    }
-    return "unknown";
-}
-
 } 
\ No newline at end of file
@@ -8,14 +8,24 @@
 namespace loredb::query::cypher {
 
 util::expected<PropertyValue, storage::Error> evaluate_expression(const Expression& expr, 
-                                                                 const VariableMap& variables, 
+                                                                 RowView row,
+                                                                 const SlotLayout& layout,
                                                                  ExecutionContext& ctx);
 
 util::expected<bool, storage::Error> evaluate_boolean_expression(const Expression& expr, 
-                                                                 const VariableMap& variables, 
+                                                                 RowView row,
+                                                                 const SlotLayout& layout,
                                                                  ExecutionContext& ctx);
 
+// Numeric operands compare as numbers, anything else by string representation
+bool compare_values(ComparisonOperator op, const PropertyValue& left, const PropertyValue& right);
+
+// Query-side view of a stored value; binary blobs become a placeholder string
+PropertyValue from_storage_value(const storage::PropertyValue& value);
+
+// Stored form of a query value
+storage::PropertyValue to_storage_value(const PropertyValue& value);
+
 std::string property_value_to_string(const PropertyValue& value);
-std::string variable_binding_to_string(const VariableBinding& binding);
 
 } // namespace loredb::query::cypher 
\ No newline at end of file
@@ -0,0 +1,435 @@
+#include "pattern_matcher.h"
+#include "expression_evaluator.h"
+#include "../../storage/graph_store.h"
+#include "../../storage/simple_index_manager.h"
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <unordered_map>
+
+namespace loredb::query::cypher {
+
+util::expected<NodeData, storage::Error> read_node(ExecutionContext& ctx, storage::NodeId node_id) {
+    return ctx.graph_store->has_mvcc()
+        ? ctx.graph_store->get_node(ctx.tx_id, node_id)
+        : ctx.graph_store->get_node(node_id);
+}
+
+util::expected<EdgeData, storage::Error> read_edge(ExecutionContext& ctx, storage::EdgeId edge_id) {
+    return ctx.graph_store->has_mvcc()
+        ? ctx.graph_store->get_edge(ctx.tx_id, edge_id)
+        : ctx.graph_store->get_edge(edge_id);
+}
+
+util::expected<std::vector<storage::NodeId>, storage::Error> find_nodes_by_pattern(const Node& node,
+                                                                                   ExecutionContext& ctx) {
+    std::vector<storage::NodeId> result;
+
+    auto composite = composite_constraint_keys(node, ctx.index_manager.get());
+    auto keys = indexed_constraint_keys(node, ctx.index_manager.get());
+    // Keys answered by the composite probe need no posting of their own
+    keys.erase(std::remove_if(keys.begin(), keys.end(), [&](const std::string& key) {
+        return std::find(composite.begin(), composite.end(), key) != composite.end();
+    }), keys.end());
+    if (!keys.empty() || !composite.empty() || !node.labels.empty()) {
+        if (auto candidates = seek_nodes_by_index(node, keys, ctx, {}, composite); candidates.has_value()) {
+            for (auto node_id : *candidates) {
+                if (matches_node_pattern(node, node_id, ctx)) {
+                    result.push_back(node_id);
+                }
+            }
+            return result;
+        }
+    }
+
+    // Every id handed out; ids are never reused, so after deletes live nodes sit above the node count
+    const storage::NodeId id_limit = ctx.graph_store->get_node_id_limit();
+    for (storage::NodeId node_id = 1; node_id < id_limit; ++node_id) {
+        auto node_result = read_node(ctx, node_id);
+        if (!node_result.has_value()) {
+            continue;
+        }
+        if (node.properties.empty() || matches_property_constraints(node.properties, node_result.value().second)) {
+            result.push_back(node_id);
+        }
+    }
+
+    return result;
+}
+
+std::vector<std::string> indexed_constraint_keys(const Node& node, const storage::SimpleIndexManager* index_manager) {
+    std::vector<std::string> keys;
+    if (index_manager == nullptr) {
+        return keys;
+    }
+    for (const auto& [key, value] : node.properties) {
+        // Postings hold rendered values, which only line up with string constraints:
+        // a numeric constraint also matches numerically equal values of the other type.
+        // An index still being built lacks older nodes' postings.
+        if (std::holds_alternative<std::string>(value) && index_manager->has_node_property_index(key) &&
+            index_manager->is_index_ready(storage::SimpleIndexManager::property_index_name(key))) {
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+std::vector<std::string> composite_constraint_keys(const Node& node,
+                                                   const storage::SimpleIndexManager* index_manager) {
+    std::vector<std::string> best;
+    if (index_manager == nullptr || index_manager->get_node_composite_index_count() == 0) {
+        return best;
+    }
+    for (const auto& keys : index_manager->get_node_composite_indexes()) {
+        if (!index_manager->is_index_ready(storage::SimpleIndexManager::composite_index_name(keys))) {
+            continue;
+        }
+        size_t bound = 0;
+        while (bound < keys.size()) {
+            // Only string constraints line up with rendered values, as for single-key indexes
+            auto it = node.properties.find(keys[bound]);
+            if (it == node.properties.end() || !std::holds_alternative<std::string>(it->second)) {
+                break;
+            }
+            ++bound;
+        }
+        if (bound > best.size()) {
+            best.assign(keys.begin(), keys.begin() + bound);
+        }
+    }
+    return best;
+}
+
+std::optional<std::vector<storage::NodeId>> seek_nodes_by_index(const Node& node,
+                                                                const std::vector<std::string>& keys,
+                                                                ExecutionContext& ctx,
+                                                                const std::vector<PropertyRange>& ranges,
+                                                                const std::vector<std::string>& composite) {
+    using Candidates = std::vector<storage::NodeId>;
+    // Every predicate becomes a posting list; they are combined before any node is read
+    std::vector<storage::PostingList> postings;
+    postings.reserve(node.labels.size() + keys.size() + ranges.size() + 1);
+    if (!composite.empty()) {
+        std::vector<std::string> values;
+        values.reserve(composite.size());
+        for (const auto& key : composite) {
+            auto it = node.properties.find(key);
+            if (it == node.properties.end() || !std::holds_alternative<std::string>(it->second)) {
+                break;
+            }
+            values.push_back(std::get<std::string>(it->second));
+        }
+        // Like an unanswerable range, a composite probe that fails is skipped
+        auto ids = ctx.index_manager->find_nodes_by_composite(composite, values);
+        if (ids.has_value() && ids.value().has_value()) {
+            if (ids.value()->empty()) {
+                return Candidates{};
+            }
+            postings.push_back(storage::PostingList::from_ids(*ids.value()));
+        }
+    }
+    for (const auto& label : node.labels) {
+        auto label_id = ctx.graph_store->label_dictionary().find(label);
+        if (!label_id.has_value()) {
+            return Candidates{};
+        }
+        auto ids = ctx.graph_store->find_nodes_by_label(*label_id);
+        if (ids.empty()) {
+            return Candidates{};
+        }
+        postings.push_back(storage::PostingList::from_ids(ids));
+    }
+    for (const auto& key : keys) {
+        auto it = node.properties.find(key);
+        if (it == node.properties.end() || !std::holds_alternative<std::string>(it->second)) {
+            continue;
+        }
+        auto ids = ctx.index_manager->find_node_postings(key, std::get<std::string>(it->second));
+        if (ids.empty()) {
+            return Candidates{};
+        }
+        postings.push_back(std::move(ids));
+    }
+    for (const auto& range : ranges) {
+        // A range index that cannot answer (or be read) is skipped; the scan stays correct
+        auto ids = ctx.index_manager->find_nodes_in_range(range.key, range.lower, range.upper);
+        if (!ids.has_value() || !ids.value().has_value()) {
+            continue;
+        }
+        if (ids.value()->empty()) {
+            return Candidates{};
+        }
+        postings.push_back(storage::PostingList::from_ids(*ids.value()));
+    }
+    if (postings.empty()) {
+        return std::nullopt;
+    }
+
+    // Intersect smallest first so the running result only shrinks
+    std::sort(postings.begin(), postings.end(),
+              [](const auto& a, const auto& b) { return a.size() < b.size(); });
+    storage::PostingList result = std::move(postings.front());
+    for (size_t i = 1; i < postings.size() && !result.empty(); ++i) {
+        result &= postings[i];
+    }
+    return result.ids();
+}
+
+std::string index_value(const storage::PropertyValue& value) {
+    return property_value_to_string(from_storage_value(value));
+}
+
+util::expected<void, storage::Error> update_node_indexes(ExecutionContext& ctx, storage::NodeId node_id,
+                                                         const std::vector<storage::Property>& properties,
+                                                         const std::optional<std::string>& changed) {
+    if (!ctx.index_manager) {
+        return {};
+    }
+    for (const auto& prop : properties) {
+        if (changed.has_value() && !(prop.key == *changed)) {
+            continue;
+        }
+        if (ctx.index_manager->has_node_property_index(prop.key)) {
+            auto indexed = ctx.index_manager->index_node_property(node_id, prop.key, index_value(prop.value));
+            if (!indexed.has_value()) {
+                return indexed;
+            }
+        }
+        if (auto result = ctx.index_manager->index_node_range(node_id, prop.key, prop.value); !result.has_value()) {
+            return result;
+        }
+        if (ctx.index_manager->has_vector_index(prop.key)) {
+            // A value that is not a vector leaves the node out of the index
+            auto vector = storage::vector_value(prop.value);
+            auto indexed = vector.has_value() ? ctx.index_manager->index_node_vector(node_id, prop.key, *vector)
+                                              : util::expected<void, storage::Error>{};
+            if (!vector.has_value()) {
+                ctx.index_manager->remove_node_vector(node_id, prop.key);
+            }
+            if (!indexed.has_value()) {
+                return indexed;
+            }
+        }
+    }
+
+    // The text index holds the node's whole text, so any change to a text key re-posts it
+    const auto text_keys = ctx.index_manager->get_text_index_keys();
+    if (!text_keys.empty() &&
+        (!changed.has_value() || std::find(text_keys.begin(), text_keys.end(), *changed) != text_keys.end())) {
+        ctx.index_manager->index_node_text(node_id, properties);
+    }
+
+    if (ctx.index_manager->get_node_composite_index_count() == 0) {
+        return {};
+    }
+    std::unordered_map<std::string, std::string> values;
+    values.reserve(properties.size());
+    for (const auto& prop : properties) {
+        values.emplace(prop.key.str(), index_value(prop.value));
+    }
+    return ctx.index_manager->index_node_composites(node_id, values, changed);
+}
+
+util::expected<void, storage::Error> remove_node_indexes(ExecutionContext& ctx, storage::NodeId node_id,
+                                                         const std::vector<storage::Property>& properties,
+                                                         const std::optional<std::string>& changed) {
+    if (!ctx.index_manager) {
+        return {};
+    }
+    for (const auto& prop : properties) {
+        if (changed.has_value() && !(prop.key == *changed)) {
+            continue;
+        }
+        if (ctx.index_manager->has_node_property_index(prop.key)) {
+            auto removed = ctx.index_manager->remove_node_property_index(node_id, prop.key, index_value(prop.value));
+            if (!removed.has_value()) {
+                return removed;
+            }
+        }
+        if (auto result = ctx.index_manager->remove_node_range_index(node_id, prop.key, prop.value);
+            !result.has_value()) {
+            return result;
+        }
+        if (!changed.has_value() && ctx.index_manager->has_vector_index(prop.key)) {
+            ctx.index_manager->remove_node_vector(node_id, prop.key);
+        }
+    }
+    if (!changed.has_value()) {
+        ctx.index_manager->remove_node_text(node_id);
+    }
+
+    if (ctx.index_manager->get_node_composite_index_count() == 0) {
+        return {};
+    }
+    std::unordered_map<std::string, std::string> values;
+    values.reserve(properties.size());
+    for (const auto& prop : properties) {
+        values.emplace(prop.key.str(), index_value(prop.value));
+    }
+    return ctx.index_manager->remove_node_composites(node_id, values, changed);
+}
+
+util::expected<void, storage::Error> retire_node_postings(ExecutionContext& ctx, const RetiredPostings& retired) {
+    if (auto removed = remove_node_indexes(ctx, retired.node_id, retired.properties, retired.changed);
+        !removed.has_value()) {
+        return removed;
+    }
+    // Nobody writes a node after deleting it
+    if (!retired.changed.has_value()) {
+        return {};
+    }
+
+    // Writers store the record before posting it, so a writer this read misses
+    // posts after the removal above
+    auto current = ctx.graph_store->get_node(retired.node_id);
+    if (!current.has_value()) {
+        return {};
+    }
+    const auto value_of = [&](const std::vector<storage::Property>& properties) -> std::optional<std::string> {
+        for (const auto& prop : properties) {
+            if (prop.key == *retired.changed) {
+                return index_value(prop.value);
+            }
+        }
+        return std::nullopt;
+    };
+    if (value_of(current.value().second) != value_of(retired.properties)) {
+        return {};
+    }
+    return update_node_indexes(ctx, retired.node_id, current.value().second, retired.changed);
+}
+
+std::vector<storage::LabelId> resolve_labels(const std::vector<std::string>& names, ExecutionContext& ctx) {
+    std::vector<storage::LabelId> ids;
+    ids.reserve(names.size());
+    for (const auto& name : names) {
+        if (auto id = ctx.graph_store->label_dictionary().find(name); id.has_value()) {
+            ids.push_back(*id);
+        }
+    }
+    return ids;
+}
+
+bool edge_may_have_type(ExecutionContext& ctx, storage::EdgeId edge_id,
+                        const std::vector<storage::LabelId>& type_ids) {
+    if (ctx.graph_store->edge_has_label(edge_id, storage::NO_LABEL)) {
+        return true;
+    }
+    return std::any_of(type_ids.begin(), type_ids.end(),
+                       [&](storage::LabelId type) { return ctx.graph_store->edge_has_label(edge_id, type); });
+}
+
+bool matches_node_pattern(const Node& pattern, storage::NodeId node_id, ExecutionContext& ctx) {
+    // Labels are checked against the postings before the record is read
+    for (const auto& label : pattern.labels) {
+        auto label_id = ctx.graph_store->label_dictionary().find(label);
+        if (!label_id.has_value() || !ctx.graph_store->node_has_label(node_id, *label_id)) {
+            return false;
+        }
+    }
+    if (pattern.properties.empty() && !pattern.labels.empty() && !ctx.graph_store->has_mvcc()) {
+        // Nothing left to check, and without MVCC the postings alone decide visibility
+        return true;
+    }
+    auto node_result = read_node(ctx, node_id);
+    if (!node_result.has_value()) {
+        return false;
+    }
+    return matches_property_constraints(pattern.properties, node_result.value().second);
+}
+
+bool matches_edge_pattern(const Edge& pattern,
+                          const storage::EdgeRecord& edge_record,
+                          const std::vector<storage::Property>& edge_properties,
+                          ExecutionContext& ctx) {
+    if (!pattern.types.empty() && edge_record.label_id != storage::NO_LABEL) {
+        const std::string type = ctx.graph_store->label_dictionary().name(edge_record.label_id);
+        if (std::find(pattern.types.begin(), pattern.types.end(), type) == pattern.types.end()) {
+            return false;
+        }
+    } else if (!pattern.types.empty()) {
+        // Edges created without a type may still carry one as a "type" property
+        bool type_matches = false;
+        const auto type_key = storage::PropertyKey::find("type");
+        for (const auto& prop : edge_properties) {
+            if (type_key.has_value() && prop.key == *type_key) {
+                auto type_str = std::visit([](const auto& v) -> std::string {
+                    if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::string>) {
+                        return v;
+                    } else {
+                        return "unknown";
+                    }
+                }, prop.value);
+
+                for (const auto& expected_type : pattern.types) {
+                    if (type_str == expected_type) {
+                        type_matches = true;
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+
+        if (!type_matches) {
+            return false;
+        }
+    }
+
+    return matches_property_constraints(pattern.properties, edge_properties);
+}
+
+bool matches_property_constraints(const PropertyMap& constraints,
+                                  const std::vector<storage::Property>& properties) {
+    for (const auto& [key, expected_value] : constraints) {
+        // A key no property ever used cannot match; otherwise compare ids
+        auto key_id = storage::PropertyKey::find(key);
+        if (!key_id.has_value()) {
+            return false;
+        }
+        bool found_match = false;
+        for (const auto& prop : properties) {
+            if (prop.key != *key_id) continue;
+
+            // Convert storage::PropertyValue to AST PropertyValue
+            PropertyValue actual_value = std::visit([](const auto& v) -> PropertyValue {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<T, std::string>) return v;
+                else if constexpr (std::is_same_v<T, int64_t>) return v;
+                else if constexpr (std::is_same_v<T, double>) return v;
+                else if constexpr (std::is_same_v<T, bool>) return v;
+                else return std::string("binary_data");
+            }, prop.value);
+
+            // Compare based on contained types
+            if (actual_value.index() == expected_value.index()) {
+                if (actual_value == expected_value) {
+                    found_match = true;
+                    break;
+                }
+            } else {
+                // Handle numeric cross-type comparisons (int vs double)
+                bool actual_is_num = std::holds_alternative<int64_t>(actual_value) || std::holds_alternative<double>(actual_value);
+                bool expected_is_num = std::holds_alternative<int64_t>(expected_value) || std::holds_alternative<double>(expected_value);
+                if (actual_is_num && expected_is_num) {
+                    double act = std::holds_alternative<int64_t>(actual_value) ? static_cast<double>(std::get<int64_t>(actual_value)) : std::get<double>(actual_value);
+                    double exp = std::holds_alternative<int64_t>(expected_value) ? static_cast<double>(std::get<int64_t>(expected_value)) : std::get<double>(expected_value);
+                    if (std::abs(act - exp) < 1e-9) {
+                        found_match = true;
+                        break;
+                    }
+                } else {
+                    // Fallback to string comparison
+                    if (property_value_to_string(actual_value) == property_value_to_string(expected_value)) {
+                        found_match = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (!found_match) return false;
+    }
+    return true;
+}
+
+} // namespace loredb::query::cypher
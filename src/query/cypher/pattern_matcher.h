@@ -0,0 +1,96 @@
+/// \file pattern_matcher.h
+/// \brief Node/edge pattern matching primitives shared by the Cypher physical operators.
+/// \author LoreDB contributors
+/// \ingroup query
+#pragma once
+
+#include "ast.h"
+#include "../query_types.h"
+#include "../../storage/label_index.h"
+#include "../../storage/page_store.h"
+#include "../../storage/record.h"
+#include "../../util/expected.h"
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace loredb::query::cypher {
+
+using NodeData = std::pair<storage::NodeRecord, std::vector<storage::Property>>;
+using EdgeData = std::pair<storage::EdgeRecord, std::vector<storage::Property>>;
+
+// Bounds on one property of a node, taken from WHERE comparisons. Both bounds
+// are treated as inclusive; strict comparisons are left to the WHERE filter.
+struct PropertyRange {
+    std::string key;
+    std::optional<storage::PropertyValue> lower;
+    std::optional<storage::PropertyValue> upper;
+};
+
+// Read a node/edge through the context's transaction when MVCC is enabled
+util::expected<NodeData, storage::Error> read_node(ExecutionContext& ctx, storage::NodeId node_id);
+util::expected<EdgeData, storage::Error> read_edge(ExecutionContext& ctx, storage::EdgeId edge_id);
+
+// All visible nodes satisfying the pattern's labels and property constraints. Uses
+// label postings and declared indexes when it can, otherwise scans every node.
+util::expected<std::vector<storage::NodeId>, storage::Error> find_nodes_by_pattern(const Node& node,
+                                                                                   ExecutionContext& ctx);
+
+// Keys of the pattern's string equality constraints that have a declared node index
+std::vector<std::string> indexed_constraint_keys(const Node& node, const storage::SimpleIndexManager* index_manager);
+
+// Longest run of leading keys of a declared composite index that the pattern
+// constrains to strings; empty when no composite index applies
+std::vector<std::string> composite_constraint_keys(const Node& node,
+                                                   const storage::SimpleIndexManager* index_manager);
+
+// Sorted, de-duplicated ids posted under every label and `keys` constraint of
+// `node`, found in the range indexes for `ranges`, and found by one composite
+// probe on the `composite` constraints. A superset of the matches:
+// candidates still need to be read and checked. nullopt when no posting applied
+// (e.g. a range index that cannot answer its bounds) and the caller must scan.
+std::optional<std::vector<storage::NodeId>> seek_nodes_by_index(const Node& node,
+                                                                const std::vector<std::string>& keys,
+                                                                ExecutionContext& ctx,
+                                                                const std::vector<PropertyRange>& ranges = {},
+                                                                const std::vector<std::string>& composite = {});
+
+// Value under which a stored property is posted in a declared node index
+std::string index_value(const storage::PropertyValue& value);
+
+// Posts `properties` (the node's whole property list after a write) under every
+// declared node index they cover; with `changed`, only postings involving that key
+util::expected<void, storage::Error> update_node_indexes(ExecutionContext& ctx, storage::NodeId node_id,
+                                                         const std::vector<storage::Property>& properties,
+                                                         const std::optional<std::string>& changed = std::nullopt);
+
+// Removes the postings update_node_indexes() made for `properties` (the node's
+// property list before a write); with `changed`, only postings involving that
+// key. Without it the node is gone, so its text and vectors go as well.
+util::expected<void, storage::Error> remove_node_indexes(ExecutionContext& ctx, storage::NodeId node_id,
+                                                         const std::vector<storage::Property>& properties,
+                                                         const std::optional<std::string>& changed = std::nullopt);
+
+// Removes `retired` once its write committed. A later write may have stored the
+// retired value again and posted it first; the node is re-read after the removal
+// and such a value posted again, so a concurrent writer's postings survive.
+util::expected<void, storage::Error> retire_node_postings(ExecutionContext& ctx, const RetiredPostings& retired);
+
+// Dictionary ids of `names`; names that were never interned have no id and are dropped
+std::vector<storage::LabelId> resolve_labels(const std::vector<std::string>& names, ExecutionContext& ctx);
+
+// Whether the edge can have one of `type_ids`, judged from label postings alone.
+// Unlabeled edges always can, since they fall back to their "type" property.
+bool edge_may_have_type(ExecutionContext& ctx, storage::EdgeId edge_id,
+                        const std::vector<storage::LabelId>& type_ids);
+
+bool matches_property_constraints(const PropertyMap& constraints,
+                                  const std::vector<storage::Property>& properties);
+bool matches_node_pattern(const Node& pattern, storage::NodeId node_id, ExecutionContext& ctx);
+bool matches_edge_pattern(const Edge& pattern,
+                          const storage::EdgeRecord& edge_record,
+                          const std::vector<storage::Property>& edge_properties,
+                          ExecutionContext& ctx);
+
+} // namespace loredb::query::cypher
@@ -1,78 +1,488 @@
 #include "execution_plan.h"
-#include "cypher/expression_evaluator.h"
+#include "cypher/pattern_matcher.h"
+#include <algorithm>
+#include <numeric>
 
 namespace loredb::query {
 
-void PhysicalScan::init() {
-    // Nothing to do for now
+namespace {
+
+// Binds `variable`'s slot, or when it is already bound checks that the binding agrees
+bool bind_variable(std::span<Slot> row, const PlanVariable& variable, Slot::Kind kind, uint64_t id) {
+    if (variable.slot == NO_SLOT) {
+        return true;
+    }
+    Slot& slot = row[variable.slot];
+    if (slot.kind == Slot::Kind::EMPTY) {
+        slot = Slot{kind, id};
+        return true;
+    }
+    return slot.kind == kind && slot.id == id;
+}
+
+// Node bound to `variable` in `row`, or 0 when it is unbound
+storage::NodeId bound_node(RowView row, const PlanVariable& variable) {
+    if (variable.slot == NO_SLOT || row[variable.slot].kind != Slot::Kind::NODE) {
+        return 0;
+    }
+    return row[variable.slot].id;
 }
 
-util::expected<ResultSet, storage::Error> PhysicalScan::execute(ExecutionContext& ctx) {
-    // Simplified implementation: Scans all nodes, ignoring label for now.
-    // In a real implementation, this would use an index scan if a label is provided.
-    ResultSet result_set;
-    for (storage::NodeId node_id = 1; node_id <= 100; ++node_id) { // Limiting to 100 for safety
-        if (ctx.graph_store->has_mvcc()) {
-            if (ctx.graph_store->get_node(ctx.tx_id, node_id).has_value()) {
-                ResultRow row;
-                row.bindings[variable_] = VariableBinding(VariableBinding::Type::NODE, node_id);
-                result_set.push_back(std::move(row));
+// Edges incident to `node_id` in `direction` that match `edge`, paired with the node at the other end
+std::vector<std::pair<storage::EdgeId, storage::NodeId>> expand_neighbours(ExecutionContext& ctx,
+                                                                           storage::NodeId node_id,
+                                                                           const cypher::Edge& edge,
+                                                                           ExpandDirection direction) {
+    std::vector<std::pair<storage::EdgeId, storage::NodeId>> result;
+    const auto type_ids = cypher::resolve_labels(edge.types, ctx);
+
+    auto visit = [&](const std::vector<storage::EdgeId>& edge_ids, bool outgoing) {
+        for (auto edge_id : edge_ids) {
+            // Edges of other types are dropped from the postings without decoding them
+            if (!edge.types.empty() && !cypher::edge_may_have_type(ctx, edge_id, type_ids)) {
+                continue;
+            }
+            auto edge_result = cypher::read_edge(ctx, edge_id);
+            if (!edge_result.has_value()) {
+                continue;
             }
-        } else {
-            if (ctx.graph_store->get_node(node_id).has_value()) {
-                ResultRow row;
-                row.bindings[variable_] = VariableBinding(VariableBinding::Type::NODE, node_id);
-                result_set.push_back(std::move(row));
+            const auto& [edge_record, edge_properties] = edge_result.value();
+            // A self-loop shows up in both lists; report it once for undirected patterns
+            if (!outgoing && direction == ExpandDirection::BOTH && edge_record.from_node == edge_record.to_node) {
+                continue;
             }
+            if (!cypher::matches_edge_pattern(edge, edge_record, edge_properties, ctx)) {
+                continue;
+            }
+            result.emplace_back(edge_id, outgoing ? edge_record.to_node : edge_record.from_node);
+        }
+    };
+
+    if (direction != ExpandDirection::INCOMING) {
+        auto outgoing = ctx.graph_store->get_outgoing_edges(node_id);
+        if (outgoing.has_value()) {
+            visit(outgoing.value(), true);
         }
     }
-    return result_set;
+    if (direction != ExpandDirection::OUTGOING) {
+        auto incoming = ctx.graph_store->get_incoming_edges(node_id);
+        if (incoming.has_value()) {
+            visit(incoming.value(), false);
+        }
+    }
+    return result;
+}
+
+std::string describe_edge(const std::string& from, const cypher::Edge& edge, const std::string& to,
+                          ExpandDirection direction) {
+    std::string inner = edge.variable.value_or("");
+    for (size_t i = 0; i < edge.types.size(); ++i) {
+        inner += (i == 0 ? ":" : "|") + edge.types[i];
+    }
+    if (edge.min_hops != 1 || edge.max_hops != 1) {
+        inner += "*" + std::to_string(edge.min_hops) + ".." +
+                 (edge.max_hops == -1 ? std::string() : std::to_string(edge.max_hops));
+    }
+    std::string left = direction == ExpandDirection::INCOMING ? "<-[" : "-[";
+    std::string right = direction == ExpandDirection::OUTGOING ? "]->" : "]-";
+    return "(" + from + ")" + left + inner + right + "(" + to + ")";
+}
+
+} // namespace
+
+void BatchCursor::reset() {
+    batch_.clear();
+    pos_ = 0;
+    exhausted_ = false;
+}
+
+util::expected<RowView, storage::Error> BatchCursor::current(ExecutionContext& ctx, size_t width,
+                                                             size_t max_rows) {
+    while (pos_ >= batch_.size()) {
+        if (exhausted_) {
+            return RowView{};
+        }
+        batch_.reset(width);
+        auto pulled = input_->next_batch(ctx, batch_, max_rows);
+        if (!pulled.has_value()) {
+            return util::unexpected<storage::Error>(pulled.error());
+        }
+        pos_ = 0;
+        if (batch_.empty()) {
+            exhausted_ = true;
+        }
+    }
+    return batch_[pos_];
+}
+
+util::expected<void, storage::Error> PhysicalScan::open(ExecutionContext& ctx) {
+    next_node_id_ = 1;
+    // Ids are never reused, so after deletes live nodes sit above the node count
+    last_node_id_ = ctx.graph_store->get_node_id_limit() - 1;
+    candidates_.reset();
+    candidate_pos_ = 0;
+    cursor_.reset();
+    if (input_) {
+        return input_->open(ctx);
+    }
+    if (!index_keys_.empty() || !pattern_.labels.empty() || !ranges_.empty() || !composite_keys_.empty()) {
+        // Falls back to the scan below when no index could answer
+        candidates_ = cypher::seek_nodes_by_index(pattern_, index_keys_, ctx, ranges_, composite_keys_);
+    }
+    return {};
+}
+
+void PhysicalScan::close() {
+    candidates_.reset();
+    cursor_.reset();
+    if (input_) {
+        input_->close();
+    }
+}
+
+std::vector<std::shared_ptr<PhysicalOperator>> PhysicalScan::children() const {
+    if (input_) {
+        return {input_};
+    }
+    return {};
+}
+
+util::expected<void, storage::Error> PhysicalScan::next_batch(ExecutionContext& ctx, ResultSet& batch,
+                                                              size_t max_rows) {
+    batch.clear();
+    return input_ ? apply_batch(ctx, batch, max_rows) : scan_batch(ctx, batch, max_rows);
+}
+
+util::expected<void, storage::Error> PhysicalScan::scan_batch(ExecutionContext& ctx, ResultSet& batch,
+                                                              size_t max_rows) {
+    if (candidates_.has_value()) {
+        while (batch.size() < max_rows && candidate_pos_ < candidates_->size()) {
+            storage::NodeId node_id = (*candidates_)[candidate_pos_++];
+            // Postings can be stale, so every candidate is re-checked against the store
+            if (cypher::matches_node_pattern(pattern_, node_id, ctx)) {
+                bind_variable(batch.append_empty(), variable_, Slot::Kind::NODE, node_id);
+            }
+        }
+        return {};
+    }
+
+    while (batch.size() < max_rows && next_node_id_ <= last_node_id_) {
+        storage::NodeId node_id = next_node_id_++;
+        auto node_result = cypher::read_node(ctx, node_id);
+        if (!node_result.has_value()) {
+            continue;
+        }
+        if (!pattern_.properties.empty() &&
+            !cypher::matches_property_constraints(pattern_.properties, node_result.value().second)) {
+            continue;
+        }
+        bind_variable(batch.append_empty(), variable_, Slot::Kind::NODE, node_id);
+    }
+    return {};
 }
 
-void PhysicalFilter::init() {
-    input_->init();
+util::expected<void, storage::Error> PhysicalScan::apply_batch(ExecutionContext& ctx, ResultSet& batch,
+                                                               size_t max_rows) {
+    while (batch.size() < max_rows) {
+        auto current = cursor_.current(ctx, batch.width(), max_rows);
+        if (!current.has_value()) {
+            return util::unexpected<storage::Error>(current.error());
+        }
+        RowView row = current.value();
+        if (row.empty()) {
+            break;
+        }
+
+        const Slot& slot = row[variable_.slot];
+        if (slot.kind != Slot::Kind::EMPTY) {
+            if (slot.kind == Slot::Kind::NODE && cypher::matches_node_pattern(pattern_, slot.id, ctx)) {
+                batch.append(row);
+            }
+            cursor_.advance();
+            continue;
+        }
+
+        // Candidates are only needed when some input row leaves the variable unbound
+        if (!candidates_.has_value()) {
+            auto node_ids = cypher::find_nodes_by_pattern(pattern_, ctx);
+            if (!node_ids.has_value()) {
+                return util::unexpected<storage::Error>(node_ids.error());
+            }
+            candidates_ = std::move(node_ids.value());
+        }
+        while (candidate_pos_ < candidates_->size() && batch.size() < max_rows) {
+            bind_variable(batch.append(row), variable_, Slot::Kind::NODE, (*candidates_)[candidate_pos_++]);
+        }
+        if (candidate_pos_ >= candidates_->size()) {
+            candidate_pos_ = 0;
+            cursor_.advance();
+        }
+    }
+    return {};
 }
 
-util::expected<ResultSet, storage::Error> PhysicalFilter::execute(ExecutionContext& ctx) {
-    auto input_result = input_->execute(ctx);
-    if (!input_result.has_value()) {
-        return util::unexpected<storage::Error>(input_result.error());
+std::string PhysicalScan::describe() const {
+    std::string desc = input_ ? "NodeScanApply("
+                     : !index_keys_.empty() || !ranges_.empty() || !composite_keys_.empty() ? "NodeIndexSeek("
+                     : !pattern_.labels.empty() ? "NodeLabelScan("
+                     : "NodeScan(";
+    desc += variable_.name;
+    for (const auto& label : pattern_.labels) {
+        desc += ":" + label;
+    }
+    if (!pattern_.properties.empty()) {
+        desc += " {" + std::to_string(pattern_.properties.size()) + " props}";
+    }
+    if (!input_ && (!index_keys_.empty() || !ranges_.empty() || !composite_keys_.empty())) {
+        desc += " on";
+        if (!composite_keys_.empty()) {
+            desc += " composite(";
+            for (size_t i = 0; i < composite_keys_.size(); ++i) {
+                desc += (i == 0 ? "" : ", ") + composite_keys_[i];
+            }
+            desc += ")";
+        }
+        for (const auto& key : index_keys_) {
+            desc += " " + key;
+        }
+        for (const auto& range : ranges_) {
+            desc += " range(" + range.key + ")";
+        }
     }
+    return desc + ")";
+}
+
+util::expected<void, storage::Error> PhysicalExpand::open(ExecutionContext& ctx) {
+    cursor_.reset();
+    neighbours_.clear();
+    neighbour_pos_ = 0;
+    row_expanded_ = false;
+    return input_->open(ctx);
+}
+
+void PhysicalExpand::close() {
+    cursor_.reset();
+    neighbours_.clear();
+    neighbours_.shrink_to_fit();
+    input_->close();
+}
+
+util::expected<void, storage::Error> PhysicalExpand::next_batch(ExecutionContext& ctx, ResultSet& batch,
+                                                                size_t max_rows) {
+    batch.clear();
+
+    while (batch.size() < max_rows) {
+        auto current = cursor_.current(ctx, batch.width(), max_rows);
+        if (!current.has_value()) {
+            return util::unexpected<storage::Error>(current.error());
+        }
+        RowView row = current.value();
+        if (row.empty()) {
+            break;
+        }
+
+        if (!row_expanded_) {
+            neighbours_.clear();
+            neighbour_pos_ = 0;
+            if (storage::NodeId from_id = bound_node(row, from_variable_)) {
+                neighbours_ = expand_neighbours(ctx, from_id, edge_, direction_);
+            }
+            row_expanded_ = true;
+        }
 
-    ResultSet filtered_result;
-    
-    for (const auto& row : input_result.value()) {
-        auto condition_result = cypher::evaluate_boolean_expression(*predicate_, row.bindings, ctx);
-        if (!condition_result.has_value()) {
-            return util::unexpected<storage::Error>(condition_result.error());
+        while (neighbour_pos_ < neighbours_.size() && batch.size() < max_rows) {
+            const auto [edge_id, to_id] = neighbours_[neighbour_pos_++];
+            if (!cypher::matches_node_pattern(to_pattern_, to_id, ctx)) {
+                continue;
+            }
+            auto new_row = batch.append(row);
+            if (!bind_variable(new_row, edge_variable_, Slot::Kind::EDGE, edge_id) ||
+                !bind_variable(new_row, to_variable_, Slot::Kind::NODE, to_id)) {
+                // Already bound to a different entity, so this path is not a match
+                batch.truncate(batch.size() - 1);
+            }
         }
-        if (condition_result.value()) {
-            filtered_result.push_back(row);
+
+        if (neighbour_pos_ >= neighbours_.size()) {
+            row_expanded_ = false;
+            cursor_.advance();
         }
     }
 
-    return filtered_result;
+    return {};
 }
 
-util::expected<QueryResult, storage::Error> ExecutionPlan::execute(ExecutionContext& ctx) {
-    root_->init();
-    auto result_set = root_->execute(ctx);
-    if (!result_set.has_value()) {
-        return util::unexpected<storage::Error>(result_set.error());
+std::string PhysicalExpand::describe() const {
+    return "Expand" + describe_edge(from_variable_.name, edge_, to_variable_.name, direction_);
+}
+
+PathEnumerator::Options PhysicalVarLengthExpand::path_options(const cypher::Edge& edge) {
+    PathEnumerator::Options options;
+    options.min_hops = static_cast<size_t>(std::max(0, edge.min_hops));
+    options.max_hops = static_cast<size_t>(edge.max_hops == -1 ? DEFAULT_MAX_HOPS : std::max(0, edge.max_hops));
+    options.uniqueness = PathEnumerator::Uniqueness::NODES;
+    return options;
+}
+
+util::expected<void, storage::Error> PhysicalVarLengthExpand::open(ExecutionContext& ctx) {
+    cursor_.reset();
+    row_started_ = false;
+    return input_->open(ctx);
+}
+
+void PhysicalVarLengthExpand::close() {
+    cursor_.reset();
+    paths_.clear();
+    row_started_ = false;
+    input_->close();
+}
+
+util::expected<void, storage::Error> PhysicalVarLengthExpand::next_batch(ExecutionContext& ctx, ResultSet& batch,
+                                                                         size_t max_rows) {
+    batch.clear();
+    // Edge types and properties are checked here, as each node is expanded
+    const PathEnumerator::ExpandFn expand = [&](storage::NodeId node_id, std::vector<PathEnumerator::Step>& steps) {
+        auto neighbours = expand_neighbours(ctx, node_id, edge_, direction_);
+        steps.insert(steps.end(), neighbours.begin(), neighbours.end());
+    };
+
+    while (batch.size() < max_rows) {
+        auto current = cursor_.current(ctx, batch.width(), max_rows);
+        if (!current.has_value()) {
+            return util::unexpected<storage::Error>(current.error());
+        }
+        RowView row = current.value();
+        if (row.empty()) {
+            break;
+        }
+
+        if (!row_started_) {
+            if (storage::NodeId from_id = bound_node(row, from_variable_)) {
+                paths_.reset(from_id);
+            } else {
+                paths_.clear();
+            }
+            row_started_ = true;
+        }
+
+        bool exhausted = false;
+        while (batch.size() < max_rows) {
+            if (!paths_.next(expand)) {
+                exhausted = true;
+                break;
+            }
+            const storage::NodeId last_node_id = paths_.nodes().back();
+            if (cypher::matches_node_pattern(to_pattern_, last_node_id, ctx)) {
+                // Note: path and edge-list variable bindings are not implemented
+                if (!bind_variable(batch.append(row), to_variable_, Slot::Kind::NODE, last_node_id)) {
+                    batch.truncate(batch.size() - 1);
+                }
+            }
+        }
+
+        if (exhausted) {
+            row_started_ = false;
+            cursor_.advance();
+        }
     }
 
-    // This is a simplified conversion. A real implementation would need to
-    // extract the correct columns based on the RETURN clause.
-    QueryResult final_result({"_id"});
-    for (const auto& row : result_set.value()) {
-        for (const auto& [var, binding] : row.bindings) {
-            if (binding.type == VariableBinding::Type::NODE) {
-                final_result.add_row({std::to_string(binding.id_value)});
+    return {};
+}
+
+std::string PhysicalVarLengthExpand::describe() const {
+    return "VarLengthExpand" + describe_edge(from_variable_.name, edge_, to_variable_.name, direction_);
+}
+
+util::expected<void, storage::Error> PhysicalFilter::open(ExecutionContext& ctx) {
+    return input_->open(ctx);
+}
+
+util::expected<void, storage::Error> PhysicalFilter::next_batch(ExecutionContext& ctx, ResultSet& batch,
+                                                                size_t max_rows) {
+    // Keep pulling until something survives or the input runs dry, so that an
+    // empty batch still means "exhausted" to our consumer
+    do {
+        auto pulled = input_->next_batch(ctx, batch, max_rows);
+        if (!pulled.has_value() || batch.empty()) {
+            return pulled;
+        }
+
+        selection_.resize(batch.size());
+        std::iota(selection_.begin(), selection_.end(), 0u);
+        auto evaluated = predicate_.evaluate(batch, ctx, selection_);
+        if (!evaluated.has_value()) {
+            return evaluated;
+        }
+
+        // Selected indices are ascending, so compacting in place never overwrites a pending row
+        for (size_t kept = 0; kept < selection_.size(); ++kept) {
+            if (selection_[kept] != kept) {
+                batch.copy_row(kept, selection_[kept]);
             }
         }
+        batch.truncate(selection_.size());
+    } while (batch.empty());
+
+    return {};
+}
+
+util::expected<void, storage::Error> PhysicalLimit::open(ExecutionContext& ctx) {
+    produced_ = 0;
+    return input_->open(ctx);
+}
+
+util::expected<void, storage::Error> PhysicalLimit::next_batch(ExecutionContext& ctx, ResultSet& batch,
+                                                               size_t max_rows) {
+    batch.clear();
+    if (produced_ >= limit_) {
+        return {};
+    }
+
+    // Never ask the input for more than we can still hand out
+    auto pulled = input_->next_batch(ctx, batch, std::min(max_rows, limit_ - produced_));
+    if (!pulled.has_value()) {
+        return pulled;
+    }
+    produced_ += batch.size();
+    return {};
+}
+
+util::expected<ResultSet, storage::Error> ExecutionPlan::execute(ExecutionContext& ctx) {
+    auto opened = open(ctx);
+    if (!opened.has_value()) {
+        return util::unexpected<storage::Error>(opened.error());
+    }
+
+    ResultSet result_set(layout_->size());
+    ResultSet batch;
+    while (true) {
+        auto pulled = next_batch(ctx, batch);
+        if (!pulled.has_value()) {
+            close();
+            return util::unexpected<storage::Error>(pulled.error());
+        }
+        if (batch.empty()) {
+            break;
+        }
+        result_set.append_all(batch);
     }
+    close();
+    return result_set;
+}
 
-    return final_result;
+std::string ExecutionPlan::explain() const {
+    std::string out;
+    std::vector<std::pair<const PhysicalOperator*, size_t>> stack{{root_.get(), 0}};
+    while (!stack.empty()) {
+        auto [op, depth] = stack.back();
+        stack.pop_back();
+        out += std::string(depth * 2, ' ') + op->describe() + "\n";
+        auto kids = op->children();
+        for (auto rit = kids.rbegin(); rit != kids.rend(); ++rit) {
+            stack.emplace_back(rit->get(), depth + 1);
+        }
+    }
+    return out;
 }
 
-} // namespace loredb::query 
\ No newline at end of file
+} // namespace loredb::query
@@ -1,9 +1,14 @@
 #pragma once
 
 #include "cypher/ast.h"
+#include "cypher/batch_evaluator.h"
+#include "cypher/pattern_matcher.h"
 #include "../storage/graph_store.h"
 #include "query_types.h"
+#include "traversal.h"
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace loredb::query {
@@ -11,60 +16,262 @@ namespace loredb::query {
 // Forward declaration
 struct ExecutionContext;
 
-// Base class for all physical query operators
+// Rows requested per next_batch() call when the consumer has no tighter bound
+inline constexpr size_t DEFAULT_BATCH_SIZE = 1024;
+
+// A pattern variable and the row slot the planner assigned to it. Unnamed
+// variables keep NO_SLOT and are never bound.
+struct PlanVariable {
+    std::string name;
+    size_t slot = NO_SLOT;
+};
+
+// Which adjacency list an expansion walks, relative to the bound node
+enum class ExpandDirection {
+    OUTGOING,   // (bound)-[]->(new)
+    INCOMING,   // (bound)<-[]-(new)
+    BOTH        // (bound)-[]-(new)
+};
+
+/**
+ * @class PhysicalOperator
+ * @brief Base class for pull-based (iterator model) physical operators.
+ *
+ * Consumers call open() once, then next_batch() until it yields an empty batch,
+ * then close(). Each call produces at most `max_rows` rows and operators pass
+ * the bound down to their inputs, so a LIMIT above a scan stops the scan as soon
+ * as enough rows have been produced and memory stays proportional to the batch.
+ * Rows are flat slot arrays; operators address variables by the slot indices the
+ * planner resolved, and keep the width of the batch they are handed.
+ */
 class PhysicalOperator {
 public:
     virtual ~PhysicalOperator() = default;
-    
-    // Initializes the operator
-    virtual void init() = 0;
-    
-    // Executes the operator and returns a result set
-    virtual util::expected<ResultSet, storage::Error> execute(ExecutionContext& ctx) = 0;
-    
+
+    // Prepares the operator (and its inputs) for a fresh pass
+    virtual util::expected<void, storage::Error> open(ExecutionContext& ctx) = 0;
+
+    // Replaces `batch` with up to `max_rows` rows; an empty batch means the operator is exhausted
+    virtual util::expected<void, storage::Error> next_batch(ExecutionContext& ctx, ResultSet& batch,
+                                                            size_t max_rows) = 0;
+
+    // Releases per-pass state (and closes inputs)
+    virtual void close() = 0;
+
     // Returns the children of this operator
     virtual std::vector<std::shared_ptr<PhysicalOperator>> children() const = 0;
+
+    // One-line description used by ExecutionPlan::explain()
+    virtual std::string describe() const = 0;
 };
 
-// Scans all nodes in the graph
+// Row-at-a-time view over an input operator's batches
+class BatchCursor {
+public:
+    explicit BatchCursor(std::shared_ptr<PhysicalOperator> input) : input_(std::move(input)) {}
+
+    void reset();
+
+    // Current input row, pulling the next batch of `width`-slot rows when needed;
+    // an empty view once the input is exhausted
+    util::expected<RowView, storage::Error> current(ExecutionContext& ctx, size_t width, size_t max_rows);
+    void advance() { ++pos_; }
+
+private:
+    std::shared_ptr<PhysicalOperator> input_;
+    ResultSet batch_;
+    size_t pos_ = 0;
+    bool exhausted_ = false;
+};
+
+// Produces the nodes matching a node pattern. With an input, each input row is
+// either checked (variable already bound) or combined with every matching node.
+// A leaf scan of a labeled pattern, or one given `index_keys`, intersects the
+// label postings and the declared indexes on those constraint keys instead of
+// visiting every node.
 class PhysicalScan : public PhysicalOperator {
 public:
-    PhysicalScan(std::string variable, std::optional<std::string> label)
-        : variable_(std::move(variable)), label_(std::move(label)) {}
-        
-    void init() override;
-    util::expected<ResultSet, storage::Error> execute(ExecutionContext& ctx) override;
-    std::vector<std::shared_ptr<PhysicalOperator>> children() const override { return {}; }
+    PhysicalScan(std::shared_ptr<PhysicalOperator> input, PlanVariable variable, cypher::Node pattern,
+                 std::vector<std::string> index_keys = {}, std::vector<cypher::PropertyRange> ranges = {},
+                 std::vector<std::string> composite_keys = {})
+        : input_(std::move(input)), cursor_(input_), variable_(std::move(variable)), pattern_(std::move(pattern)),
+          index_keys_(std::move(index_keys)), ranges_(std::move(ranges)), composite_keys_(std::move(composite_keys)) {}
+
+    util::expected<void, storage::Error> open(ExecutionContext& ctx) override;
+    util::expected<void, storage::Error> next_batch(ExecutionContext& ctx, ResultSet& batch, size_t max_rows) override;
+    void close() override;
+    std::vector<std::shared_ptr<PhysicalOperator>> children() const override;
+    std::string describe() const override;
+
+private:
+    util::expected<void, storage::Error> scan_batch(ExecutionContext& ctx, ResultSet& batch, size_t max_rows);
+    util::expected<void, storage::Error> apply_batch(ExecutionContext& ctx, ResultSet& batch, size_t max_rows);
+
+    std::shared_ptr<PhysicalOperator> input_;
+    BatchCursor cursor_;
+    PlanVariable variable_;
+    cypher::Node pattern_;
+    std::vector<std::string> index_keys_;
+    // Range-indexed WHERE bounds on the variable (leaf only)
+    std::vector<cypher::PropertyRange> ranges_;
+    // Leading keys of a composite index probed for the constraints (leaf only)
+    std::vector<std::string> composite_keys_;
+
+    // Leaf scan position
+    storage::NodeId next_node_id_ = 1;
+    storage::NodeId last_node_id_ = 0;
+
+    // Label/index-seek candidates (leaf) or matching nodes materialized on first use
+    // (apply mode), and the position within them
+    std::optional<std::vector<storage::NodeId>> candidates_;
+    size_t candidate_pos_ = 0;
+};
+
+// Follows single-hop edges from a bound node and binds the edge and neighbour
+class PhysicalExpand : public PhysicalOperator {
+public:
+    PhysicalExpand(std::shared_ptr<PhysicalOperator> input,
+                   PlanVariable from_variable,
+                   cypher::Edge edge,
+                   PlanVariable edge_variable,
+                   PlanVariable to_variable,
+                   cypher::Node to_pattern,
+                   ExpandDirection direction)
+        : input_(std::move(input)), cursor_(input_), from_variable_(std::move(from_variable)), edge_(std::move(edge)),
+          edge_variable_(std::move(edge_variable)), to_variable_(std::move(to_variable)),
+          to_pattern_(std::move(to_pattern)), direction_(direction) {}
+
+    util::expected<void, storage::Error> open(ExecutionContext& ctx) override;
+    util::expected<void, storage::Error> next_batch(ExecutionContext& ctx, ResultSet& batch, size_t max_rows) override;
+    void close() override;
+    std::vector<std::shared_ptr<PhysicalOperator>> children() const override { return {input_}; }
+    std::string describe() const override;
+
+private:
+    std::shared_ptr<PhysicalOperator> input_;
+    BatchCursor cursor_;
+    PlanVariable from_variable_;
+    cypher::Edge edge_;
+    PlanVariable edge_variable_;
+    PlanVariable to_variable_;
+    cypher::Node to_pattern_;
+    ExpandDirection direction_;
+
+    // Neighbours of the current input row and how far we've emitted them
+    std::vector<std::pair<storage::EdgeId, storage::NodeId>> neighbours_;
+    size_t neighbour_pos_ = 0;
+    bool row_expanded_ = false;
+};
+
+// Follows paths of min_hops..max_hops edges (no repeated nodes) from a bound node
+class PhysicalVarLengthExpand : public PhysicalOperator {
+public:
+    // Unbounded patterns (max_hops == -1) are capped at this depth for safety
+    static constexpr int DEFAULT_MAX_HOPS = 10;
+
+    PhysicalVarLengthExpand(std::shared_ptr<PhysicalOperator> input,
+                            PlanVariable from_variable,
+                            cypher::Edge edge,
+                            PlanVariable edge_variable,
+                            PlanVariable to_variable,
+                            cypher::Node to_pattern,
+                            ExpandDirection direction)
+        : input_(std::move(input)), cursor_(input_), from_variable_(std::move(from_variable)), edge_(std::move(edge)),
+          edge_variable_(std::move(edge_variable)), to_variable_(std::move(to_variable)),
+          to_pattern_(std::move(to_pattern)), direction_(direction), paths_(path_options(edge_)) {}
+
+    util::expected<void, storage::Error> open(ExecutionContext& ctx) override;
+    util::expected<void, storage::Error> next_batch(ExecutionContext& ctx, ResultSet& batch, size_t max_rows) override;
+    void close() override;
+    std::vector<std::shared_ptr<PhysicalOperator>> children() const override { return {input_}; }
+    std::string describe() const override;
 
 private:
-    std::string variable_;
-    std::optional<std::string> label_;
+    // Hop bounds and node uniqueness of the pattern, applied while walking
+    static PathEnumerator::Options path_options(const cypher::Edge& edge);
+
+    std::shared_ptr<PhysicalOperator> input_;
+    BatchCursor cursor_;
+    PlanVariable from_variable_;
+    cypher::Edge edge_;
+    PlanVariable edge_variable_;
+    PlanVariable to_variable_;
+    cypher::Node to_pattern_;
+    ExpandDirection direction_;
+
+    // Paths from the current input row's node, resumed across batches
+    PathEnumerator paths_;
+    bool row_started_ = false;
 };
 
-// Filters a result set based on a predicate
+// Filters each batch with a vectorized predicate. The predicate is borrowed from
+// the query AST and the layout from the owning plan; both must outlive the operator.
 class PhysicalFilter : public PhysicalOperator {
 public:
-    PhysicalFilter(std::shared_ptr<PhysicalOperator> input, cypher::Expression* predicate)
-        : input_(std::move(input)), predicate_(predicate) {}
-        
-    void init() override;
-    util::expected<ResultSet, storage::Error> execute(ExecutionContext& ctx) override;
+    PhysicalFilter(std::shared_ptr<PhysicalOperator> input, const cypher::Expression* predicate,
+                   const SlotLayout* layout)
+        : input_(std::move(input)), predicate_(predicate, layout) {}
+
+    util::expected<void, storage::Error> open(ExecutionContext& ctx) override;
+    util::expected<void, storage::Error> next_batch(ExecutionContext& ctx, ResultSet& batch, size_t max_rows) override;
+    void close() override { input_->close(); }
     std::vector<std::shared_ptr<PhysicalOperator>> children() const override { return {input_}; }
+    std::string describe() const override { return "Filter"; }
 
 private:
     std::shared_ptr<PhysicalOperator> input_;
-    std::unique_ptr<cypher::Expression> predicate_;
+    cypher::BatchPredicate predicate_;
+    cypher::SelectionVector selection_;
+};
+
+// Stops pulling from its input once `limit` rows have been produced
+class PhysicalLimit : public PhysicalOperator {
+public:
+    PhysicalLimit(std::shared_ptr<PhysicalOperator> input, size_t limit)
+        : input_(std::move(input)), limit_(limit) {}
+
+    util::expected<void, storage::Error> open(ExecutionContext& ctx) override;
+    util::expected<void, storage::Error> next_batch(ExecutionContext& ctx, ResultSet& batch, size_t max_rows) override;
+    void close() override { input_->close(); }
+    std::vector<std::shared_ptr<PhysicalOperator>> children() const override { return {input_}; }
+    std::string describe() const override { return "Limit(" + std::to_string(limit_) + ")"; }
+
+private:
+    std::shared_ptr<PhysicalOperator> input_;
+    size_t limit_;
+    size_t produced_ = 0;
 };
 
 // Represents the query execution plan
 class ExecutionPlan {
 public:
-    explicit ExecutionPlan(std::shared_ptr<PhysicalOperator> root) : root_(std::move(root)) {}
-    
-    util::expected<QueryResult, storage::Error> execute(ExecutionContext& ctx);
-    
+    ExecutionPlan(std::shared_ptr<PhysicalOperator> root, std::unique_ptr<SlotLayout> layout)
+        : root_(std::move(root)), layout_(std::move(layout)) {}
+
+    // Streaming interface mirroring PhysicalOperator; batches are given the layout's width
+    util::expected<void, storage::Error> open(ExecutionContext& ctx) { return root_->open(ctx); }
+    util::expected<void, storage::Error> next_batch(ExecutionContext& ctx, ResultSet& batch,
+                                                    size_t max_rows = DEFAULT_BATCH_SIZE) {
+        batch.reset(layout_->size());
+        return root_->next_batch(ctx, batch, max_rows);
+    }
+    void close() { root_->close(); }
+
+    // Runs the plan to completion and returns every matched binding
+    util::expected<ResultSet, storage::Error> execute(ExecutionContext& ctx);
+
+    // Indented operator tree, root first
+    std::string explain() const;
+
+    const std::shared_ptr<PhysicalOperator>& root() const { return root_; }
+
+    // Variable-to-slot mapping shared by every row the plan produces
+    const SlotLayout& layout() const { return *layout_; }
+
 private:
     std::shared_ptr<PhysicalOperator> root_;
+    // Heap-allocated so operators can hold a stable pointer to it
+    std::unique_ptr<SlotLayout> layout_;
 };
 
-} // namespace loredb::query 
\ No newline at end of file
+} // namespace loredb::query
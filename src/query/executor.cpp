@@ -1,7 +1,10 @@
 #include "executor.h"
+#include "../util/dense_bitmap.h"
 #include <queue>
-#include <unordered_set>
+#include <unordered_map>
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <sstream>
 #include <fmt/core.h>
 #include <fmt/format.h>
@@ -219,20 +222,117 @@ util::expected<QueryResult, storage::Error> QueryExecutor::find_shortest_path(st
 }
 
 util::expected<QueryResult, storage::Error> QueryExecutor::find_paths_with_length(storage::NodeId from_node, storage::NodeId to_node, size_t max_length) {
-    auto paths = bfs_paths_with_length(from_node, to_node, max_length);
-    
     QueryResult query_result({"path_length", "path"});
-    
-    for (const auto& path : paths) {
-        std::stringstream path_stream;
-        for (size_t i = 0; i < path.size(); ++i) {
-            if (i > 0) path_stream << " -> ";
-            path_stream << path[i];
+
+    // Undirected, without repeating a node; each path is formatted as it is found
+    PathEnumerator::Options options;
+    options.max_hops = max_length;
+    options.target = to_node;
+    PathEnumerator paths(options);
+    const PathEnumerator::ExpandFn expand = [this](storage::NodeId node_id, std::vector<PathEnumerator::Step>& steps) {
+        auto adjacent = graph_store_->get_adjacent_nodes(node_id);
+        if (adjacent.has_value()) {
+            // Neighbours are deduplicated, so parallel edges give one path
+            for (storage::NodeId neighbor : adjacent.value()) {
+                steps.emplace_back(0, neighbor);
+            }
         }
-        
-        query_result.add_row({std::to_string(path.size() - 1), path_stream.str()});
+    };
+
+    paths.reset(from_node);
+    while (paths.next(expand)) {
+        std::string path;
+        for (storage::NodeId node : paths.nodes()) {
+            path += path.empty() ? std::to_string(node) : " -> " + std::to_string(node);
+        }
+        query_result.add_row({std::to_string(paths.hops()), std::move(path)});
+    }
+
+    return query_result;
+}
+
+util::expected<QueryResult, storage::Error> QueryExecutor::get_k_hop_neighborhood(storage::NodeId node_id,
+                                                                                size_t max_hops,
+                                                                                TraversalDirection direction) {
+    if (!graph_store_->get_node(node_id).has_value()) {
+        return util::unexpected(storage::Error{storage::ErrorCode::NOT_FOUND, "Node not found"});
+    }
+    BfsEngine::Options options;
+    options.direction = direction;
+    options.max_depth = max_hops;
+    const auto traversal = BfsEngine(graph_store_).run({node_id}, options);
+    
+    QueryResult query_result({"node_id", "hops"});
+    for (size_t hops = 1; hops < traversal.levels.size(); ++hops) {
+        for (storage::NodeId neighbor : traversal.levels[hops]) {
+            query_result.add_row({std::to_string(neighbor), std::to_string(hops)});
+        }
+    }
+    return query_result;
+}
+
+util::expected<QueryResult, storage::Error> QueryExecutor::is_reachable(storage::NodeId from_node,
+                                                                      storage::NodeId to_node, size_t max_hops,
+                                                                      TraversalDirection direction) {
+    if (!graph_store_->get_node(from_node).has_value()) {
+        return util::unexpected(storage::Error{storage::ErrorCode::NOT_FOUND, "Node not found"});
+    }
+    BfsEngine::Options options;
+    options.direction = direction;
+    options.max_depth = max_hops;
+    options.target = to_node;
+    const auto hops = BfsEngine(graph_store_).run({from_node}, options).depth_of(to_node);
+    
+    QueryResult query_result({"reachable", "hops"});
+    query_result.add_row({hops.has_value() ? "true" : "false", hops.has_value() ? std::to_string(*hops) : ""});
+    return query_result;
+}
+
+util::expected<QueryResult, storage::Error> QueryExecutor::find_weighted_shortest_path(storage::NodeId from_node,
+                                                                                     storage::NodeId to_node,
+                                                                                     const std::string& weight_key) {
+    if (!graph_store_->get_node(from_node).has_value() || !graph_store_->get_node(to_node).has_value()) {
+        return util::unexpected(storage::Error{storage::ErrorCode::NOT_FOUND, "Node not found"});
+    }
+    std::shared_ptr<const LandmarkIndex> landmarks;
+    {
+        std::lock_guard<std::mutex> lock(landmarks_mutex_);
+        landmarks = landmarks_;
+    }
+    
+    // Landmarks built before an edge changed may misguide A*; search without them until rebuilt
+    const bool guided = landmarks && landmarks->weight_key() == weight_key && landmarks->is_current(*graph_store_);
+    WeightedPathFinder finder(graph_store_, weight_key);
+    auto found = guided ? finder.find(from_node, to_node, *landmarks) : finder.find(from_node, to_node);
+    if (!found.has_value()) {
+        return util::unexpected(found.error());
     }
+    const auto& path = found.value();
     
+    QueryResult query_result({"total_weight", "path_length", "path"});
+    if (!path.found()) {
+        query_result.add_row({"", "0", "No path found"});
+    } else {
+        query_result.add_row({fmt::format("{}", path.total_weight), std::to_string(path.edges.size()),
+                              fmt::format("{}", fmt::join(path.nodes, " -> "))});
+    }
+    return query_result;
+}
+
+util::expected<QueryResult, storage::Error> QueryExecutor::build_path_landmarks(const std::string& weight_key,
+                                                                              size_t landmark_count) {
+    auto index = LandmarkIndex::build(WeightedPathFinder(graph_store_, weight_key), *graph_store_, landmark_count);
+    if (!index.has_value()) {
+        return util::unexpected(index.error());
+    }
+    auto landmarks = std::make_shared<const LandmarkIndex>(std::move(index.value()));
+    
+    QueryResult query_result({"landmark", "node_id"});
+    for (size_t i = 0; i < landmarks->landmarks().size(); ++i) {
+        query_result.add_row({std::to_string(i), std::to_string(landmarks->landmarks()[i])});
+    }
+    std::lock_guard<std::mutex> lock(landmarks_mutex_);
+    landmarks_ = std::move(landmarks);
     return query_result;
 }
 
@@ -248,16 +348,44 @@ util::expected<QueryResult, storage::Error> QueryExecutor::count_edges() {
     return query_result;
 }
 
-util::expected<QueryResult, storage::Error> QueryExecutor::get_node_degree_stats() {
+util::expected<QueryResult, storage::Error> QueryExecutor::get_node_degree_stats(size_t top_k) {
+    using storage::DegreeDirection;
     QueryResult query_result({"metric", "value"});
+    const auto& stats = graph_store_->degree_statistics();
     
-    // For now, just return basic stats
     query_result.add_row({"total_nodes", std::to_string(graph_store_->get_node_count())});
     query_result.add_row({"total_edges", std::to_string(graph_store_->get_edge_count())});
+    query_result.add_row({"min_degree", std::to_string(stats.min_degree(DegreeDirection::BOTH))});
+    query_result.add_row({"max_degree", std::to_string(stats.max_degree(DegreeDirection::BOTH))});
+    query_result.add_row({"mean_degree", fmt::format("{:.3f}", stats.mean_degree(DegreeDirection::BOTH))});
+    for (int percentile : {50, 90, 99}) {
+        query_result.add_row({fmt::format("p{}_degree", percentile),
+                              std::to_string(stats.percentile(DegreeDirection::BOTH, percentile))});
+    }
+    query_result.add_row({"mean_in_degree", fmt::format("{:.3f}", stats.mean_degree(DegreeDirection::IN))});
+    query_result.add_row({"max_in_degree", std::to_string(stats.max_degree(DegreeDirection::IN))});
+    query_result.add_row({"mean_out_degree", fmt::format("{:.3f}", stats.mean_degree(DegreeDirection::OUT))});
+    query_result.add_row({"max_out_degree", std::to_string(stats.max_degree(DegreeDirection::OUT))});
+    
+    const auto hubs = stats.top_hubs(top_k);
+    for (size_t rank = 0; rank < hubs.size(); ++rank) {
+        query_result.add_row({fmt::format("hub_{}", rank + 1),
+                              fmt::format("node:{},degree:{},in:{},out:{}", hubs[rank].node_id, hubs[rank].degree(),
+                                          hubs[rank].in_degree, hubs[rank].out_degree)});
+    }
     
     return query_result;
 }
 
+util::expected<QueryResult, storage::Error> QueryExecutor::get_degree_histogram(storage::DegreeDirection direction) {
+    QueryResult query_result({"min_degree", "max_degree", "nodes"});
+    for (const auto& bucket : graph_store_->degree_statistics().histogram(direction)) {
+        query_result.add_row({std::to_string(bucket.min_degree), std::to_string(bucket.max_degree),
+                              std::to_string(bucket.nodes)});
+    }
+    return query_result;
+}
+
 util::expected<QueryResult, storage::Error> QueryExecutor::batch_get_nodes(const std::vector<storage::NodeId>& node_ids) {
     QueryResult query_result({"id", "properties"});
     
@@ -314,24 +442,322 @@ util::expected<QueryResult, storage::Error> QueryExecutor::get_document_outlinks
     return get_outgoing_edges(document_id);
 }
 
-util::expected<QueryResult, storage::Error> QueryExecutor::find_related_documents(storage::NodeId document_id, size_t max_results) {
+util::expected<QueryResult, storage::Error> QueryExecutor::find_related_documents(storage::NodeId document_id,
+                                                                                  size_t max_results,
+                                                                                  RelatedMode mode) {
+    if (mode == RelatedMode::SHARED_NEIGHBORS) {
+        return find_documents_sharing_neighbors(document_id, max_results);
+    }
     auto adjacent_result = graph_store_->get_adjacent_nodes(document_id);
     if (!adjacent_result.has_value()) {
         return util::unexpected<storage::Error>(adjacent_result.error());
     }
-    
-    QueryResult query_result({"document_id", "relation_type"});
-    
     auto adjacent_nodes = adjacent_result.value();
-    for (size_t i = 0; i < adjacent_nodes.size() && i < max_results; ++i) {
-        query_result.add_row({std::to_string(adjacent_nodes[i]), "adjacent"});
+
+    QueryResult query_result({"document_id", "relation_type"});
+    const auto embedding = mode == RelatedMode::ADJACENT
+                               ? std::nullopt
+                               : index_manager_->find_node_vector(document_id, EMBEDDING_KEY);
+    std::optional<std::vector<storage::HnswIndex::Hit>> hits;
+    if (embedding.has_value()) {
+        storage::PostingList self;
+        self.add(document_id);
+        const size_t candidates = mode == RelatedMode::BLENDED ? max_results * BLENDED_CANDIDATE_FACTOR : max_results;
+        hits = index_manager_->search_vectors(EMBEDDING_KEY, *embedding, candidates, self);
+    }
+
+    if (!hits.has_value()) {
+        for (size_t i = 0; i < adjacent_nodes.size() && i < max_results; ++i) {
+            query_result.add_row({std::to_string(adjacent_nodes[i]), "adjacent"});
+        }
+        return query_result;
+    }
+
+    if (mode == RelatedMode::SEMANTIC) {
+        for (const auto& hit : *hits) {
+            if (node_exists(hit.node_id)) {
+                query_result.add_row({std::to_string(hit.node_id), fmt::format("semantic:{:.3f}", hit.similarity)});
+            }
+        }
+        return query_result;
+    }
+
+    // Graph proximity is 1 / hops for documents within two hops
+    std::unordered_map<storage::NodeId, double> proximity;
+    for (auto neighbor : adjacent_nodes) {
+        proximity.emplace(neighbor, 1.0);
+    }
+    for (auto neighbor : adjacent_nodes) {
+        auto second = graph_store_->get_adjacent_nodes(neighbor);
+        if (second.has_value()) {
+            for (auto node_id : second.value()) {
+                proximity.emplace(node_id, 0.5);
+            }
+        }
+    }
+    proximity.erase(document_id);
+
+    std::unordered_map<storage::NodeId, double> similarity;
+    for (const auto& hit : *hits) {
+        similarity.emplace(hit.node_id, hit.similarity);
+    }
+    // Nearby documents outside the semantic candidates are scored from their own embeddings
+    for (const auto& [node_id, hops] : proximity) {
+        if (!similarity.contains(node_id)) {
+            auto vector = index_manager_->find_node_vector(node_id, EMBEDDING_KEY);
+            similarity.emplace(node_id, vector.has_value() && vector->size() == embedding->size()
+                                            ? storage::HnswIndex::dot(vector->data(), embedding->data(),
+                                                                      vector->size())
+                                            : 0.0);
+        }
+    }
+
+    std::vector<std::pair<double, storage::NodeId>> scored;
+    scored.reserve(similarity.size());
+    for (const auto& [node_id, sim] : similarity) {
+        auto near = proximity.find(node_id);
+        const double closeness = near == proximity.end() ? 0.0 : near->second;
+        scored.emplace_back((1.0 - PROXIMITY_WEIGHT) * sim + PROXIMITY_WEIGHT * closeness, node_id);
+    }
+    std::sort(scored.begin(), scored.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+    for (const auto& [score, node_id] : scored) {
+        if (query_result.rows.size() == max_results) {
+            break;
+        }
+        if (node_exists(node_id)) {
+            query_result.add_row({std::to_string(node_id), fmt::format("blended:{:.3f}", score)});
+        }
     }
-    
     return query_result;
 }
 
-util::expected<QueryResult, storage::Error> QueryExecutor::suggest_links_for_document(storage::NodeId document_id, const std::string& /*content_snippet*/) {
-    // Simple link suggestion based on adjacent nodes
+util::expected<QueryResult, storage::Error> QueryExecutor::find_documents_sharing_neighbors(
+    storage::NodeId document_id, size_t max_results) {
+    auto distinct = [](util::expected<std::vector<storage::NodeId>, storage::Error> ids) {
+        if (ids.has_value()) {
+            std::sort(ids.value().begin(), ids.value().end());
+            ids.value().erase(std::unique(ids.value().begin(), ids.value().end()), ids.value().end());
+        }
+        return ids;
+    };
+    auto cited = distinct(graph_store_->get_outgoing_neighbors(document_id));
+    if (!cited.has_value()) {
+        return util::unexpected<storage::Error>(cited.error());
+    }
+    auto citing = distinct(graph_store_->get_incoming_neighbors(document_id));
+    if (!citing.has_value()) {
+        return util::unexpected<storage::Error>(citing.error());
+    }
+    std::vector<storage::NodeId> neighbors;
+    std::set_union(cited.value().begin(), cited.value().end(), citing.value().begin(), citing.value().end(),
+                   std::back_inserter(neighbors));
+
+    struct Score {
+        double adamic_adar = 0.0;
+        uint32_t co_citation = 0;
+        uint32_t coupling = 0;
+    };
+    std::unordered_map<storage::NodeId, Score> scores;
+    for (auto shared : neighbors) {
+        if (shared == document_id || graph_store_->get_degree(shared) > MAX_SHARED_NEIGHBOR_DEGREE) {
+            continue;
+        }
+        auto out = distinct(graph_store_->get_outgoing_neighbors(shared));
+        auto in = distinct(graph_store_->get_incoming_neighbors(shared));
+        if (!out.has_value() || !in.has_value()) {
+            continue;
+        }
+        std::vector<storage::NodeId> around;
+        std::set_union(out.value().begin(), out.value().end(), in.value().begin(), in.value().end(),
+                       std::back_inserter(around));
+        // `around` includes the document, so a neighbour shared with anyone has degree >= 2
+        if (around.size() < 2) {
+            continue;
+        }
+        const double weight = 1.0 / std::log(static_cast<double>(around.size()));
+        for (auto node_id : around) {
+            if (node_id != document_id) {
+                scores[node_id].adamic_adar += weight;
+            }
+        }
+        // `shared` links to the document: its other outlinks are co-cited with it
+        if (std::binary_search(citing.value().begin(), citing.value().end(), shared)) {
+            for (auto node_id : out.value()) {
+                if (node_id != document_id) {
+                    ++scores[node_id].co_citation;
+                }
+            }
+        }
+        // The document links to `shared`: its other backlinks are coupled with it
+        if (std::binary_search(cited.value().begin(), cited.value().end(), shared)) {
+            for (auto node_id : in.value()) {
+                if (node_id != document_id) {
+                    ++scores[node_id].coupling;
+                }
+            }
+        }
+    }
+
+    // Keep the best max_results in a heap whose top is the weakest kept
+    using Ranked = std::pair<const storage::NodeId, Score>;
+    const auto better = [](const Ranked* a, const Ranked* b) {
+        if (a->second.adamic_adar != b->second.adamic_adar) {
+            return a->second.adamic_adar > b->second.adamic_adar;
+        }
+        const uint32_t a_links = a->second.co_citation + a->second.coupling;
+        const uint32_t b_links = b->second.co_citation + b->second.coupling;
+        return a_links != b_links ? a_links > b_links : a->first < b->first;
+    };
+    std::priority_queue<const Ranked*, std::vector<const Ranked*>, decltype(better)> best(better);
+    for (const auto& entry : scores) {
+        best.push(&entry);
+        if (best.size() > max_results) {
+            best.pop();
+        }
+    }
+    std::vector<const Ranked*> ranked(best.size());
+    for (size_t i = ranked.size(); i-- > 0;) {
+        ranked[i] = best.top();
+        best.pop();
+    }
+
+    QueryResult query_result({"document_id", "relation_type"});
+    for (const auto* entry : ranked) {
+        query_result.add_row({std::to_string(entry->first),
+                              fmt::format("adamic_adar:{:.3f},co_citation:{},coupling:{}", entry->second.adamic_adar,
+                                          entry->second.co_citation, entry->second.coupling)});
+    }
+    return query_result;
+}
+
+util::expected<QueryResult, storage::Error> QueryExecutor::personalized_pagerank(
+    const std::vector<storage::NodeId>& source_ids, double alpha, double epsilon, size_t top_k) {
+    if (source_ids.empty() || !(alpha > 0.0 && alpha < 1.0) || !(epsilon > 0.0)) {
+        return util::unexpected(storage::Error{storage::ErrorCode::INVALID_ARGUMENT,
+                                               "personalized_pagerank needs sources, 0 < alpha < 1 and epsilon > 0"});
+    }
+    std::vector<storage::NodeId> sources = source_ids;
+    std::sort(sources.begin(), sources.end());
+    sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+    const double restart = 1.0 / static_cast<double>(sources.size());
+
+    // Only touched nodes have entries; each keeps its outlinks once fetched
+    struct State {
+        double estimate = 0.0;
+        double residual = 0.0;
+        bool queued = false;
+        std::optional<std::vector<storage::NodeId>> outlinks;
+    };
+    std::unordered_map<storage::NodeId, State> states;
+    std::vector<storage::NodeId> queue;
+    auto outlinks_of = [this](State& state, storage::NodeId node_id) -> util::expected<void, storage::Error> {
+        if (!state.outlinks.has_value()) {
+            auto out = graph_store_->get_outgoing_neighbors(node_id);
+            if (!out.has_value()) {
+                return util::unexpected<storage::Error>(out.error());
+            }
+            state.outlinks = std::move(out.value());
+        }
+        return {};
+    };
+    // A node is pushed while its residual exceeds epsilon per outlink
+    auto add_residual = [&](storage::NodeId node_id, double mass) -> util::expected<void, storage::Error> {
+        State& state = states[node_id];
+        state.residual += mass;
+        if (auto fetched = outlinks_of(state, node_id); !fetched.has_value()) {
+            return fetched;
+        }
+        const double threshold = epsilon * static_cast<double>(std::max<size_t>(state.outlinks->size(), 1));
+        if (!state.queued && state.residual > threshold) {
+            state.queued = true;
+            queue.push_back(node_id);
+        }
+        return {};
+    };
+
+    for (auto source : sources) {
+        if (auto added = add_residual(source, restart); !added.has_value()) {
+            return util::unexpected<storage::Error>(added.error());
+        }
+    }
+    while (!queue.empty()) {
+        const storage::NodeId node_id = queue.back();
+        queue.pop_back();
+        State& state = states[node_id];
+        state.queued = false;
+        const double mass = state.residual;
+        state.residual = 0.0;
+        state.estimate += alpha * mass;
+
+        // Walks stuck at a node without outlinks restart at the sources
+        // Map references survive the inserts below
+        const std::vector<storage::NodeId>& outlinks = *state.outlinks;
+        const std::vector<storage::NodeId>& targets = outlinks.empty() ? sources : outlinks;
+        const double share = (1.0 - alpha) * mass / static_cast<double>(targets.size());
+        for (auto target : targets) {
+            if (auto added = add_residual(target, share); !added.has_value()) {
+                return util::unexpected<storage::Error>(added.error());
+            }
+        }
+    }
+
+    std::vector<std::pair<double, storage::NodeId>> ranked;
+    ranked.reserve(states.size());
+    for (const auto& [node_id, state] : states) {
+        if (state.estimate > 0.0) {
+            ranked.emplace_back(state.estimate, node_id);
+        }
+    }
+    const auto better = [](const auto& a, const auto& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    };
+    const size_t kept = std::min(top_k, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(kept), ranked.end(), better);
+
+    QueryResult query_result({"node_id", "score"});
+    for (size_t i = 0; i < kept; ++i) {
+        query_result.add_row({std::to_string(ranked[i].second), fmt::format("{:.6f}", ranked[i].first)});
+    }
+    return query_result;
+}
+
+bool QueryExecutor::node_exists(storage::NodeId node_id) {
+    auto node = graph_store_->has_mvcc() && tx_id_ != 0 ? graph_store_->get_node(tx_id_, node_id)
+                                                         : graph_store_->get_node(node_id);
+    return node.has_value();
+}
+
+util::expected<QueryResult, storage::Error> QueryExecutor::suggest_links_for_document(storage::NodeId document_id, const std::string& content_snippet) {
+    // The document and the documents it already links to are not suggested
+    storage::PostingList linked;
+    linked.add(document_id);
+    auto outgoing = graph_store_->get_outgoing_edges(document_id);
+    if (!outgoing.has_value()) {
+        return util::unexpected<storage::Error>(outgoing.error());
+    }
+    for (auto edge_id : outgoing.value()) {
+        auto edge = graph_store_->get_edge(edge_id);
+        if (edge.has_value()) {
+            linked.add(edge.value().first.to_node);
+        }
+    }
+
+    // Rank documents by how well their text matches the snippet
+    auto hits = index_manager_->search_text(content_snippet, MAX_LINK_SUGGESTIONS, linked);
+    if (hits.has_value() && !hits->empty()) {
+        QueryResult query_result({"suggested_document_id", "reason"});
+        for (const auto& hit : *hits) {
+            // Postings of deleted documents are stale
+            if (node_exists(hit.node_id)) {
+                query_result.add_row({std::to_string(hit.node_id), fmt::format("text_match:{:.3f}", hit.score)});
+            }
+        }
+        return query_result;
+    }
+
+    // Without a text index or any matching term, fall back to adjacent nodes
     auto related_result = find_related_documents(document_id, 5);
     if (!related_result.has_value()) {
         return util::unexpected<storage::Error>(related_result.error());
@@ -361,6 +787,8 @@ std::string QueryExecutor::property_value_to_string(const storage::PropertyValue
             return v ? "true" : "false";
         } else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
             return "[binary data]";
+        } else if constexpr (std::is_same_v<T, std::vector<float>>) {
+            return fmt::format("[vector({})]", v.size());
         } else {
             return "[unknown]";
         }
@@ -372,7 +800,7 @@ QueryResult QueryExecutor::node_to_result(const storage::NodeRecord& node, const
     
     std::vector<std::string> prop_pairs;
     for (const auto& prop : properties) {
-        prop_pairs.push_back(fmt::format("{}:{}", prop.key, property_value_to_string(prop.value)));
+        prop_pairs.push_back(fmt::format("{}:{}", prop.key.str(), property_value_to_string(prop.value)));
     }
     std::string props_str = fmt::format("{}", fmt::join(prop_pairs, ", "));
     
@@ -404,85 +832,62 @@ std::vector<storage::NodeId> QueryExecutor::bfs_shortest_path(storage::NodeId fr
         return {from_node};
     }
     
-    std::queue<storage::NodeId> queue;
-    std::unordered_set<storage::NodeId> visited;
-    std::unordered_map<storage::NodeId, storage::NodeId> parent;
-    
-    queue.push(from_node);
-    visited.insert(from_node);
-    
-    while (!queue.empty()) {
-        storage::NodeId current = queue.front();
-        queue.pop();
+    // One search from each end. Paths ignore edge direction, so both sides
+    // expand along outgoing and incoming edges alike.
+    struct Side {
+        std::vector<storage::NodeId> frontier;
+        util::DenseBitmap visited;
+        std::unordered_map<storage::NodeId, storage::NodeId> parent;  // Next node towards this side's root
+    };
+    const size_t id_limit = graph_store_->get_node_id_limit();
+    Side forward{{from_node}, util::DenseBitmap(id_limit), {}};
+    Side backward{{to_node}, util::DenseBitmap(id_limit), {}};
+    forward.visited.set(from_node);
+    backward.visited.set(to_node);
+    
+    std::vector<storage::NodeId> next;
+    std::vector<storage::NodeId> neighbors;
+    while (!forward.frontier.empty() && !backward.frontier.empty()) {
+        // Expanding the smaller frontier keeps both searches near sqrt of the one-sided cost
+        const bool expand_forward = forward.frontier.size() <= backward.frontier.size();
+        Side& side = expand_forward ? forward : backward;
+        const Side& other = expand_forward ? backward : forward;
         
-        auto adjacent_result = graph_store_->get_adjacent_nodes(current);
-        if (!adjacent_result.has_value()) {
-            continue;
-        }
-        
-        for (storage::NodeId neighbor : adjacent_result.value()) {
-            if (visited.find(neighbor) == visited.end()) {
-                visited.insert(neighbor);
-                parent[neighbor] = current;
-                queue.push(neighbor);
-                
-                if (neighbor == to_node) {
-                    // Reconstruct path
-                    std::vector<storage::NodeId> path;
-                    storage::NodeId node = to_node;
-                    while (node != from_node) {
-                        path.push_back(node);
-                        node = parent[node];
-                    }
-                    path.push_back(from_node);
-                    std::reverse(path.begin(), path.end());
-                    return path;
+        next.clear();
+        for (storage::NodeId current : side.frontier) {
+            neighbors.clear();
+            graph_store_->append_outgoing_neighbors(current, neighbors);
+            graph_store_->append_incoming_neighbors(current, neighbors);
+            for (storage::NodeId neighbor : neighbors) {
+                if (!side.visited.set(neighbor)) {
+                    continue;
+                }
+                side.parent[neighbor] = current;
+                if (!other.visited.test(neighbor)) {
+                    next.push_back(neighbor);
+                    continue;
+                }
+                // Both searches have reached `neighbor`; with whole levels
+                // expanded at a time, any such meeting lies on a shortest path
+                std::vector<storage::NodeId> path;
+                for (storage::NodeId node = neighbor; node != from_node; node = forward.parent.at(node)) {
+                    path.push_back(node);
                 }
+                path.push_back(from_node);
+                std::reverse(path.begin(), path.end());
+                for (storage::NodeId node = neighbor; node != to_node;) {
+                    node = backward.parent.at(node);
+                    path.push_back(node);
+                }
+                return path;
             }
         }
+        side.frontier.swap(next);
     }
     
     return {}; // No path found
 }
 
-std::vector<std::vector<storage::NodeId>> QueryExecutor::bfs_paths_with_length(storage::NodeId from_node, storage::NodeId to_node, size_t max_length) {
-    std::vector<std::vector<storage::NodeId>> paths;
-    
-    // Simple DFS with path length limit
-    std::function<void(storage::NodeId, std::vector<storage::NodeId>&, std::unordered_set<storage::NodeId>&)> dfs = 
-        [&](storage::NodeId current, std::vector<storage::NodeId>& path, std::unordered_set<storage::NodeId>& visited) {
-            if (path.size() > max_length + 1) {
-                return;
-            }
-            
-            if (current == to_node && path.size() > 1) {
-                paths.push_back(path);
-                return;
-            }
-            
-            auto adjacent_result = graph_store_->get_adjacent_nodes(current);
-            if (!adjacent_result.has_value()) {
-                return;
-            }
-            
-            for (storage::NodeId neighbor : adjacent_result.value()) {
-                if (visited.find(neighbor) == visited.end()) {
-                    visited.insert(neighbor);
-                    path.push_back(neighbor);
-                    dfs(neighbor, path, visited);
-                    path.pop_back();
-                    visited.erase(neighbor);
-                }
-            }
-        };
-    
-    std::vector<storage::NodeId> path = {from_node};
-    std::unordered_set<storage::NodeId> visited = {from_node};
-    dfs(from_node, path, visited);
-    
-    return paths;
-}
-
 // Streaming implementations removed for C++20 compatibility
 // Will be re-implemented when proper coroutine support is available
 
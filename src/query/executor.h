@@ -9,8 +9,11 @@
 #include "../transaction/mvcc.h"
 #include "../util/expected.h"
 #include "query_types.h"
+#include "traversal.h"
+#include "weighted_path.h"
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -26,6 +29,20 @@ namespace loredb::query {
  */
 class QueryExecutor {
 public:
+    // How find_related_documents() relates documents
+    enum class RelatedMode {
+        ADJACENT,          // Graph neighbours
+        SHARED_NEIGHBORS,  // Two-hop neighbours ranked by Adamic-Adar
+        SEMANTIC,          // Nearest embeddings in the vector index
+        BLENDED            // Embedding similarity blended with graph proximity
+    };
+
+    // Property holding document embeddings for the semantic modes
+    static constexpr const char* EMBEDDING_KEY = "embedding";
+    // SHARED_NEIGHBORS skips shared neighbours with more edges than this; hubs
+    // relate nearly everything and would dominate the running time
+    static constexpr size_t MAX_SHARED_NEIGHBOR_DEGREE = 1000;
+
     /**
      * @brief Construct a QueryExecutor with a GraphStore and SimpleIndexManager.
      * @param graph_store Shared pointer to GraphStore.
@@ -51,14 +68,48 @@ public:
     util::expected<QueryResult, storage::Error> get_outgoing_edges(storage::NodeId node_id);
     util::expected<QueryResult, storage::Error> get_incoming_edges(storage::NodeId node_id);
     
-    // Path queries
+    // Path queries. Paths follow edges in either direction. The shortest path
+    // is found by a BFS from each end, expanding the smaller frontier first.
     util::expected<QueryResult, storage::Error> find_shortest_path(storage::NodeId from_node, storage::NodeId to_node);
+    // Every path of at most `max_length` hops that repeats no node, streamed
+    // from a PathEnumerator in depth-first order
     util::expected<QueryResult, storage::Error> find_paths_with_length(storage::NodeId from_node, storage::NodeId to_node, size_t max_length);
+    // Nodes within `max_hops` hops of `node_id` along `direction`, nearest
+    // first: columns "node_id" and "hops". Runs on the parallel BfsEngine.
+    // NOT_FOUND if the node does not exist.
+    util::expected<QueryResult, storage::Error> get_k_hop_neighborhood(
+        storage::NodeId node_id, size_t max_hops, TraversalDirection direction = TraversalDirection::BOTH);
+    // Whether `to_node` is reachable from `from_node` along `direction` within
+    // `max_hops`: columns "reachable" ("true"/"false") and "hops" (empty when
+    // unreachable). NOT_FOUND if `from_node` does not exist.
+    util::expected<QueryResult, storage::Error> is_reachable(
+        storage::NodeId from_node, storage::NodeId to_node, size_t max_hops = SIZE_MAX,
+        TraversalDirection direction = TraversalDirection::OUTGOING);
+    // Least-weight path where each edge costs its numeric `weight_key`
+    // property (see WeightedPathFinder): columns "total_weight", "path_length"
+    // and "path". Uses A* when landmarks were built for `weight_key`,
+    // bidirectional Dijkstra otherwise. NOT_FOUND if either node does not
+    // exist; INVALID_ARGUMENT for a negative or non-numeric weight.
+    util::expected<QueryResult, storage::Error> find_weighted_shortest_path(storage::NodeId from_node,
+                                                                            storage::NodeId to_node,
+                                                                            const std::string& weight_key);
+    // Picks landmarks and precomputes their distances for `weight_key`,
+    // replacing any earlier landmarks: columns "landmark" and "node_id".
+    // Rebuild after adding edges or lowering weights.
+    util::expected<QueryResult, storage::Error> build_path_landmarks(
+        const std::string& weight_key, size_t landmark_count = LandmarkIndex::DEFAULT_LANDMARKS);
     
     // Aggregate queries
     util::expected<QueryResult, storage::Error> count_nodes();
     util::expected<QueryResult, storage::Error> count_edges();
-    util::expected<QueryResult, storage::Error> get_node_degree_stats();
+    // Degree distribution from the store's degree statistics, without visiting
+    // any node: min, max, mean and percentiles of the total degree (as
+    // DegreeStatistics bucket bounds), mean and max in/out degree, and the
+    // `top_k` hubs ("hub_<rank>": "node:<id>,degree:<n>,in:<n>,out:<n>")
+    util::expected<QueryResult, storage::Error> get_node_degree_stats(size_t top_k = 10);
+    // Non-empty degree buckets in `direction`: "min_degree", "max_degree", "nodes"
+    util::expected<QueryResult, storage::Error> get_degree_histogram(
+        storage::DegreeDirection direction = storage::DegreeDirection::BOTH);
     
     // Batch operations
     util::expected<QueryResult, storage::Error> batch_get_nodes(const std::vector<storage::NodeId>& node_ids);
@@ -67,10 +118,43 @@ public:
     // Document-specific queries
     util::expected<QueryResult, storage::Error> get_document_backlinks(storage::NodeId document_id);
     util::expected<QueryResult, storage::Error> get_document_outlinks(storage::NodeId document_id);
-    util::expected<QueryResult, storage::Error> find_related_documents(storage::NodeId document_id, size_t max_results = 10);
+    // Up to `max_results` documents related to `document_id`. ADJACENT lists
+    // graph neighbours ("adjacent"). SHARED_NEIGHBORS ranks the documents that
+    // share neighbours with it by Adamic-Adar, the sum of 1 / log(degree) over
+    // shared neighbours, and also counts co-citations (both linked from the
+    // same document) and couplings (both linking to the same document)
+    // ("adamic_adar:<score>,co_citation:<n>,coupling:<n>"). SEMANTIC returns the nearest embeddings
+    // under EMBEDDING_KEY from the vector index ("semantic:<similarity>").
+    // BLENDED scores those and the documents within two hops by similarity and
+    // 1 / hops, weighted equally ("blended:<score>"). The semantic modes fall
+    // back to ADJACENT without a ready vector index or an indexed embedding.
+    util::expected<QueryResult, storage::Error> find_related_documents(storage::NodeId document_id,
+                                                                       size_t max_results = 10,
+                                                                       RelatedMode mode = RelatedMode::ADJACENT);
+    // Nodes ranked by personalized PageRank from `source_ids`: the probability
+    // that a random walk along outgoing edges, restarting at a uniformly chosen
+    // source with probability `alpha` at each step, is at the node. Computed by
+    // forward push over the adjacency lists: pushing stops once no node holds
+    // more than epsilon of unpushed probability per outlink, so the work is
+    // bounded by 1 / (alpha * epsilon) rather than the graph size, and scores
+    // approach the exact values as epsilon shrinks. Columns "node_id" and "score",
+    // best `top_k` first. INVALID_ARGUMENT without sources, for alpha outside
+    // (0, 1), or for epsilon <= 0.
+    util::expected<QueryResult, storage::Error> personalized_pagerank(const std::vector<storage::NodeId>& source_ids,
+                                                                      double alpha = 0.15, double epsilon = 1e-4,
+                                                                      size_t top_k = 10);
+    // Documents whose text best matches `content_snippet` by BM25 over the
+    // index manager's text index, excluding the document's existing outlinks.
+    // Reason "text_match:<score>"; without a text index or any matching term,
+    // falls back to adjacent documents with reason "related_document".
     util::expected<QueryResult, storage::Error> suggest_links_for_document(storage::NodeId document_id, const std::string& content_snippet);
 
 private:
+    static constexpr size_t MAX_LINK_SUGGESTIONS = 10;
+    static constexpr double PROXIMITY_WEIGHT = 0.5;
+    // BLENDED draws this many semantic candidates per result before re-ranking
+    static constexpr size_t BLENDED_CANDIDATE_FACTOR = 4;
+
     std::shared_ptr<storage::GraphStore> graph_store_;
     std::shared_ptr<storage::SimpleIndexManager> index_manager_;
 
@@ -80,12 +164,19 @@ private:
     
     // Helper methods
     std::string property_value_to_string(const storage::PropertyValue& value);
+    util::expected<QueryResult, storage::Error> find_documents_sharing_neighbors(storage::NodeId document_id,
+                                                                                 size_t max_results);
+    // Whether `node_id` is still visible; index postings may be stale
+    bool node_exists(storage::NodeId node_id);
     QueryResult node_to_result(const storage::NodeRecord& node, const std::vector<storage::Property>& properties);
     QueryResult edge_to_result(const storage::EdgeRecord& edge, const std::vector<storage::Property>& properties);
     
     // BFS for path finding
     std::vector<storage::NodeId> bfs_shortest_path(storage::NodeId from_node, storage::NodeId to_node);
-    std::vector<std::vector<storage::NodeId>> bfs_paths_with_length(storage::NodeId from_node, storage::NodeId to_node, size_t max_length);
+
+    // Landmarks for weighted path queries, built on request
+    std::mutex landmarks_mutex_;
+    std::shared_ptr<const LandmarkIndex> landmarks_;
 };
 
 // Simplified streaming interfaces (removing C++20 generator dependency)
@@ -1,40 +1,353 @@
 #include "planner.h"
+#include "cypher/expression_compiler.h"
+#include "cypher/expression_evaluator.h"
+#include "cypher/pattern_matcher.h"
+#include "../storage/simple_index_manager.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
 
 namespace loredb::query {
 
-std::unique_ptr<ExecutionPlan> Planner::create_plan(cypher::Query& query) {
-    std::shared_ptr<PhysicalOperator> plan = nullptr;
+namespace {
 
-    if (query.match.has_value()) {
-        plan = plan_match(query.match.value());
+// Assumed graph size when the planner has no store to ask
+constexpr double UNKNOWN_NODE_COUNT = 1000.0;
+
+const std::vector<cypher::PropertyRange> NO_RANGES;
+
+} // namespace
+
+Planner::Planner(std::shared_ptr<storage::GraphStore> graph_store,
+                 std::shared_ptr<storage::SimpleIndexManager> index_manager)
+    : graph_store_(std::move(graph_store)), index_manager_(std::move(index_manager)) {
+}
+
+std::unique_ptr<ExecutionPlan> Planner::create_plan(const cypher::Query& query) {
+    if (!query.match.has_value()) {
+        return nullptr;
+    }
+
+    layout_ = std::make_unique<SlotLayout>();
+    PredicateHints hints;
+    if (query.where.has_value() && query.where->condition) {
+        collect_hints(*query.where->condition, hints);
+    }
+
+    std::shared_ptr<PhysicalOperator> plan = plan_match(query.match.value(), hints);
+    if (!plan) {
+        return nullptr;
+    }
+
+    // A WHERE that folds to true (e.g. `1 = 1`) needs no filter at all
+    if (query.where.has_value() && query.where->condition &&
+        cypher::fold_predicate(*query.where->condition) != true) {
+        plan = std::make_shared<PhysicalFilter>(plan, query.where->condition.get(), layout_.get());
+    }
+
+    // Without ORDER BY the limit can be pushed into the pipeline so matching stops
+    // early; sorting needs every row first, so the executor applies it after ORDER BY
+    if (query.limit.has_value() && !query.order_by.has_value()) {
+        plan = std::make_shared<PhysicalLimit>(plan, static_cast<size_t>(std::max<int64_t>(0, query.limit->count)));
+    }
+
+    // RETURN and ORDER BY are applied by the executor on the plan's output
+    return std::make_unique<ExecutionPlan>(plan, std::move(layout_));
+}
+
+std::shared_ptr<PhysicalOperator> Planner::plan_match(const cypher::MatchClause& match_clause,
+                                                      const PredicateHints& hints) {
+    std::shared_ptr<PhysicalOperator> root;
+    std::unordered_set<std::string> bound;
+
+    // Later patterns see variables bound by earlier ones and join on them
+    for (const auto& pattern : match_clause.patterns) {
+        if (pattern.nodes.empty() || pattern.edges.size() + 1 != pattern.nodes.size()) {
+            continue;
+        }
+        root = plan_pattern(root, pattern, hints, bound);
+    }
+    return root;
+}
+
+std::shared_ptr<PhysicalOperator> Planner::plan_pattern(std::shared_ptr<PhysicalOperator> input,
+                                                        const cypher::Pattern& pattern,
+                                                        const PredicateHints& hints,
+                                                        std::unordered_set<std::string>& bound) {
+    const size_t n = pattern.nodes.size();
+
+    // Anonymous nodes still need a binding to expand through; the leading space
+    // keeps the generated names out of reach of user identifiers
+    std::vector<PlanVariable> vars(n);
+    std::vector<double> node_cards(n);
+    for (size_t i = 0; i < n; ++i) {
+        const auto& node = pattern.nodes[i];
+        vars[i].name = node.variable.value_or(" anon" + std::to_string(anonymous_counter_++));
+        vars[i].slot = layout_->add(vars[i].name);
+
+        if (bound.count(vars[i].name)) {
+            node_cards[i] = 1.0;
+            continue;
+        }
+        const auto* ranges = hinted_ranges(hints, node);
+        auto hint = node.variable.has_value() ? hints.equalities.find(*node.variable) : hints.equalities.end();
+        if (hint == hints.equalities.end()) {
+            node_cards[i] = estimate_node_cardinality(node, ranges ? *ranges : NO_RANGES);
+        } else {
+            cypher::Node with_hints = node;
+            with_hints.properties.insert(hint->second.begin(), hint->second.end());
+            node_cards[i] = estimate_node_cardinality(with_hints, ranges ? *ranges : NO_RANGES);
+        }
+    }
+
+    std::vector<double> expand_factors(pattern.edges.size());
+    std::vector<PlanVariable> edge_vars(pattern.edges.size());
+    for (size_t j = 0; j < pattern.edges.size(); ++j) {
+        const auto& edge = pattern.edges[j];
+        expand_factors[j] = estimate_expand_factor(edge);
+        if (edge.variable.has_value()) {
+            edge_vars[j] = PlanVariable{*edge.variable, layout_->add(*edge.variable)};
+        }
+    }
+
+    const size_t anchor = choose_anchor(node_cards, expand_factors);
+
+    auto make_expand = [&](std::shared_ptr<PhysicalOperator> in, size_t from, size_t edge_index, size_t to,
+                           ExpandDirection direction) -> std::shared_ptr<PhysicalOperator> {
+        const auto& edge = pattern.edges[edge_index];
+        if (edge.min_hops != 1 || edge.max_hops != 1) {
+            return std::make_shared<PhysicalVarLengthExpand>(std::move(in), vars[from], edge, edge_vars[edge_index],
+                                                             vars[to], pattern.nodes[to], direction);
+        }
+        return std::make_shared<PhysicalExpand>(std::move(in), vars[from], edge, edge_vars[edge_index],
+                                                vars[to], pattern.nodes[to], direction);
+    };
+
+    // A leaf anchor with indexed equality constraints (one composite probe for
+    // the keys a composite index covers) or range-indexed WHERE bounds becomes an
+    // index seek
+    std::vector<std::string> index_keys;
+    std::vector<std::string> composite_keys;
+    std::vector<cypher::PropertyRange> index_ranges;
+    if (!input) {
+        composite_keys = cypher::composite_constraint_keys(pattern.nodes[anchor], index_manager_.get());
+        for (auto& key : cypher::indexed_constraint_keys(pattern.nodes[anchor], index_manager_.get())) {
+            if (std::find(composite_keys.begin(), composite_keys.end(), key) == composite_keys.end()) {
+                index_keys.push_back(std::move(key));
+            }
+        }
+        if (const auto* ranges = hinted_ranges(hints, pattern.nodes[anchor]); ranges && index_manager_) {
+            std::copy_if(ranges->begin(), ranges->end(), std::back_inserter(index_ranges),
+                         [&](const cypher::PropertyRange& range) {
+                             return index_manager_->has_node_range_index(range.key) &&
+                                    index_manager_->is_index_ready(
+                                        storage::SimpleIndexManager::range_index_name(range.key));
+                         });
+        }
+    }
+    std::shared_ptr<PhysicalOperator> root = std::make_shared<PhysicalScan>(
+        std::move(input), vars[anchor], pattern.nodes[anchor], std::move(index_keys), std::move(index_ranges),
+        std::move(composite_keys));
+    bound.insert(vars[anchor].name);
+
+    // Walk right along the pattern as written...
+    for (size_t j = anchor; j + 1 < n; ++j) {
+        const auto& edge = pattern.edges[j];
+        root = make_expand(root, j, j, j + 1, edge.directed ? ExpandDirection::OUTGOING : ExpandDirection::BOTH);
+        bound.insert(vars[j + 1].name);
+    }
+    // ...then left, following each edge against its written direction
+    for (size_t j = anchor; j > 0; --j) {
+        const auto& edge = pattern.edges[j - 1];
+        root = make_expand(root, j, j - 1, j - 1, edge.directed ? ExpandDirection::INCOMING : ExpandDirection::BOTH);
+        bound.insert(vars[j - 1].name);
+    }
+    for (const auto& edge : pattern.edges) {
+        if (edge.variable.has_value()) {
+            bound.insert(*edge.variable);
+        }
+    }
+
+    return root;
+}
+
+size_t Planner::choose_anchor(const std::vector<double>& node_cards,
+                              const std::vector<double>& expand_factors) const {
+    const double total_nodes = node_count();
+    const size_t n = node_cards.size();
+
+    // Cost = total intermediate rows produced when starting at node i; a node's
+    // constraints pass cards[k] / total_nodes of the rows that reach it
+    size_t best = 0;
+    double best_cost = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < n; ++i) {
+        double rows = node_cards[i];
+        double cost = rows;
+        for (size_t j = i; j + 1 < n; ++j) {
+            rows *= expand_factors[j] * (node_cards[j + 1] / total_nodes);
+            cost += rows;
+        }
+        for (size_t j = i; j > 0; --j) {
+            rows *= expand_factors[j - 1] * (node_cards[j - 1] / total_nodes);
+            cost += rows;
+        }
+        // Strict comparison keeps the leftmost node on ties
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = i;
+        }
+    }
+    return best;
+}
+
+double Planner::estimate_node_cardinality(const cypher::Node& node,
+                                          const std::vector<cypher::PropertyRange>& ranges) const {
+    const double total_nodes = node_count();
+    double indexed = total_nodes;
+    double unindexed_selectivity = 1.0;
+
+    // Label postings are exact counts (a label never interned matches nothing)
+    if (graph_store_) {
+        for (const auto& label : node.labels) {
+            auto label_id = graph_store_->label_dictionary().find(label);
+            indexed = std::min(indexed, label_id.has_value()
+                ? static_cast<double>(graph_store_->count_nodes_by_label(*label_id))
+                : 0.0);
+        }
     }
 
-    if (plan && query.where.has_value()) {
-        plan = std::make_shared<PhysicalFilter>(plan, query.where.value().condition.release());
+    for (const auto& [key, value] : node.properties) {
+        if (index_manager_ && std::holds_alternative<std::string>(value)) {
+            // Declared indexes post every value, so the posting count is an upper bound
+            // even when it is zero; otherwise any postings found are still a useful hint.
+            // Postings of an index still being built are neither.
+            size_t postings = index_manager_->count_nodes_by_property(key, std::get<std::string>(value));
+            if ((postings > 0 || index_manager_->has_node_property_index(key)) &&
+                index_manager_->is_index_ready(storage::SimpleIndexManager::property_index_name(key))) {
+                indexed = std::min(indexed, static_cast<double>(postings));
+                continue;
+            }
+        }
+        unindexed_selectivity *= DEFAULT_EQUALITY_SELECTIVITY;
+    }
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        unindexed_selectivity *= DEFAULT_RANGE_SELECTIVITY;
     }
 
-    // TODO: Add planning for RETURN, ORDER BY, LIMIT etc.
+    return std::max(1.0, indexed * unindexed_selectivity);
+}
+
+double Planner::estimate_expand_factor(const cypher::Edge& edge) const {
+    double degree = graph_store_
+        ? static_cast<double>(graph_store_->get_edge_count()) / node_count()
+        : 1.0;
+    if (!edge.directed) {
+        degree *= 2.0;
+    }
+    if (graph_store_ && !edge.types.empty()) {
+        // Share of edges that can have one of the types; unlabeled edges may via their "type" property
+        double typed = static_cast<double>(graph_store_->count_edges_by_label(storage::NO_LABEL));
+        for (const auto& type : edge.types) {
+            if (auto type_id = graph_store_->label_dictionary().find(type); type_id.has_value()) {
+                typed += static_cast<double>(graph_store_->count_edges_by_label(*type_id));
+            }
+        }
+        degree *= typed / std::max(1.0, static_cast<double>(graph_store_->get_edge_count()));
+    }
+    for (size_t i = 0; i < edge.properties.size(); ++i) {
+        degree *= DEFAULT_EQUALITY_SELECTIVITY;
+    }
 
-    if (plan) {
-        return std::make_unique<ExecutionPlan>(plan);
+    if (edge.min_hops == 1 && edge.max_hops == 1) {
+        return degree;
     }
 
-    return nullptr;
+    // Variable-length: sum the frontier sizes over the allowed hop range
+    const int max_hops = edge.max_hops == -1 ? PhysicalVarLengthExpand::DEFAULT_MAX_HOPS : edge.max_hops;
+    double factor = 0.0;
+    double frontier = 1.0;
+    for (int h = 0; h <= max_hops; ++h) {
+        if (h >= edge.min_hops) {
+            factor += frontier;
+        }
+        frontier *= degree;
+    }
+    return factor;
 }
 
-std::shared_ptr<PhysicalOperator> Planner::plan_match(const cypher::MatchClause& match_clause) {
-    // This is a very simplified planner. It only handles a single node pattern.
-    if (match_clause.patterns.empty() || match_clause.patterns[0].nodes.empty()) {
+const std::vector<cypher::PropertyRange>* Planner::hinted_ranges(const PredicateHints& hints,
+                                                                 const cypher::Node& node) {
+    if (!node.variable.has_value()) {
         return nullptr;
     }
+    auto it = hints.ranges.find(*node.variable);
+    return it == hints.ranges.end() ? nullptr : &it->second;
+}
+
+double Planner::node_count() const {
+    if (!graph_store_) {
+        return UNKNOWN_NODE_COUNT;
+    }
+    return std::max(1.0, static_cast<double>(graph_store_->get_node_count()));
+}
+
+void Planner::collect_hints(const cypher::Expression& expr, PredicateHints& hints) {
+    switch (expr.type()) {
+        case cypher::ExpressionType::LOGICAL_AND: {
+            const auto& and_expr = std::get<cypher::LogicalAnd>(expr.content);
+            collect_hints(*and_expr.left, hints);
+            collect_hints(*and_expr.right, hints);
+            break;
+        }
+        case cypher::ExpressionType::COMPARISON: {
+            const auto& comp = std::get<cypher::Comparison>(expr.content);
+            const cypher::Expression* access = comp.left.get();
+            const cypher::Expression* literal = comp.right.get();
+            auto op = comp.op;
+            if (access->type() != cypher::ExpressionType::PROPERTY_ACCESS) {
+                // `literal op n.key` bounds n.key from the other side
+                std::swap(access, literal);
+                switch (op) {
+                    case cypher::ComparisonOperator::LESS_THAN: op = cypher::ComparisonOperator::GREATER_THAN; break;
+                    case cypher::ComparisonOperator::LESS_EQUAL: op = cypher::ComparisonOperator::GREATER_EQUAL; break;
+                    case cypher::ComparisonOperator::GREATER_THAN: op = cypher::ComparisonOperator::LESS_THAN; break;
+                    case cypher::ComparisonOperator::GREATER_EQUAL: op = cypher::ComparisonOperator::LESS_EQUAL; break;
+                    default: break;
+                }
+            }
+            if (access->type() != cypher::ExpressionType::PROPERTY_ACCESS ||
+                literal->type() != cypher::ExpressionType::LITERAL) {
+                break;
+            }
+            const auto& pa = std::get<cypher::PropertyAccess>(access->content);
+            const auto& value = std::get<cypher::Literal>(literal->content).value;
+            if (op == cypher::ComparisonOperator::EQUAL) {
+                hints.equalities[pa.entity][pa.property] = value;
+                break;
+            }
 
-    const auto& node_pattern = match_clause.patterns[0].nodes[0];
-    std::optional<std::string> label;
-    if (!node_pattern.labels.empty()) {
-        label = node_pattern.labels[0];
+            const bool upper = op == cypher::ComparisonOperator::LESS_THAN ||
+                               op == cypher::ComparisonOperator::LESS_EQUAL;
+            if (!upper && op != cypher::ComparisonOperator::GREATER_THAN &&
+                op != cypher::ComparisonOperator::GREATER_EQUAL) {
+                break;
+            }
+            auto& ranges = hints.ranges[pa.entity];
+            auto range = std::find_if(ranges.begin(), ranges.end(),
+                                      [&](const cypher::PropertyRange& r) { return r.key == pa.property; });
+            if (range == ranges.end()) {
+                range = ranges.insert(ranges.end(), cypher::PropertyRange{pa.property, std::nullopt, std::nullopt});
+            }
+            // Any one bound per side is a valid superset; keep the first seen
+            auto& bound = upper ? range->upper : range->lower;
+            if (!bound.has_value()) {
+                bound = cypher::to_storage_value(value);
+            }
+            break;
+        }
+        default:
+            break;
     }
-    
-    return std::make_shared<PhysicalScan>(node_pattern.variable.value_or(""), label);
 }
 
-} // namespace loredb::query 
\ No newline at end of file
+} // namespace loredb::query
@@ -1,20 +1,78 @@
 #pragma once
 
 #include "cypher/ast.h"
+#include "cypher/pattern_matcher.h"
 #include "execution_plan.h"
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace loredb::storage {
+    class SimpleIndexManager;
+}
 
 namespace loredb::query {
 
+/**
+ * @class Planner
+ * @brief Cost-based planner turning MATCH/WHERE into a tree of physical operators.
+ *
+ * Each pattern is anchored at the node with the lowest estimated cardinality and
+ * expanded outwards in both directions from there, so selective endpoints (e.g.
+ * `(b {title: 'X'})`) drive the traversal instead of a full scan of the first node.
+ * Estimates come from graph-level counts, property-index postings when available,
+ * and fixed selectivities for everything else. Every variable (including the
+ * generated names of anonymous nodes) is assigned a row slot while planning.
+ */
 class Planner {
 public:
+    // Selectivity assumed for an equality constraint with no index statistics
+    static constexpr double DEFAULT_EQUALITY_SELECTIVITY = 0.1;
+    // Selectivity assumed for a property bounded by WHERE range comparisons
+    static constexpr double DEFAULT_RANGE_SELECTIVITY = 0.3;
+
     Planner() = default;
+    Planner(std::shared_ptr<storage::GraphStore> graph_store,
+            std::shared_ptr<storage::SimpleIndexManager> index_manager);
+
+    // Plans MATCH (+ WHERE, + LIMIT when no ORDER BY). Returns nullptr for queries without a MATCH clause.
+    // The plan borrows expressions from `query`, which must outlive it.
+    std::unique_ptr<ExecutionPlan> create_plan(const cypher::Query& query);
 
-    std::unique_ptr<ExecutionPlan> create_plan(cypher::Query& query);
+    // Estimated number of nodes matching `node` whose properties also satisfy `ranges` (at least 1)
+    double estimate_node_cardinality(const cypher::Node& node,
+                                     const std::vector<cypher::PropertyRange>& ranges = {}) const;
 
 private:
-    std::shared_ptr<PhysicalOperator> plan_match(const cypher::MatchClause& match_clause);
-    // Add more helper methods for other clauses as needed
+    // Constraints per variable harvested from WHERE. Equalities only feed the
+    // estimates; ranges also drive range-index seeks. WHERE still filters every row.
+    struct PredicateHints {
+        std::unordered_map<std::string, cypher::PropertyMap> equalities;
+        std::unordered_map<std::string, std::vector<cypher::PropertyRange>> ranges;
+    };
+
+    std::shared_ptr<PhysicalOperator> plan_match(const cypher::MatchClause& match_clause,
+                                                 const PredicateHints& hints);
+    std::shared_ptr<PhysicalOperator> plan_pattern(std::shared_ptr<PhysicalOperator> input,
+                                                   const cypher::Pattern& pattern,
+                                                   const PredicateHints& hints,
+                                                   std::unordered_set<std::string>& bound);
+    size_t choose_anchor(const std::vector<double>& node_cards,
+                         const std::vector<double>& expand_factors) const;
+    double estimate_expand_factor(const cypher::Edge& edge) const;
+    double node_count() const;
+
+    static void collect_hints(const cypher::Expression& expr, PredicateHints& hints);
+    // WHERE ranges on `node`'s variable, or nullptr
+    static const std::vector<cypher::PropertyRange>* hinted_ranges(const PredicateHints& hints,
+                                                                   const cypher::Node& node);
+
+    std::shared_ptr<storage::GraphStore> graph_store_;
+    std::shared_ptr<storage::SimpleIndexManager> index_manager_;
+    // Slots of the plan being built; handed over to the ExecutionPlan
+    std::unique_ptr<SlotLayout> layout_;
+    size_t anonymous_counter_ = 0;
 };
 
-} // namespace loredb::query 
\ No newline at end of file
+} // namespace loredb::query
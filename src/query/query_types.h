@@ -3,11 +3,13 @@
 #include "../storage/graph_store.h"
 #include "../transaction/mvcc.h"
 #include "cypher/ast.h"
+#include <algorithm>
 #include <vector>
+#include <span>
 #include <string>
 #include <variant>
-#include <unordered_map>
 #include <memory>
+#include <optional>
 
 namespace loredb::storage {
     class SimpleIndexManager;
@@ -31,51 +33,131 @@ struct QueryResult {
     bool empty() const { return rows.empty(); }
 };
 
-// Variable binding during query execution
-struct VariableBinding {
-    enum class Type {
+// Marks a variable with no row slot (e.g. an unnamed edge)
+inline constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+
+// One column of a row: the node or edge a pattern variable is bound to
+struct Slot {
+    enum class Kind : uint8_t {
+        EMPTY,
         NODE,
-        EDGE,
-        LITERAL
+        EDGE
     };
-    
-    Type type;
-    uint64_t id_value;  // For NODE and EDGE types
-    cypher::PropertyValue literal_value;  // For LITERAL type
-    
-    VariableBinding() : type(Type::LITERAL), id_value(0), literal_value(std::string("")) {}
-    
-    VariableBinding(Type t, uint64_t id) : type(t), id_value(id), literal_value(std::string("")) {
-        if (t != Type::NODE && t != Type::EDGE) {
-            throw std::invalid_argument("Invalid type for ID constructor");
+
+    Kind kind = Kind::EMPTY;
+    uint64_t id = 0;
+
+    bool operator==(const Slot&) const = default;
+};
+
+// Maps pattern variables to row slots; resolved once at plan time
+class SlotLayout {
+public:
+    // Slot for `name`, allocating a new one the first time the name is seen
+    size_t add(const std::string& name) {
+        size_t slot = find(name);
+        if (slot != NO_SLOT) {
+            return slot;
         }
+        names_.push_back(name);
+        return names_.size() - 1;
     }
-    
-    VariableBinding(Type t, cypher::PropertyValue value) : type(t), id_value(0), literal_value(std::move(value)) {
-        if (t != Type::LITERAL) {
-            throw std::invalid_argument("Invalid type for literal constructor");
-        }
+
+    // Slot for `name`, or NO_SLOT when the variable is not part of the layout.
+    // Layouts hold a handful of names, so a linear scan beats hashing here.
+    size_t find(const std::string& name) const {
+        auto it = std::find(names_.begin(), names_.end(), name);
+        return it == names_.end() ? NO_SLOT : static_cast<size_t>(it - names_.begin());
     }
+
+    size_t size() const { return names_.size(); }
+    const std::vector<std::string>& names() const { return names_; }
+
+private:
+    std::vector<std::string> names_;
 };
 
-using VariableMap = std::unordered_map<std::string, VariableBinding>;
+using RowView = std::span<const Slot>;
 
-// Result row for intermediate processing
-struct ResultRow {
-    VariableMap bindings;
-    
-    ResultRow() = default;
-    explicit ResultRow(VariableMap vars) : bindings(std::move(vars)) {}
+/**
+ * @class ResultSet
+ * @brief Batch of rows stored row-major in one flat slot array.
+ *
+ * Every row has width() slots laid out as assigned by the plan's SlotLayout, so
+ * binding or reading a variable is an index into contiguous memory rather than a
+ * string lookup, and a batch costs one allocation however many rows it holds.
+ */
+class ResultSet {
+public:
+    ResultSet() = default;
+    explicit ResultSet(size_t width) : width_(width) {}
+
+    size_t width() const { return width_; }
+    size_t size() const { return rows_; }
+    bool empty() const { return rows_ == 0; }
+
+    // Drops all rows, keeping the width and the allocation
+    void clear() {
+        slots_.clear();
+        rows_ = 0;
+    }
+    // Drops all rows and switches to rows of `width` slots
+    void reset(size_t width) {
+        clear();
+        width_ = width;
+    }
+
+    std::span<Slot> operator[](size_t row) { return {slots_.data() + row * width_, width_}; }
+    RowView operator[](size_t row) const { return {slots_.data() + row * width_, width_}; }
+
+    // Appends a copy of `row` (which must not live in this batch) and returns the new row
+    std::span<Slot> append(RowView row) {
+        slots_.insert(slots_.end(), row.begin(), row.end());
+        return (*this)[rows_++];
+    }
+    // Appends a row with every slot empty and returns it
+    std::span<Slot> append_empty() {
+        slots_.resize(slots_.size() + width_);
+        return (*this)[rows_++];
+    }
+    // Appends every row of `other`, which must have the same width
+    void append_all(const ResultSet& other) {
+        slots_.insert(slots_.end(), other.slots_.begin(), other.slots_.end());
+        rows_ += other.rows_;
+    }
+
+    // Overwrites row `dst` with row `src`
+    void copy_row(size_t dst, size_t src) {
+        std::copy_n(slots_.begin() + src * width_, width_, slots_.begin() + dst * width_);
+    }
+    // Keeps only the first `rows` rows
+    void truncate(size_t rows) {
+        rows_ = std::min(rows_, rows);
+        slots_.resize(rows_ * width_);
+    }
+
+private:
+    size_t width_ = 0;
+    size_t rows_ = 0;
+    std::vector<Slot> slots_;
 };
 
-using ResultSet = std::vector<ResultRow>;
+// Index postings of property values a write replaced or deleted
+struct RetiredPostings {
+    storage::NodeId node_id;
+    std::vector<storage::Property> properties;
+    // Only postings involving this key; unset when the node itself was deleted
+    std::optional<std::string> changed;
+};
 
 // Execution context for a single query
 struct ExecutionContext {
     std::shared_ptr<storage::GraphStore> graph_store;
     std::shared_ptr<storage::SimpleIndexManager> index_manager;
     transaction::TransactionId tx_id;
-    VariableMap variables;
+    // Removed from the indexes once the transaction commits, so an abort keeps
+    // every posting its old values still need
+    std::vector<RetiredPostings> retired_postings;
     
     ExecutionContext(std::shared_ptr<storage::GraphStore> gs, 
                      std::shared_ptr<storage::SimpleIndexManager> im,
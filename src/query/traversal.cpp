@@ -0,0 +1,258 @@
+#include "traversal.h"
+#include <algorithm>
+#include <atomic>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+namespace loredb::query {
+
+namespace {
+
+using NodeLists = tbb::enumerable_thread_specific<std::vector<storage::NodeId>>;
+
+// The nodes found by every thread, ascending
+std::vector<storage::NodeId> gather(NodeLists& found) {
+    std::vector<storage::NodeId> nodes;
+    for (auto& local : found) {
+        nodes.insert(nodes.end(), local.begin(), local.end());
+    }
+    tbb::parallel_sort(nodes.begin(), nodes.end());
+    return nodes;
+}
+
+}  // namespace
+
+std::optional<size_t> BfsEngine::Result::depth_of(storage::NodeId node_id) const {
+    for (size_t depth = 0; depth < levels.size(); ++depth) {
+        if (std::binary_search(levels[depth].begin(), levels[depth].end(), node_id)) {
+            return depth;
+        }
+    }
+    return std::nullopt;
+}
+
+BfsEngine::BfsEngine(std::shared_ptr<storage::GraphStore> graph_store) : graph_store_(std::move(graph_store)) {
+}
+
+TraversalDirection BfsEngine::reverse(TraversalDirection direction) {
+    switch (direction) {
+        case TraversalDirection::OUTGOING:
+            return TraversalDirection::INCOMING;
+        case TraversalDirection::INCOMING:
+            return TraversalDirection::OUTGOING;
+        default:
+            return TraversalDirection::BOTH;
+    }
+}
+
+void BfsEngine::append_neighbors(storage::NodeId node_id, TraversalDirection direction,
+                                 std::vector<storage::NodeId>& neighbors) const {
+    if (direction != TraversalDirection::INCOMING) {
+        graph_store_->append_outgoing_neighbors(node_id, neighbors);
+    }
+    if (direction != TraversalDirection::OUTGOING) {
+        graph_store_->append_incoming_neighbors(node_id, neighbors);
+    }
+}
+
+BfsEngine::Result BfsEngine::run(const std::vector<storage::NodeId>& sources, const Options& options) const {
+    Result result;
+    const size_t id_limit = graph_store_->get_node_id_limit();
+    util::DenseBitmap visited(id_limit);
+
+    std::vector<storage::NodeId> frontier;
+    size_t frontier_edges = 0;
+    for (storage::NodeId source : sources) {
+        if (source < id_limit && visited.set(source)) {
+            frontier.push_back(source);
+            frontier_edges += graph_store_->get_degree(source);
+        }
+    }
+    std::sort(frontier.begin(), frontier.end());
+    if (frontier.empty()) {
+        return result;
+    }
+    result.levels.push_back(frontier);
+
+    // Each edge is counted from both of its ends
+    const size_t edge_ends = 2 * graph_store_->get_edge_count();
+    size_t unexplored_edges = edge_ends - std::min(edge_ends, frontier_edges);
+    const double node_count = static_cast<double>(std::max<size_t>(1, graph_store_->get_node_count()));
+    bool bottom_up = false;
+
+    for (size_t depth = 1; depth <= options.max_depth; ++depth) {
+        if (options.target.has_value() && visited.test(*options.target)) {
+            break;
+        }
+        if (!bottom_up) {
+            bottom_up = static_cast<double>(frontier_edges) > static_cast<double>(unexplored_edges) / TOP_DOWN_ALPHA;
+        } else {
+            bottom_up = static_cast<double>(frontier.size()) >= node_count / BOTTOM_UP_BETA;
+        }
+
+        size_t next_edges = 0;
+        std::vector<storage::NodeId> next;
+        if (bottom_up) {
+            util::DenseBitmap frontier_bits(id_limit);
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, frontier.size(), GRAIN_SIZE),
+                              [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i != range.end(); ++i) {
+                    frontier_bits.set_atomic(frontier[i]);
+                }
+            });
+            next = bottom_up_step(frontier_bits, options.direction, visited, next_edges);
+            ++result.bottom_up_steps;
+        } else {
+            next = top_down_step(frontier, options.direction, visited, next_edges);
+        }
+        if (next.empty()) {
+            break;
+        }
+        unexplored_edges -= std::min(unexplored_edges, next_edges);
+        frontier_edges = next_edges;
+        result.levels.push_back(next);
+        frontier = std::move(next);
+    }
+    return result;
+}
+
+std::vector<storage::NodeId> BfsEngine::top_down_step(const std::vector<storage::NodeId>& frontier,
+                                                      TraversalDirection direction, util::DenseBitmap& visited,
+                                                      size_t& frontier_edges) const {
+    NodeLists found;
+    std::atomic<size_t> edges{0};
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, frontier.size(), GRAIN_SIZE),
+                      [&](const tbb::blocked_range<size_t>& range) {
+        auto& local = found.local();
+        std::vector<storage::NodeId> neighbors;
+        size_t local_edges = 0;
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            neighbors.clear();
+            append_neighbors(frontier[i], direction, neighbors);
+            for (storage::NodeId neighbor : neighbors) {
+                if (neighbor < visited.size() && visited.set_atomic(neighbor)) {
+                    local.push_back(neighbor);
+                    local_edges += graph_store_->get_degree(neighbor);
+                }
+            }
+        }
+        edges.fetch_add(local_edges, std::memory_order_relaxed);
+    });
+    frontier_edges = edges.load();
+    return gather(found);
+}
+
+std::vector<storage::NodeId> BfsEngine::bottom_up_step(const util::DenseBitmap& frontier,
+                                                       TraversalDirection direction, util::DenseBitmap& visited,
+                                                       size_t& frontier_edges) const {
+    const TraversalDirection parents_direction = reverse(direction);
+    const size_t id_limit = visited.size();
+    const size_t words = (id_limit + 63) / 64;
+    NodeLists found;
+    std::atomic<size_t> edges{0};
+    // Tasks own whole words of `visited`, so they update it without atomics
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, words, GRAIN_SIZE), [&](const tbb::blocked_range<size_t>& range) {
+        auto& local = found.local();
+        std::vector<storage::NodeId> parents;
+        size_t local_edges = 0;
+        const storage::NodeId end = std::min<storage::NodeId>(id_limit, range.end() * 64);
+        for (storage::NodeId node_id = range.begin() * 64; node_id < end; ++node_id) {
+            if (visited.test(node_id)) {
+                continue;
+            }
+            parents.clear();
+            append_neighbors(node_id, parents_direction, parents);
+            for (storage::NodeId parent : parents) {
+                if (frontier.test(parent)) {
+                    visited.set(node_id);
+                    local.push_back(node_id);
+                    local_edges += graph_store_->get_degree(node_id);
+                    break;
+                }
+            }
+        }
+        edges.fetch_add(local_edges, std::memory_order_relaxed);
+    });
+    frontier_edges = edges.load();
+    return gather(found);
+}
+
+void PathEnumerator::reset(storage::NodeId start) {
+    clear();
+    nodes_.push_back(start);
+    started_ = false;
+}
+
+void PathEnumerator::clear() {
+    nodes_.clear();
+    edges_.clear();
+    frames_.clear();
+    steps_.clear();
+    started_ = true;
+}
+
+bool PathEnumerator::next(const ExpandFn& expand) {
+    if (!started_ && !nodes_.empty()) {
+        started_ = true;
+        expand_last(expand);
+        if (reportable()) {
+            return true;
+        }
+    }
+    while (!nodes_.empty()) {
+        // The last node is a leaf, or all its steps have been tried
+        if (frames_.size() < nodes_.size()) {
+            pop();
+            continue;
+        }
+        if (steps_.size() == frames_.back().begin) {
+            frames_.pop_back();
+            pop();
+            continue;
+        }
+        const Step step = steps_.back();
+        steps_.pop_back();
+        if (!admissible(step)) {
+            continue;
+        }
+        edges_.push_back(step.first);
+        nodes_.push_back(step.second);
+        expand_last(expand);
+        if (reportable()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PathEnumerator::admissible(const Step& step) const {
+    if (options_.uniqueness == Uniqueness::EDGES) {
+        return std::find(edges_.begin(), edges_.end(), step.first) == edges_.end();
+    }
+    return std::find(nodes_.begin(), nodes_.end(), step.second) == nodes_.end();
+}
+
+bool PathEnumerator::reportable() const {
+    return hops() >= options_.min_hops && (!options_.target.has_value() || nodes_.back() == *options_.target);
+}
+
+void PathEnumerator::expand_last(const ExpandFn& expand) {
+    if (hops() >= options_.max_hops || (hops() > 0 && options_.target == nodes_.back())) {
+        return;
+    }
+    const size_t begin = steps_.size();
+    expand(nodes_.back(), steps_);
+    std::reverse(steps_.begin() + static_cast<std::ptrdiff_t>(begin), steps_.end());
+    frames_.push_back({begin});
+}
+
+void PathEnumerator::pop() {
+    nodes_.pop_back();
+    if (!edges_.empty()) {
+        edges_.pop_back();
+    }
+}
+
+}  // namespace loredb::query
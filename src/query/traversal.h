@@ -0,0 +1,160 @@
+/// \file traversal.h
+/// \brief Direction-optimizing parallel BFS and prefix-sharing path enumeration over the graph store.
+/// \author LoreDB contributors
+/// \ingroup query
+#pragma once
+
+#include "../storage/graph_store.h"
+#include "../util/dense_bitmap.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace loredb::query {
+
+enum class TraversalDirection {
+    OUTGOING,  // Along edges
+    INCOMING,  // Against edges
+    BOTH       // Ignoring edge direction
+};
+
+/**
+ * @class BfsEngine
+ * @brief Level-synchronous BFS that switches between top-down and bottom-up steps.
+ *
+ * Visited nodes and the frontier are bitmaps over the node id space. A
+ * top-down step expands every frontier node in parallel and claims unvisited
+ * neighbours with an atomic bit set. Once the frontier's edges outnumber the
+ * unexplored edges by more than TOP_DOWN_ALPHA, a bottom-up step runs
+ * instead: every unvisited node looks for a parent in the frontier and stops
+ * at the first one, each task owning a disjoint run of bitmap words. The
+ * search returns to top-down once the frontier falls below 1 / BOTTOM_UP_BETA
+ * of the nodes (Beamer, Asanović and Patterson). Frontier degrees count edges
+ * in both directions.
+ *
+ * Adjacency is read from the GraphStore lists under their shared lock, so
+ * traversals see edges as they are while they run. Nodes created after a
+ * traversal starts are not visited.
+ */
+class BfsEngine {
+public:
+    static constexpr double TOP_DOWN_ALPHA = 14.0;
+    static constexpr double BOTTOM_UP_BETA = 24.0;
+    // Frontier nodes (top-down) or bitmap words (bottom-up) per parallel task
+    static constexpr size_t GRAIN_SIZE = 64;
+
+    struct Options {
+        TraversalDirection direction = TraversalDirection::OUTGOING;
+        // Deepest level to visit
+        size_t max_depth = SIZE_MAX;
+        // Stop after the level that reaches this node
+        std::optional<storage::NodeId> target;
+    };
+
+    struct Result {
+        // levels[d] holds the nodes first reached after d hops, ascending;
+        // levels[0] holds the sources
+        std::vector<std::vector<storage::NodeId>> levels;
+        // How many levels were expanded bottom-up
+        size_t bottom_up_steps = 0;
+
+        // Hops to `node_id`, if it was reached
+        std::optional<size_t> depth_of(storage::NodeId node_id) const;
+    };
+
+    explicit BfsEngine(std::shared_ptr<storage::GraphStore> graph_store);
+
+    Result run(const std::vector<storage::NodeId>& sources, const Options& options) const;
+
+private:
+    // Appends the neighbours of `node_id` reached by following `direction`
+    void append_neighbors(storage::NodeId node_id, TraversalDirection direction,
+                          std::vector<storage::NodeId>& neighbors) const;
+    static TraversalDirection reverse(TraversalDirection direction);
+
+    // One step each way; both return the next frontier, ascending, and add the
+    // degrees of its nodes to `frontier_edges`
+    std::vector<storage::NodeId> top_down_step(const std::vector<storage::NodeId>& frontier,
+                                               TraversalDirection direction, util::DenseBitmap& visited,
+                                               size_t& frontier_edges) const;
+    std::vector<storage::NodeId> bottom_up_step(const util::DenseBitmap& frontier, TraversalDirection direction,
+                                                util::DenseBitmap& visited, size_t& frontier_edges) const;
+
+    std::shared_ptr<storage::GraphStore> graph_store_;
+};
+
+/**
+ * @class PathEnumerator
+ * @brief Streams the paths from one start node, depth first, one at a time.
+ *
+ * The enumerator keeps a single path and backtracks over it: memory is the
+ * path plus the pending neighbours of each node on it, whatever the number of
+ * paths. Each next() call extends or backtracks to the following path and
+ * returns, so a consumer can stop or pause between paths. Paths are reported
+ * in depth-first pre-order, a path before its extensions.
+ *
+ * Limits are applied while walking rather than to finished paths: nothing is
+ * expanded beyond max_hops, a path that would repeat a node (or an edge) is
+ * never built, and a path reaching the target is not extended further. Edge
+ * types and other per-edge filters belong in the expand function.
+ */
+class PathEnumerator {
+public:
+    enum class Uniqueness {
+        NODES,  // No node twice on a path
+        EDGES   // No edge twice on a path; nodes may repeat
+    };
+
+    // An edge and the node it leads to
+    using Step = std::pair<storage::EdgeId, storage::NodeId>;
+    // Appends the steps that may extend a path ending at the node
+    using ExpandFn = std::function<void(storage::NodeId, std::vector<Step>&)>;
+
+    struct Options {
+        size_t min_hops = 1;
+        size_t max_hops = 1;
+        Uniqueness uniqueness = Uniqueness::NODES;
+        // Only report paths ending here, and do not extend past it
+        std::optional<storage::NodeId> target;
+    };
+
+    explicit PathEnumerator(Options options) : options_(std::move(options)) {}
+
+    // Starts over from `start`
+    void reset(storage::NodeId start);
+    // Drops the current start; next() reports nothing until reset()
+    void clear();
+    // Moves to the next path, calling `expand` for nodes that may be
+    // extended; false once every path has been reported
+    bool next(const ExpandFn& expand);
+
+    // The current path: hops() + 1 nodes and hops() edges
+    const std::vector<storage::NodeId>& nodes() const { return nodes_; }
+    const std::vector<storage::EdgeId>& edges() const { return edges_; }
+    size_t hops() const { return edges_.size(); }
+
+private:
+    // The steps still to try from nodes_[i] are steps_[begin, next frame's
+    // begin), stored reversed so they are taken from the back
+    struct Frame {
+        size_t begin;
+    };
+
+    bool admissible(const Step& step) const;
+    bool reportable() const;
+    // Pushes a frame for the last node if the path may grow past it
+    void expand_last(const ExpandFn& expand);
+    // Drops the last node (and edge) of the path
+    void pop();
+
+    Options options_;
+    std::vector<storage::NodeId> nodes_;
+    std::vector<storage::EdgeId> edges_;
+    std::vector<Frame> frames_;
+    std::vector<Step> steps_;
+    bool started_ = false;
+};
+
+}  // namespace loredb::query
@@ -0,0 +1,306 @@
+#include "weighted_path.h"
+#include "../util/pairing_heap.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace loredb::query {
+
+namespace {
+
+using Queue = util::PairingHeap<double, storage::NodeId>;
+using EdgeList = std::vector<std::pair<storage::EdgeId, storage::NodeId>>;
+
+// A node's best known distance from the search's origin and how it was reached
+struct Label {
+    double distance = WeightedPathFinder::UNREACHABLE;
+    storage::NodeId parent = 0;
+    storage::EdgeId edge = 0;
+    Queue::Handle handle = 0;
+    bool settled = false;
+};
+
+struct Search {
+    std::unordered_map<storage::NodeId, Label> labels;
+    Queue queue;
+
+    void start(storage::NodeId node_id) {
+        Label& label = labels[node_id];
+        label.distance = 0.0;
+        label.handle = queue.push(0.0, node_id);
+    }
+
+    // Records a path of `distance` to `node_id` through `edge` from `parent`,
+    // queued under `distance + bound`; false if it is no shorter
+    bool relax(storage::NodeId node_id, storage::NodeId parent, storage::EdgeId edge, double distance, double bound) {
+        auto [it, inserted] = labels.try_emplace(node_id);
+        Label& label = it->second;
+        if (label.settled || distance >= label.distance) {
+            return false;
+        }
+        if (inserted) {
+            label.handle = queue.push(distance + bound, node_id);
+        } else {
+            queue.decrease_key(label.handle, distance + bound);
+        }
+        label.distance = distance;
+        label.parent = parent;
+        label.edge = edge;
+        return true;
+    }
+
+    double distance(storage::NodeId node_id) const {
+        auto it = labels.find(node_id);
+        return it == labels.end() ? WeightedPathFinder::UNREACHABLE : it->second.distance;
+    }
+
+    // Appends the path from `node_id` back to the search's origin
+    void trace(storage::NodeId node_id, std::vector<storage::NodeId>& nodes, std::vector<storage::EdgeId>& edges,
+               storage::NodeId origin) const {
+        while (node_id != origin) {
+            const Label& label = labels.at(node_id);
+            edges.push_back(label.edge);
+            nodes.push_back(label.parent);
+            node_id = label.parent;
+        }
+    }
+};
+
+}  // namespace
+
+WeightedPathFinder::WeightedPathFinder(std::shared_ptr<storage::GraphStore> graph_store,
+                                       const std::string& weight_key)
+    : graph_store_(std::move(graph_store)), weight_key_(weight_key), key_(storage::PropertyKey::find(weight_key)) {
+}
+
+util::expected<double, storage::Error> WeightedPathFinder::edge_weight(storage::EdgeId edge_id) const {
+    if (!key_.has_value()) {
+        return DEFAULT_WEIGHT;
+    }
+    auto value = graph_store_->get_edge_property(edge_id, *key_);
+    if (!value.has_value()) {
+        return util::unexpected(value.error());
+    }
+    if (!value.value().has_value()) {
+        return DEFAULT_WEIGHT;
+    }
+
+    double weight = std::numeric_limits<double>::quiet_NaN();
+    if (const auto* number = std::get_if<double>(&*value.value())) {
+        weight = *number;
+    } else if (const auto* integer = std::get_if<int64_t>(&*value.value())) {
+        weight = static_cast<double>(*integer);
+    }
+    if (!(weight >= 0.0)) {
+        return util::unexpected(storage::Error{storage::ErrorCode::INVALID_ARGUMENT,
+                                               "Edge " + std::to_string(edge_id) + " has no usable '" + weight_key_ +
+                                                   "' weight; weights must be non-negative numbers"});
+    }
+    return weight;
+}
+
+void WeightedPathFinder::append_edges(storage::NodeId node_id, EdgeList& edges) const {
+    graph_store_->append_outgoing_adjacency(node_id, edges);
+    graph_store_->append_incoming_adjacency(node_id, edges);
+}
+
+util::expected<WeightedPathFinder::Result, storage::Error> WeightedPathFinder::find(storage::NodeId from_node,
+                                                                                     storage::NodeId to_node) const {
+    Result result;
+    Search forward;
+    Search backward;
+    forward.start(from_node);
+    backward.start(to_node);
+
+    // Shortest path seen so far, as the node where its two halves meet
+    double best = from_node == to_node ? 0.0 : UNREACHABLE;
+    storage::NodeId meet = from_node;
+    EdgeList edges;
+
+    while (!forward.queue.empty() && !backward.queue.empty() &&
+           forward.queue.top_key() + backward.queue.top_key() < best) {
+        const bool grow_forward = forward.queue.size() <= backward.queue.size();
+        Search& side = grow_forward ? forward : backward;
+        const Search& other = grow_forward ? backward : forward;
+
+        const storage::NodeId node_id = side.queue.top_value();
+        side.queue.pop();
+        Label& label = side.labels.at(node_id);
+        label.settled = true;
+        const double distance = label.distance;
+        ++result.settled;
+
+        edges.clear();
+        append_edges(node_id, edges);
+        for (const auto& [edge_id, neighbor] : edges) {
+            auto weight = edge_weight(edge_id);
+            if (!weight.has_value()) {
+                return util::unexpected(weight.error());
+            }
+            const double candidate = distance + weight.value();
+            if (side.relax(neighbor, node_id, edge_id, candidate, 0.0) &&
+                candidate + other.distance(neighbor) < best) {
+                best = candidate + other.distance(neighbor);
+                meet = neighbor;
+            }
+        }
+    }
+
+    if (best == UNREACHABLE) {
+        return result;
+    }
+    result.total_weight = best;
+    result.nodes.push_back(meet);
+    forward.trace(meet, result.nodes, result.edges, from_node);
+    std::reverse(result.nodes.begin(), result.nodes.end());
+    std::reverse(result.edges.begin(), result.edges.end());
+    backward.trace(meet, result.nodes, result.edges, to_node);
+    return result;
+}
+
+util::expected<WeightedPathFinder::Result, storage::Error> WeightedPathFinder::find(
+    storage::NodeId from_node, storage::NodeId to_node, const LandmarkIndex& landmarks) const {
+    Result result;
+    Search search;
+    if (landmarks.lower_bound(from_node, to_node) == UNREACHABLE) {
+        return result;
+    }
+    search.start(from_node);
+
+    EdgeList edges;
+    while (!search.queue.empty()) {
+        const storage::NodeId node_id = search.queue.top_value();
+        search.queue.pop();
+        Label& label = search.labels.at(node_id);
+        label.settled = true;
+        const double distance = label.distance;
+        ++result.settled;
+
+        if (node_id == to_node) {
+            result.total_weight = distance;
+            result.nodes.push_back(to_node);
+            search.trace(to_node, result.nodes, result.edges, from_node);
+            std::reverse(result.nodes.begin(), result.nodes.end());
+            std::reverse(result.edges.begin(), result.edges.end());
+            return result;
+        }
+
+        edges.clear();
+        append_edges(node_id, edges);
+        for (const auto& [edge_id, neighbor] : edges) {
+            const double bound = landmarks.lower_bound(neighbor, to_node);
+            if (bound == UNREACHABLE) {
+                continue;
+            }
+            auto weight = edge_weight(edge_id);
+            if (!weight.has_value()) {
+                return util::unexpected(weight.error());
+            }
+            search.relax(neighbor, node_id, edge_id, distance + weight.value(), bound);
+        }
+    }
+    return result;
+}
+
+util::expected<std::vector<double>, storage::Error> WeightedPathFinder::distances_from(storage::NodeId source) const {
+    std::vector<double> distances(graph_store_->get_node_id_limit(), UNREACHABLE);
+    Search search;
+    search.start(source);
+
+    EdgeList edges;
+    while (!search.queue.empty()) {
+        const storage::NodeId node_id = search.queue.top_value();
+        search.queue.pop();
+        Label& label = search.labels.at(node_id);
+        label.settled = true;
+        const double distance = label.distance;
+        if (node_id < distances.size()) {
+            distances[node_id] = distance;
+        }
+
+        edges.clear();
+        append_edges(node_id, edges);
+        for (const auto& [edge_id, neighbor] : edges) {
+            auto weight = edge_weight(edge_id);
+            if (!weight.has_value()) {
+                return util::unexpected(weight.error());
+            }
+            search.relax(neighbor, node_id, edge_id, distance + weight.value(), 0.0);
+        }
+    }
+    return distances;
+}
+
+util::expected<LandmarkIndex, storage::Error> LandmarkIndex::build(const WeightedPathFinder& finder,
+                                                                  storage::GraphStore& graph_store,
+                                                                  size_t landmark_count) {
+    LandmarkIndex index;
+    index.weight_key_ = finder.weight_key();
+    // Read first, so an edge changed during the build marks the index stale
+    index.edge_version_ = graph_store.get_edge_version();
+    auto node_ids = graph_store.get_node_ids();
+    if (node_ids.empty()) {
+        return index;
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+
+    // Distance from each node to its nearest landmark; the first landmark is
+    // the node farthest from the lowest id
+    std::vector<double> nearest(graph_store.get_node_id_limit(), WeightedPathFinder::UNREACHABLE);
+    auto seed = finder.distances_from(node_ids.front());
+    if (!seed.has_value()) {
+        return util::unexpected(seed.error());
+    }
+    const auto farthest = [&](const std::vector<double>& distances) {
+        storage::NodeId pick = 0;
+        double pick_distance = 0.0;
+        for (storage::NodeId node_id : node_ids) {
+            const double distance = node_id < distances.size() ? distances[node_id] : WeightedPathFinder::UNREACHABLE;
+            if (distance > pick_distance) {
+                pick = node_id;
+                pick_distance = distance;
+            }
+        }
+        return pick;
+    };
+
+    storage::NodeId next = farthest(seed.value());
+    if (next == 0) {
+        next = node_ids.front();
+    }
+    while (next != 0 && index.landmarks_.size() < landmark_count) {
+        auto distances = finder.distances_from(next);
+        if (!distances.has_value()) {
+            return util::unexpected(distances.error());
+        }
+        for (size_t i = 0; i < std::min(nearest.size(), distances.value().size()); ++i) {
+            nearest[i] = std::min(nearest[i], distances.value()[i]);
+        }
+        index.landmarks_.push_back(next);
+        index.distances_.push_back(std::move(distances.value()));
+        // 0 once every node is a landmark
+        next = farthest(nearest);
+    }
+    return index;
+}
+
+double LandmarkIndex::lower_bound(storage::NodeId u, storage::NodeId v) const {
+    double bound = 0.0;
+    for (const auto& distances : distances_) {
+        if (u >= distances.size() || v >= distances.size()) {
+            continue;  // Created after the index was built
+        }
+        const double du = distances[u];
+        const double dv = distances[v];
+        if (du == WeightedPathFinder::UNREACHABLE || dv == WeightedPathFinder::UNREACHABLE) {
+            if (du != dv) {
+                return WeightedPathFinder::UNREACHABLE;
+            }
+            continue;
+        }
+        bound = std::max(bound, std::abs(du - dv));
+    }
+    return bound;
+}
+
+}  // namespace loredb::query
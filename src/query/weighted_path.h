@@ -0,0 +1,115 @@
+/// \file weighted_path.h
+/// \brief Weighted shortest paths by bidirectional Dijkstra or landmark-guided A*.
+/// \author LoreDB contributors
+/// \ingroup query
+#pragma once
+
+#include "../storage/graph_store.h"
+#include "../util/expected.h"
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace loredb::query {
+
+class LandmarkIndex;
+
+/**
+ * @class WeightedPathFinder
+ * @brief Least-weight paths where each edge costs the value of one numeric property.
+ *
+ * Like the unweighted path queries, paths follow edges in either direction.
+ * Weights are read with GraphStore::get_edge_property(), which steps over the
+ * edge's other properties without decoding them, and only for edges at nodes
+ * the search settles. An edge without the property costs DEFAULT_WEIGHT; a
+ * negative, NaN or non-numeric weight fails the search with INVALID_ARGUMENT.
+ *
+ * Without landmarks the search is a bidirectional Dijkstra that grows the
+ * smaller of the two queues and stops once their minimum keys add up to the
+ * best path seen. With a LandmarkIndex it is an A* search from the source,
+ * guided by the landmark lower bounds. Both queue nodes in a PairingHeap and
+ * lower their keys in place.
+ */
+class WeightedPathFinder {
+public:
+    static constexpr double DEFAULT_WEIGHT = 1.0;
+    static constexpr double UNREACHABLE = std::numeric_limits<double>::infinity();
+
+    struct Result {
+        std::vector<storage::NodeId> nodes;  // Source to target; empty without a path
+        std::vector<storage::EdgeId> edges;
+        double total_weight = UNREACHABLE;
+        // Nodes taken off the queues, a measure of the search's work
+        size_t settled = 0;
+
+        bool found() const { return !nodes.empty(); }
+    };
+
+    WeightedPathFinder(std::shared_ptr<storage::GraphStore> graph_store, const std::string& weight_key);
+
+    const std::string& weight_key() const { return weight_key_; }
+
+    util::expected<Result, storage::Error> find(storage::NodeId from_node, storage::NodeId to_node) const;
+    // A* search; `landmarks` must have been built for the same weight key
+    util::expected<Result, storage::Error> find(storage::NodeId from_node, storage::NodeId to_node,
+                                                const LandmarkIndex& landmarks) const;
+    // Distance from `source` to every node, indexed by node id below the
+    // store's id limit; UNREACHABLE where there is no path
+    util::expected<std::vector<double>, storage::Error> distances_from(storage::NodeId source) const;
+
+private:
+    util::expected<double, storage::Error> edge_weight(storage::EdgeId edge_id) const;
+    void append_edges(storage::NodeId node_id, std::vector<std::pair<storage::EdgeId, storage::NodeId>>& edges) const;
+
+    std::shared_ptr<storage::GraphStore> graph_store_;
+    std::string weight_key_;
+    // Unset if no property ever used the key, so every edge has the default weight
+    std::optional<storage::PropertyKey> key_;
+};
+
+/**
+ * @class LandmarkIndex
+ * @brief Distances from a few landmark nodes, giving lower bounds for A* (ALT).
+ *
+ * By the triangle inequality |d(L, t) - d(L, v)| <= d(v, t) for every
+ * landmark L, so the largest such difference is an admissible, consistent
+ * A* heuristic. Landmarks are picked farthest-first: each new one is the node
+ * farthest from all landmarks chosen so far, an unreachable node counting as
+ * farthest, so every component gets one before any gets a second.
+ *
+ * Building runs one full Dijkstra per landmark and stores a distance per node
+ * id per landmark; it is meant to run ahead of queries, not per query. Any
+ * edge change can invalidate the bounds: added edges and lighter weights make
+ * them inadmissible, and removed edges or heavier weights can leave a bound of
+ * UNREACHABLE between nodes that are still connected. The index records the
+ * store's edge version when it is built; is_current() tells whether it still
+ * matches, and QueryExecutor falls back to bidirectional Dijkstra when not.
+ */
+class LandmarkIndex {
+public:
+    static constexpr size_t DEFAULT_LANDMARKS = 8;
+
+    static util::expected<LandmarkIndex, storage::Error> build(const WeightedPathFinder& finder,
+                                                              storage::GraphStore& graph_store,
+                                                              size_t landmark_count = DEFAULT_LANDMARKS);
+
+    const std::string& weight_key() const { return weight_key_; }
+    const std::vector<storage::NodeId>& landmarks() const { return landmarks_; }
+    // Whether no edge of `graph_store` has changed since the index was built
+    bool is_current(const storage::GraphStore& graph_store) const {
+        return edge_version_ == graph_store.get_edge_version();
+    }
+    // Lower bound on the weight of a path between `u` and `v`; UNREACHABLE if
+    // they were in different components when the index was built
+    double lower_bound(storage::NodeId u, storage::NodeId v) const;
+
+private:
+    std::string weight_key_;
+    uint64_t edge_version_ = 0;
+    std::vector<storage::NodeId> landmarks_;
+    std::vector<std::vector<double>> distances_;  // [landmark][node id]
+};
+
+}  // namespace loredb::query
@@ -0,0 +1,332 @@
+#include "bplus_tree.h"
+#include "../util/varint.h"
+#include <algorithm>
+#include <cstring>
+
+namespace loredb::storage {
+
+namespace {
+
+constexpr size_t BODY_SIZE = PAGE_SIZE - sizeof(PageHeader);
+
+}  // namespace
+
+BPlusTree::BPlusTree(PageStore& pages, PageId root) : pages_(pages), root_(root) {
+}
+
+bool BPlusTree::less(std::string_view a_key, uint64_t a_value, std::string_view b_key, uint64_t b_value) {
+    const int cmp = a_key.compare(b_key);
+    return cmp < 0 || (cmp == 0 && a_value < b_value);
+}
+
+size_t BPlusTree::encoded_size(const Node& node) {
+    size_t size = 1 + (node.leaf ? 0 : sizeof(PageId));
+    for (const auto& entry : node.entries) {
+        size += util::VarInt::encoded_size(entry.key.size()) + entry.key.size() + sizeof(uint64_t);
+        if (!node.leaf) {
+            size += sizeof(PageId);
+        }
+    }
+    return size;
+}
+
+PageId BPlusTree::child_for(const Node& node, std::string_view key, uint64_t value) {
+    // The last separator <= (key, value) owns the subtree to descend into
+    auto it = std::upper_bound(node.entries.begin(), node.entries.end(), std::make_pair(key, value),
+                               [](const auto& target, const Entry& e) {
+                                   return less(target.first, target.second, e.key, e.value);
+                               });
+    return it == node.entries.begin() ? node.first_child : std::prev(it)->child;
+}
+
+util::expected<BPlusTree::Node, Error> BPlusTree::read_node(PageId page_id) const {
+    auto page_result = pages_.read_page(page_id);
+    if (!page_result.has_value()) {
+        return util::unexpected(page_result.error());
+    }
+    auto page = page_result.value();
+
+    PageHeader header;
+    std::memcpy(&header, page.data(), sizeof(PageHeader));
+    if (header.page_type != static_cast<uint32_t>(PageType::INDEX)) {
+        return util::unexpected(Error{ErrorCode::CORRUPTION, "Not an index page"});
+    }
+
+    auto corrupt = [] { return util::unexpected(Error{ErrorCode::CORRUPTION, "Malformed index page"}); };
+    std::span<const uint8_t> data = page.subspan(sizeof(PageHeader));
+    Node node;
+    node.leaf = data[0] != 0;
+    node.next_leaf = header.next_page_id;
+    data = data.subspan(1);
+    if (!node.leaf) {
+        std::memcpy(&node.first_child, data.data(), sizeof(PageId));
+        data = data.subspan(sizeof(PageId));
+    }
+
+    const size_t fixed = sizeof(uint64_t) + (node.leaf ? 0 : sizeof(PageId));
+    node.entries.resize(header.record_count);
+    for (auto& entry : node.entries) {
+        auto len = util::VarInt::decode(data);
+        if (!len.has_value() || len.value() > MAX_KEY_SIZE || len.value() + fixed > data.size()) {
+            return corrupt();
+        }
+        entry.key.assign(reinterpret_cast<const char*>(data.data()), len.value());
+        data = data.subspan(len.value());
+        std::memcpy(&entry.value, data.data(), sizeof(uint64_t));
+        data = data.subspan(sizeof(uint64_t));
+        if (!node.leaf) {
+            std::memcpy(&entry.child, data.data(), sizeof(PageId));
+            data = data.subspan(sizeof(PageId));
+        }
+    }
+    return node;
+}
+
+util::expected<void, Error> BPlusTree::write_node(PageId page_id, const Node& node) {
+    std::vector<uint8_t> page(PAGE_SIZE, 0);
+    PageHeader header;
+    header.page_id = page_id;
+    header.page_type = static_cast<uint32_t>(PageType::INDEX);
+    header.record_count = static_cast<uint32_t>(node.entries.size());
+    header.next_page_id = node.next_leaf;
+
+    uint8_t* out = page.data() + sizeof(PageHeader);
+    *out++ = node.leaf ? 1 : 0;
+    if (!node.leaf) {
+        std::memcpy(out, &node.first_child, sizeof(PageId));
+        out += sizeof(PageId);
+    }
+    for (const auto& entry : node.entries) {
+        out += util::VarInt::encode(entry.key.size(), std::span<uint8_t>(out, page.data() + PAGE_SIZE));
+        std::memcpy(out, entry.key.data(), entry.key.size());
+        out += entry.key.size();
+        std::memcpy(out, &entry.value, sizeof(uint64_t));
+        out += sizeof(uint64_t);
+        if (!node.leaf) {
+            std::memcpy(out, &entry.child, sizeof(PageId));
+            out += sizeof(PageId);
+        }
+    }
+    header.next_free_offset = static_cast<uint32_t>(out - page.data());
+    std::memcpy(page.data(), &header, sizeof(PageHeader));
+    return pages_.write_page(page_id, page);
+}
+
+util::expected<PageId, Error> BPlusTree::allocate_node(const Node& node) {
+    auto page_id = pages_.allocate_page();
+    if (!page_id.has_value()) {
+        return util::unexpected(page_id.error());
+    }
+    if (auto result = write_node(page_id.value(), node); !result.has_value()) {
+        return util::unexpected(result.error());
+    }
+    return page_id.value();
+}
+
+util::expected<std::optional<BPlusTree::Entry>, Error> BPlusTree::insert_into(PageId page_id, Entry entry) {
+    auto node_result = read_node(page_id);
+    if (!node_result.has_value()) {
+        return util::unexpected(node_result.error());
+    }
+    Node node = std::move(node_result.value());
+
+    auto position = [&node](const Entry& e) {
+        return std::lower_bound(node.entries.begin(), node.entries.end(), e, [](const Entry& a, const Entry& b) {
+            return less(a.key, a.value, b.key, b.value);
+        });
+    };
+
+    if (node.leaf) {
+        auto it = position(entry);
+        if (it != node.entries.end() && it->key == entry.key && it->value == entry.value) {
+            return std::optional<Entry>{};
+        }
+        node.entries.insert(it, std::move(entry));
+    } else {
+        const PageId child = child_for(node, entry.key, entry.value);
+        auto split = insert_into(child, std::move(entry));
+        if (!split.has_value()) {
+            return util::unexpected(split.error());
+        }
+        if (!split.value().has_value()) {
+            return std::optional<Entry>{};
+        }
+        Entry separator = std::move(*split.value());
+        node.entries.insert(position(separator), std::move(separator));
+    }
+
+    if (encoded_size(node) <= BODY_SIZE) {
+        if (auto result = write_node(page_id, node); !result.has_value()) {
+            return util::unexpected(result.error());
+        }
+        return std::optional<Entry>{};
+    }
+
+    // Split by bytes so both halves fit whatever the key sizes
+    const size_t total = encoded_size(node);
+    size_t mid = 0;
+    for (size_t bytes = 0; mid + 1 < node.entries.size() && bytes < total / 2; ++mid) {
+        bytes += node.entries[mid].key.size() + 2 * sizeof(uint64_t);
+    }
+    mid = std::max<size_t>(mid, 1);
+
+    Node right;
+    right.leaf = node.leaf;
+    Entry separator;
+    if (node.leaf) {
+        right.entries.assign(std::make_move_iterator(node.entries.begin() + mid),
+                             std::make_move_iterator(node.entries.end()));
+        separator.key = right.entries.front().key;
+        separator.value = right.entries.front().value;
+    } else {
+        // The middle separator moves up; its subtree becomes the right node's first child
+        separator = std::move(node.entries[mid]);
+        right.first_child = separator.child;
+        right.entries.assign(std::make_move_iterator(node.entries.begin() + mid + 1),
+                             std::make_move_iterator(node.entries.end()));
+    }
+    node.entries.resize(mid);
+
+    right.next_leaf = node.next_leaf;
+    auto right_page = allocate_node(right);
+    if (!right_page.has_value()) {
+        return util::unexpected(right_page.error());
+    }
+    if (node.leaf) {
+        node.next_leaf = right_page.value();
+    }
+    if (auto result = write_node(page_id, node); !result.has_value()) {
+        return util::unexpected(result.error());
+    }
+    separator.child = right_page.value();
+    return std::optional<Entry>{std::move(separator)};
+}
+
+util::expected<void, Error> BPlusTree::insert(std::string_view key, uint64_t value) {
+    if (key.size() > MAX_KEY_SIZE) {
+        return util::unexpected(Error{ErrorCode::INVALID_ARGUMENT, "Index key too long"});
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (root_ == INVALID_PAGE_ID) {
+        auto root = allocate_node(Node{});
+        if (!root.has_value()) {
+            return util::unexpected(root.error());
+        }
+        root_ = root.value();
+    }
+
+    auto split = insert_into(root_, Entry{std::string(key), value, INVALID_PAGE_ID});
+    if (!split.has_value()) {
+        return util::unexpected(split.error());
+    }
+    if (split.value().has_value()) {
+        Node new_root;
+        new_root.leaf = false;
+        new_root.first_child = root_;
+        new_root.entries.push_back(std::move(*split.value()));
+        auto root = allocate_node(new_root);
+        if (!root.has_value()) {
+            return util::unexpected(root.error());
+        }
+        root_ = root.value();
+    }
+    return {};
+}
+
+util::expected<bool, Error> BPlusTree::erase(std::string_view key, uint64_t value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PageId page_id = root_;
+    while (page_id != INVALID_PAGE_ID) {
+        auto node_result = read_node(page_id);
+        if (!node_result.has_value()) {
+            return util::unexpected(node_result.error());
+        }
+        Node& node = node_result.value();
+        if (!node.leaf) {
+            page_id = child_for(node, key, value);
+            continue;
+        }
+        auto it = std::find_if(node.entries.begin(), node.entries.end(),
+                               [&](const Entry& e) { return e.key == key && e.value == value; });
+        if (it == node.entries.end()) {
+            return false;
+        }
+        node.entries.erase(it);
+        if (auto result = write_node(page_id, node); !result.has_value()) {
+            return util::unexpected(result.error());
+        }
+        return true;
+    }
+    return false;
+}
+
+util::expected<void, Error> BPlusTree::scan(std::string_view lower, const Visitor& visit) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (root_ == INVALID_PAGE_ID) {
+        return {};
+    }
+
+    PageId page_id = root_;
+    bool first_leaf = true;
+    while (page_id != INVALID_PAGE_ID) {
+        auto node_result = read_node(page_id);
+        if (!node_result.has_value()) {
+            return util::unexpected(node_result.error());
+        }
+        const Node& node = node_result.value();
+        if (!node.leaf) {
+            page_id = child_for(node, lower, 0);
+            continue;
+        }
+
+        auto it = node.entries.begin();
+        if (first_leaf) {
+            it = std::lower_bound(node.entries.begin(), node.entries.end(), lower,
+                                  [](const Entry& e, std::string_view target) { return e.key < target; });
+            first_leaf = false;
+        }
+        for (; it != node.entries.end(); ++it) {
+            if (!visit(it->key, it->value)) {
+                return {};
+            }
+        }
+        page_id = node.next_leaf;
+    }
+    return {};
+}
+
+util::expected<void, Error> BPlusTree::destroy_subtree(PageId page_id) {
+    auto node_result = read_node(page_id);
+    if (!node_result.has_value()) {
+        return util::unexpected(node_result.error());
+    }
+    const Node& node = node_result.value();
+    if (!node.leaf) {
+        if (auto result = destroy_subtree(node.first_child); !result.has_value()) {
+            return result;
+        }
+        for (const auto& entry : node.entries) {
+            if (auto result = destroy_subtree(entry.child); !result.has_value()) {
+                return result;
+            }
+        }
+    }
+    return pages_.deallocate_page(page_id);
+}
+
+util::expected<void, Error> BPlusTree::destroy() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (root_ == INVALID_PAGE_ID) {
+        return {};
+    }
+    auto result = destroy_subtree(root_);
+    root_ = INVALID_PAGE_ID;
+    return result;
+}
+
+PageId BPlusTree::root() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return root_;
+}
+
+}  // namespace loredb::storage
@@ -0,0 +1,95 @@
+/// \file bplus_tree.h
+/// \brief Page-backed B+ tree over byte-string keys.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "page_store.h"
+#include "../util/expected.h"
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace loredb::storage {
+
+/**
+ * @class BPlusTree
+ * @brief Ordered multimap from byte-string keys to 64-bit values, stored in INDEX pages.
+ *
+ * Entries are (key, value) pairs ordered by key bytes (memcmp order, shorter
+ * prefix first) and then by value, so duplicate keys are allowed and every
+ * entry is unique. Leaves are chained through PageHeader::next_page_id for
+ * range scans. Deletes do not rebalance: leaves may become sparse or empty
+ * and are skipped by scans.
+ *
+ * Callers give keys an order-preserving encoding; the tree only compares bytes.
+ * All operations serialize on one mutex, and pages are decoded on read, so no
+ * page-store buffer is held across calls.
+ */
+class BPlusTree {
+public:
+    // Longest key accepted; an entry of this size still leaves room for several per page
+    static constexpr size_t MAX_KEY_SIZE = 512;
+
+    // Called for each entry in order; return false to stop the scan
+    using Visitor = std::function<bool(std::string_view key, uint64_t value)>;
+
+    /**
+     * @brief Open the tree rooted at `root`, or an empty tree for INVALID_PAGE_ID.
+     * @param pages Page store holding the tree; must outlive it.
+     * @param root Root page of an existing tree.
+     */
+    explicit BPlusTree(PageStore& pages, PageId root = INVALID_PAGE_ID);
+
+    // Adds (key, value); inserting an existing entry is a no-op
+    util::expected<void, Error> insert(std::string_view key, uint64_t value);
+    // Removes (key, value); returns whether it was present
+    util::expected<bool, Error> erase(std::string_view key, uint64_t value);
+
+    // Visits entries with key >= lower in order. The visitor runs under the
+    // tree's lock and must not call back into the tree.
+    util::expected<void, Error> scan(std::string_view lower, const Visitor& visit) const;
+
+    // Frees every page of the tree and leaves it empty
+    util::expected<void, Error> destroy();
+
+    // Root page, INVALID_PAGE_ID while the tree has never held an entry. Splits
+    // of the root move it, so owners persisting the tree re-read it after writes.
+    PageId root() const;
+
+private:
+    struct Entry {
+        std::string key;
+        uint64_t value = 0;
+        PageId child = INVALID_PAGE_ID;  // Internal nodes: subtree holding entries >= this one
+    };
+
+    struct Node {
+        bool leaf = true;
+        PageId first_child = INVALID_PAGE_ID;  // Internal nodes: subtree below the first separator
+        PageId next_leaf = INVALID_PAGE_ID;
+        std::vector<Entry> entries;
+    };
+
+    static bool less(std::string_view a_key, uint64_t a_value, std::string_view b_key, uint64_t b_value);
+    static size_t encoded_size(const Node& node);
+    static PageId child_for(const Node& node, std::string_view key, uint64_t value);
+
+    util::expected<Node, Error> read_node(PageId page_id) const;
+    util::expected<void, Error> write_node(PageId page_id, const Node& node);
+    util::expected<PageId, Error> allocate_node(const Node& node);
+
+    // Inserts below `page_id`; returns the separator for a new right sibling when the node split
+    util::expected<std::optional<Entry>, Error> insert_into(PageId page_id, Entry entry);
+    util::expected<void, Error> destroy_subtree(PageId page_id);
+
+    PageStore& pages_;
+    PageId root_;
+    mutable std::mutex mutex_;
+};
+
+}  // namespace loredb::storage
@@ -0,0 +1,105 @@
+#include "composite_index.h"
+
+namespace loredb::storage {
+
+namespace {
+
+// Component tags; an absent value sorts before any present one
+constexpr char ABSENT_TAG = 0x01;
+constexpr char PRESENT_TAG = 0x02;
+
+// Present values are escaped (0x00 -> 0x00 0xFF) and terminated by 0x00 0x01,
+// which cannot occur inside an escaped value, so components never run together
+void append_component(std::string& key, const std::string& value) {
+    key.push_back(PRESENT_TAG);
+    for (char c : value) {
+        key.push_back(c);
+        if (c == '\0') {
+            key.push_back(static_cast<char>(0xFF));
+        }
+    }
+    key.push_back('\0');
+    key.push_back(0x01);
+}
+
+}  // namespace
+
+PropertyCompositeIndex::PropertyCompositeIndex(PageStore& pages, std::vector<std::string> keys, PageId root)
+    : keys_(std::move(keys)), tree_(pages, root) {
+}
+
+std::string PropertyCompositeIndex::encode(const std::vector<std::optional<std::string>>& values) {
+    std::string key;
+    for (const auto& value : values) {
+        if (value.has_value()) {
+            append_component(key, *value);
+        } else {
+            key.push_back(ABSENT_TAG);
+        }
+        if (key.size() >= BPlusTree::MAX_KEY_SIZE) {
+            break;
+        }
+    }
+    // Truncating keeps lookups correct: a probe truncated the same way still
+    // prefixes every entry it should find
+    if (key.size() > BPlusTree::MAX_KEY_SIZE) {
+        key.resize(BPlusTree::MAX_KEY_SIZE);
+    }
+    return key;
+}
+
+util::expected<void, Error> PropertyCompositeIndex::insert(const std::vector<std::optional<std::string>>& values,
+                                                           NodeId node_id) {
+    if (values.empty() || !values.front().has_value()) {
+        return {};
+    }
+    return tree_.insert(encode(values), node_id);
+}
+
+util::expected<void, Error> PropertyCompositeIndex::erase(const std::vector<std::optional<std::string>>& values,
+                                                          NodeId node_id) {
+    if (values.empty() || !values.front().has_value()) {
+        return {};
+    }
+    auto erased = tree_.erase(encode(values), node_id);
+    if (!erased.has_value()) {
+        return util::unexpected(erased.error());
+    }
+    return {};
+}
+
+util::expected<std::vector<NodeId>, Error> PropertyCompositeIndex::find(const std::vector<std::string>& leading) const {
+    std::vector<NodeId> ids;
+    auto scanned = scan_prefix(leading, [&](NodeId node_id) { ids.push_back(node_id); });
+    if (!scanned.has_value()) {
+        return util::unexpected(scanned.error());
+    }
+    return ids;
+}
+
+util::expected<size_t, Error> PropertyCompositeIndex::count(const std::vector<std::string>& leading) const {
+    size_t matches = 0;
+    auto scanned = scan_prefix(leading, [&](NodeId) { ++matches; });
+    if (!scanned.has_value()) {
+        return util::unexpected(scanned.error());
+    }
+    return matches;
+}
+
+util::expected<void, Error> PropertyCompositeIndex::scan_prefix(const std::vector<std::string>& leading,
+                                                                const std::function<void(NodeId)>& visit) const {
+    if (leading.empty() || leading.size() > keys_.size()) {
+        return util::unexpected(Error{ErrorCode::INVALID_ARGUMENT, "Composite lookup must bind leading keys"});
+    }
+    const std::string prefix = encode(std::vector<std::optional<std::string>>(leading.begin(), leading.end()));
+
+    return tree_.scan(prefix, [&](std::string_view key, uint64_t value) {
+        if (key.substr(0, prefix.size()) != prefix) {
+            return false;
+        }
+        visit(value);
+        return true;
+    });
+}
+
+}  // namespace loredb::storage
@@ -0,0 +1,60 @@
+/// \file composite_index.h
+/// \brief Ordered index over a list of property keys answering prefix equality lookups.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "bplus_tree.h"
+#include "record.h"
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace loredb::storage {
+
+/**
+ * @class PropertyCompositeIndex
+ * @brief B+ tree over the values of an ordered list of property keys.
+ *
+ * A node is posted under the concatenation of its values for keys(), in
+ * order, so one probe answers equality on all keys or on any leading subset
+ * of them. Values are the rendered strings the equality indexes use. Nodes
+ * without the first key are not posted; missing later keys are encoded as
+ * absent so the node still matches lookups on the keys before them.
+ *
+ * Lookups return a superset of the matches: keys longer than the tree's key
+ * limit are truncated and postings may be stale. Callers re-check candidates.
+ */
+class PropertyCompositeIndex {
+public:
+    PropertyCompositeIndex(PageStore& pages, std::vector<std::string> keys, PageId root = INVALID_PAGE_ID);
+
+    const std::vector<std::string>& keys() const { return keys_; }
+
+    // Tree key for leading `values` of keys() (nullopt = node lacks that key).
+    // The key of a leading subset is a byte prefix of the key of the whole list.
+    static std::string encode(const std::vector<std::optional<std::string>>& values);
+
+    // `values` are aligned with keys()
+    util::expected<void, Error> insert(const std::vector<std::optional<std::string>>& values, NodeId node_id);
+    util::expected<void, Error> erase(const std::vector<std::optional<std::string>>& values, NodeId node_id);
+
+    // Unsorted candidates whose values for the first leading.size() keys equal `leading`
+    util::expected<std::vector<NodeId>, Error> find(const std::vector<std::string>& leading) const;
+    // Number of candidates find() would return, without collecting them
+    util::expected<size_t, Error> count(const std::vector<std::string>& leading) const;
+
+    PageId root() const { return tree_.root(); }
+    util::expected<void, Error> destroy() { return tree_.destroy(); }
+
+private:
+    // Visits the node id of every entry matching `leading`
+    util::expected<void, Error> scan_prefix(const std::vector<std::string>& leading,
+                                            const std::function<void(NodeId)>& visit) const;
+
+    std::vector<std::string> keys_;
+    BPlusTree tree_;
+};
+
+}  // namespace loredb::storage
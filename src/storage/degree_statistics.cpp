@@ -0,0 +1,213 @@
+#include "degree_statistics.h"
+#include <algorithm>
+#include <bit>
+
+namespace loredb::storage {
+
+size_t DegreeStatistics::bucket_of(uint64_t degree) {
+    if (degree < EXACT_DEGREES) {
+        return static_cast<size_t>(degree);
+    }
+    const unsigned exponent = static_cast<unsigned>(std::bit_width(degree)) - 1;  // >= 4
+    const uint64_t sub_bucket = (degree >> (exponent - SUB_BUCKET_BITS)) & ((1u << SUB_BUCKET_BITS) - 1);
+    return EXACT_DEGREES + (exponent - 4) * (size_t{1} << SUB_BUCKET_BITS) + sub_bucket;
+}
+
+uint64_t DegreeStatistics::bucket_min(size_t bucket) {
+    if (bucket < EXACT_DEGREES) {
+        return bucket;
+    }
+    const size_t exponent = 4 + (bucket - EXACT_DEGREES) / (size_t{1} << SUB_BUCKET_BITS);
+    const uint64_t sub_bucket = (bucket - EXACT_DEGREES) % (size_t{1} << SUB_BUCKET_BITS);
+    return ((uint64_t{1} << SUB_BUCKET_BITS) + sub_bucket) << (exponent - SUB_BUCKET_BITS);
+}
+
+uint64_t DegreeStatistics::bucket_max(size_t bucket) {
+    if (bucket < EXACT_DEGREES) {
+        return bucket;
+    }
+    const size_t exponent = 4 + (bucket - EXACT_DEGREES) / (size_t{1} << SUB_BUCKET_BITS);
+    return bucket_min(bucket) + ((uint64_t{1} << (exponent - SUB_BUCKET_BITS)) - 1);
+}
+
+void DegreeStatistics::move(Distribution& distribution, uint64_t from, uint64_t to) {
+    --distribution.nodes[bucket_of(from)];
+    ++distribution.nodes[bucket_of(to)];
+    distribution.degree_sum += to - from;  // Wraps back correctly when to < from
+}
+
+const DegreeStatistics::Distribution& DegreeStatistics::distribution(DegreeDirection direction) const {
+    switch (direction) {
+        case DegreeDirection::IN:
+            return in_;
+        case DegreeDirection::OUT:
+            return out_;
+        default:
+            return both_;
+    }
+}
+
+void DegreeStatistics::add_node() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++node_count_;
+    for (auto* distribution : {&in_, &out_, &both_}) {
+        ++distribution->nodes[0];
+    }
+}
+
+void DegreeStatistics::remove_node(NodeId node_id, uint64_t in_degree, uint64_t out_degree) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (node_count_ == 0) {
+        return;
+    }
+    --node_count_;
+    --in_.nodes[bucket_of(in_degree)];
+    in_.degree_sum -= in_degree;
+    --out_.nodes[bucket_of(out_degree)];
+    out_.degree_sum -= out_degree;
+    --both_.nodes[bucket_of(in_degree + out_degree)];
+    both_.degree_sum -= in_degree + out_degree;
+    std::erase_if(hubs_, [node_id](const Hub& hub) { return hub.node_id == node_id; });
+    hub_floor_ = 0;
+}
+
+void DegreeStatistics::update(NodeId node_id, uint64_t old_in, uint64_t old_out, uint64_t new_in, uint64_t new_out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    move(in_, old_in, new_in);
+    move(out_, old_out, new_out);
+    const uint64_t old_degree = old_in + old_out;
+    const uint64_t new_degree = new_in + new_out;
+    move(both_, old_degree, new_degree);
+
+    // Tracked hubs are never below the floor, so a node growing to at most the
+    // floor was not tracked and still does not qualify
+    if (new_degree > old_degree && new_degree <= hub_floor_) {
+        return;
+    }
+    track_hub(Hub{node_id, new_in, new_out});
+}
+
+void DegreeStatistics::track_hub(const Hub& hub) {
+    auto tracked = std::find_if(hubs_.begin(), hubs_.end(),
+                                [&](const Hub& candidate) { return candidate.node_id == hub.node_id; });
+    if (tracked != hubs_.end()) {
+        *tracked = hub;
+    } else if (hubs_.size() < TRACKED_HUBS) {
+        hubs_.push_back(hub);
+    } else {
+        auto smallest = std::min_element(hubs_.begin(), hubs_.end(), [](const Hub& a, const Hub& b) {
+            return a.degree() < b.degree();
+        });
+        if (hub.degree() <= smallest->degree()) {
+            return;
+        }
+        *smallest = hub;
+    }
+    hub_floor_ = 0;
+    if (hubs_.size() == TRACKED_HUBS) {
+        hub_floor_ = std::min_element(hubs_.begin(), hubs_.end(), [](const Hub& a, const Hub& b) {
+            return a.degree() < b.degree();
+        })->degree();
+    }
+}
+
+void DegreeStatistics::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    node_count_ = 0;
+    in_ = {};
+    out_ = {};
+    both_ = {};
+    hubs_.clear();
+    hub_floor_ = 0;
+}
+
+uint64_t DegreeStatistics::node_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return node_count_;
+}
+
+uint64_t DegreeStatistics::min_degree(DegreeDirection direction) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& nodes = distribution(direction).nodes;
+    for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        if (nodes[bucket] > 0) {
+            return bucket_min(bucket);
+        }
+    }
+    return 0;
+}
+
+uint64_t DegreeStatistics::max_degree(DegreeDirection direction) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (direction == DegreeDirection::BOTH && !hubs_.empty()) {
+        // The top hub is tracked exactly
+        return std::max_element(hubs_.begin(), hubs_.end(), [](const Hub& a, const Hub& b) {
+            return a.degree() < b.degree();
+        })->degree();
+    }
+    const auto& nodes = distribution(direction).nodes;
+    for (size_t bucket = BUCKET_COUNT; bucket-- > 0;) {
+        if (nodes[bucket] > 0) {
+            return bucket_min(bucket);
+        }
+    }
+    return 0;
+}
+
+double DegreeStatistics::mean_degree(DegreeDirection direction) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (node_count_ == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(distribution(direction).degree_sum) / static_cast<double>(node_count_);
+}
+
+uint64_t DegreeStatistics::percentile(DegreeDirection direction, double percentile) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (node_count_ == 0) {
+        return 0;
+    }
+    const double wanted = std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(node_count_);
+    const auto& nodes = distribution(direction).nodes;
+    uint64_t seen = 0;
+    size_t last = 0;
+    for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        if (nodes[bucket] == 0) {
+            continue;
+        }
+        seen += nodes[bucket];
+        last = bucket;
+        if (static_cast<double>(seen) >= wanted) {
+            return bucket_min(bucket);
+        }
+    }
+    return bucket_min(last);
+}
+
+std::vector<DegreeStatistics::Bucket> DegreeStatistics::histogram(DegreeDirection direction) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Bucket> buckets;
+    const auto& nodes = distribution(direction).nodes;
+    for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        if (nodes[bucket] > 0) {
+            buckets.push_back(Bucket{bucket_min(bucket), bucket_max(bucket), nodes[bucket]});
+        }
+    }
+    return buckets;
+}
+
+std::vector<DegreeStatistics::Hub> DegreeStatistics::top_hubs(size_t k) const {
+    std::vector<Hub> hubs;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        hubs = hubs_;
+    }
+    std::erase_if(hubs, [](const Hub& hub) { return hub.degree() == 0; });
+    std::sort(hubs.begin(), hubs.end(), [](const Hub& a, const Hub& b) {
+        return a.degree() != b.degree() ? a.degree() > b.degree() : a.node_id < b.node_id;
+    });
+    hubs.resize(std::min(hubs.size(), k));
+    return hubs;
+}
+
+}  // namespace loredb::storage
@@ -0,0 +1,100 @@
+/// \file degree_statistics.h
+/// \brief Incrementally maintained node degree distribution and hub tracking.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "page_store.h"
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace loredb::storage {
+
+enum class DegreeDirection {
+    IN,
+    OUT,
+    BOTH  // In plus out; a self-loop counts twice
+};
+
+/**
+ * @class DegreeStatistics
+ * @brief Degree distribution of the graph's nodes, kept up to date on every edge change.
+ *
+ * For each direction a log-linear histogram counts the nodes per degree
+ * bucket: degrees below 16 have a bucket each, and above that every power of
+ * two is split into 8 buckets, so a bucket's bounds are within 12.5% of each
+ * other. Min, max and percentiles are read off the histograms and reported as
+ * bucket lower bounds; the mean is exact. The TRACKED_HUBS nodes of highest
+ * total degree are kept alongside. All queries cost the same whatever the
+ * graph size.
+ *
+ * Hub tracking is exact while degrees only grow. A tracked hub that loses
+ * edges keeps its place until another node outgrows it, so after deletions a
+ * node may be missing from the hubs until it next gains an edge.
+ */
+class DegreeStatistics {
+public:
+    static constexpr size_t TRACKED_HUBS = 64;
+
+    struct Hub {
+        NodeId node_id = 0;
+        uint64_t in_degree = 0;
+        uint64_t out_degree = 0;
+        uint64_t degree() const { return in_degree + out_degree; }
+    };
+
+    struct Bucket {
+        uint64_t min_degree = 0;
+        uint64_t max_degree = 0;  // Inclusive
+        uint64_t nodes = 0;
+    };
+
+    // A node with no edges appears / disappears
+    void add_node();
+    void remove_node(NodeId node_id, uint64_t in_degree, uint64_t out_degree);
+    // The degrees of `node_id` changed from (old_in, old_out) to (new_in, new_out)
+    void update(NodeId node_id, uint64_t old_in, uint64_t old_out, uint64_t new_in, uint64_t new_out);
+    void clear();
+
+    uint64_t node_count() const;
+    uint64_t min_degree(DegreeDirection direction) const;
+    uint64_t max_degree(DegreeDirection direction) const;
+    double mean_degree(DegreeDirection direction) const;
+    // Smallest degree bucket holding at least `percentile` percent of the
+    // nodes, as its lower bound; 0 without nodes
+    uint64_t percentile(DegreeDirection direction, double percentile) const;
+    // Non-empty buckets, ascending
+    std::vector<Bucket> histogram(DegreeDirection direction) const;
+    // Up to `k` nodes of highest total degree, highest first (k <= TRACKED_HUBS)
+    std::vector<Hub> top_hubs(size_t k) const;
+
+private:
+    static constexpr size_t EXACT_DEGREES = 16;
+    static constexpr unsigned SUB_BUCKET_BITS = 3;
+    static constexpr size_t BUCKET_COUNT = EXACT_DEGREES + (64 - 4) * (size_t{1} << SUB_BUCKET_BITS);
+
+    static size_t bucket_of(uint64_t degree);
+    static uint64_t bucket_min(size_t bucket);
+    static uint64_t bucket_max(size_t bucket);
+
+    struct Distribution {
+        std::array<uint64_t, BUCKET_COUNT> nodes{};
+        uint64_t degree_sum = 0;
+    };
+    const Distribution& distribution(DegreeDirection direction) const;
+    static void move(Distribution& distribution, uint64_t from, uint64_t to);
+
+    void track_hub(const Hub& hub);
+
+    mutable std::mutex mutex_;
+    uint64_t node_count_ = 0;
+    Distribution in_;
+    Distribution out_;
+    Distribution both_;
+    std::vector<Hub> hubs_;  // Unordered, at most TRACKED_HUBS
+    uint64_t hub_floor_ = 0;  // Smallest tracked degree once hubs_ is full, else 0
+};
+
+}  // namespace loredb::storage
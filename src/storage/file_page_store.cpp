@@ -6,9 +6,19 @@
 
 namespace loredb::storage {
 
+namespace {
+
+// Pages are returned as views into a per-thread buffer, so concurrent readers
+// (queries alongside a background index build) never share one
+std::span<uint8_t> thread_page_buffer() {
+    thread_local std::vector<uint8_t> buffer(PAGE_SIZE);
+    return buffer;
+}
+
+}  // namespace
+
 FilePageStore::FilePageStore(const std::string& path, bool sync_on_write)
     : file_path_(path), sync_on_write_(sync_on_write), is_closed_(false), next_page_id_(1), allocated_pages_(0),
-      page_buffer_(std::make_unique<std::vector<uint8_t>>(PAGE_SIZE)),
       initial_size_(1024 * 1024), growth_factor_(2.0) {
     
     // Open file in binary mode for reliable positioning operations
@@ -28,6 +38,20 @@ FilePageStore::FilePageStore(const std::string& path, bool sync_on_write)
     
     // Clear any error flags
     file_stream_.clear();
+
+    // Reopening an existing file resumes allocation after its pages, so pages
+    // written earlier (index trees, metadata chains) are not handed out again.
+    // The free list is not persisted: pages freed in an earlier session stay unused.
+    file_stream_.seekg(0, std::ios::end);
+    const auto file_size = file_stream_.tellg();
+    file_stream_.clear();
+    if (file_size != std::streampos(-1)) {
+        const PageId existing = static_cast<PageId>(file_size) / PAGE_SIZE;
+        if (existing > 1) {
+            next_page_id_.store(existing);
+            allocated_pages_.store(existing - 1);
+        }
+    }
 }
 
 FilePageStore::~FilePageStore() {
@@ -108,16 +132,17 @@ util::expected<std::span<uint8_t>, Error> FilePageStore::read_page(PageId page_i
     }
     
     // Clear buffer first to ensure we don't have stale data
-    std::fill(page_buffer_->begin(), page_buffer_->end(), 0);
+    std::span<uint8_t> page = thread_page_buffer();
+    std::fill(page.begin(), page.end(), 0);
     
-    file_stream_.read(reinterpret_cast<char*>(page_buffer_->data()), PAGE_SIZE);
+    file_stream_.read(reinterpret_cast<char*>(page.data()), PAGE_SIZE);
     file_stream_.clear(); // Clear flags after read
     
     if (file_stream_.bad()) {
         return util::unexpected(Error{ErrorCode::IO_ERROR, "Failed to read page"});
     }
     
-    return std::span<uint8_t>{page_buffer_->data(), PAGE_SIZE};
+    return page;
 }
 
 util::expected<void, Error> FilePageStore::write_page(PageId page_id, std::span<const uint8_t> data) {
@@ -20,6 +20,8 @@ namespace loredb::storage {
  * @brief File-backed implementation of PageStore for persistent storage.
  *
  * Supports configuration for initial file size, growth factor, and sync behavior.
+ * read_page() returns a view that stays valid until the calling thread's next
+ * read_page() on any FilePageStore.
  */
 class FilePageStore : public PageStore {
 public:
@@ -66,7 +68,6 @@ private:
     std::mutex file_mutex_;
     std::atomic<PageId> next_page_id_;
     std::atomic<size_t> allocated_pages_;
-    std::unique_ptr<std::vector<uint8_t>> page_buffer_; // for reads
     std::unordered_set<PageId> free_pages_;
     
     // Configuration
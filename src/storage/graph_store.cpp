@@ -1,16 +1,77 @@
 #include "graph_store.h"
 #include "../transaction/mvcc_manager.h"
+#include "metadata_chain.h"
+#include "simple_index_manager.h"
 #include "wal_manager.h"
 #include <sstream>
 #include <chrono>
 #include <algorithm>
 #include <cstring>
+#include <stdexcept>
 
 namespace loredb::storage {
 
+namespace {
+
+// Page 1 of a graph: the heads of the metadata chains and the id generators
+// as of the last sync
+constexpr PageId SUPERBLOCK_PAGE = 1;
+
+struct Superblock {
+    static constexpr uint32_t MAGIC = 0x4C4F5245;  // 'LORE'
+
+    uint32_t magic = MAGIC;
+    uint32_t version = 1;
+    PageId label_dictionary = INVALID_PAGE_ID;
+    PageId key_dictionary = INVALID_PAGE_ID;
+    PageId index_catalog = INVALID_PAGE_ID;
+    NodeId next_node_id = 1;
+    EdgeId next_edge_id = 1;
+};
+
+// Distinct ids of the non-empty `labels`, interning new ones
+std::vector<LabelId> intern_labels(LabelDictionary& dictionary, const std::vector<std::string>& labels) {
+    std::vector<LabelId> ids;
+    ids.reserve(labels.size());
+    for (const auto& label : labels) {
+        if (LabelId id = dictionary.intern(label); id != NO_LABEL) {
+            ids.push_back(id);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+// Ids of the edges, or of the nodes at their other ends, in an adjacency list
+template <typename Entries>
+std::vector<EdgeId> edge_ids(const Entries& entries) {
+    std::vector<EdgeId> ids;
+    ids.reserve(entries.size());
+    for (const auto& entry : entries) {
+        ids.push_back(entry.edge_id);
+    }
+    return ids;
+}
+
+template <typename Entries>
+std::vector<NodeId> neighbor_ids(const Entries& entries) {
+    std::vector<NodeId> ids;
+    ids.reserve(entries.size());
+    for (const auto& entry : entries) {
+        ids.push_back(entry.neighbor);
+    }
+    return ids;
+}
+
+}  // namespace
+
 GraphStore::GraphStore(std::unique_ptr<PageStore> page_store)
     : page_store_(std::move(page_store)), next_node_id_(1), next_edge_id_(1),
       node_count_(0), edge_count_(0) {
+    if (auto result = open(); !result.has_value()) {
+        throw std::runtime_error("Failed to open graph store: " + result.error().message);
+    }
 }
 
 GraphStore::GraphStore(std::unique_ptr<PageStore> page_store,
@@ -23,14 +84,165 @@ GraphStore::GraphStore(std::unique_ptr<PageStore> page_store,
       edge_count_(0),
       mvcc_manager_(std::move(mvcc_manager)),
       wal_manager_(std::move(wal_manager)) {
+    if (auto result = open(); !result.has_value()) {
+        throw std::runtime_error("Failed to open graph store: " + result.error().message);
+    }
+}
+
+GraphStore::~GraphStore() {
+    // Records reach the page store as they are written; the dictionaries and
+    // superblock they depend on only on sync
+    sync();
+}
+
+util::expected<void, Error> GraphStore::open() {
+    if (page_store_->get_page_count() == 0) {
+        auto page = page_store_->allocate_page();
+        if (!page.has_value()) {
+            return util::unexpected(page.error());
+        }
+        if (page.value() != SUPERBLOCK_PAGE) {
+            return util::unexpected(Error{ErrorCode::CORRUPTION, "Superblock must be the first page"});
+        }
+        return write_superblock();
+    }
+
+    auto page = page_store_->read_page(SUPERBLOCK_PAGE);
+    if (!page.has_value()) {
+        return util::unexpected(page.error());
+    }
+    PageHeader header;
+    Superblock superblock;
+    std::memcpy(&header, page.value().data(), sizeof(PageHeader));
+    std::memcpy(&superblock, page.value().data() + sizeof(PageHeader), sizeof(Superblock));
+    if (header.magic != PageHeader::MAGIC || header.page_type != static_cast<uint32_t>(PageType::METADATA) ||
+        superblock.magic != Superblock::MAGIC) {
+        return util::unexpected(Error{ErrorCode::CORRUPTION, "Page 1 is not a graph superblock"});
+    }
+    if (superblock.version != 1) {
+        return util::unexpected(Error{ErrorCode::CORRUPTION, "Unsupported superblock version"});
+    }
+
+    if (superblock.label_dictionary != INVALID_PAGE_ID) {
+        if (auto result = load_label_dictionary(superblock.label_dictionary); !result.has_value()) {
+            return result;
+        }
+    }
+    if (superblock.key_dictionary != INVALID_PAGE_ID) {
+        if (auto result = load_key_dictionary(superblock.key_dictionary); !result.has_value()) {
+            return result;
+        }
+    }
+    if (auto result = rebuild_from_records(); !result.has_value()) {
+        return result;
+    }
+    // Loaded once an index manager is attached
+    catalog_head_ = superblock.index_catalog;
+    // Ids handed out before the last sync stay retired even if their records were deleted
+    next_node_id_.store(std::max(next_node_id_.load(), superblock.next_node_id));
+    next_edge_id_.store(std::max(next_edge_id_.load(), superblock.next_edge_id));
+    return {};
 }
 
-GraphStore::~GraphStore() = default;
+util::expected<void, Error> GraphStore::rebuild_from_records() {
+    struct StoredEdge {
+        EdgeId id;
+        NodeId from_node;
+        NodeId to_node;
+        LabelId label;
+    };
+    std::vector<StoredEdge> edges;
+    NodeId max_node_id = 0;
+
+    const size_t page_count = page_store_->get_page_count();
+    for (PageId page_id = SUPERBLOCK_PAGE + 1; page_id <= page_count; ++page_id) {
+        auto page = page_store_->read_page(page_id);
+        if (!page.has_value()) {
+            return util::unexpected(page.error());
+        }
+        PageHeader header;
+        std::memcpy(&header, page.value().data(), sizeof(PageHeader));
+        if (header.magic != PageHeader::MAGIC) {
+            continue;  // Allocated but never written
+        }
+        const auto record = std::span<const uint8_t>(page.value()).subspan(sizeof(PageHeader));
+
+        if (header.page_type == static_cast<uint32_t>(PageType::NODE)) {
+            NodeRecord node;
+            std::memcpy(&node, record.data(), sizeof(NodeRecord));
+            auto label_ids = RecordSerializer::deserialize_node_labels(record);
+            if (!label_ids.has_value()) {
+                return util::unexpected(label_ids.error());
+            }
+            for (LabelId label : label_ids.value()) {
+                if (label == NO_LABEL || label > labels_.size()) {
+                    return util::unexpected(Error{ErrorCode::CORRUPTION, "Node record names an unknown label"});
+                }
+                node_labels_.add(label, node.id);
+            }
+            node_page_index_[node.id] = page_id;
+            max_node_id = std::max(max_node_id, node.id);
+        } else if (header.page_type == static_cast<uint32_t>(PageType::EDGE)) {
+            EdgeRecord edge;
+            std::memcpy(&edge, record.data(), sizeof(EdgeRecord));
+            if (edge.label_id > labels_.size()) {
+                return util::unexpected(Error{ErrorCode::CORRUPTION, "Edge record names an unknown label"});
+            }
+            edge_page_index_[edge.id] = page_id;
+            edges.push_back({edge.id, edge.from_node, edge.to_node, edge.label_id});
+        }
+    }
+
+    // Adjacency lists hold edges in creation order
+    std::sort(edges.begin(), edges.end(),
+              [](const StoredEdge& a, const StoredEdge& b) { return a.id < b.id; });
+    for (const auto& edge : edges) {
+        outgoing_edges_[edge.from_node].push_back({edge.id, edge.to_node});
+        incoming_edges_[edge.to_node].push_back({edge.id, edge.from_node});
+        edge_labels_.add(edge.label, edge.id);
+    }
+
+    for (const auto& [node_id, page_id] : node_page_index_) {
+        degree_stats_.add_node();
+        if (const auto [in, out] = node_degrees(node_id); in + out > 0) {
+            degree_stats_.update(node_id, 0, 0, in, out);
+        }
+    }
+
+    node_count_.store(node_page_index_.size());
+    edge_count_.store(edges.size());
+    next_node_id_.store(max_node_id + 1);
+    next_edge_id_.store(edges.empty() ? 1 : edges.back().id + 1);
+    return {};
+}
+
+util::expected<void, Error> GraphStore::write_superblock() {
+    std::lock_guard<std::mutex> lock(superblock_mutex_);
+    Superblock superblock;
+    superblock.label_dictionary = label_dictionary_page();
+    superblock.key_dictionary = key_dictionary_page();
+    {
+        std::lock_guard<std::mutex> catalog_lock(catalog_mutex_);
+        superblock.index_catalog = catalog_head_;
+    }
+    superblock.next_node_id = next_node_id_.load();
+    superblock.next_edge_id = next_edge_id_.load();
+
+    std::vector<uint8_t> page_data(PAGE_SIZE, 0);
+    PageHeader header;
+    header.page_id = SUPERBLOCK_PAGE;
+    header.page_type = static_cast<uint32_t>(PageType::METADATA);
+    header.next_free_offset = sizeof(PageHeader) + sizeof(Superblock);
+    std::memcpy(page_data.data(), &header, sizeof(PageHeader));
+    std::memcpy(page_data.data() + sizeof(PageHeader), &superblock, sizeof(Superblock));
+    return page_store_->write_page(SUPERBLOCK_PAGE, page_data);
+}
 
 util::expected<NodeId, Error> GraphStore::create_node(transaction::TransactionId tx_id,
-                                                     const std::vector<Property>& properties) {
+                                                     const std::vector<Property>& properties,
+                                                     const std::vector<std::string>& labels) {
     // Create node via existing path
-    auto id_result = create_node(properties);
+    auto id_result = create_node(properties, labels);
     if (!id_result.has_value()) {
         return util::unexpected(id_result.error());
     }
@@ -42,6 +254,7 @@ util::expected<NodeId, Error> GraphStore::create_node(transaction::TransactionId
         {
             NodeRecord nr;
             nr.id = node_id;
+            nr.label_count = static_cast<uint32_t>(intern_labels(labels_, labels).size());
             nr.property_count = static_cast<uint32_t>(properties.size());
             ver.data = nr;
         }
@@ -153,7 +366,7 @@ util::expected<EdgeId, Error> GraphStore::create_edge(transaction::TransactionId
              er.id = eid;
              er.from_node = from_node;
              er.to_node = to_node;
-             er.label_id = std::hash<std::string>{}(label);
+             er.label_id = labels_.intern(label);
              er.property_count = properties.size();
              ver.data = er;
          }
@@ -172,7 +385,9 @@ util::expected<EdgeId, Error> GraphStore::create_edge(transaction::TransactionId
      auto res = update_edge(edge_id, properties);
      if (!res.has_value()) return res;
      if (mvcc_manager_) {
-         EdgeRecord er{};
+         // Keep the endpoints and type of the stored record in the new version
+         auto stored = get_edge(edge_id);
+         EdgeRecord er = stored.has_value() ? stored.value().first : EdgeRecord{};
          er.id = edge_id;
          er.property_count = properties.size();
          transaction::Version ver{tx_id, 0, er, properties};
@@ -217,6 +432,27 @@ util::expected<std::pair<EdgeRecord, std::vector<Property>>, Error> GraphStore::
 }
 
 util::expected<std::pair<EdgeRecord, std::vector<Property>>, Error> GraphStore::get_edge(EdgeId edge_id) {
+    auto edge_data = read_edge_record(edge_id);
+    if (!edge_data.has_value()) {
+        return util::unexpected(edge_data.error());
+    }
+    return RecordSerializer::deserialize_edge(edge_data.value(), &keys_);
+}
+
+util::expected<std::optional<PropertyValue>, Error> GraphStore::get_edge_property(EdgeId edge_id, PropertyKey key) {
+    auto edge_data = read_edge_record(edge_id);
+    if (!edge_data.has_value()) {
+        return util::unexpected(edge_data.error());
+    }
+    // A key the store never used cannot be in any record
+    auto stored = keys_.find_stored(key);
+    if (!stored.has_value()) {
+        return std::optional<PropertyValue>();
+    }
+    return RecordSerializer::find_edge_property(edge_data.value(), *stored);
+}
+
+util::expected<std::span<const uint8_t>, Error> GraphStore::read_edge_record(EdgeId edge_id) {
     // Find page containing the edge
     PageId page_id;
     {
@@ -244,57 +480,115 @@ util::expected<std::pair<EdgeRecord, std::vector<Property>>, Error> GraphStore::
     }
     
     // For now, assume one edge per page (simplified)
-    auto edge_data = page_data.subspan(sizeof(PageHeader));
-    return RecordSerializer::deserialize_edge(edge_data);
+    return std::span<const uint8_t>(page_data.subspan(sizeof(PageHeader)));
 }
 
 util::expected<std::vector<EdgeId>, Error> GraphStore::get_outgoing_edges(NodeId node_id) {
-    std::lock_guard<std::mutex> lock(adjacency_mutex_);
+    std::shared_lock<std::shared_mutex> lock(adjacency_mutex_);
     auto it = outgoing_edges_.find(node_id);
     if (it == outgoing_edges_.end()) {
         return std::vector<EdgeId>{};
     }
-    return it->second;
+    return edge_ids(it->second);
 }
 
 util::expected<std::vector<EdgeId>, Error> GraphStore::get_incoming_edges(NodeId node_id) {
-    std::lock_guard<std::mutex> lock(adjacency_mutex_);
+    std::shared_lock<std::shared_mutex> lock(adjacency_mutex_);
     auto it = incoming_edges_.find(node_id);
     if (it == incoming_edges_.end()) {
         return std::vector<EdgeId>{};
     }
-    return it->second;
+    return edge_ids(it->second);
 }
 
-util::expected<std::vector<NodeId>, Error> GraphStore::get_adjacent_nodes(NodeId node_id) {
-    std::vector<NodeId> adjacent_nodes;
-    
-    // Get outgoing edges
-    auto outgoing_result = get_outgoing_edges(node_id);
-    if (!outgoing_result.has_value()) {
-        return util::unexpected(outgoing_result.error());
+util::expected<std::vector<NodeId>, Error> GraphStore::get_outgoing_neighbors(NodeId node_id) {
+    std::shared_lock<std::shared_mutex> lock(adjacency_mutex_);
+    auto it = outgoing_edges_.find(node_id);
+    if (it == outgoing_edges_.end()) {
+        return std::vector<NodeId>{};
     }
-    
-    for (EdgeId edge_id : outgoing_result.value()) {
-        auto edge_result = get_edge(edge_id);
-        if (edge_result.has_value()) {
-            adjacent_nodes.push_back(edge_result.value().first.to_node);
+    return neighbor_ids(it->second);
+}
+
+util::expected<std::vector<NodeId>, Error> GraphStore::get_incoming_neighbors(NodeId node_id) {
+    std::shared_lock<std::shared_mutex> lock(adjacency_mutex_);
+    auto it = incoming_edges_.find(node_id);
+    if (it == incoming_edges_.end()) {
+        return std::vector<NodeId>{};
+    }
+    return neighbor_ids(it->second);
+}
+
+void GraphStore::append_outgoing_neighbors(NodeId node_id, std::vector<NodeId>& neighbors) {
+    std::shared_lock<std::shared_mutex> lock(adjacency_mutex_);
+    if (auto it = outgoing_edges_.find(node_id); it != outgoing_edges_.end()) {
+        for (const auto& entry : it->second) {
+            neighbors.push_back(entry.neighbor);
         }
     }
-    
-    // Get incoming edges
-    auto incoming_result = get_incoming_edges(node_id);
-    if (!incoming_result.has_value()) {
-        return util::unexpected(incoming_result.error());
+}
+
+void GraphStore::append_incoming_neighbors(NodeId node_id, std::vector<NodeId>& neighbors) {
+    std::shared_lock<std::shared_mutex> lock(adjacency_mutex_);
+    if (auto it = incoming_edges_.find(node_id); it != incoming_edges_.end()) {
+        for (const auto& entry : it->second) {
+            neighbors.push_back(entry.neighbor);
+        }
     }
-    
-    for (EdgeId edge_id : incoming_result.value()) {
-        auto edge_result = get_edge(edge_id);
-        if (edge_result.has_value()) {
-            adjacent_nodes.push_back(edge_result.value().first.from_node);
+}
+
+void GraphStore::append_outgoing_adjacency(NodeId node_id, std::vector<std::pair<EdgeId, NodeId>>& entries) {
+    std::shared_lock<std::shared_mutex> lock(adjacency_mutex_);
+    if (auto it = outgoing_edges_.find(node_id); it != outgoing_edges_.end()) {
+        for (const auto& entry : it->second) {
+            entries.emplace_back(entry.edge_id, entry.neighbor);
         }
     }
-    
+}
+
+void GraphStore::append_incoming_adjacency(NodeId node_id, std::vector<std::pair<EdgeId, NodeId>>& entries) {
+    std::shared_lock<std::shared_mutex> lock(adjacency_mutex_);
+    if (auto it = incoming_edges_.find(node_id); it != incoming_edges_.end()) {
+        for (const auto& entry : it->second) {
+            entries.emplace_back(entry.edge_id, entry.neighbor);
+        }
+    }
+}
+
+size_t GraphStore::get_degree(NodeId node_id) {
+    std::shared_lock<std::shared_mutex> lock(adjacency_mutex_);
+    size_t degree = 0;
+    if (auto it = outgoing_edges_.find(node_id); it != outgoing_edges_.end()) {
+        degree += it->second.size();
+    }
+    if (auto it = incoming_edges_.find(node_id); it != incoming_edges_.end()) {
+        degree += it->second.size();
+    }
+    return degree;
+}
+
+void GraphStore::for_each_edge_endpoints(const std::function<void(NodeId, NodeId)>& visit) {
+    std::shared_lock<std::shared_mutex> lock(adjacency_mutex_);
+    for (const auto& [from_node, entries] : outgoing_edges_) {
+        for (const auto& entry : entries) {
+            visit(from_node, entry.neighbor);
+        }
+    }
+}
+
+util::expected<std::vector<NodeId>, Error> GraphStore::get_adjacent_nodes(NodeId node_id) {
+    std::vector<NodeId> adjacent_nodes;
+    {
+        std::shared_lock<std::shared_mutex> lock(adjacency_mutex_);
+        for (const auto* lists : {&outgoing_edges_, &incoming_edges_}) {
+            if (auto it = lists->find(node_id); it != lists->end()) {
+                for (const auto& entry : it->second) {
+                    adjacent_nodes.push_back(entry.neighbor);
+                }
+            }
+        }
+    }
+
     // Remove duplicates
     std::sort(adjacent_nodes.begin(), adjacent_nodes.end());
     adjacent_nodes.erase(std::unique(adjacent_nodes.begin(), adjacent_nodes.end()), adjacent_nodes.end());
@@ -338,11 +632,171 @@ size_t GraphStore::get_node_count() const {
     return node_count_.load();
 }
 
+std::vector<NodeId> GraphStore::get_node_ids() {
+    std::vector<NodeId> node_ids;
+    {
+        std::lock_guard<std::mutex> lock(node_index_mutex_);
+        node_ids.reserve(node_page_index_.size());
+        for (const auto& [node_id, page_id] : node_page_index_) {
+            node_ids.push_back(node_id);
+        }
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+    return node_ids;
+}
+
 size_t GraphStore::get_edge_count() const {
     return edge_count_.load();
 }
 
+std::vector<NodeId> GraphStore::find_nodes_by_label(LabelId label) const {
+    return node_labels_.ids(label);
+}
+
+std::vector<EdgeId> GraphStore::find_edges_by_label(LabelId label) const {
+    return edge_labels_.ids(label);
+}
+
+bool GraphStore::node_has_label(NodeId node_id, LabelId label) const {
+    return node_labels_.contains(label, node_id);
+}
+
+bool GraphStore::edge_has_label(EdgeId edge_id, LabelId label) const {
+    return edge_labels_.contains(label, edge_id);
+}
+
+size_t GraphStore::count_nodes_by_label(LabelId label) const {
+    return node_labels_.count(label);
+}
+
+size_t GraphStore::count_edges_by_label(LabelId label) const {
+    return edge_labels_.count(label);
+}
+
+util::expected<std::vector<std::string>, Error> GraphStore::get_node_labels(NodeId node_id) {
+    auto ids = read_node_label_ids(node_id);
+    if (!ids.has_value()) {
+        return util::unexpected(ids.error());
+    }
+    std::vector<std::string> names;
+    names.reserve(ids.value().size());
+    for (LabelId id : ids.value()) {
+        names.push_back(labels_.name(id));
+    }
+    return names;
+}
+
+util::expected<std::vector<LabelId>, Error> GraphStore::read_node_label_ids(NodeId node_id) {
+    PageId page_id;
+    {
+        std::lock_guard<std::mutex> lock(node_index_mutex_);
+        auto it = node_page_index_.find(node_id);
+        if (it == node_page_index_.end()) {
+            return util::unexpected(Error{ErrorCode::NOT_FOUND, "Node not found"});
+        }
+        page_id = it->second;
+    }
+    
+    auto page_result = page_store_->read_page(page_id);
+    if (!page_result.has_value()) {
+        return util::unexpected(page_result.error());
+    }
+    
+    auto page_data = page_result.value();
+    return RecordSerializer::deserialize_node_labels(page_data.subspan(sizeof(PageHeader)));
+}
+
+util::expected<void, Error> GraphStore::persist_dictionary(const StringDictionary& dictionary,
+                                                           DictionaryPages& chain) {
+    std::lock_guard<std::mutex> lock(chain.mutex);
+    if (dictionary.size() == chain.persisted_count) {
+        return {};
+    }
+    
+    const size_t count = dictionary.size();
+    if (auto result = write_metadata_chain(*page_store_, chain.pages, dictionary.serialize()); !result.has_value()) {
+        return result;
+    }
+    chain.persisted_count = count;
+    return {};
+}
+
+util::expected<void, Error> GraphStore::load_dictionary(
+    DictionaryPages& chain, PageId head,
+    const std::function<util::expected<void, Error>(std::span<const uint8_t>)>& load) {
+    std::vector<PageId> pages;
+    auto data = read_metadata_chain(*page_store_, head, pages);
+    if (!data.has_value()) {
+        return util::unexpected(data.error());
+    }
+    if (auto result = load(data.value()); !result.has_value()) {
+        return result;
+    }
+    
+    std::lock_guard<std::mutex> lock(chain.mutex);
+    chain.pages = std::move(pages);
+    // Force a rewrite on the next sync if the dictionary already held more
+    chain.persisted_count = 0;
+    return {};
+}
+
+util::expected<void, Error> GraphStore::persist_label_dictionary() {
+    return persist_dictionary(labels_, label_pages_);
+}
+
+PageId GraphStore::label_dictionary_page() const {
+    return label_pages_.pages.empty() ? INVALID_PAGE_ID : label_pages_.pages.front();
+}
+
+util::expected<void, Error> GraphStore::load_label_dictionary(PageId head) {
+    return load_dictionary(label_pages_, head, [this](std::span<const uint8_t> data) { return labels_.load(data); });
+}
+
+util::expected<void, Error> GraphStore::persist_key_dictionary() {
+    return persist_dictionary(keys_.dictionary(), key_pages_);
+}
+
+PageId GraphStore::key_dictionary_page() const {
+    return key_pages_.pages.empty() ? INVALID_PAGE_ID : key_pages_.pages.front();
+}
+
+util::expected<void, Error> GraphStore::load_key_dictionary(PageId head) {
+    return load_dictionary(key_pages_, head, [this](std::span<const uint8_t> data) { return keys_.load(data); });
+}
+
+util::expected<void, Error> GraphStore::attach_index_manager(std::shared_ptr<SimpleIndexManager> indexes) {
+    if (!indexes || indexes->page_store() != page_store_) {
+        return util::unexpected(Error{ErrorCode::INVALID_ARGUMENT, "Index manager must use the graph's page store"});
+    }
+    std::lock_guard<std::mutex> lock(catalog_mutex_);
+    if (catalog_head_ != INVALID_PAGE_ID) {
+        if (auto result = indexes->load_catalog(catalog_head_); !result.has_value()) {
+            return result;
+        }
+    }
+    index_manager_ = std::move(indexes);
+    return {};
+}
+
 util::expected<void, Error> GraphStore::sync() {
+    if (auto result = persist_label_dictionary(); !result.has_value()) {
+        return result;
+    }
+    if (auto result = persist_key_dictionary(); !result.has_value()) {
+        return result;
+    }
+    {
+        std::lock_guard<std::mutex> lock(catalog_mutex_);
+        if (index_manager_) {
+            if (auto result = index_manager_->persist_catalog(); !result.has_value()) {
+                return result;
+            }
+            catalog_head_ = index_manager_->catalog_page();
+        }
+    }
+    if (auto result = write_superblock(); !result.has_value()) {
+        return result;
+    }
     return page_store_->sync();
 }
 
@@ -352,34 +806,29 @@ util::expected<void, Error> GraphStore::compact() {
 }
 
 util::expected<void, Error> GraphStore::store_node_record(NodeId node_id, const NodeRecord& node, 
-                                                        const std::vector<Property>& properties) {
+                                                        const std::vector<Property>& properties,
+                                                        const std::vector<LabelId>& labels) {
     // Serialize node data
-    auto serialized_data = RecordSerializer::serialize_node(node, properties);
+    auto serialized_data = RecordSerializer::serialize_node(node, properties, labels, &keys_);
     
-    // Allocate page if needed
-    auto page_result = allocate_node_page();
-    if (!page_result.has_value()) {
-        return util::unexpected(page_result.error());
+    // Rewrite the node's page, allocating one for a new node
+    PageId page_id = INVALID_PAGE_ID;
+    {
+        std::lock_guard<std::mutex> lock(node_index_mutex_);
+        if (auto it = node_page_index_.find(node_id); it != node_page_index_.end()) {
+            page_id = it->second;
+        }
+    }
+    if (page_id == INVALID_PAGE_ID) {
+        auto page_result = allocate_node_page();
+        if (!page_result.has_value()) {
+            return util::unexpected(page_result.error());
+        }
+        page_id = page_result.value();
     }
     
-    PageId page_id = page_result.value();
-    
-    // Prepare page data
-    std::vector<uint8_t> page_data(PAGE_SIZE, 0);
-    
-    // Write page header
-    PageHeader header;
-    header.page_id = page_id;
-    header.page_type = static_cast<uint32_t>(PageType::NODE);
-    header.record_count = 1;
-    header.next_free_offset = sizeof(PageHeader) + serialized_data.size();
-    
-    std::memcpy(page_data.data(), &header, sizeof(PageHeader));
-    std::memcpy(page_data.data() + sizeof(PageHeader), serialized_data.data(), serialized_data.size());
-    
-    // Write page
-    if (auto result = page_store_->write_page(page_id, page_data); !result.has_value()) {
-        return util::unexpected(result.error());
+    if (auto result = write_record_page(page_id, PageType::NODE, serialized_data); !result.has_value()) {
+        return result;
     }
     
     // Update node index
@@ -394,62 +843,132 @@ util::expected<void, Error> GraphStore::store_node_record(NodeId node_id, const
 util::expected<void, Error> GraphStore::store_edge_record(EdgeId edge_id, const EdgeRecord& edge, 
                                                         const std::vector<Property>& properties) {
     // Serialize edge data
-    auto serialized_data = RecordSerializer::serialize_edge(edge, properties);
+    auto serialized_data = RecordSerializer::serialize_edge(edge, properties, &keys_);
     
-    // Allocate page if needed
-    auto page_result = allocate_edge_page();
-    if (!page_result.has_value()) {
-        return util::unexpected(page_result.error());
+    // Rewrite the edge's page, allocating one for a new edge
+    PageId page_id = INVALID_PAGE_ID;
+    {
+        std::lock_guard<std::mutex> lock(edge_index_mutex_);
+        if (auto it = edge_page_index_.find(edge_id); it != edge_page_index_.end()) {
+            page_id = it->second;
+        }
+    }
+    if (page_id == INVALID_PAGE_ID) {
+        auto page_result = allocate_edge_page();
+        if (!page_result.has_value()) {
+            return util::unexpected(page_result.error());
+        }
+        page_id = page_result.value();
+    }
+    
+    if (auto result = write_record_page(page_id, PageType::EDGE, serialized_data); !result.has_value()) {
+        return result;
     }
     
-    PageId page_id = page_result.value();
+    // Update edge index
+    {
+        std::lock_guard<std::mutex> lock(edge_index_mutex_);
+        edge_page_index_[edge_id] = page_id;
+    }
     
-    // Prepare page data
+    return {};
+}
+
+util::expected<void, Error> GraphStore::write_record_page(PageId page_id, PageType type,
+                                                          const std::vector<uint8_t>& record) {
     std::vector<uint8_t> page_data(PAGE_SIZE, 0);
     
-    // Write page header
     PageHeader header;
     header.page_id = page_id;
-    header.page_type = static_cast<uint32_t>(PageType::EDGE);
+    header.page_type = static_cast<uint32_t>(type);
     header.record_count = 1;
-    header.next_free_offset = sizeof(PageHeader) + serialized_data.size();
+    header.next_free_offset = sizeof(PageHeader) + record.size();
     
     std::memcpy(page_data.data(), &header, sizeof(PageHeader));
-    std::memcpy(page_data.data() + sizeof(PageHeader), serialized_data.data(), serialized_data.size());
+    std::memcpy(page_data.data() + sizeof(PageHeader), record.data(), record.size());
     
-    // Write page
+    return page_store_->write_page(page_id, page_data);
+}
+
+util::expected<void, Error> GraphStore::free_record_page(PageId page_id) {
+    std::vector<uint8_t> page_data(PAGE_SIZE, 0);
+    PageHeader header;
+    header.page_id = page_id;
+    header.page_type = static_cast<uint32_t>(PageType::FREE);
+    std::memcpy(page_data.data(), &header, sizeof(PageHeader));
     if (auto result = page_store_->write_page(page_id, page_data); !result.has_value()) {
-        return util::unexpected(result.error());
+        return result;
     }
-    
-    // Update edge index
-    {
-        std::lock_guard<std::mutex> lock(edge_index_mutex_);
-        edge_page_index_[edge_id] = page_id;
-    }
-    
-    return {};
+    std::lock_guard<std::mutex> lock(page_alloc_mutex_);
+    return page_store_->deallocate_page(page_id);
 }
 
 util::expected<void, Error> GraphStore::update_adjacency_lists(NodeId from_node, NodeId to_node, EdgeId edge_id, bool add) {
-    std::lock_guard<std::mutex> lock(adjacency_mutex_);
+    std::lock_guard<std::shared_mutex> lock(adjacency_mutex_);
     
+    const auto from_before = node_degrees(from_node);
+    const auto to_before = node_degrees(to_node);
     if (add) {
-        outgoing_edges_[from_node].push_back(edge_id);
-        incoming_edges_[to_node].push_back(edge_id);
+        outgoing_edges_[from_node].push_back({edge_id, to_node});
+        incoming_edges_[to_node].push_back({edge_id, from_node});
     } else {
-        // Remove from outgoing edges
-        auto& outgoing = outgoing_edges_[from_node];
-        outgoing.erase(std::remove(outgoing.begin(), outgoing.end(), edge_id), outgoing.end());
-        
-        // Remove from incoming edges
-        auto& incoming = incoming_edges_[to_node];
-        incoming.erase(std::remove(incoming.begin(), incoming.end(), edge_id), incoming.end());
+        const auto is_edge = [edge_id](const AdjacencyEntry& entry) { return entry.edge_id == edge_id; };
+        std::erase_if(outgoing_edges_[from_node], is_edge);
+        std::erase_if(incoming_edges_[to_node], is_edge);
     }
     
+    if (auto result = update_node_degrees(from_node, from_before); !result.has_value()) {
+        return result;
+    }
+    if (to_node != from_node) {
+        return update_node_degrees(to_node, to_before);
+    }
     return {};
 }
 
+std::pair<size_t, size_t> GraphStore::node_degrees(NodeId node_id) const {
+    std::pair<size_t, size_t> degrees{0, 0};
+    if (auto it = incoming_edges_.find(node_id); it != incoming_edges_.end()) {
+        degrees.first = it->second.size();
+    }
+    if (auto it = outgoing_edges_.find(node_id); it != outgoing_edges_.end()) {
+        degrees.second = it->second.size();
+    }
+    return degrees;
+}
+
+util::expected<void, Error> GraphStore::update_node_degrees(NodeId node_id, std::pair<size_t, size_t> before) {
+    const auto after = node_degrees(node_id);
+    if (after == before) {
+        return {};
+    }
+    // Edges may name nodes that were never created; they have no record or statistics
+    PageId page_id;
+    {
+        std::lock_guard<std::mutex> lock(node_index_mutex_);
+        auto it = node_page_index_.find(node_id);
+        if (it == node_page_index_.end()) {
+            return {};
+        }
+        page_id = it->second;
+    }
+    degree_stats_.update(node_id, before.first, before.second, after.first, after.second);
+
+    // Patch the degrees into the record in place rather than rewriting it
+    auto page_result = page_store_->read_page(page_id);
+    if (!page_result.has_value()) {
+        return util::unexpected(page_result.error());
+    }
+    std::vector<uint8_t> page_data(page_result.value().begin(), page_result.value().end());
+    NodeRecord node;
+    std::memcpy(&node, page_data.data() + sizeof(PageHeader), sizeof(NodeRecord));
+    constexpr size_t MAX_RECORD_DEGREE = UINT32_MAX;
+    node.in_degree = static_cast<uint32_t>(std::min(after.first, MAX_RECORD_DEGREE));
+    node.out_degree = static_cast<uint32_t>(std::min(after.second, MAX_RECORD_DEGREE));
+    std::memcpy(page_data.data() + sizeof(PageHeader), &node, sizeof(NodeRecord));
+    return page_store_->write_page(page_id, page_data);
+}
+
 util::expected<PageId, Error> GraphStore::allocate_node_page() {
     std::lock_guard<std::mutex> lock(page_alloc_mutex_);
     return page_store_->allocate_page();
@@ -469,19 +988,26 @@ EdgeId GraphStore::get_next_edge_id() {
 }
 
 // Legacy create_node without transaction context
-util::expected<NodeId, Error> GraphStore::create_node(const std::vector<Property>& properties) {
+util::expected<NodeId, Error> GraphStore::create_node(const std::vector<Property>& properties,
+                                                     const std::vector<std::string>& labels) {
     NodeId node_id = get_next_node_id();
+    const auto label_ids = intern_labels(labels_, labels);
 
     NodeRecord node;
     node.id = node_id;
+    node.label_count = static_cast<uint32_t>(label_ids.size());
     node.property_count = properties.size();
     node.in_degree = 0;
     node.out_degree = 0;
 
-    if (auto result = store_node_record(node_id, node, properties); !result.has_value()) {
+    if (auto result = store_node_record(node_id, node, properties, label_ids); !result.has_value()) {
         return util::unexpected(result.error());
     }
+    for (LabelId label : label_ids) {
+        node_labels_.add(label, node_id);
+    }
 
+    degree_stats_.add_node();
     node_count_.fetch_add(1);
     return node_id;
 }
@@ -516,7 +1042,7 @@ util::expected<std::pair<NodeRecord, std::vector<Property>>, Error> GraphStore::
     
     // For now, assume one node per page (simplified)
     auto node_data = page_data.subspan(sizeof(PageHeader));
-    return RecordSerializer::deserialize_node(node_data);
+    return RecordSerializer::deserialize_node(node_data, &keys_);
 }
 
 // Legacy edge operations without transaction context
@@ -529,7 +1055,7 @@ util::expected<EdgeId, Error> GraphStore::create_edge(NodeId from_node, NodeId t
     edge.id = edge_id;
     edge.from_node = from_node;
     edge.to_node = to_node;
-    edge.label_id = std::hash<std::string>{}(label);
+    edge.label_id = labels_.intern(label);
     edge.property_count = properties.size();
     edge.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
@@ -542,8 +1068,11 @@ util::expected<EdgeId, Error> GraphStore::create_edge(NodeId from_node, NodeId t
     if (auto result = update_adjacency_lists(from_node, to_node, edge_id, true); !result.has_value()) {
         return util::unexpected(result.error());
     }
+    // Unlabeled edges are posted under NO_LABEL so type filters can still find them
+    edge_labels_.add(edge.label_id, edge_id);
 
     edge_count_.fetch_add(1);
+    edge_version_.fetch_add(1, std::memory_order_release);
     return edge_id;
 }
 
@@ -556,7 +1085,11 @@ util::expected<void, Error> GraphStore::update_edge(EdgeId edge_id, const std::v
     auto [edge, _] = edge_result.value();
     edge.property_count = properties.size();
 
-    return store_edge_record(edge_id, edge, properties);
+    if (auto result = store_edge_record(edge_id, edge, properties); !result.has_value()) {
+        return result;
+    }
+    edge_version_.fetch_add(1, std::memory_order_release);
+    return {};
 }
 
 util::expected<void, Error> GraphStore::delete_edge(EdgeId edge_id) {
@@ -571,12 +1104,21 @@ util::expected<void, Error> GraphStore::delete_edge(EdgeId edge_id) {
         return util::unexpected(result.error());
     }
 
+    PageId page_id = INVALID_PAGE_ID;
     {
         std::lock_guard<std::mutex> lock(edge_index_mutex_);
-        edge_page_index_.erase(edge_id);
+        if (auto it = edge_page_index_.find(edge_id); it != edge_page_index_.end()) {
+            page_id = it->second;
+            edge_page_index_.erase(it);
+        }
     }
+    edge_labels_.remove(edge.label_id, edge_id);
 
     edge_count_.fetch_sub(1);
+    edge_version_.fetch_add(1, std::memory_order_release);
+    if (page_id != INVALID_PAGE_ID) {
+        return free_record_page(page_id);
+    }
     return {};
 }
 
@@ -588,10 +1130,15 @@ util::expected<void, Error> GraphStore::update_node(NodeId node_id,
         return util::unexpected(node_result.error());
     }
 
+    auto label_ids = read_node_label_ids(node_id);
+    if (!label_ids.has_value()) {
+        return util::unexpected(label_ids.error());
+    }
+
     auto [node, _] = node_result.value();
     node.property_count = properties.size();
 
-    return store_node_record(node_id, node, properties);
+    return store_node_record(node_id, node, properties, label_ids.value());
 }
 
 util::expected<void, Error> GraphStore::delete_node(NodeId node_id) {
@@ -607,20 +1154,35 @@ util::expected<void, Error> GraphStore::delete_node(NodeId node_id) {
         return util::unexpected(Error{ErrorCode::INVALID_ARGUMENT, "Cannot delete node with incoming edges"});
     }
 
-    // Remove from node index
+    // Remove from label postings and the node index
+    if (auto label_ids = read_node_label_ids(node_id); label_ids.has_value()) {
+        for (LabelId label : label_ids.value()) {
+            node_labels_.remove(label, node_id);
+        }
+    }
+    PageId page_id = INVALID_PAGE_ID;
     {
         std::lock_guard<std::mutex> lock(node_index_mutex_);
-        node_page_index_.erase(node_id);
+        if (auto it = node_page_index_.find(node_id); it != node_page_index_.end()) {
+            page_id = it->second;
+            node_page_index_.erase(it);
+        }
+    }
+    if (page_id != INVALID_PAGE_ID) {
+        degree_stats_.remove_node(node_id, 0, 0);
     }
 
     // Remove from adjacency lists
     {
-        std::lock_guard<std::mutex> lock(adjacency_mutex_);
+        std::lock_guard<std::shared_mutex> lock(adjacency_mutex_);
         outgoing_edges_.erase(node_id);
         incoming_edges_.erase(node_id);
     }
 
     node_count_.fetch_sub(1);
+    if (page_id != INVALID_PAGE_ID) {
+        return free_record_page(page_id);
+    }
     return {};
 }
 
@@ -6,29 +6,43 @@
 
 #include "page_store.h"
 #include "record.h"
+#include "key_mapping.h"
+#include "degree_statistics.h"
+#include "label_index.h"
 #include "../transaction/mvcc_manager.h"
 #include "../transaction/mvcc.h"
 #include "wal_manager.h"
 #include "../util/expected.h"
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
 namespace loredb::storage {
 
+class SimpleIndexManager;
+
 /**
  * @class GraphStore
  * @brief Main storage engine for nodes and edges, supporting MVCC and WAL.
  *
  * Provides APIs for node/edge CRUD, batch operations, graph traversal, and statistics.
  * Can be constructed with or without MVCC and WAL support.
+ *
+ * Page 1 of the page store is a superblock recording where the metadata
+ * chains start. Constructing a GraphStore over a page store that already
+ * holds a graph reopens it: the dictionaries are loaded and the page index,
+ * adjacency lists, label postings and statistics are rebuilt from the
+ * records. MVCC versions live in memory only and are not recovered.
  */
 class GraphStore {
 public:
     /**
      * @brief Construct a GraphStore with legacy (non-MVCC) behavior.
      * @param page_store Unique pointer to a PageStore implementation.
+     * @throws std::runtime_error if the page store holds pages but no graph superblock.
      */
     explicit GraphStore(std::unique_ptr<PageStore> page_store);
 
@@ -37,21 +51,24 @@ public:
      * @param page_store Unique pointer to a PageStore implementation.
      * @param mvcc_manager Shared pointer to MVCCManager for versioning.
      * @param wal_manager Shared pointer to WALManager for write-ahead logging (optional).
+     * @throws std::runtime_error if the page store holds pages but no graph superblock.
      */
     GraphStore(std::unique_ptr<PageStore> page_store,
                std::shared_ptr<transaction::MVCCManager> mvcc_manager,
                std::shared_ptr<WALManager> wal_manager = nullptr);
-    /** Destructor. */
+    /** Destructor; syncs so the graph can be reopened. */
     ~GraphStore();
     
     /**
      * @brief Create a node in a transaction (MVCC-aware).
      * @param tx_id Transaction ID.
      * @param properties Node properties.
+     * @param labels Node labels, interned in the label dictionary.
      * @return NodeId or Error.
      */
     util::expected<NodeId, Error> create_node(transaction::TransactionId tx_id,
-                                             const std::vector<Property>& properties);
+                                             const std::vector<Property>& properties,
+                                             const std::vector<std::string>& labels = {});
     /**
      * @brief Get a node in a transaction (MVCC-aware).
      * @param tx_id Transaction ID.
@@ -76,7 +93,8 @@ public:
      */
     bool has_mvcc() const { return mvcc_manager_ != nullptr; }
 
-    util::expected<NodeId, Error> create_node(const std::vector<Property>& properties);
+    util::expected<NodeId, Error> create_node(const std::vector<Property>& properties,
+                                             const std::vector<std::string>& labels = {});
     util::expected<void, Error> update_node(
         NodeId node_id,
         const std::vector<Property>& properties);
@@ -125,12 +143,85 @@ public:
     util::expected<void, Error> update_edge(EdgeId edge_id, const std::vector<Property>& properties);
     util::expected<void, Error> delete_edge(EdgeId edge_id);
     util::expected<std::pair<EdgeRecord, std::vector<Property>>, Error> get_edge(EdgeId edge_id);
+    // One property of an edge, read from its record without decoding the
+    // others; nullopt if the edge has no such property
+    util::expected<std::optional<PropertyValue>, Error> get_edge_property(EdgeId edge_id, PropertyKey key);
     
     // Graph traversal
     util::expected<std::vector<EdgeId>, Error> get_outgoing_edges(NodeId node_id);
     util::expected<std::vector<EdgeId>, Error> get_incoming_edges(NodeId node_id);
     util::expected<std::vector<NodeId>, Error> get_adjacent_nodes(NodeId node_id);
+    // Neighbours along the node's outgoing / incoming edges, one per edge, read
+    // from the adjacency lists without decoding any edge record
+    util::expected<std::vector<NodeId>, Error> get_outgoing_neighbors(NodeId node_id);
+    util::expected<std::vector<NodeId>, Error> get_incoming_neighbors(NodeId node_id);
+    // The same, appended to `neighbors` so traversals can reuse one buffer
+    void append_outgoing_neighbors(NodeId node_id, std::vector<NodeId>& neighbors);
+    void append_incoming_neighbors(NodeId node_id, std::vector<NodeId>& neighbors);
+    // (edge, neighbour) pairs of the node's outgoing / incoming edges
+    void append_outgoing_adjacency(NodeId node_id, std::vector<std::pair<EdgeId, NodeId>>& entries);
+    void append_incoming_adjacency(NodeId node_id, std::vector<std::pair<EdgeId, NodeId>>& entries);
+    // Edges at the node in either direction; a self-loop counts twice
+    size_t get_degree(NodeId node_id);
+    // Calls `visit(from, to)` for every edge in the adjacency lists. The lists
+    // stay locked throughout, so the visitor sees one consistent topology; it
+    // must not call back into the store.
+    void for_each_edge_endpoints(const std::function<void(NodeId, NodeId)>& visit);
     
+    // Labels. Node labels and edge types share one dictionary of dense ids; each
+    // label has a sorted posting list of the nodes/edges carrying it. Postings are
+    // not MVCC-aware: tombstoned entities stay posted until physically removed.
+    const LabelDictionary& label_dictionary() const { return labels_; }
+    util::expected<std::vector<std::string>, Error> get_node_labels(NodeId node_id);
+    std::vector<NodeId> find_nodes_by_label(LabelId label) const;
+    std::vector<EdgeId> find_edges_by_label(LabelId label) const;
+    bool node_has_label(NodeId node_id, LabelId label) const;
+    bool edge_has_label(EdgeId edge_id, LabelId label) const;
+    size_t count_nodes_by_label(LabelId label) const;
+    size_t count_edges_by_label(LabelId label) const;
+
+    /**
+     * @brief Write the label dictionary to METADATA pages if it changed since the last call.
+     *
+     * Called by sync(). The dictionary is written as a chain of pages linked
+     * through PageHeader::next_page_id; label_dictionary_page() is its head,
+     * recorded in the superblock by sync().
+     * @return Success or Error.
+     */
+    util::expected<void, Error> persist_label_dictionary();
+    PageId label_dictionary_page() const;
+    /**
+     * @brief Load a label dictionary written by persist_label_dictionary().
+     *
+     * The constructor calls this with the head recorded in the superblock.
+     * @param head First page of the dictionary chain.
+     * @return Success or Error.
+     */
+    util::expected<void, Error> load_label_dictionary(PageId head);
+
+    // Records store property keys as ids of the store's own key dictionary,
+    // translated from the process-wide PropertyKey ids as they are written and
+    // back as they are read. It is persisted alongside the data the same way
+    // as labels and loaded when the store opens.
+    const StringDictionary& key_dictionary() const { return keys_.dictionary(); }
+    util::expected<void, Error> persist_key_dictionary();
+    PageId key_dictionary_page() const;
+    util::expected<void, Error> load_key_dictionary(PageId head);
+    
+    // Page store holding the graph; index structures may allocate pages in it too
+    std::shared_ptr<PageStore> page_store() const { return page_store_; }
+
+    /**
+     * @brief Persist `indexes`' catalog with the graph.
+     *
+     * Loads the catalog recorded in the superblock, if any, so declared
+     * indexes reopen without a rebuild; from then on sync() persists the
+     * catalog and records its head.
+     * @param indexes Index manager keeping its trees in page_store().
+     * @return Success, INVALID_ARGUMENT for a manager using another page store, or a load Error.
+     */
+    util::expected<void, Error> attach_index_manager(std::shared_ptr<SimpleIndexManager> indexes);
+
     // Batch operations
     util::expected<void, Error> batch_create_nodes(
         const std::vector<std::vector<Property>>& node_properties,
@@ -141,29 +232,71 @@ public:
     
     // Statistics
     size_t get_node_count() const;
+    // Degree distribution and hubs, maintained on every edge change. Node
+    // records carry the same in/out degrees.
+    const DegreeStatistics& degree_statistics() const { return degree_stats_; }
+    // One past the largest node id handed out, for sizing per-node arrays
+    NodeId get_node_id_limit() const { return next_node_id_.load(); }
+    // Bumped by every edge created, updated or deleted, so caches derived from
+    // edges and their properties can tell when they are stale
+    uint64_t get_edge_version() const { return edge_version_.load(std::memory_order_acquire); }
+    // Ids of the nodes held in storage, ascending. Like the adjacency lists
+    // this is physical: nodes deleted under MVCC stay until removed.
+    std::vector<NodeId> get_node_ids();
     size_t get_edge_count() const;
     
-    // Maintenance
+    // Maintenance. sync() persists the dictionaries and the attached index
+    // catalog and records their heads in the superblock before syncing the
+    // page store.
     util::expected<void, Error> sync();
     util::expected<void, Error> compact();
 
 private:
+    // Loads the superblock of a page store holding a graph and rebuilds the
+    // in-memory state from its records, or writes a fresh superblock
+    util::expected<void, Error> open();
+    util::expected<void, Error> rebuild_from_records();
+    util::expected<void, Error> write_superblock();
     util::expected<PageId, Error> allocate_node_page();
     util::expected<PageId, Error> allocate_edge_page();
     util::expected<void, Error> store_node_record(NodeId node_id, const NodeRecord& node, 
-                                                const std::vector<Property>& properties);
+                                                const std::vector<Property>& properties,
+                                                const std::vector<LabelId>& labels = {});
+    util::expected<std::vector<LabelId>, Error> read_node_label_ids(NodeId node_id);
     util::expected<void, Error> store_edge_record(EdgeId edge_id, const EdgeRecord& edge, 
                                                 const std::vector<Property>& properties);
+    // Records are rewritten in place, so each id occupies exactly one page;
+    // freed pages are marked FREE so reopening does not resurrect them
+    util::expected<void, Error> write_record_page(PageId page_id, PageType type, const std::vector<uint8_t>& record);
+    util::expected<void, Error> free_record_page(PageId page_id);
+    // The serialized record of `edge_id` within its page
+    util::expected<std::span<const uint8_t>, Error> read_edge_record(EdgeId edge_id);
+    // METADATA page chain holding a serialized StringDictionary
+    struct DictionaryPages {
+        std::mutex mutex;
+        std::vector<PageId> pages;
+        size_t persisted_count = 0;
+    };
+    util::expected<void, Error> persist_dictionary(const StringDictionary& dictionary, DictionaryPages& chain);
+    // Reads the chain at `head` and hands the blob to `load`
+    util::expected<void, Error> load_dictionary(
+        DictionaryPages& chain, PageId head,
+        const std::function<util::expected<void, Error>(std::span<const uint8_t>)>& load);
+
     util::expected<void, Error> update_adjacency_lists(
         NodeId from_node,
         NodeId to_node,
         EdgeId edge_id,
         bool add);
+    // With adjacency_mutex_ held: records that `node_id`'s (in, out) degrees
+    // were `before` in the statistics and the node record
+    util::expected<void, Error> update_node_degrees(NodeId node_id, std::pair<size_t, size_t> before);
+    std::pair<size_t, size_t> node_degrees(NodeId node_id) const;
     
     NodeId get_next_node_id();
     EdgeId get_next_edge_id();
     
-    std::unique_ptr<PageStore> page_store_;
+    std::shared_ptr<PageStore> page_store_;
     
     // ID generators
     std::atomic<NodeId> next_node_id_;
@@ -176,14 +309,37 @@ private:
     std::mutex edge_index_mutex_;
     std::unordered_map<EdgeId, PageId> edge_page_index_;
     
-    // Adjacency lists (simplified for now)
-    std::mutex adjacency_mutex_;
-    std::unordered_map<NodeId, std::vector<EdgeId>> outgoing_edges_;
-    std::unordered_map<NodeId, std::vector<EdgeId>> incoming_edges_;
+    // Adjacency lists; each entry keeps the node at the edge's other end so
+    // traversals need not read the edge. Readers share the lock, so parallel
+    // traversals do not serialize on it.
+    struct AdjacencyEntry {
+        EdgeId edge_id;
+        NodeId neighbor;
+    };
+    std::shared_mutex adjacency_mutex_;
+    std::unordered_map<NodeId, std::vector<AdjacencyEntry>> outgoing_edges_;
+    std::unordered_map<NodeId, std::vector<AdjacencyEntry>> incoming_edges_;
     
     // Statistics
     std::atomic<size_t> node_count_;
     std::atomic<size_t> edge_count_;
+    std::atomic<uint64_t> edge_version_{0};
+    DegreeStatistics degree_stats_;
+    
+    // Label dictionary and label postings
+    LabelDictionary labels_;
+    LabelIndex node_labels_;
+    LabelIndex edge_labels_;
+    DictionaryPages label_pages_;
+    KeyMapping keys_;
+    DictionaryPages key_pages_;
+    std::mutex superblock_mutex_;
+
+    // Index manager whose catalog is persisted with the graph, and the head of
+    // the catalog recorded in the superblock
+    std::mutex catalog_mutex_;
+    std::shared_ptr<SimpleIndexManager> index_manager_;
+    PageId catalog_head_ = INVALID_PAGE_ID;
     
     // Page allocation
     std::mutex page_alloc_mutex_;
@@ -0,0 +1,67 @@
+#include "key_mapping.h"
+#include <mutex>
+
+namespace loredb::storage {
+
+KeyId KeyMapping::to_stored(PropertyKey key) {
+    if (key.id() == 0) {
+        return 0;
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        if (key.id() < to_stored_.size() && to_stored_[key.id()] != 0) {
+            return to_stored_[key.id()];
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    const KeyId stored = stored_.intern(key.str());
+    map(stored, key);
+    return stored;
+}
+
+std::optional<KeyId> KeyMapping::find_stored(PropertyKey key) const {
+    if (key.id() == 0) {
+        return KeyId{0};
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (key.id() < to_stored_.size() && to_stored_[key.id()] != 0) {
+        return to_stored_[key.id()];
+    }
+    return std::nullopt;
+}
+
+std::optional<PropertyKey> KeyMapping::from_stored(KeyId id) const {
+    if (id == 0) {
+        return PropertyKey();
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (id < from_stored_.size()) {
+        return from_stored_[id];
+    }
+    return std::nullopt;
+}
+
+util::expected<void, Error> KeyMapping::load(std::span<const uint8_t> data) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (auto result = stored_.load(data); !result.has_value()) {
+        return result;
+    }
+    for (size_t id = from_stored_.empty() ? 1 : from_stored_.size(); id <= stored_.size(); ++id) {
+        map(static_cast<KeyId>(id), PropertyKey(stored_.name(static_cast<KeyId>(id))));
+    }
+    return {};
+}
+
+void KeyMapping::map(KeyId stored, PropertyKey key) {
+    if (to_stored_.size() <= key.id()) {
+        to_stored_.resize(key.id() + 1, 0);
+    }
+    to_stored_[key.id()] = stored;
+    if (from_stored_.size() <= stored) {
+        from_stored_.resize(stored + 1);
+    }
+    from_stored_[stored] = key;
+}
+
+}  // namespace loredb::storage
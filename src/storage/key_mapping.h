@@ -0,0 +1,51 @@
+/// \file key_mapping.h
+/// \brief Per-store property key dictionary and its mapping to process-wide key ids.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "property_key.h"
+#include "string_dictionary.h"
+#include "../util/expected.h"
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <vector>
+
+namespace loredb::storage {
+
+/**
+ * @class KeyMapping
+ * @brief The key dictionary of one store, translated to and from PropertyKey ids.
+ *
+ * PropertyKey ids are assigned per process in first-use order, so they cannot
+ * be written to disk: another process, or another store in this one, numbers
+ * the same keys differently. Records store ids from the store's own dictionary
+ * instead, which only holds keys the store used and is persisted with it.
+ * Loading it interns its names into the process dictionary, so it never
+ * conflicts with keys the process already knows.
+ */
+class KeyMapping {
+public:
+    // Stored id of `key`, assigning the next one on first use
+    KeyId to_stored(PropertyKey key);
+    // Stored id of `key` if the store ever used it
+    std::optional<KeyId> find_stored(PropertyKey key) const;
+    // Process key behind a stored id; nullopt for ids the store never assigned
+    std::optional<PropertyKey> from_stored(KeyId id) const;
+
+    const StringDictionary& dictionary() const { return stored_; }
+    // Extends the store dictionary with one produced by dictionary().serialize()
+    util::expected<void, Error> load(std::span<const uint8_t> data);
+
+private:
+    // Caller holds the write lock
+    void map(KeyId stored, PropertyKey key);
+
+    StringDictionary stored_;
+    mutable std::shared_mutex mutex_;
+    std::vector<KeyId> to_stored_;           // By PropertyKey id; 0 when unmapped
+    std::vector<PropertyKey> from_stored_;   // By stored id
+};
+
+}  // namespace loredb::storage
@@ -0,0 +1,60 @@
+#include "label_index.h"
+#include <algorithm>
+#include <mutex>
+
+namespace loredb::storage {
+
+void LabelIndex::add(LabelId label, uint64_t id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto& ids = postings_[label];
+    if (ids.empty() || ids.back() < id) {
+        ids.push_back(id);
+        return;
+    }
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() || *it != id) {
+        ids.insert(it, id);
+    }
+}
+
+void LabelIndex::remove(LabelId label, uint64_t id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto posting = postings_.find(label);
+    if (posting == postings_.end()) {
+        return;
+    }
+    auto& ids = posting->second;
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it != ids.end() && *it == id) {
+        ids.erase(it);
+    }
+}
+
+bool LabelIndex::contains(LabelId label, uint64_t id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto posting = postings_.find(label);
+    return posting != postings_.end() &&
+           std::binary_search(posting->second.begin(), posting->second.end(), id);
+}
+
+std::vector<uint64_t> LabelIndex::ids(LabelId label) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto posting = postings_.find(label);
+    if (posting == postings_.end()) {
+        return {};
+    }
+    return posting->second;
+}
+
+size_t LabelIndex::count(LabelId label) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto posting = postings_.find(label);
+    return posting == postings_.end() ? 0 : posting->second.size();
+}
+
+void LabelIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    postings_.clear();
+}
+
+}  // namespace loredb::storage
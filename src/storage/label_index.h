@@ -0,0 +1,50 @@
+/// \file label_index.h
+/// \brief Label dictionary and label-to-entity postings for nodes and edges.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "string_dictionary.h"
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace loredb::storage {
+
+using LabelId = StringDictionary::Id;
+
+// Id of the empty label: unlabeled edges and the "no label" value of records
+constexpr LabelId NO_LABEL = 0;
+
+// Node labels and edge types share one dictionary; records store the ids and
+// strings are only resolved at the API boundary
+using LabelDictionary = StringDictionary;
+
+/**
+ * @class LabelIndex
+ * @brief Per-label sorted posting lists of entity ids.
+ *
+ * Ids are allocated in increasing order, so postings are normally appended;
+ * out-of-order inserts fall back to a sorted insert. Membership tests are a
+ * binary search, which lets callers reject entities by label without reading
+ * and decoding their records.
+ */
+class LabelIndex {
+public:
+    void add(LabelId label, uint64_t id);
+    void remove(LabelId label, uint64_t id);
+    bool contains(LabelId label, uint64_t id) const;
+
+    // Sorted ids posted under `label`
+    std::vector<uint64_t> ids(LabelId label) const;
+    size_t count(LabelId label) const;
+
+    void clear();
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<LabelId, std::vector<uint64_t>> postings_;
+};
+
+}  // namespace loredb::storage
@@ -0,0 +1,62 @@
+#include "memory_page_store.h"
+#include <algorithm>
+
+namespace loredb::storage {
+
+util::expected<PageId, Error> MemoryPageStore::allocate_page() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_pages_.empty()) {
+        PageId page_id = free_pages_.back();
+        free_pages_.pop_back();
+        pages_[page_id - 1] = std::make_unique<Page>();
+        return page_id;
+    }
+    pages_.push_back(std::make_unique<Page>());
+    return static_cast<PageId>(pages_.size());
+}
+
+util::expected<void, Error> MemoryPageStore::deallocate_page(PageId page_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!is_live(page_id)) {
+        return util::unexpected(Error{ErrorCode::INVALID_ARGUMENT, "Invalid page ID"});
+    }
+    pages_[page_id - 1].reset();
+    free_pages_.push_back(page_id);
+    return {};
+}
+
+util::expected<std::span<uint8_t>, Error> MemoryPageStore::read_page(PageId page_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!is_live(page_id)) {
+        return util::unexpected(Error{ErrorCode::INVALID_ARGUMENT, "Invalid page ID"});
+    }
+    return std::span<uint8_t>(pages_[page_id - 1]->data(), PAGE_SIZE);
+}
+
+util::expected<void, Error> MemoryPageStore::write_page(PageId page_id, std::span<const uint8_t> data) {
+    if (data.size() != PAGE_SIZE) {
+        return util::unexpected(Error{ErrorCode::INVALID_ARGUMENT, "Page data size must be PAGE_SIZE"});
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!is_live(page_id)) {
+        return util::unexpected(Error{ErrorCode::INVALID_ARGUMENT, "Invalid page ID"});
+    }
+    std::copy(data.begin(), data.end(), pages_[page_id - 1]->begin());
+    return {};
+}
+
+size_t MemoryPageStore::get_page_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pages_.size();
+}
+
+size_t MemoryPageStore::get_allocated_pages() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pages_.size() - free_pages_.size();
+}
+
+bool MemoryPageStore::is_live(PageId page_id) const {
+    return page_id != INVALID_PAGE_ID && page_id <= pages_.size() && pages_[page_id - 1] != nullptr;
+}
+
+}  // namespace loredb::storage
@@ -0,0 +1,50 @@
+/// \file memory_page_store.h
+/// \brief In-memory page store for indexes and tests that need no file.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "page_store.h"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace loredb::storage {
+
+/**
+ * @class MemoryPageStore
+ * @brief PageStore keeping every page in memory.
+ *
+ * Page ids start at 1 (0 is INVALID_PAGE_ID) and freed pages are reused. Pages
+ * never move once allocated, so a span returned by read_page() stays readable
+ * until the page is written or the store is destroyed.
+ */
+class MemoryPageStore : public PageStore {
+public:
+    MemoryPageStore() = default;
+    MemoryPageStore(const MemoryPageStore&) = delete;
+    MemoryPageStore& operator=(const MemoryPageStore&) = delete;
+
+    util::expected<PageId, Error> allocate_page() override;
+    util::expected<void, Error> deallocate_page(PageId page_id) override;
+    util::expected<std::span<uint8_t>, Error> read_page(PageId page_id) override;
+    util::expected<void, Error> write_page(PageId page_id, std::span<const uint8_t> data) override;
+    util::expected<void, Error> sync() override { return {}; }
+    util::expected<void, Error> close() override { return {}; }
+
+    size_t get_page_count() const override;
+    size_t get_allocated_pages() const override;
+
+private:
+    using Page = std::array<uint8_t, PAGE_SIZE>;
+
+    bool is_live(PageId page_id) const;
+
+    mutable std::mutex mutex_;
+    // pages_[i] holds page i + 1; a null entry is a freed page
+    std::vector<std::unique_ptr<Page>> pages_;
+    std::vector<PageId> free_pages_;
+};
+
+}  // namespace loredb::storage
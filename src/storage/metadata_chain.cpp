@@ -0,0 +1,70 @@
+#include "metadata_chain.h"
+#include <algorithm>
+#include <cstring>
+
+namespace loredb::storage {
+
+util::expected<void, Error> write_metadata_chain(PageStore& store, std::vector<PageId>& pages,
+                                                 std::span<const uint8_t> data) {
+    constexpr size_t CHUNK_SIZE = PAGE_SIZE - sizeof(PageHeader);
+    const size_t pages_needed = std::max<size_t>(1, (data.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+    while (pages.size() < pages_needed) {
+        auto page_result = store.allocate_page();
+        if (!page_result.has_value()) {
+            return util::unexpected(page_result.error());
+        }
+        pages.push_back(page_result.value());
+    }
+
+    std::vector<uint8_t> page_data(PAGE_SIZE);
+    for (size_t i = 0; i < pages.size(); ++i) {
+        const size_t offset = std::min(data.size(), i * CHUNK_SIZE);
+        const size_t chunk = std::min(CHUNK_SIZE, data.size() - offset);
+
+        std::fill(page_data.begin(), page_data.end(), 0);
+        PageHeader header;
+        header.page_id = pages[i];
+        header.page_type = static_cast<uint32_t>(PageType::METADATA);
+        header.record_count = 1;
+        header.next_free_offset = sizeof(PageHeader) + chunk;
+        header.next_page_id = i + 1 < pages_needed ? pages[i + 1] : INVALID_PAGE_ID;
+
+        std::memcpy(page_data.data(), &header, sizeof(PageHeader));
+        if (chunk > 0) {
+            std::memcpy(page_data.data() + sizeof(PageHeader), data.data() + offset, chunk);
+        }
+        if (auto result = store.write_page(pages[i], page_data); !result.has_value()) {
+            return util::unexpected(result.error());
+        }
+    }
+    return {};
+}
+
+util::expected<std::vector<uint8_t>, Error> read_metadata_chain(PageStore& store, PageId head,
+                                                                std::vector<PageId>& pages) {
+    std::vector<uint8_t> data;
+    pages.clear();
+    for (PageId page_id = head; page_id != INVALID_PAGE_ID;) {
+        auto page_result = store.read_page(page_id);
+        if (!page_result.has_value()) {
+            return util::unexpected(page_result.error());
+        }
+
+        auto page_data = page_result.value();
+        PageHeader header;
+        std::memcpy(&header, page_data.data(), sizeof(PageHeader));
+        if (header.page_type != static_cast<uint32_t>(PageType::METADATA) ||
+            header.next_free_offset < sizeof(PageHeader) || header.next_free_offset > PAGE_SIZE ||
+            pages.size() > store.get_page_count()) {
+            return util::unexpected(Error{ErrorCode::CORRUPTION, "Invalid metadata page"});
+        }
+
+        data.insert(data.end(), page_data.begin() + sizeof(PageHeader), page_data.begin() + header.next_free_offset);
+        pages.push_back(page_id);
+        page_id = header.next_page_id;
+    }
+    return data;
+}
+
+}  // namespace loredb::storage
@@ -0,0 +1,34 @@
+/// \file metadata_chain.h
+/// \brief Blobs stored as chains of METADATA pages.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "page_store.h"
+#include "../util/expected.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace loredb::storage {
+
+/**
+ * @brief Write `data` over the METADATA page chain `pages`, allocating more pages when it no longer fits.
+ *
+ * Pages are linked through PageHeader::next_page_id; pages.front() is the
+ * head. The chain is rewritten in place and never shrinks, so its head stays
+ * stable across rewrites.
+ * @return Success or Error.
+ */
+util::expected<void, Error> write_metadata_chain(PageStore& store, std::vector<PageId>& pages,
+                                                 std::span<const uint8_t> data);
+
+/**
+ * @brief Read the blob written by write_metadata_chain() starting at `head`.
+ * @param pages Receives the chain's pages, so a later write reuses them.
+ * @return The blob, or CORRUPTION when a page is not part of a chain.
+ */
+util::expected<std::vector<uint8_t>, Error> read_metadata_chain(PageStore& store, PageId head,
+                                                                std::vector<PageId>& pages);
+
+}  // namespace loredb::storage
@@ -123,7 +123,8 @@ enum class PropertyType : uint8_t {
     BOOLEAN = 3,
     BYTES = 4,
     ARRAY = 5,
-    OBJECT = 6
+    OBJECT = 6,
+    VECTOR = 7  // Dense float32 vector, e.g. a document embedding
 };
 
 }  // namespace loredb::storage
\ No newline at end of file
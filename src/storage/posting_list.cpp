@@ -0,0 +1,373 @@
+#include "posting_list.h"
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+namespace loredb::storage {
+
+namespace {
+
+// Beyond this size ratio, intersecting arrays gallops through the larger one
+constexpr size_t GALLOP_RATIO = 32;
+
+// First position in [first, last) not less than `value`, probing exponentially
+// from `first` so a run of nearby lookups costs O(log distance) each
+std::vector<uint16_t>::const_iterator gallop(std::vector<uint16_t>::const_iterator first,
+                                             std::vector<uint16_t>::const_iterator last, uint16_t value) {
+    size_t step = 1;
+    auto low = first;
+    while (std::distance(low, last) > static_cast<std::ptrdiff_t>(step) && low[step] < value) {
+        low += step;
+        step *= 2;
+    }
+    auto high = std::distance(low, last) > static_cast<std::ptrdiff_t>(step) ? low + step + 1 : last;
+    return std::lower_bound(low, high, value);
+}
+
+std::vector<uint16_t> intersect_arrays(const std::vector<uint16_t>& a, const std::vector<uint16_t>& b) {
+    const auto& small = a.size() <= b.size() ? a : b;
+    const auto& large = a.size() <= b.size() ? b : a;
+    std::vector<uint16_t> out;
+    if (large.size() / GALLOP_RATIO > small.size()) {
+        auto it = large.begin();
+        for (uint16_t value : small) {
+            it = gallop(it, large.end(), value);
+            if (it == large.end()) {
+                break;
+            }
+            if (*it == value) {
+                out.push_back(value);
+            }
+        }
+        return out;
+    }
+    out.reserve(small.size());
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    return out;
+}
+
+bool test_bit(const std::vector<uint64_t>& bitmap, uint16_t low) {
+    return (bitmap[low >> 6] >> (low & 63)) & 1;
+}
+
+uint32_t count_bits(const std::vector<uint64_t>& bitmap) {
+    uint32_t count = 0;
+    for (uint64_t word : bitmap) {
+        count += std::popcount(word);
+    }
+    return count;
+}
+
+}  // namespace
+
+bool PostingList::Container::add(uint16_t low) {
+    if (is_bitmap()) {
+        uint64_t& word = bitmap[low >> 6];
+        const uint64_t bit = uint64_t{1} << (low & 63);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        ++cardinality;
+        return true;
+    }
+
+    auto it = std::lower_bound(array.begin(), array.end(), low);
+    if (it != array.end() && *it == low) {
+        return false;
+    }
+    array.insert(it, low);
+    ++cardinality;
+    normalize();
+    return true;
+}
+
+bool PostingList::Container::remove(uint16_t low) {
+    if (is_bitmap()) {
+        uint64_t& word = bitmap[low >> 6];
+        const uint64_t bit = uint64_t{1} << (low & 63);
+        if (!(word & bit)) {
+            return false;
+        }
+        word &= ~bit;
+        --cardinality;
+        normalize();
+        return true;
+    }
+
+    auto it = std::lower_bound(array.begin(), array.end(), low);
+    if (it == array.end() || *it != low) {
+        return false;
+    }
+    array.erase(it);
+    --cardinality;
+    return true;
+}
+
+bool PostingList::Container::contains(uint16_t low) const {
+    if (is_bitmap()) {
+        return test_bit(bitmap, low);
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+void PostingList::Container::append_to(std::vector<uint64_t>& out) const {
+    const uint64_t high = key << 16;
+    if (!is_bitmap()) {
+        for (uint16_t low : array) {
+            out.push_back(high | low);
+        }
+        return;
+    }
+    for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+        for (uint64_t bits = bitmap[w]; bits != 0; bits &= bits - 1) {
+            out.push_back(high | (w * 64 + std::countr_zero(bits)));
+        }
+    }
+}
+
+void PostingList::Container::normalize() {
+    if (is_bitmap() && cardinality <= ARRAY_MAX) {
+        to_array();
+    } else if (!is_bitmap() && cardinality > ARRAY_MAX) {
+        to_bitmap();
+    }
+}
+
+void PostingList::Container::to_bitmap() {
+    bitmap.assign(BITMAP_WORDS, 0);
+    for (uint16_t low : array) {
+        bitmap[low >> 6] |= uint64_t{1} << (low & 63);
+    }
+    array.clear();
+    array.shrink_to_fit();
+}
+
+void PostingList::Container::to_array() {
+    array.clear();
+    array.reserve(cardinality);
+    for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+        for (uint64_t bits = bitmap[w]; bits != 0; bits &= bits - 1) {
+            array.push_back(static_cast<uint16_t>(w * 64 + std::countr_zero(bits)));
+        }
+    }
+    bitmap.clear();
+    bitmap.shrink_to_fit();
+}
+
+void PostingList::Container::intersect(const Container& other) {
+    if (is_bitmap() && other.is_bitmap()) {
+        for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+            bitmap[w] &= other.bitmap[w];
+        }
+        cardinality = count_bits(bitmap);
+    } else if (is_bitmap()) {
+        // The result is no larger than the other side's array
+        std::vector<uint16_t> kept;
+        kept.reserve(other.array.size());
+        std::copy_if(other.array.begin(), other.array.end(), std::back_inserter(kept),
+                     [this](uint16_t low) { return test_bit(bitmap, low); });
+        bitmap.clear();
+        bitmap.shrink_to_fit();
+        array = std::move(kept);
+        cardinality = static_cast<uint32_t>(array.size());
+    } else if (other.is_bitmap()) {
+        std::erase_if(array, [&other](uint16_t low) { return !test_bit(other.bitmap, low); });
+        cardinality = static_cast<uint32_t>(array.size());
+    } else {
+        array = intersect_arrays(array, other.array);
+        cardinality = static_cast<uint32_t>(array.size());
+    }
+    normalize();
+}
+
+void PostingList::Container::unite(const Container& other) {
+    if (!is_bitmap() && !other.is_bitmap()) {
+        std::vector<uint16_t> merged;
+        merged.reserve(array.size() + other.array.size());
+        std::set_union(array.begin(), array.end(), other.array.begin(), other.array.end(),
+                       std::back_inserter(merged));
+        array = std::move(merged);
+        cardinality = static_cast<uint32_t>(array.size());
+        normalize();
+        return;
+    }
+    if (!is_bitmap()) {
+        to_bitmap();
+    }
+    if (other.is_bitmap()) {
+        for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+            bitmap[w] |= other.bitmap[w];
+        }
+    } else {
+        for (uint16_t low : other.array) {
+            bitmap[low >> 6] |= uint64_t{1} << (low & 63);
+        }
+    }
+    cardinality = count_bits(bitmap);
+    normalize();
+}
+
+void PostingList::Container::subtract(const Container& other) {
+    if (is_bitmap() && other.is_bitmap()) {
+        for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+            bitmap[w] &= ~other.bitmap[w];
+        }
+        cardinality = count_bits(bitmap);
+    } else if (is_bitmap()) {
+        for (uint16_t low : other.array) {
+            bitmap[low >> 6] &= ~(uint64_t{1} << (low & 63));
+        }
+        cardinality = count_bits(bitmap);
+    } else if (other.is_bitmap()) {
+        std::erase_if(array, [&other](uint16_t low) { return test_bit(other.bitmap, low); });
+        cardinality = static_cast<uint32_t>(array.size());
+    } else {
+        std::vector<uint16_t> kept;
+        kept.reserve(array.size());
+        std::set_difference(array.begin(), array.end(), other.array.begin(), other.array.end(),
+                            std::back_inserter(kept));
+        array = std::move(kept);
+        cardinality = static_cast<uint32_t>(array.size());
+    }
+    normalize();
+}
+
+PostingList PostingList::from_ids(std::span<const uint64_t> ids) {
+    std::vector<uint64_t> sorted(ids.begin(), ids.end());
+    if (!std::is_sorted(sorted.begin(), sorted.end())) {
+        std::sort(sorted.begin(), sorted.end());
+    }
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    // Sorted input appends to the last container, so no searching or shifting
+    PostingList list;
+    for (uint64_t id : sorted) {
+        if (list.containers_.empty() || list.containers_.back().key != id >> 16) {
+            Container container;
+            container.key = id >> 16;
+            list.containers_.push_back(std::move(container));
+        }
+        Container& container = list.containers_.back();
+        container.array.push_back(static_cast<uint16_t>(id));
+        ++container.cardinality;
+    }
+    for (auto& container : list.containers_) {
+        container.normalize();
+    }
+    list.size_ = sorted.size();
+    return list;
+}
+
+std::vector<PostingList::Container>::iterator PostingList::find_container(uint64_t key) {
+    return std::lower_bound(containers_.begin(), containers_.end(), key,
+                            [](const Container& c, uint64_t k) { return c.key < k; });
+}
+
+std::vector<PostingList::Container>::const_iterator PostingList::find_container(uint64_t key) const {
+    return std::lower_bound(containers_.begin(), containers_.end(), key,
+                            [](const Container& c, uint64_t k) { return c.key < k; });
+}
+
+void PostingList::recount() {
+    std::erase_if(containers_, [](const Container& c) { return c.cardinality == 0; });
+    size_ = 0;
+    for (const auto& container : containers_) {
+        size_ += container.cardinality;
+    }
+}
+
+bool PostingList::add(uint64_t id) {
+    const uint64_t key = id >> 16;
+    auto it = find_container(key);
+    if (it == containers_.end() || it->key != key) {
+        Container container;
+        container.key = key;
+        it = containers_.insert(it, std::move(container));
+    }
+    if (!it->add(static_cast<uint16_t>(id))) {
+        return false;
+    }
+    ++size_;
+    return true;
+}
+
+bool PostingList::remove(uint64_t id) {
+    const uint64_t key = id >> 16;
+    auto it = find_container(key);
+    if (it == containers_.end() || it->key != key || !it->remove(static_cast<uint16_t>(id))) {
+        return false;
+    }
+    if (it->cardinality == 0) {
+        containers_.erase(it);
+    }
+    --size_;
+    return true;
+}
+
+bool PostingList::contains(uint64_t id) const {
+    const uint64_t key = id >> 16;
+    auto it = find_container(key);
+    return it != containers_.end() && it->key == key && it->contains(static_cast<uint16_t>(id));
+}
+
+std::vector<uint64_t> PostingList::ids() const {
+    std::vector<uint64_t> out;
+    out.reserve(size_);
+    for (const auto& container : containers_) {
+        container.append_to(out);
+    }
+    return out;
+}
+
+PostingList& PostingList::operator&=(const PostingList& other) {
+    auto theirs = other.containers_.begin();
+    for (auto& container : containers_) {
+        while (theirs != other.containers_.end() && theirs->key < container.key) {
+            ++theirs;
+        }
+        if (theirs == other.containers_.end() || theirs->key != container.key) {
+            container.cardinality = 0;
+            continue;
+        }
+        container.intersect(*theirs);
+    }
+    recount();
+    return *this;
+}
+
+PostingList& PostingList::operator|=(const PostingList& other) {
+    std::vector<Container> merged;
+    merged.reserve(containers_.size() + other.containers_.size());
+    auto ours = containers_.begin();
+    auto theirs = other.containers_.begin();
+    while (ours != containers_.end() || theirs != other.containers_.end()) {
+        if (theirs == other.containers_.end() || (ours != containers_.end() && ours->key < theirs->key)) {
+            merged.push_back(std::move(*ours++));
+        } else if (ours == containers_.end() || theirs->key < ours->key) {
+            merged.push_back(*theirs++);
+        } else {
+            ours->unite(*theirs++);
+            merged.push_back(std::move(*ours++));
+        }
+    }
+    containers_ = std::move(merged);
+    recount();
+    return *this;
+}
+
+PostingList& PostingList::operator-=(const PostingList& other) {
+    auto theirs = other.containers_.begin();
+    for (auto& container : containers_) {
+        while (theirs != other.containers_.end() && theirs->key < container.key) {
+            ++theirs;
+        }
+        if (theirs != other.containers_.end() && theirs->key == container.key) {
+            container.subtract(*theirs);
+        }
+    }
+    recount();
+    return *this;
+}
+
+}  // namespace loredb::storage
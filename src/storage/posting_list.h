@@ -0,0 +1,95 @@
+/// \file posting_list.h
+/// \brief Compressed posting lists of entity ids with cheap insert, delete and set algebra.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace loredb::storage {
+
+/**
+ * @class PostingList
+ * @brief Roaring-style set of 64-bit ids.
+ *
+ * Ids are split by their high 48 bits into containers of up to 2^16 ids, kept
+ * sorted by key. A sparse container is a sorted array of the low 16 bits; once
+ * it exceeds ARRAY_MAX ids it becomes a 2^16-bit bitmap, and turns back into
+ * an array when it shrinks to ARRAY_MAX. Insert and erase touch one container:
+ * a binary search plus a bounded array shift, or a single bit in a bitmap, so
+ * the cost does not grow with the length of the list.
+ *
+ * AND, OR and ANDNOT work container by container and skip keys the operands
+ * do not share. Bitmap pairs are combined a word at a time in branch-free
+ * loops the compiler vectorizes; arrays are merged, galloping through the
+ * larger one when sizes differ widely, or probed against a bitmap.
+ *
+ * Not thread-safe; owners serialize access.
+ */
+class PostingList {
+public:
+    // Largest array container; a bitmap (8 KiB) is smaller beyond this
+    static constexpr size_t ARRAY_MAX = 4096;
+
+    PostingList() = default;
+    // Set of `ids`, which may be unsorted and hold duplicates
+    static PostingList from_ids(std::span<const uint64_t> ids);
+
+    // Adds `id`; returns whether it was absent
+    bool add(uint64_t id);
+    // Removes `id`; returns whether it was present
+    bool remove(uint64_t id);
+    bool contains(uint64_t id) const;
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    // All ids in increasing order
+    std::vector<uint64_t> ids() const;
+
+    // Intersection (AND), union (OR) and difference (ANDNOT), in place
+    PostingList& operator&=(const PostingList& other);
+    PostingList& operator|=(const PostingList& other);
+    PostingList& operator-=(const PostingList& other);
+
+    friend PostingList operator&(PostingList a, const PostingList& b) { return a &= b; }
+    friend PostingList operator|(PostingList a, const PostingList& b) { return a |= b; }
+    friend PostingList operator-(PostingList a, const PostingList& b) { return a -= b; }
+    friend bool operator==(const PostingList& a, const PostingList& b) { return a.ids() == b.ids(); }
+
+private:
+    static constexpr size_t BITMAP_WORDS = (1u << 16) / 64;
+
+    struct Container {
+        uint64_t key = 0;                 // High 48 bits shared by the container's ids
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> array;      // Sorted low bits while cardinality <= ARRAY_MAX
+        std::vector<uint64_t> bitmap;     // BITMAP_WORDS words otherwise
+
+        bool is_bitmap() const { return !bitmap.empty(); }
+        bool add(uint16_t low);
+        bool remove(uint16_t low);
+        bool contains(uint16_t low) const;
+        void append_to(std::vector<uint64_t>& out) const;
+
+        // Switches representation when the cardinality crosses ARRAY_MAX
+        void normalize();
+        void to_bitmap();
+        void to_array();
+
+        void intersect(const Container& other);
+        void unite(const Container& other);
+        void subtract(const Container& other);
+    };
+
+    std::vector<Container>::iterator find_container(uint64_t key);
+    std::vector<Container>::const_iterator find_container(uint64_t key) const;
+    void recount();
+
+    std::vector<Container> containers_;
+    size_t size_ = 0;
+};
+
+}  // namespace loredb::storage
@@ -0,0 +1,67 @@
+/// \file property_key.h
+/// \brief Interned property keys backed by a process-wide key dictionary.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "string_dictionary.h"
+#include <optional>
+#include <ostream>
+#include <string>
+
+namespace loredb::storage {
+
+using KeyId = StringDictionary::Id;
+
+/**
+ * @class PropertyKey
+ * @brief A property key stored as its id in the global key dictionary.
+ *
+ * Properties, MVCC versions and WAL entries carry the 4-byte id instead of
+ * an owned string; records on disk use the store's own ids (see KeyMapping). Building a key from a string interns it; the
+ * string is resolved back only where callers need it (str(), printing, or the
+ * implicit conversion). Comparing two keys is an integer compare, so hot loops
+ * should resolve a query key once with find() and compare keys, not strings.
+ */
+class PropertyKey {
+public:
+    PropertyKey() = default;
+    PropertyKey(const std::string& name) : id_(dictionary().intern(name)) {}
+    PropertyKey(const char* name) : id_(dictionary().intern(name)) {}
+
+    // Key for an id read back from storage; the id must come from dictionary()
+    static PropertyKey from_id(KeyId id) {
+        PropertyKey key;
+        key.id_ = id;
+        return key;
+    }
+
+    // Key for `name` if any property ever used it, without interning it
+    static std::optional<PropertyKey> find(const std::string& name) {
+        auto id = dictionary().find(name);
+        if (!id.has_value()) {
+            return std::nullopt;
+        }
+        return from_id(*id);
+    }
+
+    // The dictionary shared by every store in the process
+    static StringDictionary& dictionary() {
+        static StringDictionary keys;
+        return keys;
+    }
+
+    KeyId id() const { return id_; }
+    const std::string& str() const { return dictionary().name(id_); }
+    operator const std::string&() const { return str(); }
+
+    friend bool operator==(PropertyKey a, PropertyKey b) { return a.id_ == b.id_; }
+    friend bool operator==(PropertyKey a, const std::string& b) { return a.str() == b; }
+    friend bool operator==(PropertyKey a, const char* b) { return a.str() == b; }
+    friend std::ostream& operator<<(std::ostream& os, PropertyKey key) { return os << key.str(); }
+
+private:
+    KeyId id_ = 0;
+};
+
+}  // namespace loredb::storage
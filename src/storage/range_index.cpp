@@ -0,0 +1,126 @@
+#include "range_index.h"
+#include <bit>
+#include <cmath>
+
+namespace loredb::storage {
+
+namespace {
+
+// Key tags; numbers sort before strings
+constexpr char NUMBER_TAG = 0x02;
+constexpr char STRING_TAG = 0x03;
+
+std::string encode_number(double value) {
+    // Flip so that unsigned big-endian byte order matches numeric order
+    uint64_t bits = std::bit_cast<uint64_t>(value == 0.0 ? 0.0 : value);
+    bits = (bits & (uint64_t{1} << 63)) ? ~bits : bits | (uint64_t{1} << 63);
+
+    std::string key(1 + sizeof(uint64_t), NUMBER_TAG);
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+        key[1 + i] = static_cast<char>(bits >> (8 * (7 - i)));
+    }
+    return key;
+}
+
+}  // namespace
+
+PropertyRangeIndex::PropertyRangeIndex(PageStore& pages, PageId root, uint8_t kinds)
+    : tree_(pages, root), kinds_(kinds) {
+}
+
+uint8_t PropertyRangeIndex::kind_of(const PropertyValue& value) {
+    if (std::holds_alternative<int64_t>(value) || std::holds_alternative<double>(value)) {
+        return NUMBER;
+    }
+    return std::holds_alternative<std::string>(value) ? STRING : OTHER;
+}
+
+std::optional<std::string> PropertyRangeIndex::encode(const PropertyValue& value) {
+    if (const auto* i = std::get_if<int64_t>(&value)) {
+        return encode_number(static_cast<double>(*i));
+    }
+    if (const auto* d = std::get_if<double>(&value)) {
+        if (std::isnan(*d)) {
+            return std::nullopt;
+        }
+        return encode_number(*d);
+    }
+    if (const auto* s = std::get_if<std::string>(&value)) {
+        std::string key(1, STRING_TAG);
+        key.append(*s, 0, BPlusTree::MAX_KEY_SIZE - 1);
+        return key;
+    }
+    return std::nullopt;
+}
+
+util::expected<void, Error> PropertyRangeIndex::insert(const PropertyValue& value, NodeId node_id) {
+    kinds_.fetch_or(kind_of(value), std::memory_order_relaxed);
+    auto key = encode(value);
+    if (!key.has_value()) {
+        return {};
+    }
+    return tree_.insert(*key, node_id);
+}
+
+util::expected<void, Error> PropertyRangeIndex::erase(const PropertyValue& value, NodeId node_id) {
+    auto key = encode(value);
+    if (!key.has_value()) {
+        return {};
+    }
+    auto erased = tree_.erase(*key, node_id);
+    if (!erased.has_value()) {
+        return util::unexpected(erased.error());
+    }
+    return {};
+}
+
+util::expected<std::optional<std::vector<NodeId>>, Error> PropertyRangeIndex::find_range(
+    const std::optional<PropertyValue>& lower, const std::optional<PropertyValue>& upper) const {
+    if (!lower.has_value() && !upper.has_value()) {
+        return std::optional<std::vector<NodeId>>{};
+    }
+    const uint8_t kind = kind_of(lower.has_value() ? *lower : *upper);
+    if (kind == OTHER || (lower.has_value() && upper.has_value() && kind_of(*upper) != kind) ||
+        (kinds_.load(std::memory_order_relaxed) & ~kind) != 0) {
+        return std::optional<std::vector<NodeId>>{};
+    }
+
+    const std::string tag(1, kind == NUMBER ? NUMBER_TAG : STRING_TAG);
+    const auto lower_key = lower.has_value() ? encode(*lower) : tag;
+    const auto upper_key = upper.has_value() ? encode(*upper) : std::nullopt;
+    if (!lower_key.has_value() || (upper.has_value() && !upper_key.has_value())) {
+        // NaN bounds compare false with everything
+        return std::optional<std::vector<NodeId>>{std::vector<NodeId>{}};
+    }
+
+    std::vector<NodeId> ids;
+    auto result = tree_.scan(*lower_key, [&](std::string_view key, uint64_t node_id) {
+        if (key.empty() || key[0] != tag[0] || (upper_key.has_value() && key > std::string_view(*upper_key))) {
+            return false;
+        }
+        ids.push_back(node_id);
+        return true;
+    });
+    if (!result.has_value()) {
+        return util::unexpected(result.error());
+    }
+    return std::optional<std::vector<NodeId>>{std::move(ids)};
+}
+
+util::expected<std::vector<NodeId>, Error> PropertyRangeIndex::find_prefix(const std::string& prefix) const {
+    const std::string lower = *encode(PropertyValue(prefix));
+    std::vector<NodeId> ids;
+    auto result = tree_.scan(lower, [&](std::string_view key, uint64_t node_id) {
+        if (!key.starts_with(lower)) {
+            return false;
+        }
+        ids.push_back(node_id);
+        return true;
+    });
+    if (!result.has_value()) {
+        return util::unexpected(result.error());
+    }
+    return ids;
+}
+
+}  // namespace loredb::storage
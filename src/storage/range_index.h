@@ -0,0 +1,68 @@
+/// \file range_index.h
+/// \brief Ordered property index answering range and prefix lookups.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "bplus_tree.h"
+#include "record.h"
+#include <atomic>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace loredb::storage {
+
+/**
+ * @class PropertyRangeIndex
+ * @brief B+ tree of one property's values, mapping typed values to node ids.
+ *
+ * Values are encoded so that byte order matches Cypher's order within a type:
+ * numbers (int64 and double share one order, as in comparisons) sort before
+ * strings. Bool and bytes values are not posted. Lookups return a superset of
+ * the matches: bounds are inclusive, integers beyond 2^53 share keys with
+ * their neighbours, long strings are truncated, and postings may be stale.
+ * Callers re-check candidates against the stored values.
+ */
+class PropertyRangeIndex {
+public:
+    // Reopening an index takes the root() and kinds() it had when it was saved
+    explicit PropertyRangeIndex(PageStore& pages, PageId root = INVALID_PAGE_ID, uint8_t kinds = 0);
+
+    // Order-preserving key for `value`; nullopt for types the index does not post
+    static std::optional<std::string> encode(const PropertyValue& value);
+
+    util::expected<void, Error> insert(const PropertyValue& value, NodeId node_id);
+    util::expected<void, Error> erase(const PropertyValue& value, NodeId node_id);
+
+    /**
+     * @brief Nodes whose value may lie between `lower` and `upper` (either may be open).
+     *
+     * Cypher compares values of different types as strings, so a range can only
+     * be answered when every value ever posted has the bounds' type; otherwise
+     * (or when the bounds' types differ) the result is nullopt and the caller
+     * must scan.
+     * @return Unsorted candidate ids, or nullopt when the index cannot answer.
+     */
+    util::expected<std::optional<std::vector<NodeId>>, Error> find_range(
+        const std::optional<PropertyValue>& lower, const std::optional<PropertyValue>& upper) const;
+
+    // Nodes whose string value may start with `prefix`
+    util::expected<std::vector<NodeId>, Error> find_prefix(const std::string& prefix) const;
+
+    PageId root() const { return tree_.root(); }
+    // Bitmask of the value kinds ever posted
+    uint8_t kinds() const { return kinds_.load(std::memory_order_relaxed); }
+    util::expected<void, Error> destroy() { return tree_.destroy(); }
+
+private:
+    // Kinds of values seen so far, one bit each
+    enum ValueKind : uint8_t { NUMBER = 1, STRING = 2, OTHER = 4 };
+
+    static uint8_t kind_of(const PropertyValue& value);
+
+    BPlusTree tree_;
+    std::atomic<uint8_t> kinds_;
+};
+
+}  // namespace loredb::storage
@@ -1,17 +1,19 @@
 #include "record.h"
+#include "key_mapping.h"
 #include <cstring>
 
 namespace loredb::storage {
 
-std::vector<uint8_t> RecordSerializer::serialize_properties(const std::vector<Property>& properties) {
+std::vector<uint8_t> RecordSerializer::serialize_properties(const std::vector<Property>& properties,
+                                                            KeyMapping* keys) {
     std::vector<uint8_t> buffer;
     
     // Write property count
     write_varint(buffer, properties.size());
     
     for (const auto& prop : properties) {
-        // Write key
-        write_string(buffer, prop.key);
+        // Write key id
+        write_varint(buffer, keys ? keys->to_stored(prop.key) : prop.key.id());
         
         // Write value with type
         write_property_value(buffer, prop.value);
@@ -20,7 +22,8 @@ std::vector<uint8_t> RecordSerializer::serialize_properties(const std::vector<Pr
     return buffer;
 }
 
-util::expected<std::vector<Property>, Error> RecordSerializer::deserialize_properties(std::span<const uint8_t> data) {
+util::expected<std::vector<Property>, Error> RecordSerializer::deserialize_properties(std::span<const uint8_t> data,
+                                                                                    const KeyMapping* keys) {
     std::vector<Property> properties;
     
     // Read property count
@@ -33,11 +36,22 @@ util::expected<std::vector<Property>, Error> RecordSerializer::deserialize_prope
     properties.reserve(count);
     
     for (size_t i = 0; i < count; ++i) {
-        // Read key
-        auto key_result = read_string(data);
+        // Read key id
+        auto key_result = read_varint(data);
         if (!key_result.has_value()) {
             return util::unexpected(key_result.error());
         }
+        std::optional<PropertyKey> key;
+        if (keys) {
+            if (key_result.value() <= UINT32_MAX) {
+                key = keys->from_stored(static_cast<KeyId>(key_result.value()));
+            }
+        } else if (key_result.value() <= PropertyKey::dictionary().size()) {
+            key = PropertyKey::from_id(static_cast<KeyId>(key_result.value()));
+        }
+        if (!key.has_value()) {
+            return util::unexpected(Error{ErrorCode::CORRUPTION, "Unknown property key id"});
+        }
         
         // Read value type
         if (data.empty()) {
@@ -53,28 +67,34 @@ util::expected<std::vector<Property>, Error> RecordSerializer::deserialize_prope
             return util::unexpected(value_result.error());
         }
         
-        properties.emplace_back(std::move(key_result.value()), std::move(value_result.value()));
+        properties.emplace_back(*key, std::move(value_result.value()));
     }
     
     return properties;
 }
 
-std::vector<uint8_t> RecordSerializer::serialize_node(const NodeRecord& node, const std::vector<Property>& properties) {
+std::vector<uint8_t> RecordSerializer::serialize_node(const NodeRecord& node, const std::vector<Property>& properties,
+                                                      const std::vector<uint32_t>& labels, KeyMapping* keys) {
     std::vector<uint8_t> buffer;
     
     // Write node record header
     buffer.resize(sizeof(NodeRecord));
     std::memcpy(buffer.data(), &node, sizeof(NodeRecord));
     
+    // Write label ids
+    for (uint32_t label : labels) {
+        write_varint(buffer, label);
+    }
+    
     // Write properties
-    auto prop_data = serialize_properties(properties);
+    auto prop_data = serialize_properties(properties, keys);
     buffer.insert(buffer.end(), prop_data.begin(), prop_data.end());
     
     return buffer;
 }
 
 util::expected<std::pair<NodeRecord, std::vector<Property>>, Error> 
-RecordSerializer::deserialize_node(std::span<const uint8_t> data) {
+RecordSerializer::deserialize_node(std::span<const uint8_t> data, const KeyMapping* keys) {
     if (data.size() < sizeof(NodeRecord)) {
         return util::unexpected(Error{ErrorCode::CORRUPTION, "Insufficient data for node record"});
     }
@@ -82,8 +102,15 @@ RecordSerializer::deserialize_node(std::span<const uint8_t> data) {
     NodeRecord node;
     std::memcpy(&node, data.data(), sizeof(NodeRecord));
     
+    // Skip label ids
     auto prop_data = data.subspan(sizeof(NodeRecord));
-    auto properties_result = deserialize_properties(prop_data);
+    for (uint32_t i = 0; i < node.label_count; ++i) {
+        if (auto label = read_varint(prop_data); !label.has_value()) {
+            return util::unexpected(label.error());
+        }
+    }
+    
+    auto properties_result = deserialize_properties(prop_data, keys);
     if (!properties_result.has_value()) {
         return util::unexpected(properties_result.error());
     }
@@ -91,7 +118,30 @@ RecordSerializer::deserialize_node(std::span<const uint8_t> data) {
     return std::make_pair(node, std::move(properties_result.value()));
 }
 
-std::vector<uint8_t> RecordSerializer::serialize_edge(const EdgeRecord& edge, const std::vector<Property>& properties) {
+util::expected<std::vector<uint32_t>, Error> RecordSerializer::deserialize_node_labels(std::span<const uint8_t> data) {
+    if (data.size() < sizeof(NodeRecord)) {
+        return util::unexpected(Error{ErrorCode::CORRUPTION, "Insufficient data for node record"});
+    }
+    
+    NodeRecord node;
+    std::memcpy(&node, data.data(), sizeof(NodeRecord));
+    
+    std::vector<uint32_t> labels;
+    labels.reserve(node.label_count);
+    auto label_data = data.subspan(sizeof(NodeRecord));
+    for (uint32_t i = 0; i < node.label_count; ++i) {
+        auto label = read_varint(label_data);
+        if (!label.has_value()) {
+            return util::unexpected(label.error());
+        }
+        labels.push_back(static_cast<uint32_t>(label.value()));
+    }
+    
+    return labels;
+}
+
+std::vector<uint8_t> RecordSerializer::serialize_edge(const EdgeRecord& edge, const std::vector<Property>& properties,
+                                                      KeyMapping* keys) {
     std::vector<uint8_t> buffer;
     
     // Write edge record header
@@ -99,14 +149,14 @@ std::vector<uint8_t> RecordSerializer::serialize_edge(const EdgeRecord& edge, co
     std::memcpy(buffer.data(), &edge, sizeof(EdgeRecord));
     
     // Write properties
-    auto prop_data = serialize_properties(properties);
+    auto prop_data = serialize_properties(properties, keys);
     buffer.insert(buffer.end(), prop_data.begin(), prop_data.end());
     
     return buffer;
 }
 
 util::expected<std::pair<EdgeRecord, std::vector<Property>>, Error> 
-RecordSerializer::deserialize_edge(std::span<const uint8_t> data) {
+RecordSerializer::deserialize_edge(std::span<const uint8_t> data, const KeyMapping* keys) {
     if (data.size() < sizeof(EdgeRecord)) {
         return util::unexpected(Error{ErrorCode::CORRUPTION, "Insufficient data for edge record"});
     }
@@ -115,7 +165,7 @@ RecordSerializer::deserialize_edge(std::span<const uint8_t> data) {
     std::memcpy(&edge, data.data(), sizeof(EdgeRecord));
     
     auto prop_data = data.subspan(sizeof(EdgeRecord));
-    auto properties_result = deserialize_properties(prop_data);
+    auto properties_result = deserialize_properties(prop_data, keys);
     if (!properties_result.has_value()) {
         return util::unexpected(properties_result.error());
     }
@@ -123,6 +173,48 @@ RecordSerializer::deserialize_edge(std::span<const uint8_t> data) {
     return std::make_pair(edge, std::move(properties_result.value()));
 }
 
+util::expected<std::optional<PropertyValue>, Error> RecordSerializer::find_property(std::span<const uint8_t> data,
+                                                                                   KeyId key) {
+    auto count_result = read_varint(data);
+    if (!count_result.has_value()) {
+        return util::unexpected(count_result.error());
+    }
+
+    for (size_t i = 0; i < count_result.value(); ++i) {
+        auto key_result = read_varint(data);
+        if (!key_result.has_value()) {
+            return util::unexpected(key_result.error());
+        }
+        if (data.empty()) {
+            return util::unexpected(Error{ErrorCode::CORRUPTION, "Unexpected end of data"});
+        }
+
+        PropertyType type = static_cast<PropertyType>(data[0]);
+        data = data.subspan(1);
+
+        if (key_result.value() == key) {
+            auto value_result = read_property_value(data, type);
+            if (!value_result.has_value()) {
+                return util::unexpected(value_result.error());
+            }
+            return std::optional<PropertyValue>(std::move(value_result.value()));
+        }
+        if (auto skipped = skip_property_value(data, type); !skipped.has_value()) {
+            return util::unexpected(skipped.error());
+        }
+    }
+
+    return std::optional<PropertyValue>();
+}
+
+util::expected<std::optional<PropertyValue>, Error> RecordSerializer::find_edge_property(std::span<const uint8_t> data,
+                                                                                        KeyId key) {
+    if (data.size() < sizeof(EdgeRecord)) {
+        return util::unexpected(Error{ErrorCode::CORRUPTION, "Insufficient data for edge record"});
+    }
+    return find_property(data.subspan(sizeof(EdgeRecord)), key);
+}
+
 void RecordSerializer::write_varint(std::vector<uint8_t>& buffer, uint64_t value) {
     uint8_t temp[10];
     size_t len = util::VarInt::encode(value, temp);
@@ -179,6 +271,11 @@ void RecordSerializer::write_property_value(std::vector<uint8_t>& buffer, const
             buffer.push_back(static_cast<uint8_t>(PropertyType::BYTES));
             write_varint(buffer, v.size());
             buffer.insert(buffer.end(), v.begin(), v.end());
+        } else if constexpr (std::is_same_v<T, std::vector<float>>) {
+            buffer.push_back(static_cast<uint8_t>(PropertyType::VECTOR));
+            write_varint(buffer, v.size());
+            buffer.resize(buffer.size() + v.size() * sizeof(float));
+            std::memcpy(buffer.data() + buffer.size() - v.size() * sizeof(float), v.data(), v.size() * sizeof(float));
         }
     }, value);
 }
@@ -236,9 +333,71 @@ util::expected<PropertyValue, Error> RecordSerializer::read_property_value(std::
             return PropertyValue{std::move(bytes)};
         }
         
+        case PropertyType::VECTOR: {
+            auto len_result = read_varint(data);
+            if (!len_result.has_value()) {
+                return util::unexpected<storage::Error>(len_result.error());
+            }
+            
+            size_t len = len_result.value();
+            if (len > data.size() / sizeof(float)) {
+                return util::unexpected<storage::Error>(Error{ErrorCode::CORRUPTION, "Insufficient data for vector"});
+            }
+            
+            std::vector<float> vector(len);
+            std::memcpy(vector.data(), data.data(), len * sizeof(float));
+            data = data.subspan(len * sizeof(float));
+            return PropertyValue{std::move(vector)};
+        }
+        
+        default:
+            return util::unexpected<storage::Error>(Error{ErrorCode::CORRUPTION, "Unknown property type"});
+    }
+}
+
+util::expected<void, Error> RecordSerializer::skip_property_value(std::span<const uint8_t>& data, PropertyType type) {
+    size_t len = 0;
+    switch (type) {
+        case PropertyType::STRING:
+        case PropertyType::BYTES:
+        case PropertyType::VECTOR: {
+            auto len_result = read_varint(data);
+            if (!len_result.has_value()) {
+                return util::unexpected<storage::Error>(len_result.error());
+            }
+            const size_t width = type == PropertyType::VECTOR ? sizeof(float) : 1;
+            if (len_result.value() > data.size() / width) {
+                return util::unexpected<storage::Error>(Error{ErrorCode::CORRUPTION, "Insufficient data for value"});
+            }
+            len = len_result.value() * width;
+            break;
+        }
+
+        case PropertyType::INTEGER: {
+            auto varint_result = read_varint(data);
+            if (!varint_result.has_value()) {
+                return util::unexpected<storage::Error>(varint_result.error());
+            }
+            return {};
+        }
+
+        case PropertyType::FLOAT:
+            len = sizeof(double);
+            break;
+
+        case PropertyType::BOOLEAN:
+            len = 1;
+            break;
+
         default:
             return util::unexpected<storage::Error>(Error{ErrorCode::CORRUPTION, "Unknown property type"});
     }
+
+    if (data.size() < len) {
+        return util::unexpected<storage::Error>(Error{ErrorCode::CORRUPTION, "Insufficient data for value"});
+    }
+    data = data.subspan(len);
+    return {};
 }
 
 }  // namespace loredb::storage
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "page_store.h"
+#include "property_key.h"
 #include "../util/varint.h"
 #include "../util/expected.h"
+#include <optional>
 #include <string>
 #include <vector>
 #include <span>
@@ -10,43 +12,65 @@
 
 namespace loredb::storage {
 
+class KeyMapping;
+
 // Property value types
 using PropertyValue = std::variant<
     std::string,
     int64_t,
     double,
     bool,
-    std::vector<uint8_t>
+    std::vector<uint8_t>,
+    std::vector<float>
 >;
 
 struct Property {
-    std::string key;
+    PropertyKey key;
     PropertyValue value;
     
-    Property(std::string k, PropertyValue v) : key(std::move(k)), value(std::move(v)) {}
+    Property(PropertyKey k, PropertyValue v) : key(k), value(std::move(v)) {}
 };
 
+// Property keys are written as ids of `keys`, the store's key dictionary;
+// without one they are written as PropertyKey ids, valid only in this process
 class RecordSerializer {
 public:
     // Serialize a list of properties into a byte buffer
-    static std::vector<uint8_t> serialize_properties(const std::vector<Property>& properties);
+    static std::vector<uint8_t> serialize_properties(const std::vector<Property>& properties,
+                                                     KeyMapping* keys = nullptr);
     
     // Deserialize properties from a byte buffer
-    static util::expected<std::vector<Property>, Error> deserialize_properties(std::span<const uint8_t> data);
+    static util::expected<std::vector<Property>, Error> deserialize_properties(std::span<const uint8_t> data,
+                                                                               const KeyMapping* keys = nullptr);
     
-    // Serialize a node record
-    static std::vector<uint8_t> serialize_node(const NodeRecord& node, const std::vector<Property>& properties);
+    // Serialize a node record; `labels` (node.label_count ids) follow the header as varints
+    static std::vector<uint8_t> serialize_node(const NodeRecord& node, const std::vector<Property>& properties,
+                                               const std::vector<uint32_t>& labels = {},
+                                               KeyMapping* keys = nullptr);
     
     // Deserialize a node record
     static util::expected<std::pair<NodeRecord, std::vector<Property>>, Error> 
-    deserialize_node(std::span<const uint8_t> data);
+    deserialize_node(std::span<const uint8_t> data, const KeyMapping* keys = nullptr);
+
+    // Label ids stored in a serialized node record
+    static util::expected<std::vector<uint32_t>, Error> deserialize_node_labels(std::span<const uint8_t> data);
     
     // Serialize an edge record
-    static std::vector<uint8_t> serialize_edge(const EdgeRecord& edge, const std::vector<Property>& properties);
+    static std::vector<uint8_t> serialize_edge(const EdgeRecord& edge, const std::vector<Property>& properties,
+                                               KeyMapping* keys = nullptr);
     
     // Deserialize an edge record
     static util::expected<std::pair<EdgeRecord, std::vector<Property>>, Error> 
-    deserialize_edge(std::span<const uint8_t> data);
+    deserialize_edge(std::span<const uint8_t> data, const KeyMapping* keys = nullptr);
+
+    // The value stored under `key`, an id as written to the list, in a
+    // serialized property list, stepping over the other values without
+    // decoding them; nullopt if the key is absent
+    static util::expected<std::optional<PropertyValue>, Error> find_property(std::span<const uint8_t> data, KeyId key);
+
+    // The same for the properties of a serialized edge record
+    static util::expected<std::optional<PropertyValue>, Error> find_edge_property(std::span<const uint8_t> data,
+                                                                                  KeyId key);
 
 private:
     static void write_varint(std::vector<uint8_t>& buffer, uint64_t value);
@@ -55,6 +79,7 @@ private:
     static util::expected<std::string, Error> read_string(std::span<const uint8_t>& data);
     static void write_property_value(std::vector<uint8_t>& buffer, const PropertyValue& value);
     static util::expected<PropertyValue, Error> read_property_value(std::span<const uint8_t>& data, PropertyType type);
+    static util::expected<void, Error> skip_property_value(std::span<const uint8_t>& data, PropertyType type);
 };
 
 }  // namespace loredb::storage
\ No newline at end of file
@@ -1,66 +1,719 @@
 #include "simple_index_manager.h"
+#include "memory_page_store.h"
+#include "metadata_chain.h"
+#include "../util/varint.h"
 #include <algorithm>
 
 namespace loredb::storage {
 
-void SimpleIndexManager::index_node_property(NodeId node_id, const std::string& key, const std::string& value) {
-    PropertyKey prop_key{key, value};
-    tbb::concurrent_hash_map<PropertyKey, tbb::concurrent_vector<NodeId>, PropertyKeyHash>::accessor accessor;
-    node_property_index_.insert(accessor, prop_key);
-    accessor->second.push_back(node_id);
-}
-
-void SimpleIndexManager::remove_node_property_index(NodeId node_id, const std::string& key, const std::string& value) {
-    PropertyKey prop_key{key, value};
-    tbb::concurrent_hash_map<PropertyKey, tbb::concurrent_vector<NodeId>, PropertyKeyHash>::accessor accessor;
-    if (node_property_index_.find(accessor, prop_key)) {
-        auto& vec = accessor->second;
-        tbb::concurrent_vector<NodeId> new_vec;
-        for (const auto& id : vec) {
-            if (id != node_id) {
-                new_vec.push_back(id);
+namespace {
+
+// Bumped whenever the catalog layout changes. Version 1 had no vector indexes.
+constexpr uint64_t CATALOG_VERSION = 2;
+
+void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    uint8_t temp[util::VarInt::MAX_ENCODED_SIZE];
+    const size_t len = util::VarInt::encode(value, temp);
+    out.insert(out.end(), temp, temp + len);
+}
+
+void put_string(std::vector<uint8_t>& out, const std::string& value) {
+    put_varint(out, value.size());
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+std::optional<std::string> get_string(std::span<const uint8_t>& data) {
+    auto len = util::VarInt::decode(data);
+    if (!len.has_value() || len.value() > data.size()) {
+        return std::nullopt;
+    }
+    std::string value(reinterpret_cast<const char*>(data.data()), len.value());
+    data = data.subspan(len.value());
+    return value;
+}
+
+std::vector<std::optional<std::string>> composite_values(const PropertyCompositeIndex& index,
+                                                         const std::unordered_map<std::string, std::string>& values) {
+    std::vector<std::optional<std::string>> aligned;
+    aligned.reserve(index.keys().size());
+    for (const auto& key : index.keys()) {
+        auto it = values.find(key);
+        aligned.push_back(it == values.end() ? std::nullopt : std::optional<std::string>(it->second));
+    }
+    return aligned;
+}
+
+// "kind(k1, k2)"
+std::string index_name(const std::string& kind, const std::vector<std::string>& keys) {
+    std::string name = kind + "(";
+    for (size_t i = 0; i < keys.size(); ++i) {
+        name += (i == 0 ? "" : ", ") + keys[i];
+    }
+    return name + ")";
+}
+
+}  // namespace
+
+SimpleIndexManager::SimpleIndexManager(std::shared_ptr<PageStore> page_store)
+    : page_store_(page_store ? std::move(page_store) : std::make_shared<MemoryPageStore>()) {
+}
+
+util::expected<void, Error> SimpleIndexManager::index_node_property(NodeId node_id, const std::string& key,
+                                                                    const std::string& value) {
+    if (auto index = find_equality_index(key)) {
+        return index->insert({value}, node_id);
+    }
+    PostingMap::accessor accessor;
+    node_property_index_.insert(accessor, IndexKey{key, value});
+    accessor->second.add(node_id);
+    return {};
+}
+
+util::expected<void, Error> SimpleIndexManager::remove_node_property_index(NodeId node_id, const std::string& key,
+                                                                           const std::string& value) {
+    if (auto index = find_equality_index(key)) {
+        return index->erase({value}, node_id);
+    }
+    PostingMap::accessor accessor;
+    if (node_property_index_.find(accessor, IndexKey{key, value}) && accessor->second.remove(node_id) &&
+        accessor->second.empty()) {
+        node_property_index_.erase(accessor);
+    }
+    return {};
+}
+
+std::vector<NodeId> SimpleIndexManager::find_nodes_by_property(const std::string& key, const std::string& value) const {
+    if (auto index = find_equality_index(key)) {
+        auto ids = index->find({value});
+        return ids.has_value() ? std::move(ids.value()) : std::vector<NodeId>{};
+    }
+    PostingMap::const_accessor accessor;
+    if (node_property_index_.find(accessor, IndexKey{key, value})) {
+        return accessor->second.ids();
+    }
+    return {};
+}
+
+PostingList SimpleIndexManager::find_node_postings(const std::string& key, const std::string& value) const {
+    if (find_equality_index(key)) {
+        return PostingList::from_ids(find_nodes_by_property(key, value));
+    }
+    PostingMap::const_accessor accessor;
+    if (node_property_index_.find(accessor, IndexKey{key, value})) {
+        return accessor->second;
+    }
+    return {};
+}
+
+size_t SimpleIndexManager::count_nodes_by_property(const std::string& key, const std::string& value) const {
+    if (auto index = find_equality_index(key)) {
+        auto count = index->count({value});
+        return count.has_value() ? count.value() : 0;
+    }
+    PostingMap::const_accessor accessor;
+    if (node_property_index_.find(accessor, IndexKey{key, value})) {
+        return accessor->second.size();
+    }
+    return 0;
+}
+
+void SimpleIndexManager::create_node_property_index(const std::string& key) {
+    std::unique_lock<std::shared_mutex> lock(declared_mutex_);
+    if (equality_indexes_.count(key) == 0) {
+        equality_indexes_.emplace(key, std::make_shared<PropertyCompositeIndex>(*page_store_,
+                                                                                std::vector<std::string>{key}));
+    }
+}
+
+util::expected<void, Error> SimpleIndexManager::drop_node_property_index(const std::string& key) {
+    std::shared_ptr<PropertyCompositeIndex> index;
+    {
+        std::unique_lock<std::shared_mutex> lock(declared_mutex_);
+        auto it = equality_indexes_.find(key);
+        if (it == equality_indexes_.end()) {
+            return {};
+        }
+        index = std::move(it->second);
+        equality_indexes_.erase(it);
+    }
+    return index->destroy();
+}
+
+bool SimpleIndexManager::has_node_property_index(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(declared_mutex_);
+    return equality_indexes_.count(key) > 0;
+}
+
+std::vector<std::string> SimpleIndexManager::get_node_property_indexes() const {
+    std::shared_lock<std::shared_mutex> lock(declared_mutex_);
+    std::vector<std::string> keys;
+    keys.reserve(equality_indexes_.size());
+    for (const auto& [key, index] : equality_indexes_) {
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+std::shared_ptr<PropertyCompositeIndex> SimpleIndexManager::find_equality_index(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(declared_mutex_);
+    auto it = equality_indexes_.find(key);
+    return it == equality_indexes_.end() ? nullptr : it->second;
+}
+
+void SimpleIndexManager::create_node_range_index(const std::string& key) {
+    std::unique_lock<std::shared_mutex> lock(range_mutex_);
+    if (range_indexes_.count(key) == 0) {
+        range_indexes_.emplace(key, std::make_shared<PropertyRangeIndex>(*page_store_));
+    }
+}
+
+util::expected<void, Error> SimpleIndexManager::drop_node_range_index(const std::string& key) {
+    std::shared_ptr<PropertyRangeIndex> index;
+    {
+        std::unique_lock<std::shared_mutex> lock(range_mutex_);
+        auto it = range_indexes_.find(key);
+        if (it == range_indexes_.end()) {
+            return {};
+        }
+        index = std::move(it->second);
+        range_indexes_.erase(it);
+    }
+    return index->destroy();
+}
+
+bool SimpleIndexManager::has_node_range_index(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(range_mutex_);
+    return range_indexes_.count(key) > 0;
+}
+
+std::vector<std::string> SimpleIndexManager::get_node_range_indexes() const {
+    std::shared_lock<std::shared_mutex> lock(range_mutex_);
+    std::vector<std::string> keys;
+    keys.reserve(range_indexes_.size());
+    for (const auto& [key, index] : range_indexes_) {
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+std::shared_ptr<PropertyRangeIndex> SimpleIndexManager::find_range_index(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(range_mutex_);
+    auto it = range_indexes_.find(key);
+    return it == range_indexes_.end() ? nullptr : it->second;
+}
+
+util::expected<void, Error> SimpleIndexManager::index_node_range(NodeId node_id, const std::string& key,
+                                                                 const PropertyValue& value) {
+    auto index = find_range_index(key);
+    return index ? index->insert(value, node_id) : util::expected<void, Error>{};
+}
+
+util::expected<void, Error> SimpleIndexManager::remove_node_range_index(NodeId node_id, const std::string& key,
+                                                                        const PropertyValue& value) {
+    auto index = find_range_index(key);
+    return index ? index->erase(value, node_id) : util::expected<void, Error>{};
+}
+
+util::expected<std::optional<std::vector<NodeId>>, Error> SimpleIndexManager::find_nodes_in_range(
+    const std::string& key, const std::optional<PropertyValue>& lower,
+    const std::optional<PropertyValue>& upper) const {
+    auto index = find_range_index(key);
+    if (!index) {
+        return std::optional<std::vector<NodeId>>{};
+    }
+    return index->find_range(lower, upper);
+}
+
+util::expected<std::vector<NodeId>, Error> SimpleIndexManager::find_nodes_by_prefix(const std::string& key,
+                                                                                    const std::string& prefix) const {
+    auto index = find_range_index(key);
+    if (!index) {
+        return std::vector<NodeId>{};
+    }
+    return index->find_prefix(prefix);
+}
+
+void SimpleIndexManager::create_node_composite_index(const std::vector<std::string>& keys) {
+    if (keys.empty()) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(composite_mutex_);
+    for (const auto& index : composite_indexes_) {
+        if (index->keys() == keys) {
+            return;
+        }
+    }
+    composite_indexes_.push_back(std::make_shared<PropertyCompositeIndex>(*page_store_, keys));
+}
+
+util::expected<void, Error> SimpleIndexManager::drop_node_composite_index(const std::vector<std::string>& keys) {
+    std::shared_ptr<PropertyCompositeIndex> index;
+    {
+        std::unique_lock<std::shared_mutex> lock(composite_mutex_);
+        auto it = std::find_if(composite_indexes_.begin(), composite_indexes_.end(),
+                               [&](const auto& candidate) { return candidate->keys() == keys; });
+        if (it == composite_indexes_.end()) {
+            return {};
+        }
+        index = std::move(*it);
+        composite_indexes_.erase(it);
+    }
+    return index->destroy();
+}
+
+bool SimpleIndexManager::has_node_composite_index(const std::vector<std::string>& keys) const {
+    std::shared_lock<std::shared_mutex> lock(composite_mutex_);
+    return std::any_of(composite_indexes_.begin(), composite_indexes_.end(),
+                       [&](const auto& index) { return index->keys() == keys; });
+}
+
+std::vector<std::vector<std::string>> SimpleIndexManager::get_node_composite_indexes() const {
+    std::shared_lock<std::shared_mutex> lock(composite_mutex_);
+    std::vector<std::vector<std::string>> keys;
+    keys.reserve(composite_indexes_.size());
+    for (const auto& index : composite_indexes_) {
+        keys.push_back(index->keys());
+    }
+    return keys;
+}
+
+size_t SimpleIndexManager::get_node_composite_index_count() const {
+    std::shared_lock<std::shared_mutex> lock(composite_mutex_);
+    return composite_indexes_.size();
+}
+
+std::vector<std::shared_ptr<PropertyCompositeIndex>> SimpleIndexManager::composite_indexes() const {
+    std::shared_lock<std::shared_mutex> lock(composite_mutex_);
+    return composite_indexes_;
+}
+
+util::expected<void, Error> SimpleIndexManager::index_node_composites(
+    NodeId node_id, const std::unordered_map<std::string, std::string>& values,
+    const std::optional<std::string>& changed) {
+    for (const auto& index : composite_indexes()) {
+        const auto& keys = index->keys();
+        if (changed.has_value() && std::find(keys.begin(), keys.end(), *changed) == keys.end()) {
+            continue;
+        }
+        if (auto result = index->insert(composite_values(*index, values), node_id); !result.has_value()) {
+            return result;
+        }
+    }
+    return {};
+}
+
+util::expected<void, Error> SimpleIndexManager::remove_node_composites(
+    NodeId node_id, const std::unordered_map<std::string, std::string>& values,
+    const std::optional<std::string>& changed) {
+    for (const auto& index : composite_indexes()) {
+        const auto& keys = index->keys();
+        if (changed.has_value() && std::find(keys.begin(), keys.end(), *changed) == keys.end()) {
+            continue;
+        }
+        if (auto result = index->erase(composite_values(*index, values), node_id); !result.has_value()) {
+            return result;
+        }
+    }
+    return {};
+}
+
+util::expected<std::optional<std::vector<NodeId>>, Error> SimpleIndexManager::find_nodes_by_composite(
+    const std::vector<std::string>& keys, const std::vector<std::string>& values) const {
+    if (keys.empty() || keys.size() != values.size()) {
+        return std::optional<std::vector<NodeId>>{};
+    }
+    for (const auto& index : composite_indexes()) {
+        const auto& declared = index->keys();
+        if (declared.size() >= keys.size() && std::equal(keys.begin(), keys.end(), declared.begin()) &&
+            is_index_ready(composite_index_name(declared))) {
+            auto ids = index->find(values);
+            if (!ids.has_value()) {
+                return util::unexpected(ids.error());
             }
+            return std::optional<std::vector<NodeId>>(std::move(ids.value()));
         }
-        vec = new_vec;
     }
+    return std::optional<std::vector<NodeId>>{};
 }
 
-std::vector<NodeId> SimpleIndexManager::find_nodes_by_property(const std::string& key, const std::string& value) const {
-    PropertyKey prop_key{key, value};
-    tbb::concurrent_hash_map<PropertyKey, tbb::concurrent_vector<NodeId>, PropertyKeyHash>::const_accessor accessor;
-    if (node_property_index_.find(accessor, prop_key)) {
-        return std::vector<NodeId>(accessor->second.begin(), accessor->second.end());
+void SimpleIndexManager::create_text_index(const std::vector<std::string>& keys) {
+    std::unique_lock<std::shared_mutex> lock(text_mutex_);
+    if (!text_index_ || text_index_->keys() != keys) {
+        text_index_ = std::make_shared<FullTextIndex>(keys);
+    }
+}
+
+void SimpleIndexManager::drop_text_index() {
+    std::unique_lock<std::shared_mutex> lock(text_mutex_);
+    text_index_.reset();
+}
+
+std::shared_ptr<FullTextIndex> SimpleIndexManager::text_index() const {
+    std::shared_lock<std::shared_mutex> lock(text_mutex_);
+    return text_index_;
+}
+
+std::vector<std::string> SimpleIndexManager::get_text_index_keys() const {
+    auto index = text_index();
+    return index ? index->keys() : std::vector<std::string>{};
+}
+
+void SimpleIndexManager::index_node_text(NodeId node_id, const std::vector<Property>& properties) {
+    if (auto index = text_index()) {
+        index->index_document(node_id, properties);
+    }
+}
+
+void SimpleIndexManager::remove_node_text(NodeId node_id) {
+    if (auto index = text_index()) {
+        index->remove_document(node_id);
     }
+}
+
+std::optional<std::vector<FullTextIndex::Hit>> SimpleIndexManager::search_text(const std::string& query,
+                                                                               size_t limit,
+                                                                               const PostingList& exclude) const {
+    auto index = text_index();
+    if (!index || !is_index_ready(text_index_name(index->keys()))) {
+        return std::nullopt;
+    }
+    return index->search(query, limit, exclude);
+}
+
+void SimpleIndexManager::create_vector_index(const std::string& key) {
+    std::unique_lock<std::shared_mutex> lock(vector_mutex_);
+    vector_indexes_.try_emplace(key, std::make_shared<VectorIndex>());
+}
+
+util::expected<void, Error> SimpleIndexManager::drop_vector_index(const std::string& key) {
+    std::shared_ptr<VectorIndex> index;
+    {
+        std::unique_lock<std::shared_mutex> lock(vector_mutex_);
+        auto it = vector_indexes_.find(key);
+        if (it == vector_indexes_.end()) {
+            return util::unexpected(Error{ErrorCode::NOT_FOUND, "No vector index on " + key});
+        }
+        index = std::move(it->second);
+        vector_indexes_.erase(it);
+    }
+    free_vector_pages(*index);
     return {};
 }
 
-void SimpleIndexManager::index_edge_property(EdgeId edge_id, const std::string& key, const std::string& value) {
-    PropertyKey prop_key{key, value};
-    tbb::concurrent_hash_map<PropertyKey, tbb::concurrent_vector<EdgeId>, PropertyKeyHash>::accessor accessor;
-    edge_property_index_.insert(accessor, prop_key);
-    accessor->second.push_back(edge_id);
+void SimpleIndexManager::free_vector_pages(const VectorIndex& index) {
+    std::lock_guard<std::mutex> lock(catalog_mutex_);
+    for (PageId page : index.pages) {
+        (void)page_store_->deallocate_page(page);
+    }
 }
 
-void SimpleIndexManager::remove_edge_property_index(EdgeId edge_id, const std::string& key, const std::string& value) {
-    PropertyKey prop_key{key, value};
-    tbb::concurrent_hash_map<PropertyKey, tbb::concurrent_vector<EdgeId>, PropertyKeyHash>::accessor accessor;
-    if (edge_property_index_.find(accessor, prop_key)) {
-        auto& vec = accessor->second;
-        tbb::concurrent_vector<EdgeId> new_vec;
-        for (const auto& id : vec) {
-            if (id != edge_id) {
-                new_vec.push_back(id);
+std::shared_ptr<SimpleIndexManager::VectorIndex> SimpleIndexManager::find_vector_index(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(vector_mutex_);
+    auto it = vector_indexes_.find(key);
+    return it == vector_indexes_.end() ? nullptr : it->second;
+}
+
+bool SimpleIndexManager::has_vector_index(const std::string& key) const {
+    return find_vector_index(key) != nullptr;
+}
+
+std::vector<std::string> SimpleIndexManager::get_vector_indexes() const {
+    std::shared_lock<std::shared_mutex> lock(vector_mutex_);
+    std::vector<std::string> keys;
+    keys.reserve(vector_indexes_.size());
+    for (const auto& [key, index] : vector_indexes_) {
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+util::expected<void, Error> SimpleIndexManager::index_node_vector(NodeId node_id, const std::string& key,
+                                                                  std::span<const float> vector) {
+    if (auto index = find_vector_index(key)) {
+        return index->graph.insert(node_id, vector);
+    }
+    return {};
+}
+
+void SimpleIndexManager::remove_node_vector(NodeId node_id, const std::string& key) {
+    if (auto index = find_vector_index(key)) {
+        index->graph.remove(node_id);
+    }
+}
+
+std::optional<std::vector<float>> SimpleIndexManager::find_node_vector(NodeId node_id, const std::string& key) const {
+    auto index = find_vector_index(key);
+    return index ? index->graph.vector_of(node_id) : std::nullopt;
+}
+
+std::optional<std::vector<HnswIndex::Hit>> SimpleIndexManager::search_vectors(const std::string& key,
+                                                                              std::span<const float> query, size_t k,
+                                                                              const PostingList& exclude) const {
+    auto index = find_vector_index(key);
+    if (!index || !is_index_ready(vector_index_name(key))) {
+        return std::nullopt;
+    }
+    return index->graph.search(query, k, exclude);
+}
+
+std::string SimpleIndexManager::property_index_name(const std::string& key) {
+    return key;
+}
+
+std::string SimpleIndexManager::range_index_name(const std::string& key) {
+    return "range(" + key + ")";
+}
+
+std::string SimpleIndexManager::composite_index_name(const std::vector<std::string>& keys) {
+    return index_name("composite", keys);
+}
+
+std::string SimpleIndexManager::text_index_name(const std::vector<std::string>& keys) {
+    return index_name("text", keys);
+}
+
+std::string SimpleIndexManager::vector_index_name(const std::string& key) {
+    return "vector(" + key + ")";
+}
+
+void SimpleIndexManager::begin_index_build(const std::string& index, size_t total) {
+    std::lock_guard<std::mutex> lock(builds_mutex_);
+    builds_[index] = IndexBuildStatus{index, 0, total, false, std::nullopt};
+}
+
+void SimpleIndexManager::advance_index_build(const std::string& index, size_t scanned) {
+    std::lock_guard<std::mutex> lock(builds_mutex_);
+    if (auto it = builds_.find(index); it != builds_.end()) {
+        it->second.scanned += scanned;
+    }
+}
+
+void SimpleIndexManager::finish_index_build(const std::string& index, std::optional<Error> error) {
+    std::lock_guard<std::mutex> lock(builds_mutex_);
+    if (auto it = builds_.find(index); it != builds_.end()) {
+        it->second.ready = !error.has_value();
+        it->second.error = std::move(error);
+    }
+}
+
+bool SimpleIndexManager::is_index_ready(const std::string& index) const {
+    std::lock_guard<std::mutex> lock(builds_mutex_);
+    auto it = builds_.find(index);
+    return it == builds_.end() || it->second.ready;
+}
+
+std::vector<IndexBuildStatus> SimpleIndexManager::get_index_builds() const {
+    std::lock_guard<std::mutex> lock(builds_mutex_);
+    std::vector<IndexBuildStatus> builds;
+    builds.reserve(builds_.size());
+    for (const auto& [index, status] : builds_) {
+        builds.push_back(status);
+    }
+    return builds;
+}
+
+util::expected<void, Error> SimpleIndexManager::persist_catalog() {
+    std::vector<uint8_t> data;
+    put_varint(data, CATALOG_VERSION);
+
+    auto equality = [this] {
+        std::shared_lock<std::shared_mutex> lock(declared_mutex_);
+        return equality_indexes_;
+    }();
+    // An index still being built would reopen as complete, so it is not recorded yet
+    std::erase_if(equality, [this](const auto& entry) { return !is_index_ready(property_index_name(entry.first)); });
+    put_varint(data, equality.size());
+    for (const auto& [key, index] : equality) {
+        put_string(data, key);
+        put_varint(data, index->root());
+    }
+
+    auto ranges = [this] {
+        std::shared_lock<std::shared_mutex> lock(range_mutex_);
+        return range_indexes_;
+    }();
+    std::erase_if(ranges, [this](const auto& entry) { return !is_index_ready(range_index_name(entry.first)); });
+    put_varint(data, ranges.size());
+    for (const auto& [key, index] : ranges) {
+        put_string(data, key);
+        put_varint(data, index->root());
+        put_varint(data, index->kinds());
+    }
+
+    auto composites = composite_indexes();
+    std::erase_if(composites, [this](const auto& index) {
+        return !is_index_ready(composite_index_name(index->keys()));
+    });
+    put_varint(data, composites.size());
+    for (const auto& index : composites) {
+        put_varint(data, index->keys().size());
+        for (const auto& key : index->keys()) {
+            put_string(data, key);
+        }
+        put_varint(data, index->root());
+    }
+
+    auto vectors = [this] {
+        std::shared_lock<std::shared_mutex> lock(vector_mutex_);
+        return vector_indexes_;
+    }();
+    std::erase_if(vectors, [this](const auto& entry) { return !is_index_ready(vector_index_name(entry.first)); });
+
+    std::lock_guard<std::mutex> lock(catalog_mutex_);
+    // Each graph goes to its own chain first, so the catalog names written heads
+    put_varint(data, vectors.size());
+    for (const auto& [key, index] : vectors) {
+        auto written = write_metadata_chain(*page_store_, index->pages, index->graph.serialize());
+        if (!written.has_value()) {
+            return written;
+        }
+        put_string(data, key);
+        put_varint(data, index->pages.front());
+    }
+    return write_metadata_chain(*page_store_, catalog_pages_, data);
+}
+
+PageId SimpleIndexManager::catalog_page() const {
+    std::lock_guard<std::mutex> lock(catalog_mutex_);
+    return catalog_pages_.empty() ? INVALID_PAGE_ID : catalog_pages_.front();
+}
+
+util::expected<void, Error> SimpleIndexManager::load_catalog(PageId head) {
+    std::vector<PageId> pages;
+    auto blob = read_metadata_chain(*page_store_, head, pages);
+    if (!blob.has_value()) {
+        return util::unexpected(blob.error());
+    }
+    std::span<const uint8_t> data = blob.value();
+    const Error corrupt{ErrorCode::CORRUPTION, "Malformed index catalog"};
+
+    auto version = util::VarInt::decode(data);
+    if (!version.has_value() || version.value() == 0 || version.value() > CATALOG_VERSION) {
+        return util::unexpected(Error{ErrorCode::CORRUPTION, "Unsupported index catalog version"});
+    }
+
+    // Build everything before swapping it in, so a bad catalog changes nothing
+    std::unordered_map<std::string, std::shared_ptr<PropertyCompositeIndex>> equality;
+    auto count = util::VarInt::decode(data);
+    if (!count.has_value()) {
+        return util::unexpected(corrupt);
+    }
+    for (uint64_t i = 0; i < count.value(); ++i) {
+        auto key = get_string(data);
+        auto root = util::VarInt::decode(data);
+        if (!key.has_value() || !root.has_value()) {
+            return util::unexpected(corrupt);
+        }
+        equality.emplace(*key, std::make_shared<PropertyCompositeIndex>(
+                                   *page_store_, std::vector<std::string>{*key}, root.value()));
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<PropertyRangeIndex>> ranges;
+    count = util::VarInt::decode(data);
+    if (!count.has_value()) {
+        return util::unexpected(corrupt);
+    }
+    for (uint64_t i = 0; i < count.value(); ++i) {
+        auto key = get_string(data);
+        auto root = util::VarInt::decode(data);
+        auto kinds = util::VarInt::decode(data);
+        if (!key.has_value() || !root.has_value() || !kinds.has_value() || kinds.value() > UINT8_MAX) {
+            return util::unexpected(corrupt);
+        }
+        ranges.emplace(*key, std::make_shared<PropertyRangeIndex>(*page_store_, root.value(),
+                                                                  static_cast<uint8_t>(kinds.value())));
+    }
+
+    std::vector<std::shared_ptr<PropertyCompositeIndex>> composites;
+    count = util::VarInt::decode(data);
+    if (!count.has_value()) {
+        return util::unexpected(corrupt);
+    }
+    for (uint64_t i = 0; i < count.value(); ++i) {
+        auto key_count = util::VarInt::decode(data);
+        if (!key_count.has_value() || key_count.value() == 0 || key_count.value() > data.size()) {
+            return util::unexpected(corrupt);
+        }
+        std::vector<std::string> keys;
+        for (uint64_t k = 0; k < key_count.value(); ++k) {
+            auto key = get_string(data);
+            if (!key.has_value()) {
+                return util::unexpected(corrupt);
             }
+            keys.push_back(std::move(*key));
+        }
+        auto root = util::VarInt::decode(data);
+        if (!root.has_value()) {
+            return util::unexpected(corrupt);
+        }
+        composites.push_back(std::make_shared<PropertyCompositeIndex>(*page_store_, std::move(keys), root.value()));
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<VectorIndex>> vectors;
+    count = version.value() >= 2 ? util::VarInt::decode(data) : util::expected<uint64_t, Error>(uint64_t{0});
+    if (!count.has_value()) {
+        return util::unexpected(corrupt);
+    }
+    for (uint64_t i = 0; i < count.value(); ++i) {
+        auto key = get_string(data);
+        auto head = util::VarInt::decode(data);
+        if (!key.has_value() || !head.has_value()) {
+            return util::unexpected(corrupt);
+        }
+        auto index = std::make_shared<VectorIndex>();
+        auto graph = read_metadata_chain(*page_store_, head.value(), index->pages);
+        if (!graph.has_value()) {
+            return util::unexpected(graph.error());
+        }
+        auto loaded = index->graph.load(graph.value());
+        if (!loaded.has_value()) {
+            return util::unexpected(loaded.error());
         }
-        vec = new_vec;
+        vectors.emplace(std::move(*key), std::move(index));
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(declared_mutex_);
+        equality_indexes_ = std::move(equality);
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(range_mutex_);
+        range_indexes_ = std::move(ranges);
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(composite_mutex_);
+        composite_indexes_ = std::move(composites);
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(vector_mutex_);
+        vector_indexes_ = std::move(vectors);
+    }
+    std::lock_guard<std::mutex> lock(catalog_mutex_);
+    catalog_pages_ = std::move(pages);
+    return {};
+}
+
+void SimpleIndexManager::index_edge_property(EdgeId edge_id, const std::string& key, const std::string& value) {
+    PostingMap::accessor accessor;
+    edge_property_index_.insert(accessor, IndexKey{key, value});
+    accessor->second.add(edge_id);
+}
+
+void SimpleIndexManager::remove_edge_property_index(EdgeId edge_id, const std::string& key, const std::string& value) {
+    PostingMap::accessor accessor;
+    if (edge_property_index_.find(accessor, IndexKey{key, value}) && accessor->second.remove(edge_id) &&
+        accessor->second.empty()) {
+        edge_property_index_.erase(accessor);
     }
 }
 
 std::vector<EdgeId> SimpleIndexManager::find_edges_by_property(const std::string& key, const std::string& value) const {
-    PropertyKey prop_key{key, value};
-    tbb::concurrent_hash_map<PropertyKey, tbb::concurrent_vector<EdgeId>, PropertyKeyHash>::const_accessor accessor;
-    if (edge_property_index_.find(accessor, prop_key)) {
-        return std::vector<EdgeId>(accessor->second.begin(), accessor->second.end());
+    PostingMap::const_accessor accessor;
+    if (edge_property_index_.find(accessor, IndexKey{key, value})) {
+        return accessor->second.ids();
     }
     return {};
 }
@@ -147,6 +800,46 @@ void SimpleIndexManager::clear_all_indexes() {
     node_property_index_.clear();
     edge_property_index_.clear();
 
+    // Declared keys would otherwise answer lookups from the now-empty postings
+    {
+        std::unique_lock<std::shared_mutex> declared_lock(declared_mutex_);
+        for (auto& [key, index] : equality_indexes_) {
+            index->destroy();
+        }
+        equality_indexes_.clear();
+    }
+    {
+        std::unique_lock<std::shared_mutex> range_lock(range_mutex_);
+        for (auto& [key, index] : range_indexes_) {
+            index->destroy();
+        }
+        range_indexes_.clear();
+    }
+    {
+        std::unique_lock<std::shared_mutex> composite_lock(composite_mutex_);
+        for (auto& index : composite_indexes_) {
+            index->destroy();
+        }
+        composite_indexes_.clear();
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> text_lock(text_mutex_);
+        text_index_.reset();
+    }
+    {
+        std::unique_lock<std::shared_mutex> vector_lock(vector_mutex_);
+        for (auto& [key, index] : vector_indexes_) {
+            free_vector_pages(*index);
+        }
+        vector_indexes_.clear();
+    }
+
+    {
+        std::lock_guard<std::mutex> builds_lock(builds_mutex_);
+        builds_.clear();
+    }
+
     std::unique_lock<std::shared_mutex> adj_lock(adjacency_mutex_);
     outgoing_adjacency_.clear();
     incoming_adjacency_.clear();
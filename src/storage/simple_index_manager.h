@@ -1,25 +1,176 @@
 #pragma once
 
+#include "composite_index.h"
 #include "page_store.h"
+#include "posting_list.h"
+#include "range_index.h"
+#include "text_index.h"
+#include "vector_index.h"
+#include <map>
+#include <memory>
+#include <optional>
 #include <vector>
 #include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <tbb/concurrent_hash_map.h>
-#include <tbb/concurrent_vector.h>
 
 namespace loredb::storage {
 
+// Progress of an online index build, by index name (see SimpleIndexManager::*_index_name)
+struct IndexBuildStatus {
+    std::string index;
+    size_t scanned = 0;
+    size_t total = 0;
+    bool ready = false;
+    std::optional<Error> error;
+};
+
 // Simplified index manager using lock-free structures for property indexing
 class SimpleIndexManager {
 public:
-    SimpleIndexManager() = default;
+    // Range indexes keep their B+ trees in `page_store` (in memory when null)
+    explicit SimpleIndexManager(std::shared_ptr<PageStore> page_store = nullptr);
     ~SimpleIndexManager() = default;
+
+    // Null when the trees are kept in memory
+    const std::shared_ptr<PageStore>& page_store() const { return page_store_; }
     
-    // Node property indexing
-    void index_node_property(NodeId node_id, const std::string& key, const std::string& value);
-    void remove_node_property_index(NodeId node_id, const std::string& key, const std::string& value);
+    // Node property indexing. Postings of declared keys go to their index pages;
+    // other keys keep ad-hoc postings in memory. A declared index that cannot be
+    // read answers find_nodes_by_property() with no ids.
+    util::expected<void, Error> index_node_property(NodeId node_id, const std::string& key, const std::string& value);
+    util::expected<void, Error> remove_node_property_index(NodeId node_id, const std::string& key,
+                                                           const std::string& value);
     std::vector<NodeId> find_nodes_by_property(const std::string& key, const std::string& value) const;
+    // The same candidates as a posting list, for combining predicates with
+    // AND/OR/ANDNOT before any node is read
+    PostingList find_node_postings(const std::string& key, const std::string& value) const;
+    // Size of find_nodes_by_property()'s answer, counted without building it
+    size_t count_nodes_by_property(const std::string& key, const std::string& value) const;
+    
+    // Declared node property indexes. Once a key is declared, the writer that owns
+    // this manager keeps every node's value for it indexed, so equality lookups on
+    // the key may be answered from postings instead of a scan. Postings may still
+    // hold stale ids (deleted nodes, overwritten values); readers must re-check.
+    // Declared indexes are B+ trees in the page store, like the range and
+    // composite indexes below.
+    void create_node_property_index(const std::string& key);
+    util::expected<void, Error> drop_node_property_index(const std::string& key);
+    bool has_node_property_index(const std::string& key) const;
+    std::vector<std::string> get_node_property_indexes() const;
+
+    // Declared node range indexes: ordered B+ trees over typed values of a key,
+    // answering range and prefix lookups. Same contract as the equality indexes:
+    // the owning writer posts every value, and lookups may return stale ids.
+    void create_node_range_index(const std::string& key);
+    util::expected<void, Error> drop_node_range_index(const std::string& key);
+    bool has_node_range_index(const std::string& key) const;
+    std::vector<std::string> get_node_range_indexes() const;
+    util::expected<void, Error> index_node_range(NodeId node_id, const std::string& key, const PropertyValue& value);
+    util::expected<void, Error> remove_node_range_index(NodeId node_id, const std::string& key,
+                                                        const PropertyValue& value);
+    // Candidates for lower <= value <= upper; nullopt when `key` has no range
+    // index or the index cannot answer for these bounds (see PropertyRangeIndex)
+    util::expected<std::optional<std::vector<NodeId>>, Error> find_nodes_in_range(
+        const std::string& key, const std::optional<PropertyValue>& lower,
+        const std::optional<PropertyValue>& upper) const;
+    util::expected<std::vector<NodeId>, Error> find_nodes_by_prefix(const std::string& key,
+                                                                    const std::string& prefix) const;
+
+    // Declared composite indexes over an ordered list of keys, posting a node's
+    // rendered values for all of them under one tree key. A lookup binding any
+    // leading subset of the keys takes a single probe. Same contract as above.
+    void create_node_composite_index(const std::vector<std::string>& keys);
+    util::expected<void, Error> drop_node_composite_index(const std::vector<std::string>& keys);
+    bool has_node_composite_index(const std::vector<std::string>& keys) const;
+    std::vector<std::vector<std::string>> get_node_composite_indexes() const;
+    size_t get_node_composite_index_count() const;
+    // Posts `values` (rendered values by key) to every composite index, or only to
+    // those covering `changed` when given
+    util::expected<void, Error> index_node_composites(NodeId node_id,
+                                                      const std::unordered_map<std::string, std::string>& values,
+                                                      const std::optional<std::string>& changed = std::nullopt);
+    util::expected<void, Error> remove_node_composites(NodeId node_id,
+                                                       const std::unordered_map<std::string, std::string>& values,
+                                                       const std::optional<std::string>& changed = std::nullopt);
+    // Candidates whose values for `keys` equal `values`, from a composite index
+    // whose leading keys are `keys`; nullopt when no such index is ready
+    util::expected<std::optional<std::vector<NodeId>>, Error> find_nodes_by_composite(
+        const std::vector<std::string>& keys, const std::vector<std::string>& values) const;
     
+    // Declared full-text index over the string values of `keys` (at most one;
+    // declaring another replaces it). The owning writer re-posts a node's text
+    // whenever it writes one of the keys. Kept in memory and not in the catalog.
+    void create_text_index(const std::vector<std::string>& keys);
+    void drop_text_index();
+    // Keys of the declared text index; empty when there is none
+    std::vector<std::string> get_text_index_keys() const;
+    // Replaces the text posted for `node_id`; a no-op without a text index
+    void index_node_text(NodeId node_id, const std::vector<Property>& properties);
+    void remove_node_text(NodeId node_id);
+    // BM25-ranked candidates for `query`, skipping `exclude`; nullopt when no
+    // text index is ready
+    std::optional<std::vector<FullTextIndex::Hit>> search_text(const std::string& query, size_t limit,
+                                                               const PostingList& exclude = {}) const;
+
+    // Declared vector indexes: an HNSW graph per key over nodes' float vectors
+    // (VECTOR values, or BYTES holding packed float32). The owning writer posts
+    // every node's vector for the key. Unlike the text index, vector indexes are
+    // persisted: each graph is written to its own METADATA chain with the catalog.
+    void create_vector_index(const std::string& key);
+    util::expected<void, Error> drop_vector_index(const std::string& key);
+    bool has_vector_index(const std::string& key) const;
+    std::vector<std::string> get_vector_indexes() const;
+    // Adds or replaces the vector of `node_id`; a no-op when `key` has no index
+    util::expected<void, Error> index_node_vector(NodeId node_id, const std::string& key,
+                                                  std::span<const float> vector);
+    void remove_node_vector(NodeId node_id, const std::string& key);
+    // The vector indexed for `node_id`, normalized
+    std::optional<std::vector<float>> find_node_vector(NodeId node_id, const std::string& key) const;
+    // Approximately the `k` nodes most similar to `query`, skipping `exclude`;
+    // nullopt when `key` has no ready vector index
+    std::optional<std::vector<HnswIndex::Hit>> search_vectors(const std::string& key, std::span<const float> query,
+                                                              size_t k, const PostingList& exclude = {}) const;
+
+    // Online builds. While a build registered with begin_index_build() runs,
+    // writers post to the index as usual but is_index_ready() is false, so
+    // lookups must not rely on it. Index names match EXPLAIN: "key",
+    // "range(key)", "composite(k1, k2)", "text(k1, k2)", and "vector(key)".
+    static std::string property_index_name(const std::string& key);
+    static std::string range_index_name(const std::string& key);
+    static std::string composite_index_name(const std::vector<std::string>& keys);
+    static std::string text_index_name(const std::vector<std::string>& keys);
+    static std::string vector_index_name(const std::string& key);
+    void begin_index_build(const std::string& index, size_t total);
+    void advance_index_build(const std::string& index, size_t scanned);
+    // Marks the index ready, or records why its build failed
+    void finish_index_build(const std::string& index, std::optional<Error> error = std::nullopt);
+    bool is_index_ready(const std::string& index) const;
+    // Builds started since the indexes were last cleared, ordered by name
+    std::vector<IndexBuildStatus> get_index_builds() const;
+
+    /**
+     * @brief Write the catalog of declared indexes to METADATA pages.
+     *
+     * The catalog records each index's keys and root page, so load_catalog()
+     * reopens every index without reading or rebuilding its postings. Roots
+     * move when trees split: call this at the same points the page store is
+     * synced, as GraphStore::sync() does for an attached manager. Indexes
+     * still being built are left out. catalog_page() is the
+     * head of the catalog's page chain.
+     * @return Success or Error.
+     */
+    util::expected<void, Error> persist_catalog();
+    PageId catalog_page() const;
+    /**
+     * @brief Replace the declared indexes with those of a persisted catalog.
+     * @param head First page of a catalog written by persist_catalog() to this manager's page store.
+     * @return Success or Error; on error the current indexes are kept.
+     */
+    util::expected<void, Error> load_catalog(PageId head);
+
     // Edge property indexing
     void index_edge_property(EdgeId edge_id, const std::string& key, const std::string& value);
     void remove_edge_property_index(EdgeId edge_id, const std::string& key, const std::string& value);
@@ -41,30 +192,70 @@ public:
     void clear_all_indexes();
 
 private:
-    struct PropertyKey {
+    struct IndexKey {
         std::string key;
         std::string value;
         
-        bool operator==(const PropertyKey& other) const {
+        bool operator==(const IndexKey& other) const {
             return key == other.key && value == other.value;
         }
     };
     
-    struct PropertyKeyHash {
-        static size_t hash(const PropertyKey& pk) {
+    struct IndexKeyHash {
+        static size_t hash(const IndexKey& pk) {
             return std::hash<std::string>{}(pk.key) ^ (std::hash<std::string>{}(pk.value) << 1);
         }
         
-        static bool equal(const PropertyKey& a, const PropertyKey& b) {
+        static bool equal(const IndexKey& a, const IndexKey& b) {
             return a.key == b.key && a.value == b.value;
         }
     };
     
+    // Ad-hoc postings by (key, value); an accessor on the entry guards its list
+    using PostingMap = tbb::concurrent_hash_map<IndexKey, PostingList, IndexKeyHash>;
+
     // Node property indexes
-    tbb::concurrent_hash_map<PropertyKey, tbb::concurrent_vector<NodeId>, PropertyKeyHash> node_property_index_;
+    PostingMap node_property_index_;
     
     // Edge property indexes
-    tbb::concurrent_hash_map<PropertyKey, tbb::concurrent_vector<EdgeId>, PropertyKeyHash> edge_property_index_;
+    PostingMap edge_property_index_;
+    
+    // Indexes declared through create_node_property_index(), as one-key composite trees
+    std::shared_ptr<PropertyCompositeIndex> find_equality_index(const std::string& key) const;
+    mutable std::shared_mutex declared_mutex_;
+    std::unordered_map<std::string, std::shared_ptr<PropertyCompositeIndex>> equality_indexes_;
+
+    // Range indexes by key; shared so lookups survive a concurrent drop
+    std::shared_ptr<PropertyRangeIndex> find_range_index(const std::string& key) const;
+    std::shared_ptr<PageStore> page_store_;
+    mutable std::shared_mutex range_mutex_;
+    std::unordered_map<std::string, std::shared_ptr<PropertyRangeIndex>> range_indexes_;
+
+    // Composite indexes in declaration order
+    std::vector<std::shared_ptr<PropertyCompositeIndex>> composite_indexes() const;
+    mutable std::shared_mutex composite_mutex_;
+    std::vector<std::shared_ptr<PropertyCompositeIndex>> composite_indexes_;
+
+    std::shared_ptr<FullTextIndex> text_index() const;
+    mutable std::shared_mutex text_mutex_;
+    std::shared_ptr<FullTextIndex> text_index_;
+
+    // Vector indexes by key, with the METADATA chain each is persisted to
+    struct VectorIndex {
+        HnswIndex graph;
+        std::vector<PageId> pages;  // Guarded by catalog_mutex_
+    };
+    std::shared_ptr<VectorIndex> find_vector_index(const std::string& key) const;
+    void free_vector_pages(const VectorIndex& index);
+    mutable std::shared_mutex vector_mutex_;
+    std::unordered_map<std::string, std::shared_ptr<VectorIndex>> vector_indexes_;
+
+    mutable std::mutex builds_mutex_;
+    std::map<std::string, IndexBuildStatus> builds_;
+
+    // METADATA chain holding the persisted catalog
+    mutable std::mutex catalog_mutex_;
+    std::vector<PageId> catalog_pages_;
     
     // Adjacency lists (still using mutexes for now)
     mutable std::shared_mutex adjacency_mutex_;
@@ -0,0 +1,155 @@
+#include "string_dictionary.h"
+#include "../util/varint.h"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace loredb::storage {
+
+namespace {
+
+const std::string EMPTY_NAME;
+
+}  // namespace
+
+StringDictionary::StringDictionary()
+    : chunks_(std::make_unique<std::atomic<std::string*>[]>(MAX_CHUNKS)) {
+    for (size_t i = 0; i < MAX_CHUNKS; ++i) {
+        chunks_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+StringDictionary::~StringDictionary() {
+    reset();
+}
+
+StringDictionary::Id StringDictionary::intern(std::string_view name) {
+    if (name.empty()) {
+        return 0;
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    return append(name);
+}
+
+std::optional<StringDictionary::Id> StringDictionary::find(std::string_view name) const {
+    if (name.empty()) {
+        return Id{0};
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it == ids_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const std::string& StringDictionary::name(Id id) const {
+    if (id == 0 || id > size()) {
+        return EMPTY_NAME;
+    }
+    const size_t index = id - 1;
+    return chunks_[index >> CHUNK_BITS].load(std::memory_order_acquire)[index & (CHUNK_SIZE - 1)];
+}
+
+StringDictionary::Id StringDictionary::append(std::string_view name) {
+    const size_t index = size_.load(std::memory_order_relaxed);
+    const size_t chunk = index >> CHUNK_BITS;
+    if (chunk >= MAX_CHUNKS) {
+        throw std::length_error("StringDictionary is full");
+    }
+
+    std::string* names = chunks_[chunk].load(std::memory_order_relaxed);
+    if (names == nullptr) {
+        names = new std::string[CHUNK_SIZE];
+        chunks_[chunk].store(names, std::memory_order_release);
+    }
+    names[index & (CHUNK_SIZE - 1)] = std::string(name);
+
+    const Id id = static_cast<Id>(index + 1);
+    ids_.emplace(std::string(name), id);
+    // Publish the name before the id can be resolved
+    size_.store(index + 1, std::memory_order_release);
+    return id;
+}
+
+void StringDictionary::reset() {
+    ids_.clear();
+    for (size_t i = 0; i < MAX_CHUNKS; ++i) {
+        delete[] chunks_[i].exchange(nullptr, std::memory_order_acq_rel);
+    }
+    size_.store(0, std::memory_order_release);
+}
+
+std::vector<uint8_t> StringDictionary::serialize() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<uint8_t> buffer;
+    uint8_t temp[util::VarInt::MAX_ENCODED_SIZE];
+
+    const size_t count = size();
+    size_t len = util::VarInt::encode(count, temp);
+    buffer.insert(buffer.end(), temp, temp + len);
+    for (size_t id = 1; id <= count; ++id) {
+        const std::string& entry = name(static_cast<Id>(id));
+        len = util::VarInt::encode(entry.size(), temp);
+        buffer.insert(buffer.end(), temp, temp + len);
+        buffer.insert(buffer.end(), entry.begin(), entry.end());
+    }
+    return buffer;
+}
+
+util::expected<void, Error> StringDictionary::load(std::span<const uint8_t> data) {
+    auto count = util::VarInt::decode(data);
+    if (!count.has_value()) {
+        return util::unexpected(count.error());
+    }
+
+    // Validate everything before touching the current contents
+    std::vector<std::string_view> names;
+    std::unordered_set<std::string_view> seen;
+    for (uint64_t i = 0; i < count.value(); ++i) {
+        auto len = util::VarInt::decode(data);
+        if (!len.has_value()) {
+            return util::unexpected(len.error());
+        }
+        if (len.value() > data.size()) {
+            return util::unexpected(Error{ErrorCode::CORRUPTION, "Truncated string dictionary"});
+        }
+        std::string_view entry(reinterpret_cast<const char*>(data.data()), len.value());
+        data = data.subspan(len.value());
+        if (entry.empty() || !seen.insert(entry).second) {
+            return util::unexpected(Error{ErrorCode::CORRUPTION, "Invalid string dictionary entry"});
+        }
+        names.push_back(entry);
+    }
+    if (names.size() > MAX_CHUNKS * CHUNK_SIZE) {
+        return util::unexpected(Error{ErrorCode::CORRUPTION, "String dictionary too large"});
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // Ids already handed out must keep their meaning
+    const size_t known = std::min(size(), names.size());
+    for (size_t i = 0; i < known; ++i) {
+        if (name(static_cast<Id>(i + 1)) != names[i]) {
+            return util::unexpected(Error{ErrorCode::CORRUPTION, "String dictionary conflicts with interned ids"});
+        }
+    }
+    for (size_t i = known; i < names.size(); ++i) {
+        append(names[i]);
+    }
+    return {};
+}
+
+}  // namespace loredb::storage
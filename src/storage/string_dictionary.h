@@ -0,0 +1,80 @@
+/// \file string_dictionary.h
+/// \brief Append-only dictionary assigning dense ids to strings.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "page_store.h"
+#include "../util/expected.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace loredb::storage {
+
+/**
+ * @class StringDictionary
+ * @brief Maps strings to dense ids and back.
+ *
+ * Id 0 is the empty string; other ids are assigned in first-use order starting
+ * at 1 and never reused, so a dictionary only grows and a prefix of its
+ * serialized form stays valid. Names live in fixed chunks that never move:
+ * resolving an id takes no lock and the returned reference stays valid for the
+ * dictionary's lifetime.
+ */
+class StringDictionary {
+public:
+    using Id = uint32_t;
+
+    StringDictionary();
+    ~StringDictionary();
+    StringDictionary(const StringDictionary&) = delete;
+    StringDictionary& operator=(const StringDictionary&) = delete;
+
+    // Id for `name`, assigning the next one on first use
+    Id intern(std::string_view name);
+
+    // Id for `name` if it was ever interned
+    std::optional<Id> find(std::string_view name) const;
+
+    // Name behind `id`; empty for 0 and unknown ids
+    const std::string& name(Id id) const;
+
+    // Number of interned strings (the highest assigned id)
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+
+    // Varint count followed by length-prefixed names in id order
+    std::vector<uint8_t> serialize() const;
+
+    // Extends the dictionary with one produced by serialize(). Ids both sides
+    // know must name the same strings; ids beyond size() are appended.
+    util::expected<void, Error> load(std::span<const uint8_t> data);
+
+private:
+    static constexpr size_t CHUNK_BITS = 10;
+    static constexpr size_t CHUNK_SIZE = size_t{1} << CHUNK_BITS;
+    static constexpr size_t MAX_CHUNKS = 4096;
+
+    // Appends `name` as id size() + 1; caller holds the write lock
+    Id append(std::string_view name);
+    void reset();
+
+    struct Hash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, Id, Hash, std::equal_to<>> ids_;
+    std::unique_ptr<std::atomic<std::string*>[]> chunks_;
+    std::atomic<size_t> size_{0};
+};
+
+}  // namespace loredb::storage
@@ -0,0 +1,147 @@
+#include "text_index.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace loredb::storage {
+
+namespace {
+
+bool is_term_byte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+}  // namespace
+
+FullTextIndex::FullTextIndex(std::vector<std::string> keys) : keys_(std::move(keys)) {
+}
+
+std::vector<std::string> FullTextIndex::tokenize(std::string_view text) {
+    std::vector<std::string> terms;
+    size_t i = 0;
+    while (i < text.size()) {
+        while (i < text.size() && !is_term_byte(static_cast<unsigned char>(text[i]))) {
+            ++i;
+        }
+        std::string term;
+        for (; i < text.size() && is_term_byte(static_cast<unsigned char>(text[i])); ++i) {
+            const char c = text[i];
+            term.push_back(c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c);
+        }
+        if (!term.empty()) {
+            terms.push_back(std::move(term));
+        }
+    }
+    return terms;
+}
+
+void FullTextIndex::index_document(NodeId node_id, const std::vector<Property>& properties) {
+    std::vector<std::string> terms;
+    for (const auto& key : keys_) {
+        for (const auto& prop : properties) {
+            if (prop.key == key && std::holds_alternative<std::string>(prop.value)) {
+                auto tokens = tokenize(std::get<std::string>(prop.value));
+                terms.insert(terms.end(), std::make_move_iterator(tokens.begin()),
+                             std::make_move_iterator(tokens.end()));
+            }
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    remove_locked(node_id);
+    if (terms.empty()) {
+        return;
+    }
+
+    std::unordered_map<TermId, uint32_t> frequencies;
+    for (auto& term : terms) {
+        auto [it, inserted] = term_ids_.try_emplace(std::move(term), static_cast<TermId>(postings_.size()));
+        if (inserted) {
+            postings_.emplace_back();
+        }
+        ++frequencies[it->second];
+    }
+
+    Document document;
+    document.terms.assign(frequencies.begin(), frequencies.end());
+    std::sort(document.terms.begin(), document.terms.end());
+    document.length = static_cast<uint32_t>(terms.size());
+    for (const auto& [term, frequency] : document.terms) {
+        postings_[term].add(node_id);
+    }
+    total_length_ += document.length;
+    documents_.emplace(node_id, std::move(document));
+}
+
+void FullTextIndex::remove_document(NodeId node_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    remove_locked(node_id);
+}
+
+void FullTextIndex::remove_locked(NodeId node_id) {
+    auto it = documents_.find(node_id);
+    if (it == documents_.end()) {
+        return;
+    }
+    for (const auto& [term, frequency] : it->second.terms) {
+        postings_[term].remove(node_id);
+    }
+    total_length_ -= it->second.length;
+    documents_.erase(it);
+}
+
+std::vector<FullTextIndex::Hit> FullTextIndex::search(std::string_view query, size_t limit,
+                                                      const PostingList& exclude) const {
+    auto terms = tokenize(query);
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (documents_.empty() || limit == 0) {
+        return {};
+    }
+    const double documents = static_cast<double>(documents_.size());
+    const double average_length = static_cast<double>(total_length_) / documents;
+
+    std::unordered_map<NodeId, double> scores;
+    for (const auto& term : terms) {
+        auto id = term_ids_.find(term);
+        if (id == term_ids_.end() || postings_[id->second].empty()) {
+            continue;
+        }
+        const PostingList& posting = postings_[id->second];
+        const double df = static_cast<double>(posting.size());
+        const double idf = std::log(1.0 + (documents - df + 0.5) / (df + 0.5));
+        for (NodeId node_id : (exclude.empty() ? posting : posting - exclude).ids()) {
+            const Document& document = documents_.at(node_id);
+            auto entry = std::lower_bound(document.terms.begin(), document.terms.end(),
+                                          std::make_pair(id->second, uint32_t{0}));
+            const double tf = entry->second;
+            const double norm = K1 * (1.0 - B + B * document.length / average_length);
+            scores[node_id] += idf * tf * (K1 + 1.0) / (tf + norm);
+        }
+    }
+
+    std::vector<Hit> hits;
+    hits.reserve(scores.size());
+    for (const auto& [node_id, score] : scores) {
+        hits.push_back(Hit{node_id, score});
+    }
+    const auto better = [](const Hit& a, const Hit& b) {
+        return a.score > b.score || (a.score == b.score && a.node_id < b.node_id);
+    };
+    if (hits.size() > limit) {
+        std::partial_sort(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(limit), hits.end(), better);
+        hits.resize(limit);
+    } else {
+        std::sort(hits.begin(), hits.end(), better);
+    }
+    return hits;
+}
+
+size_t FullTextIndex::document_count() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return documents_.size();
+}
+
+}  // namespace loredb::storage
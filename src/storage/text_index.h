@@ -0,0 +1,79 @@
+/// \file text_index.h
+/// \brief Full-text inverted index over string properties with BM25 ranking.
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "posting_list.h"
+#include "record.h"
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace loredb::storage {
+
+/**
+ * @class FullTextIndex
+ * @brief Inverted index from terms to the nodes whose text contains them.
+ *
+ * A node's text is the concatenation of its string values for keys(). Terms
+ * are lowercased runs of ASCII letters and digits; bytes of multi-byte UTF-8
+ * characters count as letters, so non-ASCII words stay whole. Each term
+ * posts its documents in a compressed PostingList, and each document keeps
+ * its term frequencies so it can be re-indexed or removed without a scan.
+ *
+ * search() ranks documents by Okapi BM25 (k1 = 1.2, b = 0.75). Like the other
+ * indexes, postings may be stale; callers re-check that hits still exist.
+ * The index lives in memory and is rebuilt after a restart.
+ */
+class FullTextIndex {
+public:
+    static constexpr double K1 = 1.2;
+    static constexpr double B = 0.75;
+
+    struct Hit {
+        NodeId node_id = 0;
+        double score = 0.0;
+    };
+
+    explicit FullTextIndex(std::vector<std::string> keys);
+
+    const std::vector<std::string>& keys() const { return keys_; }
+
+    // Terms of `text` in order, with repeats
+    static std::vector<std::string> tokenize(std::string_view text);
+
+    // Replaces the terms posted for `node_id` with those of its values for keys()
+    void index_document(NodeId node_id, const std::vector<Property>& properties);
+    void remove_document(NodeId node_id);
+
+    // Best `limit` documents for the terms of `query` by descending score (ties
+    // by id), skipping the ids in `exclude`
+    std::vector<Hit> search(std::string_view query, size_t limit, const PostingList& exclude = {}) const;
+
+    size_t document_count() const;
+
+private:
+    using TermId = uint32_t;
+
+    struct Document {
+        std::vector<std::pair<TermId, uint32_t>> terms;  // (term, frequency) sorted by term
+        uint32_t length = 0;                              // Terms including repeats
+    };
+
+    void remove_locked(NodeId node_id);
+
+    std::vector<std::string> keys_;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, TermId> term_ids_;
+    std::vector<PostingList> postings_;  // By term id
+    std::unordered_map<NodeId, Document> documents_;
+    uint64_t total_length_ = 0;
+};
+
+}  // namespace loredb::storage
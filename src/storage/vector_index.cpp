@@ -0,0 +1,453 @@
+#include "vector_index.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <queue>
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+namespace loredb::storage {
+
+namespace {
+
+constexpr uint32_t FORMAT_VERSION = 1;
+
+// Normalized copy of `vector`, or nullopt for a zero (or non-finite) vector
+std::optional<std::vector<float>> normalized(std::span<const float> vector) {
+    const double norm = std::sqrt(static_cast<double>(HnswIndex::dot(vector.data(), vector.data(), vector.size())));
+    if (!(norm > 0.0) || !std::isfinite(norm)) {
+        return std::nullopt;
+    }
+    std::vector<float> out(vector.begin(), vector.end());
+    for (float& x : out) {
+        x = static_cast<float>(x / norm);
+    }
+    return out;
+}
+
+template <typename T>
+void put(std::vector<uint8_t>& out, T value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// Bounds-checked reader over a serialized index
+struct Reader {
+    std::span<const uint8_t> data;
+    size_t offset = 0;
+
+    template <typename T>
+    bool get(T& value) {
+        if (data.size() - offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+};
+
+}  // namespace
+
+std::optional<std::vector<float>> vector_value(const PropertyValue& value) {
+    if (const auto* vector = std::get_if<std::vector<float>>(&value)) {
+        return *vector;
+    }
+    const auto* bytes = std::get_if<std::vector<uint8_t>>(&value);
+    if (bytes == nullptr || bytes->empty() || bytes->size() % sizeof(float) != 0) {
+        return std::nullopt;
+    }
+    std::vector<float> vector(bytes->size() / sizeof(float));
+    std::memcpy(vector.data(), bytes->data(), bytes->size());
+    return vector;
+}
+
+float HnswIndex::dot(const float* a, const float* b, size_t n) {
+    size_t i = 0;
+    float sum = 0.0f;
+#if defined(__AVX512F__)
+    __m512 acc = _mm512_setzero_ps();
+    for (; i + 16 <= n; i += 16) {
+        acc = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc);
+    }
+    // Summed through memory: GCC's _mm512_reduce_add_ps trips -Wuninitialized
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, acc);
+    for (float lane : lanes) {
+        sum += lane;
+    }
+#elif defined(__AVX2__) && defined(__FMA__)
+    // Two accumulators hide the FMA latency
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+    const __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(half, _mm_movehdup_ps(half));
+    sum = _mm_cvtss_f32(half);
+#else
+    float partial[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (; i + 4 <= n; i += 4) {
+        partial[0] += a[i] * b[i];
+        partial[1] += a[i + 1] * b[i + 1];
+        partial[2] += a[i + 2] * b[i + 2];
+        partial[3] += a[i + 3] * b[i + 3];
+    }
+    sum = (partial[0] + partial[1]) + (partial[2] + partial[3]);
+#endif
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+uint32_t HnswIndex::dimensions() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return dimensions_;
+}
+
+size_t HnswIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return slot_of_.size();
+}
+
+float HnswIndex::distance(const float* query, uint32_t slot) const {
+    return 1.0f - dot(query, vector_at(slot), dimensions_);
+}
+
+util::expected<void, Error> HnswIndex::insert(NodeId node_id, std::span<const float> vector) {
+    auto unit = normalized(vector);
+    if (!unit) {
+        return util::unexpected(Error{ErrorCode::INVALID_ARGUMENT, "Vector has no direction"});
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (dimensions_ != 0 && vector.size() != dimensions_) {
+        return util::unexpected(Error{ErrorCode::INVALID_ARGUMENT,
+                                      "Vector has " + std::to_string(vector.size()) + " dimensions, index has " +
+                                          std::to_string(dimensions_)});
+    }
+    remove_locked(node_id);
+    insert_locked(node_id, *unit);
+    return {};
+}
+
+void HnswIndex::remove(NodeId node_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    remove_locked(node_id);
+}
+
+std::optional<std::vector<float>> HnswIndex::vector_of(NodeId node_id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = slot_of_.find(node_id);
+    if (it == slot_of_.end()) {
+        return std::nullopt;
+    }
+    const float* vector = vector_at(it->second);
+    return std::vector<float>(vector, vector + dimensions_);
+}
+
+void HnswIndex::remove_locked(NodeId node_id) {
+    auto it = slot_of_.find(node_id);
+    if (it == slot_of_.end()) {
+        return;
+    }
+    slots_[it->second].deleted = true;
+    slot_of_.erase(it);
+    if (slots_.size() - slot_of_.size() > slot_of_.size()) {
+        rebuild_locked();
+    }
+}
+
+void HnswIndex::rebuild_locked() {
+    std::vector<std::pair<NodeId, std::vector<float>>> live;
+    live.reserve(slot_of_.size());
+    for (uint32_t slot = 0; slot < slots_.size(); ++slot) {
+        if (!slots_[slot].deleted) {
+            const float* vector = vector_at(slot);
+            live.emplace_back(slots_[slot].node_id, std::vector<float>(vector, vector + dimensions_));
+        }
+    }
+    const uint32_t dimensions = dimensions_;
+    vectors_.clear();
+    slots_.clear();
+    slot_of_.clear();
+    entry_ = NO_SLOT;
+    top_level_ = 0;
+    dimensions_ = live.empty() ? 0 : dimensions;
+    for (const auto& [node_id, vector] : live) {
+        insert_locked(node_id, vector);
+    }
+}
+
+void HnswIndex::insert_locked(NodeId node_id, const std::vector<float>& unit) {
+    if (dimensions_ == 0) {
+        dimensions_ = static_cast<uint32_t>(unit.size());
+    }
+
+    // Levels fall off geometrically with ratio 1/M
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const double draw = std::max(uniform(rng_), 1e-12);
+    const size_t level = std::min<size_t>(static_cast<size_t>(-std::log(draw) / std::log(double{M})), MAX_LEVEL);
+
+    const auto slot = static_cast<uint32_t>(slots_.size());
+    vectors_.insert(vectors_.end(), unit.begin(), unit.end());
+    slots_.push_back(Slot{node_id, false, std::vector<std::vector<uint32_t>>(level + 1)});
+    slot_of_[node_id] = slot;
+    if (entry_ == NO_SLOT) {
+        entry_ = slot;
+        top_level_ = level;
+        return;
+    }
+
+    const float* query = vector_at(slot);
+    std::vector<Candidate> entry = descend(query, level);
+    for (size_t layer = std::min(level, top_level_) + 1; layer-- > 0;) {
+        auto nearest = search_layer(query, entry, EF_CONSTRUCTION, layer);
+        slots_[slot].links[layer] = select_neighbors(nearest, M);
+
+        for (uint32_t neighbor : slots_[slot].links[layer]) {
+            auto& links = slots_[neighbor].links[layer];
+            links.push_back(slot);
+            if (links.size() <= max_links(layer)) {
+                continue;
+            }
+            // Over capacity: keep a diverse subset of the neighbour's links
+            const float* base = vector_at(neighbor);
+            std::vector<Candidate> candidates;
+            candidates.reserve(links.size());
+            for (uint32_t linked : links) {
+                candidates.emplace_back(distance(base, linked), linked);
+            }
+            std::sort(candidates.begin(), candidates.end());
+            links = select_neighbors(candidates, max_links(layer));
+        }
+        entry = std::move(nearest);
+    }
+
+    if (level > top_level_) {
+        entry_ = slot;
+        top_level_ = level;
+    }
+}
+
+std::vector<HnswIndex::Candidate> HnswIndex::descend(const float* query, size_t layer) const {
+    Candidate best{distance(query, entry_), entry_};
+    for (size_t current = top_level_; current > layer; --current) {
+        for (bool moved = true; moved;) {
+            moved = false;
+            for (uint32_t neighbor : slots_[best.second].links[current]) {
+                const float d = distance(query, neighbor);
+                if (d < best.first) {
+                    best = {d, neighbor};
+                    moved = true;
+                }
+            }
+        }
+    }
+    return {best};
+}
+
+std::vector<HnswIndex::Candidate> HnswIndex::search_layer(const float* query, const std::vector<Candidate>& entry,
+                                                          size_t ef, size_t layer) const {
+    std::vector<bool> visited(slots_.size(), false);
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> frontier;  // Nearest on top
+    std::priority_queue<Candidate> found;                                            // Farthest on top
+    for (const auto& candidate : entry) {
+        visited[candidate.second] = true;
+        frontier.push(candidate);
+        found.push(candidate);
+    }
+    while (found.size() > ef) {
+        found.pop();
+    }
+
+    while (!frontier.empty()) {
+        const auto [d, slot] = frontier.top();
+        if (found.size() >= ef && d > found.top().first) {
+            break;
+        }
+        frontier.pop();
+        for (uint32_t neighbor : slots_[slot].links[layer]) {
+            if (visited[neighbor]) {
+                continue;
+            }
+            visited[neighbor] = true;
+            const float nd = distance(query, neighbor);
+            if (found.size() < ef || nd < found.top().first) {
+                frontier.emplace(nd, neighbor);
+                found.emplace(nd, neighbor);
+                if (found.size() > ef) {
+                    found.pop();
+                }
+            }
+        }
+    }
+
+    std::vector<Candidate> nearest(found.size());
+    for (size_t i = nearest.size(); i-- > 0;) {
+        nearest[i] = found.top();
+        found.pop();
+    }
+    return nearest;
+}
+
+std::vector<uint32_t> HnswIndex::select_neighbors(const std::vector<Candidate>& candidates, size_t limit) const {
+    std::vector<uint32_t> chosen;
+    std::vector<uint32_t> pruned;
+    for (const auto& [d, slot] : candidates) {
+        if (chosen.size() >= limit) {
+            break;
+        }
+        // Skip a candidate that an already chosen neighbour is closer to; the
+        // chosen one reaches it, and links spread across directions instead
+        const bool covered = std::any_of(chosen.begin(), chosen.end(), [&](uint32_t other) {
+            return distance(vector_at(slot), other) < d;
+        });
+        (covered ? pruned : chosen).push_back(slot);
+    }
+    // Fill remaining capacity with the nearest pruned candidates
+    for (size_t i = 0; i < pruned.size() && chosen.size() < limit; ++i) {
+        chosen.push_back(pruned[i]);
+    }
+    return chosen;
+}
+
+std::vector<HnswIndex::Hit> HnswIndex::search(std::span<const float> query, size_t k,
+                                              const PostingList& exclude) const {
+    auto unit = normalized(query);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (!unit || k == 0 || entry_ == NO_SLOT || query.size() != dimensions_) {
+        return {};
+    }
+
+    const size_t ef = std::max(EF_SEARCH, k + exclude.size());
+    auto nearest = search_layer(unit->data(), descend(unit->data(), 0), ef, 0);
+
+    std::vector<Hit> hits;
+    for (const auto& [d, slot] : nearest) {
+        if (hits.size() == k) {
+            break;
+        }
+        if (!slots_[slot].deleted && !exclude.contains(slots_[slot].node_id)) {
+            hits.push_back(Hit{slots_[slot].node_id, 1.0f - d});
+        }
+    }
+    return hits;
+}
+
+std::vector<uint8_t> HnswIndex::serialize() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<uint8_t> out;
+    put(out, FORMAT_VERSION);
+    put(out, dimensions_);
+    put(out, static_cast<uint32_t>(slots_.size()));
+    put(out, entry_);
+    put(out, static_cast<uint32_t>(top_level_));
+    for (const auto& slot : slots_) {
+        put(out, slot.node_id);
+        put(out, static_cast<uint8_t>(slot.deleted));
+        put(out, static_cast<uint8_t>(slot.links.size()));
+        for (const auto& links : slot.links) {
+            put(out, static_cast<uint32_t>(links.size()));
+            for (uint32_t linked : links) {
+                put(out, linked);
+            }
+        }
+    }
+    const auto* floats = reinterpret_cast<const uint8_t*>(vectors_.data());
+    out.insert(out.end(), floats, floats + vectors_.size() * sizeof(float));
+    return out;
+}
+
+util::expected<void, Error> HnswIndex::load(std::span<const uint8_t> data) {
+    const auto corrupt = [](const std::string& what) {
+        return util::unexpected(Error{ErrorCode::CORRUPTION, "Vector index " + what});
+    };
+
+    Reader reader{data};
+    uint32_t version = 0;
+    uint32_t dimensions = 0;
+    uint32_t count = 0;
+    uint32_t entry = 0;
+    uint32_t top_level = 0;
+    if (!reader.get(version) || !reader.get(dimensions) || !reader.get(count) || !reader.get(entry) ||
+        !reader.get(top_level)) {
+        return corrupt("header is truncated");
+    }
+    if (version != FORMAT_VERSION) {
+        return corrupt("has unsupported version " + std::to_string(version));
+    }
+    if (count == 0 ? entry != NO_SLOT : (entry >= count || dimensions == 0)) {
+        return corrupt("has an invalid entry point");
+    }
+
+    std::vector<Slot> slots(count);
+    std::unordered_map<NodeId, uint32_t> slot_of;
+    for (uint32_t s = 0; s < count; ++s) {
+        uint8_t deleted = 0;
+        uint8_t levels = 0;
+        if (!reader.get(slots[s].node_id) || !reader.get(deleted) || !reader.get(levels) || levels == 0 ||
+            levels > MAX_LEVEL + 1) {
+            return corrupt("slot " + std::to_string(s) + " is truncated or invalid");
+        }
+        slots[s].deleted = deleted != 0;
+        slots[s].links.resize(levels);
+        for (auto& links : slots[s].links) {
+            uint32_t size = 0;
+            if (!reader.get(size) || size > 2 * M) {
+                return corrupt("slot " + std::to_string(s) + " has invalid links");
+            }
+            links.resize(size);
+            for (uint32_t& linked : links) {
+                if (!reader.get(linked) || linked >= count) {
+                    return corrupt("slot " + std::to_string(s) + " has invalid links");
+                }
+            }
+        }
+        if (!slots[s].deleted && !slot_of.emplace(slots[s].node_id, s).second) {
+            return corrupt("holds node " + std::to_string(slots[s].node_id) + " twice");
+        }
+    }
+    // Every link must exist on its target's layers too
+    for (const auto& slot : slots) {
+        for (size_t layer = 0; layer < slot.links.size(); ++layer) {
+            for (uint32_t linked : slot.links[layer]) {
+                if (slots[linked].links.size() <= layer) {
+                    return corrupt("links a slot above its level");
+                }
+            }
+        }
+    }
+    if (count != 0 && slots[entry].links.size() != top_level + 1) {
+        return corrupt("has an invalid entry point");
+    }
+
+    const size_t floats = size_t{count} * dimensions;
+    if ((data.size() - reader.offset) != floats * sizeof(float)) {
+        return corrupt("vector data has the wrong size");
+    }
+    std::vector<float> vectors(floats);
+    std::memcpy(vectors.data(), data.data() + reader.offset, floats * sizeof(float));
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    dimensions_ = count == 0 ? 0 : dimensions;
+    vectors_ = std::move(vectors);
+    slots_ = std::move(slots);
+    slot_of_ = std::move(slot_of);
+    entry_ = entry;
+    top_level_ = top_level;
+    return {};
+}
+
+}  // namespace loredb::storage
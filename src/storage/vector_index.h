@@ -0,0 +1,119 @@
+/// \file vector_index.h
+/// \brief Approximate nearest-neighbour index over float vectors (HNSW).
+/// \author LoreDB contributors
+/// \ingroup storage
+#pragma once
+
+#include "page_store.h"
+#include "posting_list.h"
+#include "record.h"
+#include "../util/expected.h"
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace loredb::storage {
+
+// The float vector held by `value`: a VECTOR, or BYTES of packed native-endian
+// float32 (how embeddings arrive from clients without a vector type)
+std::optional<std::vector<float>> vector_value(const PropertyValue& value);
+
+/**
+ * @class HnswIndex
+ * @brief Hierarchical navigable small-world graph over node vectors, by cosine similarity.
+ *
+ * Vectors are normalized on insert, so similarity is a dot product computed
+ * by an AVX-512 or AVX2/FMA kernel when the build targets them (release builds
+ * use -march=native), and by an unrolled scalar loop otherwise. Each vector
+ * is a slot on layers 0..level, linked to up to M neighbours per layer (2M on
+ * layer 0). Neighbours are chosen with the diversity heuristic of Malkov and
+ * Yashunin.
+ *
+ * Inserts are incremental. Replacing or removing a node's vector leaves a
+ * tombstone that searches route through but never return; once tombstones
+ * outnumber live vectors the graph is rebuilt from the live ones. The whole
+ * graph serializes to a blob, so an index reopens without re-inserting.
+ * Lookups take a shared lock and writes an exclusive one.
+ */
+class HnswIndex {
+public:
+    static constexpr size_t M = 16;
+    static constexpr size_t EF_CONSTRUCTION = 200;
+    static constexpr size_t EF_SEARCH = 64;
+
+    struct Hit {
+        NodeId node_id = 0;
+        float similarity = 0.0f;  // Cosine similarity in [-1, 1]
+    };
+
+    HnswIndex() = default;
+    HnswIndex(const HnswIndex&) = delete;
+    HnswIndex& operator=(const HnswIndex&) = delete;
+
+    // Dot product of two float arrays of length `n`
+    static float dot(const float* a, const float* b, size_t n);
+
+    // Dimensions fixed by the first vector inserted; 0 while empty
+    uint32_t dimensions() const;
+    // Live vectors
+    size_t size() const;
+
+    // Adds or replaces the vector of `node_id`. INVALID_ARGUMENT for a zero
+    // vector or one whose dimensions differ from dimensions().
+    util::expected<void, Error> insert(NodeId node_id, std::span<const float> vector);
+    void remove(NodeId node_id);
+    // The stored, normalized vector of `node_id`
+    std::optional<std::vector<float>> vector_of(NodeId node_id) const;
+
+    // Approximately the `k` vectors most similar to `query`, best first,
+    // skipping the ids in `exclude`
+    std::vector<Hit> search(std::span<const float> query, size_t k, const PostingList& exclude = {}) const;
+
+    std::vector<uint8_t> serialize() const;
+    // Replaces the contents with a blob from serialize(); on error nothing changes
+    util::expected<void, Error> load(std::span<const uint8_t> data);
+
+private:
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+    static constexpr uint8_t MAX_LEVEL = 16;
+
+    struct Slot {
+        NodeId node_id = 0;
+        bool deleted = false;
+        std::vector<std::vector<uint32_t>> links;  // Neighbour slots by layer, 0..level
+    };
+
+    // (distance, slot); distance is 1 - similarity
+    using Candidate = std::pair<float, uint32_t>;
+
+    const float* vector_at(uint32_t slot) const { return vectors_.data() + size_t{slot} * dimensions_; }
+    float distance(const float* query, uint32_t slot) const;
+    static size_t max_links(size_t layer) { return layer == 0 ? 2 * M : M; }
+
+    // Closest `ef` slots to `query` on `layer` reachable from `entry`, nearest first
+    std::vector<Candidate> search_layer(const float* query, const std::vector<Candidate>& entry, size_t ef,
+                                        size_t layer) const;
+    // Up to `limit` of `candidates` (nearest first) that are not closer to an already chosen one
+    std::vector<uint32_t> select_neighbors(const std::vector<Candidate>& candidates, size_t limit) const;
+    // Greedy descent from the top layer down to `layer` + 1
+    std::vector<Candidate> descend(const float* query, size_t layer) const;
+
+    void insert_locked(NodeId node_id, const std::vector<float>& normalized);
+    void remove_locked(NodeId node_id);
+    void rebuild_locked();
+
+    mutable std::shared_mutex mutex_;
+    uint32_t dimensions_ = 0;
+    std::vector<float> vectors_;  // Slot-major, normalized
+    std::vector<Slot> slots_;
+    std::unordered_map<NodeId, uint32_t> slot_of_;  // Live slot of each node
+    uint32_t entry_ = NO_SLOT;
+    size_t top_level_ = 0;
+    std::mt19937 rng_{0x5eed};
+};
+
+}  // namespace loredb::storage
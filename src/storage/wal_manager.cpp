@@ -1,5 +1,6 @@
 #include "wal_manager.h"
 #include "../util/logger.h"
+#include "../util/varint.h"
 #include <fstream>
 #include <chrono>
 #include <cstring>
@@ -8,6 +9,28 @@
 
 namespace loredb::storage {
 
+namespace {
+
+void write_varint(std::ostream& out, uint64_t value) {
+    uint8_t temp[util::VarInt::MAX_ENCODED_SIZE];
+    const size_t len = util::VarInt::encode(value, temp);
+    out.write(reinterpret_cast<const char*>(temp), static_cast<std::streamsize>(len));
+}
+
+util::expected<uint64_t, Error> read_varint(std::istream& in) {
+    uint8_t temp[util::VarInt::MAX_ENCODED_SIZE];
+    size_t len = 0;
+    do {
+        if (len == sizeof(temp) || !in.read(reinterpret_cast<char*>(&temp[len]), 1)) {
+            return util::unexpected(Error{ErrorCode::IO_ERROR, "Failed to read varint"});
+        }
+    } while (temp[len++] & 0x80);
+    std::span<const uint8_t> data(temp, len);
+    return util::VarInt::decode(data);
+}
+
+}  // namespace
+
 size_t WALRecord::get_serialized_size() const {
     size_t base_size = sizeof(LSN) + sizeof(transaction::TransactionId) + 
                        sizeof(WALRecordType) + sizeof(uint64_t) + sizeof(uint32_t);
@@ -15,19 +38,13 @@ size_t WALRecord::get_serialized_size() const {
     if (std::holds_alternative<std::pair<NodeId, std::vector<Property>>>(data)) {
         const auto& [node_id, props] = std::get<std::pair<NodeId, std::vector<Property>>>(data);
         base_size += sizeof(NodeId);
-        for (const auto& prop : props) {
-            base_size += prop.key.size() + sizeof(uint32_t); // key length + key
-            // Simplified property value size calculation
-            base_size += sizeof(uint32_t) + 64; // type + estimated value size
-        }
+        // Per property: key id (name only on first use), type and an estimated value size
+        base_size += props.size() * (util::VarInt::MAX_ENCODED_SIZE + sizeof(uint32_t) + 64);
     } else if (std::holds_alternative<std::tuple<EdgeId, NodeId, NodeId, std::string, std::vector<Property>>>(data)) {
         const auto& [edge_id, from, to, label, props] =
             std::get<std::tuple<EdgeId, NodeId, NodeId, std::string, std::vector<Property>>>(data);
         base_size += sizeof(EdgeId) + sizeof(NodeId) + sizeof(NodeId) + sizeof(uint32_t) + label.size();
-        for (const auto& prop : props) {
-            base_size += prop.key.size() + sizeof(uint32_t);
-            base_size += sizeof(uint32_t) + 64;
-        }
+        base_size += props.size() * (util::VarInt::MAX_ENCODED_SIZE + sizeof(uint32_t) + 64);
     } else if (std::holds_alternative<LSN>(data)) {
         base_size += sizeof(LSN);
     }
@@ -67,8 +84,9 @@ WALManager::WALManager(const std::string& path) : path_(path) {
             log_file_.seekg(sizeof(WALHeader), std::ios::beg);
             
             LSN max_lsn = 0;
+            LoggedKeys keys;
             while (log_file_.tellg() < file_size) {
-                auto record_result = read_record(log_file_);
+                auto record_result = read_record(log_file_, keys);
                 if (!record_result.has_value()) break;
                 max_lsn = std::max(max_lsn, record_result.value().lsn);
             }
@@ -294,9 +312,10 @@ util::expected<void, Error> WALManager::recover_from_log(const std::function<uti
     
     size_t records_applied = 0;
     LSN max_lsn = 0;
+    LoggedKeys keys;
     
     while (recovery_file.good()) {
-        auto record_result = read_record(recovery_file);
+        auto record_result = read_record(recovery_file, keys);
         if (!record_result.has_value()) {
             if (recovery_file.eof()) break;
             LOG_WARN("Failed to read WAL record during recovery: {}", record_result.error().message);
@@ -344,9 +363,7 @@ util::expected<LSN, Error> WALManager::write_record(const WALRecord& record) {
         log_file_.write(reinterpret_cast<const char*>(&prop_count), sizeof(prop_count));
         
         for (const auto& prop : props) {
-            uint32_t key_len = static_cast<uint32_t>(prop.key.size());
-            log_file_.write(reinterpret_cast<const char*>(&key_len), sizeof(key_len));
-            log_file_.write(prop.key.data(), key_len);
+            write_key(prop.key);
             
             // Simplified property value serialization - just write the variant index for now
             uint32_t value_type = static_cast<uint32_t>(prop.value.index());
@@ -367,9 +384,7 @@ util::expected<LSN, Error> WALManager::write_record(const WALRecord& record) {
         log_file_.write(reinterpret_cast<const char*>(&prop_count), sizeof(prop_count));
         
         for (const auto& prop : props) {
-            uint32_t key_len = static_cast<uint32_t>(prop.key.size());
-            log_file_.write(reinterpret_cast<const char*>(&key_len), sizeof(key_len));
-            log_file_.write(prop.key.data(), key_len);
+            write_key(prop.key);
             
             uint32_t value_type = static_cast<uint32_t>(prop.value.index());
             log_file_.write(reinterpret_cast<const char*>(&value_type), sizeof(value_type));
@@ -386,7 +401,72 @@ util::expected<LSN, Error> WALManager::write_record(const WALRecord& record) {
     return record.lsn;
 }
 
-util::expected<WALRecord, Error> WALManager::read_record(std::istream& file) {
+void WALManager::write_key(PropertyKey key) {
+    // Ids are process-local, so the first record using a key in this log
+    // session carries its name; later records only carry the id
+    if (logged_keys_.insert(key.id()).second) {
+        write_varint(log_file_, (uint64_t{key.id()} << 1) | 1);
+        const std::string& name = key.str();
+        write_varint(log_file_, name.size());
+        log_file_.write(name.data(), static_cast<std::streamsize>(name.size()));
+    } else {
+        write_varint(log_file_, uint64_t{key.id()} << 1);
+    }
+}
+
+util::expected<PropertyKey, Error> WALManager::read_key(std::istream& file, LoggedKeys& keys) {
+    auto tag = read_varint(file);
+    if (!tag.has_value()) {
+        return util::unexpected(tag.error());
+    }
+    const uint64_t log_id = tag.value() >> 1;
+    
+    if (tag.value() & 1) {
+        auto len = read_varint(file);
+        if (!len.has_value() || len.value() > MAX_LOGGED_STRING) {
+            return util::unexpected(Error{ErrorCode::CORRUPTION, "Invalid WAL property key"});
+        }
+        std::string name(len.value(), '\0');
+        if (!file.read(name.data(), static_cast<std::streamsize>(name.size()))) {
+            return util::unexpected(Error{ErrorCode::IO_ERROR, "Failed to read WAL property key"});
+        }
+        // A later session may have given the id another name; the newest wins
+        PropertyKey key(name);
+        keys.insert_or_assign(log_id, key);
+        return key;
+    }
+    
+    auto it = keys.find(log_id);
+    if (it == keys.end()) {
+        return util::unexpected(Error{ErrorCode::CORRUPTION, "WAL property key used before its definition"});
+    }
+    return it->second;
+}
+
+util::expected<std::vector<Property>, Error> WALManager::read_properties(std::istream& file, LoggedKeys& keys) {
+    uint32_t prop_count = 0;
+    file.read(reinterpret_cast<char*>(&prop_count), sizeof(prop_count));
+    if (!file) {
+        return util::unexpected(Error{ErrorCode::IO_ERROR, "Failed to read WAL properties"});
+    }
+    
+    std::vector<Property> props;
+    for (uint32_t i = 0; i < prop_count; ++i) {
+        auto key = read_key(file, keys);
+        if (!key.has_value()) {
+            return util::unexpected(key.error());
+        }
+        
+        uint32_t value_type;
+        file.read(reinterpret_cast<char*>(&value_type), sizeof(value_type));
+        
+        // For now, just create a placeholder property
+        props.emplace_back(key.value(), std::string("placeholder"));
+    }
+    return props;
+}
+
+util::expected<WALRecord, Error> WALManager::read_record(std::istream& file, LoggedKeys& keys) {
     WALRecord record;
     
     // Read fixed-size header
@@ -414,27 +494,37 @@ util::expected<WALRecord, Error> WALManager::read_record(std::istream& file) {
             NodeId node_id;
             file.read(reinterpret_cast<char*>(&node_id), sizeof(node_id));
             
-            std::vector<Property> props;
-            if (record.type != WALRecordType::DELETE_NODE) {
-                uint32_t prop_count;
-                file.read(reinterpret_cast<char*>(&prop_count), sizeof(prop_count));
-                
-                for (uint32_t i = 0; i < prop_count; ++i) {
-                    uint32_t key_len;
-                    file.read(reinterpret_cast<char*>(&key_len), sizeof(key_len));
-                    
-                    std::string key(key_len, '\0');
-                    file.read(key.data(), key_len);
-                    
-                    uint32_t value_type;
-                    file.read(reinterpret_cast<char*>(&value_type), sizeof(value_type));
-                    
-                    // For now, just create a placeholder property
-                    props.emplace_back(std::move(key), std::string("placeholder"));
-                }
+            auto props = read_properties(file, keys);
+            if (!props.has_value()) {
+                return util::unexpected(props.error());
             }
+            record.data = std::make_pair(node_id, std::move(props.value()));
+            break;
+        }
+        
+        case WALRecordType::CREATE_EDGE:
+        case WALRecordType::UPDATE_EDGE:
+        case WALRecordType::DELETE_EDGE: {
+            EdgeId edge_id;
+            NodeId from;
+            NodeId to;
+            file.read(reinterpret_cast<char*>(&edge_id), sizeof(edge_id));
+            file.read(reinterpret_cast<char*>(&from), sizeof(from));
+            file.read(reinterpret_cast<char*>(&to), sizeof(to));
+            
+            uint32_t label_len = 0;
+            file.read(reinterpret_cast<char*>(&label_len), sizeof(label_len));
+            if (!file || label_len > MAX_LOGGED_STRING) {
+                return util::unexpected(Error{ErrorCode::CORRUPTION, "Invalid WAL edge label"});
+            }
+            std::string label(label_len, '\0');
+            file.read(label.data(), label_len);
             
-            record.data = std::make_pair(node_id, std::move(props));
+            auto props = read_properties(file, keys);
+            if (!props.has_value()) {
+                return util::unexpected(props.error());
+            }
+            record.data = std::make_tuple(edge_id, from, to, std::move(label), std::move(props.value()));
             break;
         }
         
@@ -480,7 +570,7 @@ util::expected<bool, Error> WALManager::read_header() {
         return util::unexpected(Error{ErrorCode::CORRUPTION, "Invalid WAL magic number"});
     }
     
-    if (header_.version != 1) {
+    if (header_.version != 2) {
         return util::unexpected(Error{ErrorCode::CORRUPTION, "Unsupported WAL version"});
     }
     
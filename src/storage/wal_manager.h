@@ -10,6 +10,8 @@
 #include <fstream>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <atomic>
 #include <variant>
@@ -41,7 +43,7 @@ enum class WALRecordType : uint8_t {
 
 struct WALHeader {
     uint32_t magic = 0xDEADBEEF;
-    uint32_t version = 1;
+    uint32_t version = 2;  // 2: property keys logged as dictionary ids
     uint64_t creation_time;
     LSN last_checkpoint_lsn = 0;
 };
@@ -125,8 +127,15 @@ public:
     util::expected<void, Error> log_operation(const OperationLog& op);
 
 private:
+    // Log key id -> key in this process, built while reading a log
+    using LoggedKeys = std::unordered_map<uint64_t, PropertyKey>;
+    static constexpr uint64_t MAX_LOGGED_STRING = 1 << 20;
+
     util::expected<LSN, Error> write_record(const WALRecord& record);
-    util::expected<WALRecord, Error> read_record(std::istream& file);
+    util::expected<WALRecord, Error> read_record(std::istream& file, LoggedKeys& keys);
+    void write_key(PropertyKey key);
+    util::expected<PropertyKey, Error> read_key(std::istream& file, LoggedKeys& keys);
+    util::expected<std::vector<Property>, Error> read_properties(std::istream& file, LoggedKeys& keys);
     util::expected<void, Error> write_header();
     util::expected<bool, Error> read_header();
     
@@ -137,6 +146,8 @@ private:
     std::atomic<LSN> current_lsn_{1};
     std::atomic<LSN> last_checkpoint_lsn_{0};
     WALHeader header_;
+    // Keys whose names this session already wrote; guarded by mutex_
+    std::unordered_set<KeyId> logged_keys_;
 };
 
 } // namespace loredb::storage 
\ No newline at end of file
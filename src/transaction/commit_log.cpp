@@ -0,0 +1,183 @@
+#include "commit_log.h"
+#include <algorithm>
+
+namespace loredb::transaction {
+
+namespace {
+
+constexpr uint64_t STATUS_MASK = 0x3;
+
+size_t next_power_of_two(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+}  // namespace
+
+CommitLog::CommitLog() {
+    directories_.push_back(std::make_unique<Directory>(INITIAL_DIRECTORY_SLOTS));
+    directory_.store(directories_.back().get(), std::memory_order_release);
+}
+
+CommitLog::~CommitLog() = default;
+
+CommitLog::Segment* CommitLog::find_segment(uint64_t segment_no) const {
+    Directory* dir = directory_.load(std::memory_order_acquire);
+    Segment* seg = dir->slots[segment_no & (dir->slots.size() - 1)].load(std::memory_order_acquire);
+    if (seg == nullptr || seg->segment_no.load(std::memory_order_acquire) != segment_no) {
+        return nullptr;
+    }
+    return seg;
+}
+
+void CommitLog::set_status(TransactionId tx_id, CommitStatus status) {
+    const uint64_t segment_no = tx_id / TXNS_PER_SEGMENT;
+    const size_t offset = tx_id % TXNS_PER_SEGMENT;
+    const size_t word_index = offset / STATUSES_PER_WORD;
+    const unsigned shift = static_cast<unsigned>((offset % STATUSES_PER_WORD) * 2);
+    const uint64_t bits = static_cast<uint64_t>(status) << shift;
+
+    while (segment_no >= truncated_segments_.load(std::memory_order_acquire)) {
+        Segment* seg = find_segment(segment_no);
+        if (seg == nullptr) {
+            seg = get_or_create_segment(segment_no);
+            if (seg == nullptr) {
+                return;  // Truncated while we waited for the lock
+            }
+        }
+
+        auto& word = seg->words[word_index];
+        uint64_t expected = word.load(std::memory_order_relaxed);
+        while (!word.compare_exchange_weak(expected, (expected & ~(STATUS_MASK << shift)) | bits,
+                                           std::memory_order_release, std::memory_order_relaxed)) {
+        }
+
+        // If the segment was recycled underneath us the write is moot; retry so the
+        // horizon check above decides whether it still needs to land somewhere.
+        if (seg->segment_no.load(std::memory_order_acquire) == segment_no) {
+            return;
+        }
+    }
+}
+
+CommitStatus CommitLog::get_status(TransactionId tx_id) const {
+    const uint64_t segment_no = tx_id / TXNS_PER_SEGMENT;
+    if (segment_no < truncated_segments_.load(std::memory_order_acquire)) {
+        return CommitStatus::COMMITTED;
+    }
+
+    Segment* seg = find_segment(segment_no);
+    if (seg == nullptr) {
+        return segment_no < truncated_segments_.load(std::memory_order_acquire)
+            ? CommitStatus::COMMITTED : CommitStatus::UNKNOWN;
+    }
+
+    const size_t offset = tx_id % TXNS_PER_SEGMENT;
+    const unsigned shift = static_cast<unsigned>((offset % STATUSES_PER_WORD) * 2);
+    const uint64_t word = seg->words[offset / STATUSES_PER_WORD].load(std::memory_order_acquire);
+
+    // Seqlock-style validation: the segment may have been recycled while we read it
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (seg->segment_no.load(std::memory_order_relaxed) != segment_no) {
+        return segment_no < truncated_segments_.load(std::memory_order_acquire)
+            ? CommitStatus::COMMITTED : CommitStatus::UNKNOWN;
+    }
+
+    return static_cast<CommitStatus>((word >> shift) & STATUS_MASK);
+}
+
+CommitLog::Segment* CommitLog::get_or_create_segment(uint64_t segment_no) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const uint64_t truncated = truncated_segments_.load(std::memory_order_relaxed);
+    if (segment_no < truncated) {
+        return nullptr;
+    }
+
+    Directory* dir = directory_.load(std::memory_order_relaxed);
+    Segment* existing = dir->slots[segment_no & (dir->slots.size() - 1)].load(std::memory_order_relaxed);
+    if (existing != nullptr) {
+        if (existing->segment_no.load(std::memory_order_relaxed) == segment_no) {
+            return existing;  // Another writer created it first
+        }
+        // Slot is occupied by a different live segment: widen the ring
+        grow_directory_locked(truncated, segment_no);
+        dir = directory_.load(std::memory_order_relaxed);
+    }
+
+    Segment* seg;
+    if (!free_segments_.empty()) {
+        seg = free_segments_.back();
+        free_segments_.pop_back();
+        for (auto& w : seg->words) {
+            w.store(0, std::memory_order_relaxed);
+        }
+    } else {
+        segments_.push_back(std::make_unique<Segment>());
+        seg = segments_.back().get();
+    }
+
+    seg->segment_no.store(segment_no, std::memory_order_release);
+    dir->slots[segment_no & (dir->slots.size() - 1)].store(seg, std::memory_order_release);
+
+    max_segment_no_ = std::max(max_segment_no_, segment_no);
+    return seg;
+}
+
+void CommitLog::grow_directory_locked(uint64_t min_live_segment, uint64_t new_segment) {
+    Directory* old_dir = directory_.load(std::memory_order_relaxed);
+    const uint64_t high = std::max(new_segment, max_segment_no_);
+    const size_t needed = static_cast<size_t>(high - min_live_segment + 1);
+    size_t capacity = std::max(old_dir->slots.size() * 2, next_power_of_two(needed));
+
+    auto new_dir = std::make_unique<Directory>(capacity);
+    for (const auto& slot : old_dir->slots) {
+        Segment* seg = slot.load(std::memory_order_relaxed);
+        if (seg == nullptr) {
+            continue;
+        }
+        const uint64_t no = seg->segment_no.load(std::memory_order_relaxed);
+        new_dir->slots[no & (capacity - 1)].store(seg, std::memory_order_relaxed);
+    }
+
+    // Old directories stay alive until destruction: lock-free readers may still hold them
+    directories_.push_back(std::move(new_dir));
+    directory_.store(directories_.back().get(), std::memory_order_release);
+}
+
+void CommitLog::truncate(TransactionId horizon) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const uint64_t new_truncated = horizon / TXNS_PER_SEGMENT;
+    const uint64_t old_truncated = truncated_segments_.load(std::memory_order_relaxed);
+    if (new_truncated <= old_truncated) {
+        return;
+    }
+
+    // Publish the horizon before invalidating segments so a reader that loses the
+    // seqlock race re-reads the horizon and reports COMMITTED
+    truncated_segments_.store(new_truncated, std::memory_order_release);
+
+    Directory* dir = directory_.load(std::memory_order_relaxed);
+    for (auto& slot : dir->slots) {
+        Segment* seg = slot.load(std::memory_order_relaxed);
+        if (seg == nullptr) {
+            continue;
+        }
+        if (seg->segment_no.load(std::memory_order_relaxed) < new_truncated) {
+            slot.store(nullptr, std::memory_order_release);
+            seg->segment_no.store(INVALID_SEGMENT, std::memory_order_release);
+            free_segments_.push_back(seg);
+        }
+    }
+}
+
+size_t CommitLog::get_segment_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return segments_.size() - free_segments_.size();
+}
+
+}  // namespace loredb::transaction
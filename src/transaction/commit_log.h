@@ -0,0 +1,115 @@
+/// \file commit_log.h
+/// \brief Compact transaction status table (commit log) indexed by transaction ID.
+/// \author LoreDB contributors
+/// \ingroup transaction
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace loredb::transaction {
+
+using TransactionId = uint64_t;
+
+/// Two-bit status stored per transaction in the commit log.
+enum class CommitStatus : uint8_t {
+    UNKNOWN = 0,      // Never recorded (e.g. issued by another manager); treated as committed
+    IN_PROGRESS = 1,
+    COMMITTED = 2,
+    ABORTED = 3
+};
+
+/**
+ * @class CommitLog
+ * @brief CLOG-style status table: two bits per transaction in fixed-size segments.
+ *
+ * Transaction IDs are dense and monotonically increasing, so statuses are stored
+ * positionally in segments of TXNS_PER_SEGMENT entries, addressed through a ring
+ * directory (segment `s` lives in slot `s % capacity`). Segments that lie entirely
+ * below the truncation horizon are dropped and every ID below the horizon reports
+ * COMMITTED, which bounds memory by the span of in-flight transactions rather than
+ * by the total number of transactions ever run.
+ *
+ * Status lookups are lock-free. Truncated segments are recycled rather than freed,
+ * so a reader racing with truncation always dereferences valid memory; it detects
+ * recycling by re-checking the segment number after reading (seqlock style).
+ * Structural changes (allocation, truncation, directory growth) are serialized by
+ * an internal mutex; status updates on existing segments are plain CAS operations.
+ */
+class CommitLog {
+public:
+    static constexpr size_t TXNS_PER_SEGMENT = 32768;  // 8 KiB of status bits
+    static constexpr size_t INITIAL_DIRECTORY_SLOTS = 16;
+
+    CommitLog();
+    ~CommitLog();
+
+    // Rule-of-five: non-copyable, non-movable (readers hold raw pointers)
+    CommitLog(const CommitLog&) = delete;
+    CommitLog& operator=(const CommitLog&) = delete;
+    CommitLog(CommitLog&&) = delete;
+    CommitLog& operator=(CommitLog&&) = delete;
+
+    /**
+     * @brief Record the status of a transaction, allocating its segment if needed.
+     * IDs below the truncation horizon are ignored.
+     */
+    void set_status(TransactionId tx_id, CommitStatus status);
+
+    /**
+     * @brief Lock-free status lookup.
+     * @return COMMITTED for IDs below the horizon, UNKNOWN for IDs never recorded.
+     */
+    CommitStatus get_status(TransactionId tx_id) const;
+
+    /**
+     * @brief Drop all segments that lie entirely below `horizon`.
+     *
+     * After truncation every ID below the (segment-aligned) horizon reports COMMITTED.
+     * Callers must ensure no live version still depends on an aborted or in-progress
+     * transaction below the horizon (see MVCCManager::garbage_collect).
+     */
+    void truncate(TransactionId horizon);
+
+    /** First transaction ID whose status is still tracked explicitly. */
+    TransactionId get_horizon() const {
+        return truncated_segments_.load(std::memory_order_acquire) * TXNS_PER_SEGMENT;
+    }
+
+    /** Number of segments currently holding live statuses. */
+    size_t get_segment_count() const;
+
+private:
+    static constexpr uint64_t INVALID_SEGMENT = UINT64_MAX;
+    static constexpr size_t STATUSES_PER_WORD = 32;
+    static constexpr size_t WORDS_PER_SEGMENT = TXNS_PER_SEGMENT / STATUSES_PER_WORD;
+
+    struct Segment {
+        std::atomic<uint64_t> segment_no{INVALID_SEGMENT};
+        std::array<std::atomic<uint64_t>, WORDS_PER_SEGMENT> words{};
+    };
+
+    struct Directory {
+        explicit Directory(size_t n) : slots(n) {}
+        std::vector<std::atomic<Segment*>> slots;
+    };
+
+    Segment* find_segment(uint64_t segment_no) const;
+    Segment* get_or_create_segment(uint64_t segment_no);
+    void grow_directory_locked(uint64_t min_live_segment, uint64_t new_segment);
+
+    std::atomic<Directory*> directory_;
+    std::atomic<uint64_t> truncated_segments_{0};
+
+    mutable std::mutex mutex_;
+    uint64_t max_segment_no_{0};                            // Highest segment ever allocated
+    std::vector<std::unique_ptr<Segment>> segments_;        // Owns every segment ever allocated
+    std::vector<Segment*> free_segments_;                   // Recycled segments ready for reuse
+    std::vector<std::unique_ptr<Directory>> directories_;   // Current and retired directories
+};
+
+}  // namespace loredb::transaction
@@ -1,23 +1,33 @@
 #include "mvcc.h"
+#include <algorithm>
 #include <mutex>  // for std::unique_lock
 
 namespace loredb::transaction {
 
 TransactionManager::TransactionManager() : next_transaction_id_(1), current_timestamp_(1) {
+    horizon_thread_ = std::thread([this] { run_horizon_sweeps(); });
 }
 
-TransactionManager::~TransactionManager() = default;
+TransactionManager::~TransactionManager() {
+    {
+        std::lock_guard<std::mutex> lock(horizon_mutex_);
+        stopping_ = true;
+    }
+    horizon_cv_.notify_all();
+    horizon_thread_.join();
+}
 
 std::shared_ptr<Transaction> TransactionManager::begin_transaction() {
+    // Issue the ID under the lock so commit log truncation never overtakes a transaction
+    // that has been numbered but not yet registered as active
+    std::unique_lock<std::shared_mutex> lock(transactions_mutex_);
     TransactionId tid = next_transaction_id_.fetch_add(1);
     auto txn = std::make_shared<Transaction>(tid);
     txn->start_timestamp = get_current_timestamp();
     
     // Track active transaction
-    {
-        std::unique_lock<std::shared_mutex> lock(transactions_mutex_);
-        active_transactions_[tid] = txn;
-    }
+    commit_log_.set_status(tid, CommitStatus::IN_PROGRESS);
+    active_transactions_[tid] = txn;
     
     return txn;
 }
@@ -30,12 +40,16 @@ bool TransactionManager::commit_transaction(std::shared_ptr<Transaction> txn) {
     txn->commit_timestamp = get_current_timestamp();
     txn->state = TransactionState::COMMITTED;
     
-    // Move from active to completed
+    // Record the outcome before leaving the active set so truncation can never pass it
+    commit_log_.set_status(txn->id, CommitStatus::COMMITTED);
+    TransactionId oldest_active;
     {
         std::unique_lock<std::shared_mutex> lock(transactions_mutex_);
         active_transactions_.erase(txn->id);
-        completed_transactions_[txn->id] = TransactionState::COMMITTED;
+        oldest_active = oldest_active_locked();
     }
+    transactions_finished_.notify_all();
+    advance_horizon(oldest_active);
     
     return true;
 }
@@ -47,12 +61,16 @@ bool TransactionManager::abort_transaction(std::shared_ptr<Transaction> txn) {
     
     txn->state = TransactionState::ABORTED;
     
-    // Move from active to completed
+    // Record the outcome before leaving the active set so truncation can never pass it
+    commit_log_.set_status(txn->id, CommitStatus::ABORTED);
+    TransactionId oldest_active;
     {
         std::unique_lock<std::shared_mutex> lock(transactions_mutex_);
         active_transactions_.erase(txn->id);
-        completed_transactions_[txn->id] = TransactionState::ABORTED;
+        oldest_active = oldest_active_locked();
     }
+    transactions_finished_.notify_all();
+    advance_horizon(oldest_active);
     
     return true;
 }
@@ -74,22 +92,98 @@ bool TransactionManager::is_visible(Timestamp created_at, Timestamp deleted_at,
 }
 
 bool TransactionManager::is_transaction_committed(TransactionId tx_id) const {
+    switch (commit_log_.get_status(tx_id)) {
+        case CommitStatus::IN_PROGRESS:
+        case CommitStatus::ABORTED:
+            return false;
+        case CommitStatus::COMMITTED:
+        case CommitStatus::UNKNOWN:
+            // Unknown IDs predate this manager or were truncated; assume they committed
+            return true;
+    }
+    return true;
+}
+
+bool TransactionManager::is_transaction_aborted(TransactionId tx_id) const {
+    return commit_log_.get_status(tx_id) == CommitStatus::ABORTED;
+}
+
+TransactionId TransactionManager::get_oldest_active_transaction_id() const {
     std::shared_lock<std::shared_mutex> lock(transactions_mutex_);
-    
-    // Check if transaction is still active
-    if (active_transactions_.find(tx_id) != active_transactions_.end()) {
-        return false;
+    return oldest_active_locked();
+}
+
+void TransactionManager::wait_for_transactions_before(TransactionId tx_id) const {
+    std::shared_lock<std::shared_mutex> lock(transactions_mutex_);
+    transactions_finished_.wait(lock, [&] { return oldest_active_locked() >= tx_id; });
+}
+
+TransactionId TransactionManager::oldest_active_locked() const {
+    if (active_transactions_.empty()) {
+        return next_transaction_id_.load();
     }
-    
-    // Check completed transactions
-    auto it = completed_transactions_.find(tx_id);
-    if (it != completed_transactions_.end()) {
-        return it->second == TransactionState::COMMITTED;
+    return active_transactions_.begin()->first;
+}
+
+void TransactionManager::truncate_commit_log(TransactionId horizon) {
+    // Hold the lock so no transaction can leave the active set mid-truncation
+    std::shared_lock<std::shared_mutex> lock(transactions_mutex_);
+    commit_log_.truncate(std::min(horizon, oldest_active_locked()));
+}
+
+size_t TransactionManager::add_horizon_listener(HorizonListener listener) {
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    const size_t token = next_listener_token_++;
+    horizon_listeners_.emplace(token, std::move(listener));
+    return token;
+}
+
+void TransactionManager::remove_horizon_listener(size_t token) {
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    horizon_listeners_.erase(token);
+}
+
+void TransactionManager::advance_horizon(TransactionId oldest_active) {
+    const TransactionId horizon = oldest_active - oldest_active % CommitLog::TXNS_PER_SEGMENT;
+    if (horizon <= commit_log_.get_horizon() || horizon <= pending_horizon_.load()) {
+        return;
     }
-    
-    // Transaction not found, assume it's old and committed
-    // This handles the case where we've garbage collected old transaction records
-    return true;
+    {
+        std::lock_guard<std::mutex> lock(horizon_mutex_);
+        if (horizon <= pending_horizon_.load()) {
+            return;
+        }
+        pending_horizon_.store(horizon);
+    }
+    horizon_cv_.notify_all();
+}
+
+void TransactionManager::run_horizon_sweeps() {
+    std::unique_lock<std::mutex> lock(horizon_mutex_);
+    while (true) {
+        horizon_cv_.wait(lock, [this] { return stopping_ || pending_horizon_.load() > swept_horizon_; });
+        if (stopping_) {
+            return;
+        }
+        // Horizons requested while this sweep runs are picked up by the next one
+        const TransactionId horizon = pending_horizon_.load();
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> listeners_lock(listeners_mutex_);
+            for (auto& [token, listener] : horizon_listeners_) {
+                listener(horizon);
+            }
+        }
+        truncate_commit_log(horizon);
+        lock.lock();
+        swept_horizon_ = horizon;
+        horizon_cv_.notify_all();
+    }
+}
+
+void TransactionManager::wait_for_horizon_sweep() {
+    std::unique_lock<std::mutex> lock(horizon_mutex_);
+    horizon_cv_.wait(lock, [this] { return stopping_ || swept_horizon_ >= pending_horizon_.load(); });
 }
 
-}  // namespace loredb::transaction
\ No newline at end of file
+}  // namespace loredb::transaction
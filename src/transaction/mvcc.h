@@ -1,14 +1,18 @@
 #pragma once
 
+#include "commit_log.h"
 #include <cstdint>
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
 #include <shared_mutex>
+#include <thread>
 
 namespace loredb::transaction {
 
-using TransactionId = uint64_t;
 using Timestamp = uint64_t;
 
 enum class TransactionState {
@@ -36,8 +40,38 @@ public:
     bool commit_transaction(std::shared_ptr<Transaction> txn);
     bool abort_transaction(std::shared_ptr<Transaction> txn);
     
-    // Check if a transaction is committed
+    // Check if a transaction is committed (lock-free commit log lookup).
+    // IDs the log has never seen, or that fall below the truncation horizon, count as committed.
     bool is_transaction_committed(TransactionId tx_id) const;
+
+    // Check if a transaction is known to have aborted
+    bool is_transaction_aborted(TransactionId tx_id) const;
+
+    // Oldest transaction still running, or the next ID to be issued if none are active
+    TransactionId get_oldest_active_transaction_id() const;
+
+    // Blocks until every transaction with an ID below `tx_id` has committed or aborted
+    void wait_for_transactions_before(TransactionId tx_id) const;
+
+    // Drop commit log segments below `horizon` (clamped to the oldest active transaction).
+    // Only safe once no surviving version references an aborted transaction below it.
+    void truncate_commit_log(TransactionId horizon);
+
+    const CommitLog& get_commit_log() const { return commit_log_; }
+
+    // Called once a commit or abort has moved the oldest active transaction past a
+    // commit log segment boundary, just before the log drops the statuses below
+    // `horizon`. Listeners run on a background thread so the commit that crossed
+    // the boundary does not pay for them. A listener must stop depending on
+    // aborted transactions below `horizon`; MVCCManager registers one that purges
+    // their versions.
+    using HorizonListener = std::function<void(TransactionId horizon)>;
+    // Returns a token for remove_horizon_listener(); removal waits for a running sweep
+    size_t add_horizon_listener(HorizonListener listener);
+    void remove_horizon_listener(size_t token);
+
+    // Blocks until the background sweep has caught up with every horizon requested so far
+    void wait_for_horizon_sweep();
     
     Timestamp get_current_timestamp();
     bool is_visible(Timestamp created_at, Timestamp deleted_at, Timestamp read_timestamp);
@@ -46,10 +80,34 @@ private:
     std::atomic<TransactionId> next_transaction_id_;
     std::atomic<Timestamp> current_timestamp_;
     
-    // Track transaction states
+    // Active transactions ordered by ID so the oldest is always begin()
     mutable std::shared_mutex transactions_mutex_;
-    std::unordered_map<TransactionId, std::shared_ptr<Transaction>> active_transactions_;
-    std::unordered_map<TransactionId, TransactionState> completed_transactions_;
+    std::map<TransactionId, std::shared_ptr<Transaction>> active_transactions_;
+    // Signalled whenever a transaction leaves the active set
+    mutable std::condition_variable_any transactions_finished_;
+
+    // Hands the background sweep a new horizon once `oldest_active` has left the
+    // oldest tracked commit log segment
+    void advance_horizon(TransactionId oldest_active);
+    // Background thread: runs the listeners, then truncates the commit log
+    void run_horizon_sweeps();
+    // With transactions_mutex_ held
+    TransactionId oldest_active_locked() const;
+
+    // Two-bit status per transaction; replaces an unbounded map of completed transactions
+    CommitLog commit_log_;
+
+    std::mutex listeners_mutex_;
+    std::map<size_t, HorizonListener> horizon_listeners_;
+    size_t next_listener_token_{0};
+
+    // Horizon requested by commits/aborts and the last one the sweep finished
+    std::mutex horizon_mutex_;
+    std::condition_variable horizon_cv_;
+    std::atomic<TransactionId> pending_horizon_{0};
+    TransactionId swept_horizon_{0};
+    bool stopping_{false};
+    std::thread horizon_thread_;
 };
 
 }  // namespace loredb::transaction
\ No newline at end of file
@@ -6,6 +6,14 @@ namespace loredb::transaction {
 
 MVCCManager::MVCCManager(std::shared_ptr<TransactionManager> txn_manager) 
     : txn_manager_(std::move(txn_manager)), lock_manager_(std::make_unique<LockManager>()) {
+    // Versions of aborted transactions must go before their commit log statuses do
+    horizon_listener_ = txn_manager_->add_horizon_listener([this](TransactionId horizon) {
+        collect_versions(horizon);
+    });
+}
+
+MVCCManager::~MVCCManager() {
+    txn_manager_->remove_horizon_listener(horizon_listener_);
 }
 
 util::expected<Version, MVCCError> MVCCManager::read_version(uint64_t key, TransactionId tx_id) const {
@@ -55,9 +63,35 @@ util::expected<void, MVCCError> MVCCManager::write_version(uint64_t key, Version
 }
 
 void MVCCManager::garbage_collect(TransactionId min_active_tx_id) {
+    // Everything below this horizon finished before the sweep starts, so its final
+    // status is already in the commit log and the sweep can resolve it.
+    const TransactionId horizon = std::min(min_active_tx_id,
+                                           txn_manager_->get_oldest_active_transaction_id());
+    collect_versions(horizon);
+
+    // No surviving version references an aborted transaction below the horizon any
+    // more, so those IDs can safely collapse to "committed" in the commit log.
+    txn_manager_->truncate_commit_log(horizon);
+}
+
+void MVCCManager::collect_versions(TransactionId min_active_tx_id) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
     for (auto it = versions_.begin(); it != versions_.end(); ) {
         auto & vec = it->second;
+
+        // Versions written by aborted transactions were never visible to anyone
+        vec.erase(std::remove_if(vec.begin(), vec.end(), [this](const Version &v) {
+            return txn_manager_->is_transaction_aborted(v.created_tx_id);
+        }), vec.end());
+
+        // An aborted delete/update never took effect: hand the end of the version's
+        // lifetime to the next surviving version (or make it live again)
+        for (size_t i = 0; i < vec.size(); ++i) {
+            if (vec[i].deleted_tx_id != 0 && txn_manager_->is_transaction_aborted(vec[i].deleted_tx_id)) {
+                vec[i].deleted_tx_id = (i + 1 < vec.size()) ? vec[i + 1].created_tx_id : 0;
+            }
+        }
+
         // Remove versions that are deleted and visibility ended before min_active_tx_id
         vec.erase(std::remove_if(vec.begin(), vec.end(), [min_active_tx_id](const Version &v) {
             return v.deleted_tx_id != 0 && v.deleted_tx_id < min_active_tx_id;
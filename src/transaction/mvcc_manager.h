@@ -48,6 +48,10 @@ public:
      * @param txn_manager Shared pointer to TransactionManager.
      */
     explicit MVCCManager(std::shared_ptr<TransactionManager> txn_manager);
+    ~MVCCManager();
+
+    MVCCManager(const MVCCManager&) = delete;
+    MVCCManager& operator=(const MVCCManager&) = delete;
 
     // Read the visible version for a transaction.
     util::expected<Version, MVCCError> read_version(uint64_t key, TransactionId tx_id) const;
@@ -56,7 +60,10 @@ public:
     // On success, returns {}. On conflict, returns error.
     util::expected<void, MVCCError> write_version(uint64_t key, Version version);
 
-    // Garbage collect versions that are older than min_active_tx_id (i.e., no TX can see them)
+    // Garbage collect versions that are older than min_active_tx_id (i.e., no TX can see them),
+    // discard versions left behind by aborted transactions, then truncate the commit log.
+    // The same sweep also runs on the transaction manager's background thread before it
+    // truncates the commit log, so the log stays bounded without calling this.
     void garbage_collect(TransactionId min_active_tx_id);
 
     // Get the lock manager
@@ -72,11 +79,14 @@ public:
 private:
     // Check if a version is visible to a transaction
     bool is_version_visible(const Version& version, TransactionId tx_id) const;
+    // The sweep of garbage_collect(), without truncating the commit log
+    void collect_versions(TransactionId min_active_tx_id);
     
     std::shared_ptr<TransactionManager> txn_manager_;
     std::unique_ptr<LockManager> lock_manager_;
     mutable std::shared_mutex mutex_;
     std::unordered_map<uint64_t, std::vector<Version>> versions_;
+    size_t horizon_listener_;
 };
 
 } // namespace loredb::transaction 
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "dense_bitmap.h"
+#include <algorithm>
+#include <bit>
+
+namespace loredb::util {
+
+DenseBitmap::DenseBitmap(size_t size) : size_(size), words_((size + 63) / 64, 0) {
+}
+
+void DenseBitmap::clear() {
+    std::fill(words_.begin(), words_.end(), 0);
+}
+
+size_t DenseBitmap::count() const {
+    size_t bits = 0;
+    for (uint64_t word : words_) {
+        bits += static_cast<size_t>(std::popcount(word));
+    }
+    return bits;
+}
+
+void DenseBitmap::grow(size_t size) {
+    // Grow geometrically so ids arriving one at a time stay amortized O(1)
+    size_ = std::max(size, size_ + size_ / 2);
+    words_.resize((size_ + 63) / 64, 0);
+}
+
+}  // namespace loredb::util
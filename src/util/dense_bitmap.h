@@ -0,0 +1,75 @@
+/// \file dense_bitmap.h
+/// \brief Bitmap over a dense integer space, such as node ids.
+/// \author LoreDB contributors
+/// \ingroup util
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace loredb::util {
+
+/**
+ * @class DenseBitmap
+ * @brief One bit per integer in [0, size()), for visited sets and frontiers.
+ *
+ * Membership is a shift and a mask, with none of the hashing and allocation
+ * of an unordered_set. Setting a bit past the end grows the bitmap, so
+ * callers can size it from a snapshot of the id space and still accept ids
+ * allocated afterwards.
+ */
+class DenseBitmap {
+public:
+    DenseBitmap() = default;
+    explicit DenseBitmap(size_t size);
+
+    size_t size() const { return size_; }
+
+    bool test(size_t index) const {
+        return index < size_ && ((words_[index / 64] >> (index % 64)) & 1) != 0;
+    }
+    // Sets the bit; returns whether it was clear
+    bool set(size_t index) {
+        if (index >= size_) {
+            grow(index + 1);
+        }
+        uint64_t& word = words_[index / 64];
+        const uint64_t mask = uint64_t{1} << (index % 64);
+        const bool was_clear = (word & mask) == 0;
+        word |= mask;
+        return was_clear;
+    }
+    void reset(size_t index) {
+        if (index < size_) {
+            words_[index / 64] &= ~(uint64_t{1} << (index % 64));
+        }
+    }
+    // Thread-safe variants for a bitmap shared by a parallel loop. They never
+    // grow it: `index` must be below size().
+    bool test_atomic(size_t index) const {
+        std::atomic_ref<uint64_t> word(const_cast<uint64_t&>(words_[index / 64]));
+        return ((word.load(std::memory_order_relaxed) >> (index % 64)) & 1) != 0;
+    }
+    bool set_atomic(size_t index) {
+        const uint64_t mask = uint64_t{1} << (index % 64);
+        std::atomic_ref<uint64_t> word(words_[index / 64]);
+        // Skip the locked read-modify-write when the bit is already set
+        if ((word.load(std::memory_order_relaxed) & mask) != 0) {
+            return false;
+        }
+        return (word.fetch_or(mask, std::memory_order_relaxed) & mask) == 0;
+    }
+    void clear();
+    // Number of set bits
+    size_t count() const;
+
+private:
+    void grow(size_t size);
+
+    size_t size_ = 0;
+    std::vector<uint64_t> words_;
+};
+
+}  // namespace loredb::util
@@ -0,0 +1,135 @@
+/// \file pairing_heap.h
+/// \brief Addressable min pairing heap with decrease-key.
+/// \author LoreDB contributors
+/// \ingroup util
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace loredb::util {
+
+/**
+ * @class PairingHeap
+ * @brief Min-heap of (key, value) entries whose keys can be lowered in place.
+ *
+ * push() and decrease_key() are O(1); pop() is O(log n) amortized. Entries
+ * live in one pool and are linked by index, so a push costs no allocation
+ * once the pool has grown, and handles stay valid until clear(). Suited to
+ * Dijkstra-style searches that lower a queued node's distance instead of
+ * queueing it again.
+ */
+template <typename Key, typename Value>
+class PairingHeap {
+public:
+    using Handle = size_t;
+
+    bool empty() const { return root_ == NONE; }
+    size_t size() const { return size_; }
+
+    const Key& top_key() const { return nodes_[root_].key; }
+    const Value& top_value() const { return nodes_[root_].value; }
+    const Key& key(Handle handle) const { return nodes_[handle].key; }
+
+    Handle push(Key key, Value value) {
+        const Handle handle = nodes_.size();
+        nodes_.push_back({std::move(key), std::move(value)});
+        root_ = root_ == NONE ? handle : meld(root_, handle);
+        ++size_;
+        return handle;
+    }
+
+    // Lowers the key of a queued entry; `key` must not exceed its current key
+    void decrease_key(Handle handle, Key key) {
+        nodes_[handle].key = std::move(key);
+        if (handle == root_) {
+            return;
+        }
+        // Cut the subtree out of its parent's child list and meld it with the root
+        Node& node = nodes_[handle];
+        if (nodes_[node.prev].child == handle) {
+            nodes_[node.prev].child = node.next;
+        } else {
+            nodes_[node.prev].next = node.next;
+        }
+        if (node.next != NONE) {
+            nodes_[node.next].prev = node.prev;
+        }
+        node.next = node.prev = NONE;
+        root_ = meld(root_, handle);
+    }
+
+    void pop() {
+        const Handle child = nodes_[root_].child;
+        nodes_[root_].child = NONE;
+        --size_;
+        root_ = child == NONE ? NONE : merge_pairs(child);
+    }
+
+    void clear() {
+        nodes_.clear();
+        root_ = NONE;
+        size_ = 0;
+    }
+
+private:
+    static constexpr Handle NONE = SIZE_MAX;
+
+    struct Node {
+        Key key;
+        Value value;
+        Handle child = NONE;  // Leftmost child
+        Handle next = NONE;   // Right sibling
+        Handle prev = NONE;   // Left sibling, or the parent for a leftmost child
+    };
+
+    // Links two roots; the larger becomes the leftmost child of the smaller
+    Handle meld(Handle a, Handle b) {
+        if (nodes_[b].key < nodes_[a].key) {
+            std::swap(a, b);
+        }
+        Node& parent = nodes_[a];
+        Node& child = nodes_[b];
+        child.next = parent.child;
+        if (parent.child != NONE) {
+            nodes_[parent.child].prev = b;
+        }
+        child.prev = a;
+        parent.child = b;
+        parent.next = parent.prev = NONE;
+        return a;
+    }
+
+    // Two-pass merge of a sibling list: meld pairs left to right, then fold
+    // the results right to left
+    Handle merge_pairs(Handle first) {
+        pairs_.clear();
+        while (first != NONE) {
+            const Handle second = nodes_[first].next;
+            if (second == NONE) {
+                nodes_[first].next = nodes_[first].prev = NONE;
+                pairs_.push_back(first);
+                break;
+            }
+            const Handle rest = nodes_[second].next;
+            nodes_[first].next = nodes_[first].prev = NONE;
+            nodes_[second].next = nodes_[second].prev = NONE;
+            pairs_.push_back(meld(first, second));
+            first = rest;
+        }
+        Handle root = pairs_.back();
+        for (size_t i = pairs_.size() - 1; i-- > 0;) {
+            root = meld(pairs_[i], root);
+        }
+        return root;
+    }
+
+    std::vector<Node> nodes_;
+    std::vector<Handle> pairs_;
+    Handle root_ = NONE;
+    size_t size_ = 0;
+};
+
+}  // namespace loredb::util
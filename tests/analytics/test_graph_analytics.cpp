@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+#include "../../src/analytics/graph_analytics.h"
+#include "../../src/storage/graph_store.h"
+#include "../../src/storage/memory_page_store.h"
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <set>
+
+using namespace loredb::analytics;
+using namespace loredb::storage;
+
+namespace {
+
+class GraphAnalyticsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        store_ = std::make_shared<GraphStore>(std::make_unique<MemoryPageStore>());
+    }
+
+    std::vector<NodeId> create_nodes(size_t count) {
+        std::vector<NodeId> ids;
+        for (size_t i = 0; i < count; ++i) {
+            auto id = store_->create_node({{"name", PropertyValue{"n" + std::to_string(i)}}});
+            EXPECT_TRUE(id.has_value());
+            ids.push_back(id.value());
+        }
+        return ids;
+    }
+
+    void link(NodeId from, NodeId to) {
+        ASSERT_TRUE(store_->create_edge(from, to, "LINKS", {}).has_value());
+    }
+
+    // Random directed graph with a few parallel edges and self-loops
+    std::vector<NodeId> random_graph(size_t nodes, size_t edges, uint32_t seed) {
+        auto ids = create_nodes(nodes);
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<size_t> pick(0, nodes - 1);
+        for (size_t i = 0; i < edges; ++i) {
+            link(ids[pick(rng)], ids[pick(rng)]);
+        }
+        return ids;
+    }
+
+    std::shared_ptr<GraphStore> store_;
+};
+
+}  // namespace
+
+TEST_F(GraphAnalyticsTest, SnapshotRenumbersNodesIntoCsr) {
+    auto ids = create_nodes(4);
+    ASSERT_TRUE(store_->delete_node(ids[1]).has_value());
+    link(ids[0], ids[2]);
+    link(ids[0], ids[2]);
+    link(ids[3], ids[0]);
+    link(ids[2], ids[2]);
+
+    auto graph = CsrGraph::snapshot(*store_);
+    ASSERT_TRUE(graph.has_value());
+    ASSERT_EQ(graph->vertex_count(), 3u);
+    EXPECT_EQ(graph->edge_count(), 4u);
+    EXPECT_EQ(graph->vertex_of(ids[1]), CsrGraph::NO_VERTEX);
+    EXPECT_EQ(graph->vertex_of(1000), CsrGraph::NO_VERTEX);
+
+    const auto a = graph->vertex_of(ids[0]);
+    const auto c = graph->vertex_of(ids[2]);
+    const auto d = graph->vertex_of(ids[3]);
+    EXPECT_EQ(graph->node_id(a), ids[0]);
+    EXPECT_LT(a, c);
+    EXPECT_LT(c, d);
+    auto out = graph->out_neighbors(a);
+    EXPECT_EQ(std::vector<CsrGraph::Vertex>(out.begin(), out.end()), (std::vector<CsrGraph::Vertex>{c, c}));
+    auto in = graph->in_neighbors(c);
+    EXPECT_EQ(std::vector<CsrGraph::Vertex>(in.begin(), in.end()), (std::vector<CsrGraph::Vertex>{a, a, c}));
+    EXPECT_EQ(graph->out_degree(d), 1u);
+    EXPECT_EQ(graph->in_degree(d), 0u);
+}
+
+TEST_F(GraphAnalyticsTest, PageRankMatchesSequentialPowerIteration) {
+    random_graph(300, 1200, 7);
+    create_nodes(5);  // Dangling and unreachable
+    auto graph = CsrGraph::snapshot(*store_);
+    ASSERT_TRUE(graph.has_value());
+
+    PageRankOptions options;
+    options.tolerance = 1e-12;
+    options.max_iterations = 200;
+    auto scores = pagerank(*graph, options);
+    ASSERT_EQ(scores.size(), graph->vertex_count());
+    EXPECT_NEAR(std::accumulate(scores.begin(), scores.end(), 0.0), 1.0, 1e-9);
+
+    // Push-style reference over the out-lists
+    const size_t n = graph->vertex_count();
+    std::vector<double> rank(n, 1.0 / n);
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        std::vector<double> next(n, 0.0);
+        double dangling = 0.0;
+        for (CsrGraph::Vertex v = 0; v < n; ++v) {
+            auto out = graph->out_neighbors(v);
+            if (out.empty()) {
+                dangling += rank[v];
+            }
+            for (auto u : out) {
+                next[u] += options.damping * rank[v] / out.size();
+            }
+        }
+        for (auto& score : next) {
+            score += (1.0 - options.damping) / n + options.damping * dangling / n;
+        }
+        rank = next;
+    }
+    for (size_t v = 0; v < n; ++v) {
+        EXPECT_NEAR(scores[v], rank[v], 1e-9) << v;
+    }
+    EXPECT_TRUE(pagerank(CsrGraph{}).empty());
+}
+
+TEST_F(GraphAnalyticsTest, ComponentsAreNamedByTheirSmallestVertex) {
+    auto ids = random_graph(2000, 1500, 11);
+    auto graph = CsrGraph::snapshot(*store_);
+    ASSERT_TRUE(graph.has_value());
+    auto component = weakly_connected_components(*graph);
+    ASSERT_EQ(component.size(), graph->vertex_count());
+
+    // Reference: flood fill over both directions from each unvisited vertex in order
+    const size_t n = graph->vertex_count();
+    std::vector<CsrGraph::Vertex> expected(n, CsrGraph::NO_VERTEX);
+    size_t components = 0;
+    for (CsrGraph::Vertex start = 0; start < n; ++start) {
+        if (expected[start] != CsrGraph::NO_VERTEX) {
+            continue;
+        }
+        ++components;
+        std::vector<CsrGraph::Vertex> stack{start};
+        expected[start] = start;
+        while (!stack.empty()) {
+            auto v = stack.back();
+            stack.pop_back();
+            for (auto lists : {graph->out_neighbors(v), graph->in_neighbors(v)}) {
+                for (auto u : lists) {
+                    if (expected[u] == CsrGraph::NO_VERTEX) {
+                        expected[u] = start;
+                        stack.push_back(u);
+                    }
+                }
+            }
+        }
+    }
+    EXPECT_EQ(component, expected);
+    EXPECT_GT(components, 1u);
+    EXPECT_LT(components, n);
+}
+
+TEST_F(GraphAnalyticsTest, CountsEachUndirectedTriangleOnce) {
+    // K4 with edges in both directions, a parallel edge and a self-loop
+    auto ids = create_nodes(5);
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t j = 0; j < 4; ++j) {
+            if (i != j) {
+                link(ids[i], ids[j]);
+            }
+        }
+    }
+    link(ids[0], ids[1]);
+    link(ids[2], ids[2]);
+    link(ids[4], ids[0]);
+    auto graph = CsrGraph::snapshot(*store_);
+    ASSERT_TRUE(graph.has_value());
+    auto triangles = count_triangles(*graph);
+    EXPECT_EQ(triangles.total, 4u);
+    EXPECT_EQ(triangles.per_vertex, (std::vector<uint64_t>{3, 3, 3, 3, 0}));
+
+    // Against a brute force over vertex triples on a denser random graph
+    SetUp();
+    random_graph(60, 500, 23);
+    graph = CsrGraph::snapshot(*store_);
+    ASSERT_TRUE(graph.has_value());
+    const size_t n = graph->vertex_count();
+    std::vector<std::set<CsrGraph::Vertex>> adjacent(n);
+    for (CsrGraph::Vertex v = 0; v < n; ++v) {
+        for (auto u : graph->out_neighbors(v)) {
+            if (u != v) {
+                adjacent[v].insert(u);
+                adjacent[u].insert(v);
+            }
+        }
+    }
+    uint64_t total = 0;
+    std::vector<uint64_t> per_vertex(n, 0);
+    for (CsrGraph::Vertex a = 0; a < n; ++a) {
+        for (CsrGraph::Vertex b = a + 1; b < n; ++b) {
+            for (CsrGraph::Vertex c = b + 1; c < n; ++c) {
+                if (adjacent[a].count(b) && adjacent[b].count(c) && adjacent[a].count(c)) {
+                    ++total;
+                    ++per_vertex[a];
+                    ++per_vertex[b];
+                    ++per_vertex[c];
+                }
+            }
+        }
+    }
+    triangles = count_triangles(*graph);
+    EXPECT_GT(total, 0u);
+    EXPECT_EQ(triangles.total, total);
+    EXPECT_EQ(triangles.per_vertex, per_vertex);
+}
+
+TEST_F(GraphAnalyticsTest, WritesResultsBackAsProperties) {
+    auto ids = create_nodes(3);
+    link(ids[0], ids[1]);
+    auto graph = CsrGraph::snapshot(*store_);
+    ASSERT_TRUE(graph.has_value());
+    auto component = weakly_connected_components(*graph);
+
+    auto write = [&] {
+        return write_property(*store_, *graph, "component", [&](CsrGraph::Vertex v) {
+            return PropertyValue{static_cast<int64_t>(graph->node_id(component[v]))};
+        });
+    };
+    ASSERT_TRUE(write().has_value());
+    // Writing again replaces the value rather than adding a second one
+    ASSERT_TRUE(write().has_value());
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        auto node = store_->get_node(ids[i]);
+        ASSERT_TRUE(node.has_value());
+        const auto& properties = node.value().second;
+        ASSERT_EQ(properties.size(), 2u);
+        EXPECT_EQ(std::get<std::string>(properties[0].value), "n" + std::to_string(i));
+        EXPECT_TRUE(properties[1].key == "component");
+        EXPECT_EQ(std::get<int64_t>(properties[1].value), static_cast<int64_t>(i < 2 ? ids[0] : ids[2]));
+    }
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "../../src/query/cypher/batch_evaluator.h"
+#include "../../src/query/cypher/expression_evaluator.h"
+#include "../../src/query/cypher/parser.h"
+#include "../../src/storage/file_page_store.h"
+#include "../../src/storage/graph_store.h"
+#include "../../src/storage/simple_index_manager.h"
+#include <filesystem>
+#include <numeric>
+#include <unistd.h>
+
+using namespace loredb::query;
+using namespace loredb::query::cypher;
+namespace storage = loredb::storage;
+
+class BatchEvaluatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        db_path_ = "/tmp/test_batch_evaluator_" + std::to_string(getpid()) + ".db";
+        std::filesystem::remove(db_path_);
+        graph_store_ = std::make_shared<storage::GraphStore>(std::make_unique<storage::FilePageStore>(db_path_));
+        index_manager_ = std::make_shared<storage::SimpleIndexManager>();
+
+        // Mixed types on purpose: ints, doubles, strings, bools and missing values
+        for (int i = 0; i < 40; ++i) {
+            std::vector<storage::Property> props;
+            props.emplace_back("title", std::string("doc") + std::to_string(i));
+            if (i % 4 == 0) {
+                props.emplace_back("score", int64_t{i});
+            } else if (i % 4 == 1) {
+                props.emplace_back("score", static_cast<double>(i) + 0.5);
+            } else if (i % 4 == 2) {
+                props.emplace_back("score", std::to_string(i));
+            }
+            props.emplace_back("flag", i % 3 == 0);
+            node_ids_.push_back(graph_store_->create_node(props).value());
+        }
+
+        layout_.add("n");
+        batch_.reset(layout_.size());
+        for (auto id : node_ids_) {
+            batch_.append_empty()[0] = Slot{Slot::Kind::NODE, id};
+        }
+    }
+
+    void TearDown() override {
+        graph_store_.reset();
+        std::filesystem::remove(db_path_);
+    }
+
+    // Rows selected by the batch evaluator and by the row evaluator for `where`
+    std::pair<SelectionVector, SelectionVector> evaluate_where(const std::string& where) {
+        auto parsed = parser_.parse("MATCH (n) WHERE " + where + " RETURN n");
+        EXPECT_TRUE(parsed.has_value()) << where;
+        query_ = std::move(parsed.value());
+        return evaluate_both(*query_->where->condition);
+    }
+
+    std::pair<SelectionVector, SelectionVector> evaluate_both(const Expression& predicate) {
+        ExecutionContext ctx(graph_store_, index_manager_, 0);
+
+        SelectionVector batched(batch_.size());
+        std::iota(batched.begin(), batched.end(), 0u);
+        BatchPredicate batch_predicate(&predicate, &layout_);
+        EXPECT_TRUE(batch_predicate.evaluate(batch_, ctx, batched).has_value());
+
+        SelectionVector row_by_row;
+        for (uint32_t i = 0; i < batch_.size(); ++i) {
+            auto matched = evaluate_boolean_expression(predicate, batch_[i], layout_, ctx);
+            EXPECT_TRUE(matched.has_value());
+            if (matched.value_or(false)) {
+                row_by_row.push_back(i);
+            }
+        }
+        return {batched, row_by_row};
+    }
+
+    std::string db_path_;
+    CypherParser parser_;
+    std::unique_ptr<Query> query_;
+    std::shared_ptr<storage::GraphStore> graph_store_;
+    std::shared_ptr<storage::SimpleIndexManager> index_manager_;
+    std::vector<storage::NodeId> node_ids_;
+    SlotLayout layout_;
+    ResultSet batch_;
+};
+
+TEST_F(BatchEvaluatorTest, NumericComparisonsMatchRowEvaluator) {
+    for (const char* where : {"n.score > 10", "n.score <= 20.5", "n.score = 8", "n.score <> 9.5"}) {
+        auto [batched, row_by_row] = evaluate_where(where);
+        EXPECT_EQ(batched, row_by_row) << where;
+        EXPECT_FALSE(batched.empty()) << where;
+    }
+}
+
+TEST_F(BatchEvaluatorTest, StringAndMixedComparisonsMatchRowEvaluator) {
+    for (const char* where : {"n.title = \"doc7\"", "n.title < \"doc2\"", "n.score = \"6\"", "n.flag = \"true\"",
+                              "n.missing = 1", "n = \"3\""}) {
+        auto [batched, row_by_row] = evaluate_where(where);
+        EXPECT_EQ(batched, row_by_row) << where;
+    }
+}
+
+namespace {
+
+std::unique_ptr<Expression> score_compare(ComparisonOperator op, PropertyValue value) {
+    return std::make_unique<Expression>(Comparison(std::make_unique<Expression>(PropertyAccess("n", "score")), op,
+                                                   std::make_unique<Expression>(Literal(std::move(value)))));
+}
+
+} // namespace
+
+TEST_F(BatchEvaluatorTest, LogicalOperatorsNarrowSelection) {
+    // The parser does not build AND/OR trees yet, so assemble them directly
+    Expression range(LogicalAnd(score_compare(ComparisonOperator::GREATER_THAN, int64_t{10}),
+                                score_compare(ComparisonOperator::LESS_THAN, 30.0)));
+    Expression either(LogicalOr(score_compare(ComparisonOperator::EQUAL, std::string("6")),
+                                score_compare(ComparisonOperator::GREATER_EQUAL, int64_t{36})));
+    Expression nested(LogicalAnd(std::make_unique<Expression>(LogicalOr(
+                                     score_compare(ComparisonOperator::LESS_THAN, int64_t{4}),
+                                     score_compare(ComparisonOperator::EQUAL, std::string("18")))),
+                                 score_compare(ComparisonOperator::NOT_EQUAL, int64_t{0})));
+
+    for (const Expression* predicate : {&range, &either, &nested}) {
+        auto [batched, row_by_row] = evaluate_both(*predicate);
+        EXPECT_EQ(batched, row_by_row);
+        EXPECT_FALSE(batched.empty());
+        EXPECT_TRUE(std::is_sorted(batched.begin(), batched.end()));
+    }
+}
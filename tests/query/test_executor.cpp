@@ -3,6 +3,10 @@
 #include "../../src/storage/file_page_store.h"
 #include "../../src/storage/graph_store.h"
 #include "../../src/storage/simple_index_manager.h"
+#include <map>
+#include <algorithm>
+#include <sstream>
+#include <random>
 #include <unistd.h>
 
 using namespace loredb::query;
@@ -252,6 +256,71 @@ TEST_F(QueryExecutorTest, FindShortestPathNoPath) {
     ASSERT_EQ(query_result.rows[0][0], "0"); // No path
 }
 
+TEST_F(QueryExecutorTest, FindShortestPathMatchesOneSidedSearch) {
+    // Sparse random graph with long paths between far-apart nodes
+    std::vector<NodeId> ids = {node1_id_, node2_id_, node3_id_};
+    for (int i = 0; i < 400; ++i) {
+        ids.push_back(graph_store_->create_node({{"i", PropertyValue{int64_t{i}}}}).value());
+    }
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<size_t> pick(0, ids.size() - 1);
+    for (int i = 0; i < 450; ++i) {
+        ASSERT_TRUE(graph_store_->create_edge(ids[pick(rng)], ids[pick(rng)], "links_to", {}).has_value());
+    }
+    
+    // Reference hop counts by plain BFS over edges in either direction
+    auto distances_from = [&](NodeId source) {
+        std::map<NodeId, size_t> distance{{source, 0}};
+        std::vector<NodeId> frontier{source};
+        while (!frontier.empty()) {
+            std::vector<NodeId> next;
+            for (NodeId node : frontier) {
+                const auto neighbors = graph_store_->get_adjacent_nodes(node).value();
+                for (NodeId neighbor : neighbors) {
+                    if (distance.emplace(neighbor, distance[node] + 1).second) {
+                        next.push_back(neighbor);
+                    }
+                }
+            }
+            frontier.swap(next);
+        }
+        return distance;
+    };
+    
+    size_t connected = 0;
+    for (int query = 0; query < 40; ++query) {
+        const NodeId from = ids[pick(rng)];
+        const NodeId to = ids[pick(rng)];
+        const auto distance = distances_from(from);
+        auto result = query_executor_->find_shortest_path(from, to);
+        ASSERT_TRUE(result.has_value());
+        const auto& row = result.value().rows.at(0);
+        if (!distance.count(to)) {
+            EXPECT_EQ(row[1], "No path found");
+            continue;
+        }
+        ++connected;
+        ASSERT_EQ(row[0], std::to_string(distance.at(to))) << from << " -> " << to;
+        
+        // Consecutive nodes of the path are adjacent
+        std::vector<NodeId> path;
+        std::stringstream stream(row[1]);
+        for (std::string token; stream >> token;) {
+            if (token != "->") {
+                path.push_back(std::stoull(token));
+            }
+        }
+        ASSERT_EQ(path.size(), distance.at(to) + 1);
+        EXPECT_EQ(path.front(), from);
+        EXPECT_EQ(path.back(), to);
+        for (size_t i = 1; i < path.size(); ++i) {
+            const auto adjacent = graph_store_->get_adjacent_nodes(path[i - 1]).value();
+            EXPECT_NE(std::find(adjacent.begin(), adjacent.end(), path[i]), adjacent.end());
+        }
+    }
+    EXPECT_GT(connected, 10u);
+}
+
 TEST_F(QueryExecutorTest, CountNodes) {
     auto result = query_executor_->count_nodes();
     ASSERT_TRUE(result.has_value()) << "Failed to count nodes: " << result.error().message;
@@ -285,6 +354,35 @@ TEST_F(QueryExecutorTest, GetNodeDegreeStats) {
     ASSERT_GE(query_result.rows.size(), 2); // At least total_nodes and total_edges
 }
 
+TEST_F(QueryExecutorTest, GetNodeDegreeStatsReportsDistributionAndHubs) {
+    // node2 links to and from everything
+    ASSERT_TRUE(graph_store_->create_edge(node2_id_, node1_id_, "links_to", {}).has_value());
+    ASSERT_TRUE(graph_store_->create_edge(node3_id_, node2_id_, "links_to", {}).has_value());
+    
+    auto result = query_executor_->get_node_degree_stats(2);
+    ASSERT_TRUE(result.has_value());
+    std::map<std::string, std::string> metrics;
+    for (const auto& row : result.value().rows) {
+        metrics[row[0]] = row[1];
+    }
+    EXPECT_EQ(metrics["total_edges"], "4");
+    EXPECT_EQ(metrics["min_degree"], "2");
+    EXPECT_EQ(metrics["max_degree"], "4");
+    EXPECT_EQ(metrics["mean_degree"], "2.667");
+    EXPECT_EQ(metrics["p50_degree"], "2");
+    EXPECT_EQ(metrics["p99_degree"], "4");
+    EXPECT_EQ(metrics["max_in_degree"], "2");
+    EXPECT_EQ(metrics["hub_1"], "node:" + std::to_string(node2_id_) + ",degree:4,in:2,out:2");
+    EXPECT_EQ(metrics.count("hub_2"), 1u);
+    EXPECT_EQ(metrics.count("hub_3"), 0u);
+    
+    auto histogram = query_executor_->get_degree_histogram(DegreeDirection::OUT);
+    ASSERT_TRUE(histogram.has_value());
+    ASSERT_EQ(histogram.value().rows.size(), 2u);
+    EXPECT_EQ(histogram.value().rows[0], (std::vector<std::string>{"1", "1", "2"}));
+    EXPECT_EQ(histogram.value().rows[1], (std::vector<std::string>{"2", "2", "1"}));
+}
+
 TEST_F(QueryExecutorTest, BatchGetNodes) {
     std::vector<NodeId> node_ids = {node1_id_, node2_id_, node3_id_};
     
@@ -361,6 +459,174 @@ TEST_F(QueryExecutorTest, FindRelatedDocuments) {
     ASSERT_EQ(query_result.rows[0][1], "adjacent");
 }
 
+TEST_F(QueryExecutorTest, FindRelatedDocumentsBySharedNeighbors) {
+    auto add_document = [this](const std::string& title) {
+        auto node_id = graph_store_->create_node({{"title", PropertyValue{title}}});
+        EXPECT_TRUE(node_id.has_value());
+        return node_id.value();
+    };
+    auto link = [this](NodeId from, NodeId to) {
+        ASSERT_TRUE(graph_store_->create_edge(from, to, "links_to", {}).has_value());
+    };
+    const NodeId a = add_document("A");
+    const NodeId b = add_document("B");
+    const NodeId c = add_document("C");
+    const NodeId e = add_document("E");
+    const NodeId p = add_document("P");
+    const NodeId q = add_document("Q");
+    const NodeId r = add_document("R");
+    // P and R each link to A and B (co-citation); A and C both link to Q (coupling)
+    link(p, a);
+    link(p, b);
+    link(r, a);
+    link(r, b);
+    link(r, e);
+    link(a, q);
+    link(c, q);
+    // A also links to a hub, whose other neighbours must not be scored
+    const NodeId hub = add_document("Hub");
+    const NodeId d = add_document("D");
+    link(a, hub);
+    link(d, hub);
+    for (size_t i = 0; i < QueryExecutor::MAX_SHARED_NEIGHBOR_DEGREE; ++i) {
+        link(hub, add_document("Spoke"));
+    }
+
+    auto result = query_executor_->find_related_documents(a, 10, QueryExecutor::RelatedMode::SHARED_NEIGHBORS);
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    const auto& rows = result.value().rows;
+    ASSERT_EQ(rows.size(), 3u);
+    // B shares P (1 / ln 2) and R (1 / ln 3); C shares Q (1 / ln 2); E shares R
+    EXPECT_EQ(rows[0][0], std::to_string(b));
+    EXPECT_EQ(rows[0][1], "adamic_adar:2.353,co_citation:2,coupling:0");
+    EXPECT_EQ(rows[1][0], std::to_string(c));
+    EXPECT_EQ(rows[1][1], "adamic_adar:1.443,co_citation:0,coupling:1");
+    EXPECT_EQ(rows[2][0], std::to_string(e));
+    EXPECT_EQ(rows[2][1], "adamic_adar:0.910,co_citation:1,coupling:0");
+    for (const auto& row : rows) {
+        EXPECT_NE(row[0], std::to_string(d));
+    }
+
+    auto top = query_executor_->find_related_documents(a, 2, QueryExecutor::RelatedMode::SHARED_NEIGHBORS);
+    ASSERT_TRUE(top.has_value());
+    ASSERT_EQ(top.value().rows.size(), 2u);
+    EXPECT_EQ(top.value().rows[1][0], std::to_string(c));
+}
+
+TEST_F(QueryExecutorTest, PersonalizedPageRankMatchesPowerIteration) {
+    // Node 5 only links in, so no walk from node 0 reaches it; node 6 has no outlinks
+    const std::vector<std::pair<size_t, size_t>> links = {{0, 1}, {0, 2}, {1, 2}, {1, 6}, {2, 0},
+                                                          {2, 3}, {3, 4}, {4, 2}, {5, 0}};
+    constexpr size_t NODES = 7;
+    std::vector<NodeId> ids;
+    for (size_t i = 0; i < NODES; ++i) {
+        auto node_id = graph_store_->create_node({{"title", PropertyValue{std::string("Page")}}});
+        ASSERT_TRUE(node_id.has_value());
+        ids.push_back(node_id.value());
+    }
+    std::vector<std::vector<size_t>> outlinks(NODES);
+    for (const auto& [from, to] : links) {
+        ASSERT_TRUE(graph_store_->create_edge(ids[from], ids[to], "links_to", {}).has_value());
+        outlinks[from].push_back(to);
+    }
+
+    // Exact scores by power iteration, with dangling walks restarting at the source
+    constexpr double ALPHA = 0.2;
+    std::vector<double> exact(NODES, 0.0);
+    exact[0] = 1.0;
+    for (int round = 0; round < 500; ++round) {
+        std::vector<double> next(NODES, 0.0);
+        next[0] += ALPHA;
+        for (size_t u = 0; u < NODES; ++u) {
+            if (outlinks[u].empty()) {
+                next[0] += (1.0 - ALPHA) * exact[u];
+            }
+            for (size_t v : outlinks[u]) {
+                next[v] += (1.0 - ALPHA) * exact[u] / static_cast<double>(outlinks[u].size());
+            }
+        }
+        exact = next;
+    }
+
+    auto result = query_executor_->personalized_pagerank({ids[0]}, ALPHA, 1e-8, NODES);
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    const auto& rows = result.value().rows;
+    ASSERT_EQ(rows.size(), NODES - 1);
+    double previous = 1.0;
+    for (const auto& row : rows) {
+        const auto index = std::find(ids.begin(), ids.end(), std::stoull(row[0])) - ids.begin();
+        ASSERT_LT(static_cast<size_t>(index), NODES);
+        EXPECT_NE(index, 5);
+        const double score = std::stod(row[1]);
+        EXPECT_NEAR(score, exact[index], 1e-5) << "node " << index;
+        EXPECT_LE(score, previous);
+        previous = score;
+    }
+    EXPECT_EQ(rows[0][0], std::to_string(ids[0]));
+
+    // A coarse epsilon touches less of the graph but keeps the ranking's head
+    auto coarse = query_executor_->personalized_pagerank({ids[0]}, ALPHA, 1e-2, 2);
+    ASSERT_TRUE(coarse.has_value());
+    ASSERT_EQ(coarse.value().rows.size(), 2u);
+    EXPECT_EQ(coarse.value().rows[0][0], std::to_string(ids[0]));
+
+    EXPECT_FALSE(query_executor_->personalized_pagerank({}, ALPHA).has_value());
+    EXPECT_FALSE(query_executor_->personalized_pagerank({ids[0]}, 1.0).has_value());
+    EXPECT_FALSE(query_executor_->personalized_pagerank({ids[0]}, ALPHA, 0.0).has_value());
+}
+
+TEST_F(QueryExecutorTest, FindRelatedDocumentsBySemanticAndBlendedScores) {
+    index_manager_->create_vector_index(QueryExecutor::EMBEDDING_KEY);
+    auto embed = [this](NodeId node_id, std::vector<float> embedding) {
+        auto node = graph_store_->get_node(node_id);
+        ASSERT_TRUE(node.has_value());
+        auto props = node.value().second;
+        props.push_back({QueryExecutor::EMBEDDING_KEY, PropertyValue{embedding}});
+        ASSERT_TRUE(graph_store_->update_node(node_id, props).has_value());
+        ASSERT_TRUE(index_manager_->index_node_vector(node_id, QueryExecutor::EMBEDDING_KEY, embedding).has_value());
+    };
+    // Document 1 links to 2, which links to 3; document 4 is unlinked but close in meaning
+    embed(node1_id_, {1.0f, 0.0f, 0.0f});
+    embed(node2_id_, {0.5f, 0.5f, 0.0f});
+    embed(node3_id_, {0.1f, 1.0f, 0.0f});
+    auto node4 = graph_store_->create_node({{"title", PropertyValue{std::string("Document 4")}}});
+    ASSERT_TRUE(node4.has_value());
+    embed(node4.value(), {0.9f, 0.1f, 0.0f});
+
+    // Embeddings survive the record round trip
+    auto stored = graph_store_->get_node(node1_id_);
+    ASSERT_TRUE(stored.has_value());
+    const auto& props = stored.value().second;
+    auto embedding = std::find_if(props.begin(), props.end(),
+                                  [](const Property& p) { return p.key == QueryExecutor::EMBEDDING_KEY; });
+    ASSERT_NE(embedding, props.end());
+    EXPECT_EQ(std::get<std::vector<float>>(embedding->value), (std::vector<float>{1.0f, 0.0f, 0.0f}));
+
+    auto semantic = query_executor_->find_related_documents(node1_id_, 2, QueryExecutor::RelatedMode::SEMANTIC);
+    ASSERT_TRUE(semantic.has_value()) << semantic.error().message;
+    ASSERT_EQ(semantic.value().rows.size(), 2u);
+    EXPECT_EQ(semantic.value().rows[0][0], std::to_string(node4.value()));
+    EXPECT_EQ(semantic.value().rows[0][1].rfind("semantic:", 0), 0u);
+    EXPECT_EQ(semantic.value().rows[1][0], std::to_string(node2_id_));
+
+    // Blending lifts the linked document above the closer but unlinked one,
+    // and brings in document 3 from two hops away
+    auto blended = query_executor_->find_related_documents(node1_id_, 3, QueryExecutor::RelatedMode::BLENDED);
+    ASSERT_TRUE(blended.has_value()) << blended.error().message;
+    ASSERT_EQ(blended.value().rows.size(), 3u);
+    EXPECT_EQ(blended.value().rows[0][0], std::to_string(node2_id_));
+    EXPECT_EQ(blended.value().rows[1][0], std::to_string(node4.value()));
+    EXPECT_EQ(blended.value().rows[2][0], std::to_string(node3_id_));
+    EXPECT_EQ(blended.value().rows[0][1].rfind("blended:", 0), 0u);
+
+    // Without an embedding for the document, the semantic modes list neighbours
+    index_manager_->remove_node_vector(node1_id_, QueryExecutor::EMBEDDING_KEY);
+    auto fallback = query_executor_->find_related_documents(node1_id_, 10, QueryExecutor::RelatedMode::SEMANTIC);
+    ASSERT_TRUE(fallback.has_value());
+    ASSERT_EQ(fallback.value().rows.size(), 1u);
+    EXPECT_EQ(fallback.value().rows[0][1], "adjacent");
+}
+
 TEST_F(QueryExecutorTest, SuggestLinksForDocument) {
     auto result = query_executor_->suggest_links_for_document(node1_id_, "sample content");
     ASSERT_TRUE(result.has_value()) << "Failed to suggest links for document: " << result.error().message;
@@ -372,5 +638,44 @@ TEST_F(QueryExecutorTest, SuggestLinksForDocument) {
     ASSERT_GE(query_result.rows.size(), 1);
 }
 
+TEST_F(QueryExecutorTest, SuggestLinksRanksTextMatchesExcludingOutlinks) {
+    index_manager_->create_text_index({"title", "content"});
+    auto add_document = [this](const std::string& title, const std::string& content) {
+        std::vector<Property> props = {{"title", PropertyValue{title}}, {"content", PropertyValue{content}}};
+        auto node_id = graph_store_->create_node(props);
+        EXPECT_TRUE(node_id.has_value());
+        index_manager_->index_node_text(node_id.value(), props);
+        return node_id.value();
+    };
+    // Document 2 is already linked from document 1
+    auto linked = graph_store_->get_node(node2_id_);
+    ASSERT_TRUE(linked.has_value());
+    auto linked_props = linked.value().second;
+    linked_props.push_back({"content", PropertyValue{std::string("Graph database storage")}});
+    index_manager_->index_node_text(node2_id_, linked_props);
+
+    auto storage_doc = add_document("Storage engines", "How a graph database lays out storage pages");
+    auto graph_doc = add_document("Graph basics", "An introduction to the graph data model");
+    auto cooking_doc = add_document("Cooking", "Recipes for bread");
+
+    auto result = query_executor_->suggest_links_for_document(node1_id_, "graph database STORAGE");
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    const auto& rows = result.value().rows;
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_EQ(rows[0][0], std::to_string(storage_doc));
+    EXPECT_EQ(rows[1][0], std::to_string(graph_doc));
+    EXPECT_EQ(rows[0][1].rfind("text_match:", 0), 0u);
+    for (const auto& row : rows) {
+        EXPECT_NE(row[0], std::to_string(node2_id_));
+        EXPECT_NE(row[0], std::to_string(cooking_doc));
+    }
+
+    // Re-posting a document replaces its old text
+    index_manager_->index_node_text(storage_doc, {{"title", PropertyValue{std::string("Bread")}}});
+    auto reindexed = query_executor_->suggest_links_for_document(node1_id_, "storage");
+    ASSERT_TRUE(reindexed.has_value());
+    EXPECT_EQ(reindexed.value().rows[0][1], "related_document");
+}
+
 // Streaming query tests removed for C++20 compatibility
 // TODO: Re-implement with proper coroutine support
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "../../src/query/cypher/expression_compiler.h"
+#include "../../src/query/cypher/expression_evaluator.h"
+#include "../../src/query/cypher/parser.h"
+#include "../../src/query/planner.h"
+#include "../../src/storage/file_page_store.h"
+#include "../../src/storage/graph_store.h"
+#include "../../src/storage/simple_index_manager.h"
+#include <filesystem>
+#include <unistd.h>
+
+using namespace loredb::query;
+using namespace loredb::query::cypher;
+namespace storage = loredb::storage;
+
+class ExpressionCompilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        db_path_ = "/tmp/test_expression_compiler_" + std::to_string(getpid()) + ".db";
+        std::filesystem::remove(db_path_);
+        graph_store_ = std::make_shared<storage::GraphStore>(std::make_unique<storage::FilePageStore>(db_path_));
+        index_manager_ = std::make_shared<storage::SimpleIndexManager>();
+
+        for (int i = 0; i < 20; ++i) {
+            std::vector<storage::Property> props;
+            props.emplace_back("title", std::string("doc") + std::to_string(i));
+            if (i % 3 == 0) {
+                props.emplace_back("score", int64_t{i});
+            } else if (i % 3 == 1) {
+                props.emplace_back("score", std::to_string(i));
+            }
+            auto id = graph_store_->create_node(props).value();
+            rows_.append_empty();
+            rows_[rows_.size() - 1][0] = Slot{Slot::Kind::NODE, id};
+        }
+    }
+
+    void TearDown() override {
+        graph_store_.reset();
+        std::filesystem::remove(db_path_);
+    }
+
+    const Expression& where(const std::string& condition) {
+        auto parsed = parser_.parse("MATCH (n) WHERE " + condition + " RETURN n");
+        EXPECT_TRUE(parsed.has_value()) << condition;
+        queries_.push_back(std::move(parsed.value()));
+        return *queries_.back()->where->condition;
+    }
+
+    std::string db_path_;
+    CypherParser parser_;
+    std::vector<std::unique_ptr<Query>> queries_;
+    std::shared_ptr<storage::GraphStore> graph_store_;
+    std::shared_ptr<storage::SimpleIndexManager> index_manager_;
+    SlotLayout layout_ = [] { SlotLayout layout; layout.add("n"); return layout; }();
+    ResultSet rows_{1};
+};
+
+namespace {
+
+std::unique_ptr<Expression> literal(PropertyValue value) {
+    return std::make_unique<Expression>(Literal(std::move(value)));
+}
+
+std::unique_ptr<Expression> compare(std::unique_ptr<Expression> left, ComparisonOperator op,
+                                    std::unique_ptr<Expression> right) {
+    return std::make_unique<Expression>(Comparison(std::move(left), op, std::move(right)));
+}
+
+std::unique_ptr<Expression> score_above(int64_t bound) {
+    return compare(std::make_unique<Expression>(PropertyAccess("n", "score")), ComparisonOperator::GREATER_THAN,
+                   literal(bound));
+}
+
+std::unique_ptr<Expression> literals_equal(PropertyValue left, PropertyValue right) {
+    return compare(literal(std::move(left)), ComparisonOperator::EQUAL, literal(std::move(right)));
+}
+
+} // namespace
+
+TEST_F(ExpressionCompilerTest, RowDependentPredicatesDoNotFold) {
+    for (const char* condition : {"n.score > 6", "9 <= n.score", "n.score = \"7\"", "n.title < \"doc3\"",
+                                  "n.missing = 1", "n = \"4\"", "n.score <> n.title"}) {
+        EXPECT_FALSE(fold_predicate(where(condition)).has_value()) << condition;
+    }
+
+    // A constant side that does not decide AND/OR leaves the other side to the rows
+    EXPECT_FALSE(fold_predicate(Expression(LogicalAnd(literals_equal(int64_t{1}, int64_t{1}), score_above(6))))
+                     .has_value());
+    EXPECT_FALSE(fold_predicate(Expression(LogicalOr(score_above(6), literals_equal(int64_t{1}, int64_t{2}))))
+                     .has_value());
+}
+
+TEST_F(ExpressionCompilerTest, FoldsConstants) {
+    EXPECT_EQ(fold_predicate(where("1 = 1")), true);
+    EXPECT_EQ(fold_predicate(where("2 < 1.5")), false);
+
+    EXPECT_EQ(fold_predicate(Expression(LogicalAnd(score_above(3), literals_equal(std::string("a"),
+                                                                                  std::string("b"))))),
+              false);
+    EXPECT_EQ(fold_predicate(Expression(LogicalOr(literals_equal(int64_t{1}, int64_t{1}), score_above(6)))), true);
+    EXPECT_EQ(fold_predicate(Expression(LogicalAnd(literals_equal(int64_t{1}, int64_t{1}),
+                                                   literals_equal(std::string("a"), std::string("a"))))),
+              true);
+
+    // Non-boolean expressions keep the row evaluator's error at the top level, so
+    // they are left to the filter; nested under AND/OR they count as false
+    EXPECT_FALSE(fold_predicate(where("\"x\"")).has_value());
+    EXPECT_EQ(fold_predicate(Expression(LogicalAnd(literal(std::string("x")), score_above(6)))), false);
+}
+
+TEST_F(ExpressionCompilerTest, ValuesAndPlannerUseCompiledForm) {
+    ExecutionContext ctx(graph_store_, index_manager_, 0);
+    auto title = CompiledExpression::compile(Expression(PropertyAccess("n", "title")), layout_);
+    auto value = title.evaluate(rows_[2], ctx);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(std::get<std::string>(value.value()), "doc2");
+    EXPECT_FALSE(CompiledExpression::compile(Expression(PropertyAccess("m", "title")), layout_)
+                     .evaluate(rows_[2], ctx).has_value());
+
+    // A WHERE that folds to true does not produce a Filter operator
+    auto parsed = parser_.parse("MATCH (n) WHERE 1 = 1 RETURN n");
+    ASSERT_TRUE(parsed.has_value());
+    Planner planner(graph_store_, index_manager_);
+    auto plan = planner.create_plan(*parsed.value());
+    ASSERT_NE(plan, nullptr);
+    EXPECT_EQ(plan->explain().find("Filter"), std::string::npos);
+}
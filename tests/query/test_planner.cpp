@@ -0,0 +1,568 @@
+#include <gtest/gtest.h>
+#include "../../src/query/planner.h"
+#include "../../src/query/cypher/parser.h"
+#include "../../src/query/cypher/executor.h"
+#include "../../src/query/cypher/pattern_matcher.h"
+#include "../../src/storage/file_page_store.h"
+#include "../../src/storage/graph_store.h"
+#include "../../src/storage/simple_index_manager.h"
+#include "../../src/transaction/mvcc_manager.h"
+#include "../../src/transaction/mvcc.h"
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+
+using namespace loredb::query;
+using namespace loredb::query::cypher;
+using namespace loredb::transaction;
+namespace storage = loredb::storage;
+
+class PlannerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        db_path_ = "/tmp/test_planner_" + std::to_string(getpid()) + ".db";
+        std::filesystem::remove(db_path_);
+
+        auto page_store = std::make_unique<storage::FilePageStore>(db_path_);
+        txn_manager_ = std::make_shared<TransactionManager>();
+        mvcc_manager_ = std::make_shared<MVCCManager>(txn_manager_);
+        index_manager_ = std::make_shared<storage::SimpleIndexManager>();
+        graph_store_ = std::make_shared<storage::GraphStore>(std::move(page_store), mvcc_manager_);
+        executor_ = std::make_unique<CypherExecutor>(graph_store_, index_manager_, mvcc_manager_);
+    }
+
+    void TearDown() override {
+        executor_.reset();
+        graph_store_.reset();
+        std::filesystem::remove(db_path_);
+    }
+
+    // Ten documents each linking to a single hub titled "X"
+    void build_star() {
+        auto tx = txn_manager_->begin_transaction();
+        auto hub = graph_store_->create_node(tx->id, {storage::Property("title", std::string("X"))}).value();
+        for (int i = 0; i < 10; ++i) {
+            auto doc = graph_store_->create_node(
+                tx->id, {storage::Property("title", std::string("doc") + std::to_string(i))}).value();
+            graph_store_->create_edge(tx->id, doc, hub, "LINKS",
+                                      {storage::Property("type", std::string("LINKS"))});
+        }
+        txn_manager_->commit_transaction(tx);
+    }
+
+    std::string explain(const std::string& cypher) {
+        auto parsed = parser_.parse(cypher);
+        EXPECT_TRUE(parsed.has_value());
+        query_ = std::move(parsed.value());
+        Planner planner(graph_store_, index_manager_);
+        auto plan = planner.create_plan(*query_);
+        return plan ? plan->explain() : std::string();
+    }
+
+    // The leaf of the operator tree is the anchor scan
+    static std::string leaf(const std::string& explained) {
+        auto end = explained.find_last_not_of('\n');
+        auto start = explained.rfind('\n', end);
+        std::string line = explained.substr(start == std::string::npos ? 0 : start + 1, end - start);
+        return line.substr(line.find_first_not_of(' '));
+    }
+
+    std::string db_path_;
+    CypherParser parser_;
+    std::unique_ptr<Query> query_;
+    std::shared_ptr<TransactionManager> txn_manager_;
+    std::shared_ptr<MVCCManager> mvcc_manager_;
+    std::shared_ptr<storage::SimpleIndexManager> index_manager_;
+    std::shared_ptr<storage::GraphStore> graph_store_;
+    std::unique_ptr<CypherExecutor> executor_;
+};
+
+TEST_F(PlannerTest, AnchorsOnSelectiveRightHandNode) {
+    build_star();
+    auto plan = explain("MATCH (a)-[:LINKS]->(b {title: \"X\"}) RETURN a.title");
+    EXPECT_EQ(leaf(plan), "NodeScan(b {1 props})");
+    EXPECT_NE(plan.find("Expand(b)<-[:LINKS]-(a)"), std::string::npos) << plan;
+}
+
+TEST_F(PlannerTest, KeepsLeftAnchorWhenItIsSelective) {
+    build_star();
+    auto plan = explain("MATCH (a {title: \"doc3\"})-[:LINKS]->(b) RETURN b.title");
+    EXPECT_EQ(leaf(plan), "NodeScan(a {1 props})");
+}
+
+TEST_F(PlannerTest, UsesWhereEqualitiesForEstimates) {
+    build_star();
+    auto plan = explain("MATCH (a)-[r]->(b) WHERE b.title = \"X\" RETURN a.title");
+    EXPECT_EQ(leaf(plan), "NodeScan(b)");
+    EXPECT_EQ(plan.rfind("Filter", 0), 0u) << plan;
+}
+
+TEST_F(PlannerTest, ReverseExpansionProducesSameRows) {
+    build_star();
+    auto result = executor_->execute_query("MATCH (a)-[:LINKS]->(b {title: \"X\"}) RETURN a.title, b.title");
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    ASSERT_EQ(result.value().rows.size(), 10u);
+    for (const auto& row : result.value().rows) {
+        EXPECT_EQ(row[1], "X");
+        EXPECT_EQ(row[0].rfind("doc", 0), 0u);
+    }
+}
+
+TEST_F(PlannerTest, MultiplePatternsJoinOnSharedVariables) {
+    build_star();
+    auto result = executor_->execute_query(
+        "MATCH (a {title: \"doc1\"})-[:LINKS]->(h), (b {title: \"doc2\"})-[:LINKS]->(h) RETURN a.title, b.title");
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    ASSERT_EQ(result.value().rows.size(), 1u);
+    EXPECT_EQ(result.value().rows[0][0], "doc1");
+    EXPECT_EQ(result.value().rows[0][1], "doc2");
+}
+
+namespace {
+
+// Pass-through operator that records how many rows its input produced
+class CountingOperator : public PhysicalOperator {
+public:
+    explicit CountingOperator(std::shared_ptr<PhysicalOperator> input) : input_(std::move(input)) {}
+
+    loredb::util::expected<void, storage::Error> open(ExecutionContext& ctx) override { return input_->open(ctx); }
+    loredb::util::expected<void, storage::Error> next_batch(ExecutionContext& ctx, ResultSet& batch,
+                                                            size_t max_rows) override {
+        auto pulled = input_->next_batch(ctx, batch, max_rows);
+        rows_pulled += batch.size();
+        return pulled;
+    }
+    void close() override { input_->close(); }
+    std::vector<std::shared_ptr<PhysicalOperator>> children() const override { return {input_}; }
+    std::string describe() const override { return "Counting"; }
+
+    size_t rows_pulled = 0;
+
+private:
+    std::shared_ptr<PhysicalOperator> input_;
+};
+
+} // namespace
+
+TEST_F(PlannerTest, LimitStopsScanEarly) {
+    auto tx = txn_manager_->begin_transaction();
+    for (int i = 0; i < 200; ++i) {
+        graph_store_->create_node(tx->id, {storage::Property("n", int64_t{i})});
+    }
+    txn_manager_->commit_transaction(tx);
+
+    auto layout = std::make_unique<SlotLayout>();
+    auto scan = std::make_shared<PhysicalScan>(nullptr, PlanVariable{"n", layout->add("n")}, Node{});
+    auto counter = std::make_shared<CountingOperator>(scan);
+    ExecutionPlan plan(std::make_shared<PhysicalLimit>(counter, 10), std::move(layout));
+
+    auto reader = txn_manager_->begin_transaction();
+    ExecutionContext ctx(graph_store_, index_manager_, reader->id);
+    auto rows = plan.execute(ctx);
+    txn_manager_->commit_transaction(reader);
+
+    ASSERT_TRUE(rows.has_value());
+    EXPECT_EQ(rows.value().size(), 10u);
+    EXPECT_EQ(counter->rows_pulled, 10u);
+}
+
+TEST_F(PlannerTest, StreamsInBoundedBatches) {
+    build_star();
+    auto parsed = parser_.parse("MATCH (a)-[:LINKS]->(b) RETURN a");
+    ASSERT_TRUE(parsed.has_value());
+    Planner planner(graph_store_, index_manager_);
+    auto plan = planner.create_plan(*parsed.value());
+    ASSERT_NE(plan, nullptr);
+
+    auto reader = txn_manager_->begin_transaction();
+    ExecutionContext ctx(graph_store_, index_manager_, reader->id);
+    ASSERT_TRUE(plan->open(ctx).has_value());
+    ResultSet batch;
+    size_t total = 0;
+    while (true) {
+        ASSERT_TRUE(plan->next_batch(ctx, batch, 3).has_value());
+        if (batch.empty()) break;
+        EXPECT_LE(batch.size(), 3u);
+        total += batch.size();
+    }
+    plan->close();
+    txn_manager_->commit_transaction(reader);
+    EXPECT_EQ(total, 10u);
+}
+
+TEST_F(PlannerTest, VarLengthExpandWalksTypedEdgesAndStreams) {
+    // Eight nodes, each linked to every other; one FOLLOWS edge besides
+    auto tx = txn_manager_->begin_transaction();
+    std::vector<storage::NodeId> ids;
+    for (int i = 0; i < 8; ++i) {
+        ids.push_back(graph_store_->create_node(
+            tx->id, {storage::Property("title", std::string("n") + std::to_string(i))}).value());
+    }
+    for (auto from : ids) {
+        for (auto to : ids) {
+            if (from != to) {
+                graph_store_->create_edge(tx->id, from, to, "LINKS", {});
+            }
+        }
+    }
+    graph_store_->create_edge(tx->id, ids[0], ids[1], "FOLLOWS", {});
+    graph_store_->create_edge(tx->id, ids[1], ids[2], "FOLLOWS", {});
+    txn_manager_->commit_transaction(tx);
+
+    auto typed = executor_->execute_query("MATCH (a {title: \"n0\"})-[:FOLLOWS*1..5]->(b) RETURN b.title");
+    ASSERT_TRUE(typed.has_value()) << typed.error().message;
+    std::vector<std::string> titles;
+    for (const auto& row : typed.value().rows) {
+        titles.push_back(row[0]);
+    }
+    std::sort(titles.begin(), titles.end());
+    EXPECT_EQ(titles, (std::vector<std::string>{"n1", "n2"}));
+
+    // 7 + 7*6 + ... + 7*6*5*4*3 = 3619 simple paths, walked one batch at a time
+    auto all = executor_->execute_query("MATCH (a {title: \"n0\"})-[:LINKS*1..5]->(b) RETURN b.title");
+    ASSERT_TRUE(all.has_value()) << all.error().message;
+    EXPECT_EQ(all.value().rows.size(), 3619u);
+    auto limited = executor_->execute_query("MATCH (a {title: \"n0\"})-[:LINKS*1..5]->(b) RETURN b.title LIMIT 3");
+    ASSERT_TRUE(limited.has_value()) << limited.error().message;
+    EXPECT_EQ(limited.value().rows.size(), 3u);
+}
+
+TEST_F(PlannerTest, LimitIsPushedBelowReturnWithoutOrderBy) {
+    build_star();
+    EXPECT_EQ(explain("MATCH (n) RETURN n LIMIT 2").rfind("Limit(2)", 0), 0u);
+    EXPECT_EQ(explain("MATCH (n) RETURN n.title ORDER BY n.title LIMIT 2").find("Limit"), std::string::npos);
+
+    auto result = executor_->execute_query("MATCH (a)-[:LINKS]->(b) RETURN a.title LIMIT 4");
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    EXPECT_EQ(result.value().rows.size(), 4u);
+}
+
+TEST_F(PlannerTest, RowsAreSlotArraysInLayoutOrder) {
+    build_star();
+    auto parsed = parser_.parse("MATCH (a)-[r:LINKS]->(b {title: \"X\"}) RETURN a");
+    ASSERT_TRUE(parsed.has_value());
+    Planner planner(graph_store_, index_manager_);
+    auto plan = planner.create_plan(*parsed.value());
+    ASSERT_NE(plan, nullptr);
+
+    const auto& layout = plan->layout();
+    ASSERT_EQ(layout.size(), 3u);
+    const size_t a = layout.find("a");
+    const size_t r = layout.find("r");
+    const size_t b = layout.find("b");
+    ASSERT_NE(a, NO_SLOT);
+    ASSERT_NE(r, NO_SLOT);
+    ASSERT_NE(b, NO_SLOT);
+    EXPECT_EQ(layout.find("missing"), NO_SLOT);
+
+    auto reader = txn_manager_->begin_transaction();
+    ExecutionContext ctx(graph_store_, index_manager_, reader->id);
+    auto rows = plan->execute(ctx);
+    txn_manager_->commit_transaction(reader);
+
+    ASSERT_TRUE(rows.has_value());
+    ASSERT_EQ(rows.value().size(), 10u);
+    EXPECT_EQ(rows.value().width(), 3u);
+    for (size_t i = 0; i < rows.value().size(); ++i) {
+        RowView row = rows.value()[i];
+        EXPECT_EQ(row[a].kind, Slot::Kind::NODE);
+        EXPECT_EQ(row[r].kind, Slot::Kind::EDGE);
+        EXPECT_EQ(row[b], (Slot{Slot::Kind::NODE, 1}));
+    }
+}
+
+TEST_F(PlannerTest, DeclaredIndexesTurnScansIntoSeeks) {
+    auto tx = txn_manager_->begin_transaction();
+    for (int i = 0; i < 50; ++i) {
+        graph_store_->create_node(tx->id, {storage::Property("slug", std::string("page") + std::to_string(i % 10)),
+                                           storage::Property("workspace", std::string("w") + std::to_string(i % 2))});
+    }
+    txn_manager_->commit_transaction(tx);
+
+    EXPECT_EQ(leaf(explain("MATCH (n {slug: \"page3\"}) RETURN n")), "NodeScan(n {1 props})");
+
+    ASSERT_TRUE(executor_->create_node_property_index("slug").has_value());
+    ASSERT_TRUE(executor_->create_node_property_index("workspace").has_value());
+    EXPECT_EQ(leaf(explain("MATCH (n {slug: \"page3\"}) RETURN n")), "NodeIndexSeek(n {1 props} on slug)");
+
+    // Intersecting both postings: page3 appears in workspace w1 only
+    auto both = executor_->execute_query("MATCH (n {slug: \"page3\", workspace: \"w1\"}) RETURN n.slug");
+    ASSERT_TRUE(both.has_value()) << both.error().message;
+    EXPECT_EQ(both.value().rows.size(), 5u);
+    auto none = executor_->execute_query("MATCH (n {slug: \"page3\", workspace: \"w0\"}) RETURN n.slug");
+    ASSERT_TRUE(none.has_value());
+    EXPECT_TRUE(none.value().rows.empty());
+
+    // Writes through the executor keep the index current and stale postings are filtered
+    ASSERT_TRUE(executor_->execute_query("CREATE (n {slug: \"fresh\"})").has_value());
+    ASSERT_TRUE(executor_->execute_query("MATCH (n {slug: \"page4\"}) SET n.slug = \"moved\"").has_value());
+    auto fresh = executor_->execute_query("MATCH (n {slug: \"fresh\"}) RETURN n.slug");
+    ASSERT_TRUE(fresh.has_value());
+    EXPECT_EQ(fresh.value().rows.size(), 1u);
+    auto moved = executor_->execute_query("MATCH (n {slug: \"moved\"}) RETURN n.slug");
+    ASSERT_TRUE(moved.has_value());
+    EXPECT_EQ(moved.value().rows.size(), 5u);
+    auto old = executor_->execute_query("MATCH (n {slug: \"page4\"}) RETURN n.slug");
+    ASSERT_TRUE(old.has_value());
+    EXPECT_TRUE(old.value().rows.empty());
+}
+
+TEST_F(PlannerTest, LabelsAndEdgeTypesUsePostings) {
+    auto tx = txn_manager_->begin_transaction();
+    std::vector<storage::NodeId> docs;
+    for (int i = 0; i < 6; ++i) {
+        docs.push_back(graph_store_->create_node(
+            tx->id, {storage::Property("title", std::string("doc") + std::to_string(i))}, {"Document"}).value());
+        graph_store_->create_node(tx->id, {storage::Property("title", std::string("tag") + std::to_string(i))}, {"Tag"});
+    }
+    for (int i = 0; i + 1 < 6; ++i) {
+        graph_store_->create_edge(tx->id, docs[i], docs[i + 1], i % 2 == 0 ? "LINKS" : "CITES", {});
+    }
+    txn_manager_->commit_transaction(tx);
+
+    EXPECT_EQ(leaf(explain("MATCH (n:Document) RETURN n")), "NodeLabelScan(n:Document)");
+    auto documents = executor_->execute_query("MATCH (n:Document) RETURN n.title");
+    ASSERT_TRUE(documents.has_value()) << documents.error().message;
+    EXPECT_EQ(documents.value().rows.size(), 6u);
+    auto unknown = executor_->execute_query("MATCH (n:Person) RETURN n.title");
+    ASSERT_TRUE(unknown.has_value());
+    EXPECT_TRUE(unknown.value().rows.empty());
+
+    // Labels created through Cypher are posted too
+    ASSERT_TRUE(executor_->execute_query("CREATE (n:Tag {title: \"fresh\"})").has_value());
+    auto tags = executor_->execute_query("MATCH (n:Tag) RETURN n.title");
+    ASSERT_TRUE(tags.has_value());
+    EXPECT_EQ(tags.value().rows.size(), 7u);
+
+    // Edge types come from the record's dictionary id, not a "type" property
+    auto links = executor_->execute_query("MATCH (a:Document)-[:LINKS]->(b) RETURN b.title");
+    ASSERT_TRUE(links.has_value()) << links.error().message;
+    EXPECT_EQ(links.value().rows.size(), 3u);
+    auto either = executor_->execute_query("MATCH (a {title: \"doc1\"})-[:LINKS:CITES]-(b) RETURN b.title");
+    ASSERT_TRUE(either.has_value()) << either.error().message;
+    EXPECT_EQ(either.value().rows.size(), 2u);
+}
+
+TEST_F(PlannerTest, RangeIndexesSeekWhereBounds) {
+    auto tx = txn_manager_->begin_transaction();
+    for (int i = 0; i < 50; ++i) {
+        graph_store_->create_node(tx->id, {storage::Property("updated_at", int64_t(1000 + i))});
+    }
+    txn_manager_->commit_transaction(tx);
+
+    auto count = [&](const std::string& cypher) {
+        auto result = executor_->execute_query(cypher);
+        EXPECT_TRUE(result.has_value()) << cypher;
+        return result.has_value() ? result.value().rows.size() : 0u;
+    };
+
+    EXPECT_EQ(leaf(explain("MATCH (n) WHERE n.updated_at > 1040 RETURN n")), "NodeScan(n)");
+    EXPECT_EQ(count("MATCH (n) WHERE n.updated_at > 1040 RETURN n.updated_at"), 9u);
+
+    ASSERT_TRUE(executor_->create_node_range_index("updated_at").has_value());
+    EXPECT_EQ(leaf(explain("MATCH (n) WHERE n.updated_at > 1040 RETURN n")), "NodeIndexSeek(n on range(updated_at))");
+
+    // Strict bounds are seeked inclusively and finished by the WHERE filter
+    EXPECT_EQ(count("MATCH (n) WHERE n.updated_at > 1040 RETURN n.updated_at"), 9u);
+    EXPECT_EQ(count("MATCH (n) WHERE n.updated_at >= 1040 RETURN n.updated_at"), 10u);
+    EXPECT_EQ(count("MATCH (n) WHERE n.updated_at < 1005 RETURN n.updated_at"), 5u);
+    EXPECT_EQ(count("MATCH (n) WHERE n.updated_at <= 999.5 RETURN n.updated_at"), 0u);
+
+    // Writes through the executor are posted
+    ASSERT_TRUE(executor_->execute_query("CREATE (n {updated_at: 5000})").has_value());
+    ASSERT_TRUE(executor_->execute_query("MATCH (n {updated_at: 1000}) SET n.updated_at = 6000").has_value());
+    EXPECT_EQ(count("MATCH (n) WHERE n.updated_at > 4000 RETURN n.updated_at"), 2u);
+    EXPECT_EQ(count("MATCH (n) WHERE n.updated_at < 1001 RETURN n.updated_at"), 0u);
+
+    // A string value makes numeric bounds compare as strings; the seek falls back to a scan
+    ASSERT_TRUE(executor_->execute_query("CREATE (n {updated_at: \"soon\"})").has_value());
+    EXPECT_EQ(count("MATCH (n) WHERE n.updated_at > 4000 RETURN n.updated_at"), 3u);
+}
+
+TEST_F(PlannerTest, CompositeIndexesProbeLeadingKeys) {
+    auto tx = txn_manager_->begin_transaction();
+    for (int w = 0; w < 4; ++w) {
+        for (int i = 0; i < 10; ++i) {
+            graph_store_->create_node(tx->id, {storage::Property("workspace", "w" + std::to_string(w)),
+                                               storage::Property("slug", "page" + std::to_string(i))});
+        }
+    }
+    txn_manager_->commit_transaction(tx);
+
+    ASSERT_TRUE(executor_->create_node_composite_index({"workspace", "slug"}).has_value());
+    EXPECT_EQ(leaf(explain("MATCH (n {workspace: 'w1', slug: 'page3'}) RETURN n")),
+              "NodeIndexSeek(n {2 props} on composite(workspace, slug))");
+    EXPECT_EQ(leaf(explain("MATCH (n {workspace: 'w1'}) RETURN n")),
+              "NodeIndexSeek(n {1 props} on composite(workspace))");
+    // A constraint on a trailing key alone cannot use the index
+    EXPECT_EQ(leaf(explain("MATCH (n {slug: 'page3'}) RETURN n")), "NodeScan(n {1 props})");
+
+    auto point = executor_->execute_query("MATCH (n {workspace: 'w1', slug: 'page3'}) RETURN n.slug");
+    ASSERT_TRUE(point.has_value());
+    EXPECT_EQ(point.value().rows.size(), 1u);
+    auto workspace = executor_->execute_query("MATCH (n {workspace: 'w2'}) RETURN n.slug");
+    ASSERT_TRUE(workspace.has_value());
+    EXPECT_EQ(workspace.value().rows.size(), 10u);
+
+    // Writes post the node's values; renamed nodes lose the postings of their old values
+    ASSERT_TRUE(executor_->execute_query("CREATE (n {workspace: 'w1', slug: 'fresh'})").has_value());
+    ASSERT_TRUE(executor_->execute_query("MATCH (n {workspace: 'w1', slug: 'page3'}) SET n.slug = 'moved'").has_value());
+    auto fresh = executor_->execute_query("MATCH (n {workspace: 'w1', slug: 'fresh'}) RETURN n.slug");
+    ASSERT_TRUE(fresh.has_value());
+    EXPECT_EQ(fresh.value().rows.size(), 1u);
+    auto moved = executor_->execute_query("MATCH (n {workspace: 'w1', slug: 'moved'}) RETURN n.slug");
+    ASSERT_TRUE(moved.has_value());
+    EXPECT_EQ(moved.value().rows.size(), 1u);
+    auto stale = executor_->execute_query("MATCH (n {workspace: 'w1', slug: 'page3'}) RETURN n.slug");
+    ASSERT_TRUE(stale.has_value());
+    EXPECT_EQ(stale.value().rows.size(), 0u);
+}
+
+TEST_F(PlannerTest, SetAndDeleteRemoveOldPostings) {
+    auto tx = txn_manager_->begin_transaction();
+    std::vector<storage::NodeId> ids;
+    for (int i = 0; i < 4; ++i) {
+        ids.push_back(graph_store_->create_node(tx->id, {storage::Property("slug", "page" + std::to_string(i)),
+                                                         storage::Property("workspace", std::string("w1")),
+                                                         storage::Property("rank", int64_t(i))}).value());
+    }
+    txn_manager_->commit_transaction(tx);
+    ASSERT_TRUE(executor_->create_node_property_index("slug").has_value());
+    ASSERT_TRUE(executor_->create_node_range_index("rank").has_value());
+    ASSERT_TRUE(executor_->create_node_composite_index({"workspace", "slug"}).has_value());
+
+    const auto ranked = [&](int64_t rank) {
+        auto found = index_manager_->find_nodes_in_range("rank", storage::PropertyValue(rank),
+                                                         storage::PropertyValue(rank));
+        return found.has_value() && found.value().has_value() ? *found.value() : std::vector<storage::NodeId>{};
+    };
+    const auto composite = [&](const std::string& slug) {
+        auto found = index_manager_->find_nodes_by_composite({"workspace", "slug"}, {"w1", slug});
+        return found.has_value() && found.value().has_value() ? *found.value() : std::vector<storage::NodeId>{};
+    };
+
+    ASSERT_TRUE(executor_->execute_query("MATCH (n {slug: 'page1'}) SET n.slug = 'moved'").has_value());
+    ASSERT_TRUE(executor_->execute_query("MATCH (n {slug: 'page2'}) SET n.rank = 20").has_value());
+    EXPECT_TRUE(index_manager_->find_nodes_by_property("slug", "page1").empty());
+    EXPECT_EQ(index_manager_->find_nodes_by_property("slug", "moved"), (std::vector<storage::NodeId>{ids[1]}));
+    EXPECT_TRUE(composite("page1").empty());
+    EXPECT_EQ(composite("moved"), (std::vector<storage::NodeId>{ids[1]}));
+    EXPECT_TRUE(ranked(2).empty());
+    EXPECT_EQ(ranked(20), (std::vector<storage::NodeId>{ids[2]}));
+
+    // Setting the value a node already has keeps its postings
+    ASSERT_TRUE(executor_->execute_query("MATCH (n {slug: 'page3'}) SET n.slug = 'page3'").has_value());
+    EXPECT_EQ(index_manager_->find_nodes_by_property("slug", "page3"), (std::vector<storage::NodeId>{ids[3]}));
+
+    ASSERT_TRUE(executor_->execute_query("MATCH (n {slug: 'page3'}) DELETE n").has_value());
+    EXPECT_TRUE(index_manager_->find_nodes_by_property("slug", "page3").empty());
+    EXPECT_TRUE(composite("page3").empty());
+    EXPECT_TRUE(ranked(3).empty());
+    EXPECT_EQ(ranked(0), (std::vector<storage::NodeId>{ids[0]}));
+}
+
+TEST_F(PlannerTest, RetiringPostingsKeepsValuesWrittenAgain) {
+    auto tx = txn_manager_->begin_transaction();
+    auto node = graph_store_->create_node(tx->id, {storage::Property("slug", std::string("a"))}).value();
+    txn_manager_->commit_transaction(tx);
+    ASSERT_TRUE(executor_->create_node_property_index("slug").has_value());
+
+    // T1 overwrote "a" with "b"; before it retires "a", T2 writes "a" back and posts it
+    const RetiredPostings overwritten{node, {storage::Property("slug", std::string("a"))}, std::string("slug")};
+    ASSERT_TRUE(graph_store_->update_node(node, {storage::Property("slug", std::string("a"))}).has_value());
+    ASSERT_TRUE(index_manager_->index_node_property(node, "slug", "a").has_value());
+    ExecutionContext ctx(graph_store_, index_manager_, tx->id);
+    ASSERT_TRUE(retire_node_postings(ctx, overwritten).has_value());
+    EXPECT_EQ(index_manager_->find_nodes_by_property("slug", "a"), (std::vector<storage::NodeId>{node}));
+
+    // Without a later write the retired value goes
+    ASSERT_TRUE(graph_store_->update_node(node, {storage::Property("slug", std::string("c"))}).has_value());
+    ASSERT_TRUE(index_manager_->index_node_property(node, "slug", "c").has_value());
+    ASSERT_TRUE(retire_node_postings(ctx, overwritten).has_value());
+    EXPECT_TRUE(index_manager_->find_nodes_by_property("slug", "a").empty());
+    EXPECT_EQ(index_manager_->find_nodes_by_property("slug", "c"), (std::vector<storage::NodeId>{node}));
+}
+
+TEST_F(PlannerTest, OnlineIndexBuildWaitsForOlderWritersBeforeSeeking) {
+    auto tx = txn_manager_->begin_transaction();
+    for (int i = 0; i < 20; ++i) {
+        graph_store_->create_node(tx->id, {storage::Property("slug", "page" + std::to_string(i))});
+    }
+    txn_manager_->commit_transaction(tx);
+
+    // A writer that began before the index existed does not post to it
+    auto writer = txn_manager_->begin_transaction();
+    auto build = executor_->start_node_property_index_build("slug");
+    graph_store_->create_node(writer->id, {storage::Property("slug", std::string("late"))});
+
+    // Until the build is ready, MATCH scans
+    EXPECT_EQ(build.wait_for(std::chrono::milliseconds(20)), std::future_status::timeout);
+    EXPECT_FALSE(index_manager_->is_index_ready("slug"));
+    EXPECT_EQ(leaf(explain("MATCH (n {slug: 'late'}) RETURN n")), "NodeScan(n {1 props})");
+
+    txn_manager_->commit_transaction(writer);
+    ASSERT_TRUE(build.get().has_value());
+    auto builds = index_manager_->get_index_builds();
+    ASSERT_EQ(builds.size(), 1u);
+    EXPECT_EQ(builds[0].index, "slug");
+    EXPECT_TRUE(builds[0].ready);
+    EXPECT_EQ(builds[0].scanned, builds[0].total);
+    EXPECT_EQ(builds[0].total, 21u);
+
+    // The build picked up the older writer's node once it committed
+    EXPECT_EQ(leaf(explain("MATCH (n {slug: 'late'}) RETURN n")), "NodeIndexSeek(n {1 props} on slug)");
+    auto late = executor_->execute_query("MATCH (n {slug: 'late'}) RETURN n.slug");
+    ASSERT_TRUE(late.has_value());
+    EXPECT_EQ(late.value().rows.size(), 1u);
+    EXPECT_TRUE(executor_->wait_for_index_builds().has_value());
+}
+
+TEST_F(PlannerTest, ScansReachNodesAboveDeletedIds) {
+    // Without MVCC deletes are physical, so the node count drops below the highest id
+    const std::string path = db_path_ + ".scan";
+    std::filesystem::remove(path);
+    auto graph = std::make_shared<storage::GraphStore>(std::make_unique<storage::FilePageStore>(path));
+    CypherExecutor executor(graph, index_manager_, mvcc_manager_);
+    std::vector<storage::NodeId> ids;
+    for (int i = 0; i < 5; ++i) {
+        ids.push_back(graph->create_node({storage::Property("slug", "page" + std::to_string(i))}).value());
+    }
+    ASSERT_TRUE(executor.execute_query("MATCH (n {slug: 'page1'}) DELETE n").has_value());
+    ASSERT_EQ(graph->get_node_count(), 4u);
+
+    auto all = executor.execute_query("MATCH (n) RETURN n.slug");
+    ASSERT_TRUE(all.has_value());
+    EXPECT_EQ(all.value().rows.size(), 4u);
+    auto last = executor.execute_query("MATCH (n {slug: 'page4'}) RETURN n.slug");
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(last.value().rows.size(), 1u);
+
+    // The candidates bound into input rows that leave the variable open
+    ExecutionContext ctx(graph, index_manager_, 0);
+    Node pattern(std::string("n"), {}, {{"slug", PropertyValue(std::string("page4"))}});
+    auto found = find_nodes_by_pattern(pattern, ctx);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found.value(), (std::vector<storage::NodeId>{ids[4]}));
+
+    graph.reset();
+    std::filesystem::remove(path);
+}
+
+TEST_F(PlannerTest, IndexBuildCoversNodesAboveDeletedIds) {
+    auto tx = txn_manager_->begin_transaction();
+    std::vector<storage::NodeId> ids;
+    for (int i = 0; i < 10; ++i) {
+        ids.push_back(graph_store_->create_node(tx->id, {storage::Property("slug", "page" + std::to_string(i))})
+                          .value());
+    }
+    txn_manager_->commit_transaction(tx);
+    // The node count drops below the highest id
+    ASSERT_TRUE(executor_->execute_query("MATCH (n {slug: 'page2'}) DELETE n").has_value());
+
+    ASSERT_TRUE(executor_->create_node_property_index("slug").has_value());
+    EXPECT_EQ(leaf(explain("MATCH (n {slug: 'page9'}) RETURN n")), "NodeIndexSeek(n {1 props} on slug)");
+    EXPECT_EQ(index_manager_->find_nodes_by_property("slug", "page9"), (std::vector<storage::NodeId>{ids[9]}));
+    auto last = executor_->execute_query("MATCH (n {slug: 'page9'}) RETURN n.slug");
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(last.value().rows.size(), 1u);
+}
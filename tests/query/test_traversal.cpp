@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+#include "../../src/query/executor.h"
+#include "../../src/query/traversal.h"
+#include "../../src/storage/graph_store.h"
+#include "../../src/storage/memory_page_store.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+
+using namespace loredb::query;
+using namespace loredb::storage;
+
+namespace {
+
+class TraversalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        store_ = std::make_shared<GraphStore>(std::make_unique<MemoryPageStore>());
+    }
+
+    // Random graph with `edges` edges; low ids are hubs
+    std::vector<NodeId> random_graph(size_t nodes, size_t edges, uint32_t seed) {
+        std::vector<NodeId> ids;
+        for (size_t i = 0; i < nodes; ++i) {
+            ids.push_back(store_->create_node({}).value());
+        }
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<size_t> uniform(0, nodes - 1);
+        std::geometric_distribution<size_t> skewed(0.05);
+        for (size_t i = 0; i < edges; ++i) {
+            const NodeId from = ids[i % 2 ? uniform(rng) : std::min(skewed(rng), nodes - 1)];
+            const NodeId to = ids[i % 3 ? uniform(rng) : std::min(skewed(rng), nodes - 1)];
+            EXPECT_TRUE(store_->create_edge(from, to, "LINKS", {}).has_value());
+        }
+        return ids;
+    }
+
+    // Levels of a plain serial BFS
+    std::vector<std::vector<NodeId>> reference_levels(NodeId source, TraversalDirection direction) {
+        std::map<NodeId, size_t> depth{{source, 0}};
+        std::vector<std::vector<NodeId>> levels{{source}};
+        while (true) {
+            std::vector<NodeId> next;
+            for (NodeId node : levels.back()) {
+                std::vector<NodeId> neighbors;
+                if (direction != TraversalDirection::INCOMING) {
+                    neighbors = store_->get_outgoing_neighbors(node).value();
+                }
+                if (direction != TraversalDirection::OUTGOING) {
+                    auto incoming = store_->get_incoming_neighbors(node).value();
+                    neighbors.insert(neighbors.end(), incoming.begin(), incoming.end());
+                }
+                for (NodeId neighbor : neighbors) {
+                    if (depth.emplace(neighbor, levels.size()).second) {
+                        next.push_back(neighbor);
+                    }
+                }
+            }
+            if (next.empty()) {
+                return levels;
+            }
+            std::sort(next.begin(), next.end());
+            levels.push_back(std::move(next));
+        }
+    }
+
+    std::shared_ptr<GraphStore> store_;
+};
+
+}  // namespace
+
+TEST_F(TraversalTest, LevelsMatchSerialBfsInEveryDirection) {
+    auto ids = random_graph(3000, 12000, 5);
+    BfsEngine engine(store_);
+    size_t bottom_up_steps = 0;
+    for (auto direction : {TraversalDirection::OUTGOING, TraversalDirection::INCOMING, TraversalDirection::BOTH}) {
+        for (NodeId source : {ids[0], ids[1500], ids[2999]}) {
+            BfsEngine::Options options;
+            options.direction = direction;
+            auto result = engine.run({source}, options);
+            EXPECT_EQ(result.levels, reference_levels(source, direction)) << static_cast<int>(direction);
+            bottom_up_steps += result.bottom_up_steps;
+        }
+    }
+    // The dense middle levels of this graph are expanded bottom-up
+    EXPECT_GT(bottom_up_steps, 0u);
+
+    // Several sources start one search; unknown ids are ignored
+    BfsEngine::Options options;
+    auto result = engine.run({ids[10], ids[10], ids[20], 1000000}, options);
+    ASSERT_FALSE(result.levels.empty());
+    EXPECT_EQ(result.levels[0], (std::vector<NodeId>{ids[10], ids[20]}));
+    EXPECT_TRUE(engine.run({}, options).levels.empty());
+}
+
+TEST_F(TraversalTest, StopsAtMaxDepthAndTarget) {
+    // A chain 0 -> 1 -> ... -> 9
+    std::vector<NodeId> ids;
+    for (int i = 0; i < 10; ++i) {
+        ids.push_back(store_->create_node({}).value());
+        if (i > 0) {
+            ASSERT_TRUE(store_->create_edge(ids[i - 1], ids[i], "NEXT", {}).has_value());
+        }
+    }
+    BfsEngine engine(store_);
+    BfsEngine::Options options;
+    options.max_depth = 3;
+    auto result = engine.run({ids[0]}, options);
+    ASSERT_EQ(result.levels.size(), 4u);
+    EXPECT_EQ(result.depth_of(ids[3]), 3u);
+    EXPECT_FALSE(result.depth_of(ids[4]).has_value());
+
+    options.max_depth = SIZE_MAX;
+    options.target = ids[5];
+    result = engine.run({ids[0]}, options);
+    EXPECT_EQ(result.levels.size(), 6u);
+    EXPECT_EQ(result.depth_of(ids[5]), 5u);
+
+    options.direction = TraversalDirection::INCOMING;
+    EXPECT_FALSE(engine.run({ids[0]}, options).depth_of(ids[5]).has_value());
+
+    QueryExecutor executor(store_, nullptr);
+    auto reachable = executor.is_reachable(ids[2], ids[9]);
+    ASSERT_TRUE(reachable.has_value());
+    EXPECT_EQ(reachable.value().rows[0], (std::vector<std::string>{"true", "7"}));
+    reachable = executor.is_reachable(ids[2], ids[9], 6);
+    EXPECT_EQ(reachable.value().rows[0], (std::vector<std::string>{"false", ""}));
+    reachable = executor.is_reachable(ids[9], ids[2]);
+    EXPECT_EQ(reachable.value().rows[0][0], "false");
+    EXPECT_FALSE(executor.is_reachable(1000000, ids[2]).has_value());
+
+    auto neighborhood = executor.get_k_hop_neighborhood(ids[5], 2);
+    ASSERT_TRUE(neighborhood.has_value());
+    std::vector<std::vector<std::string>> expected = {{std::to_string(ids[4]), "1"}, {std::to_string(ids[6]), "1"},
+                                                      {std::to_string(ids[3]), "2"}, {std::to_string(ids[7]), "2"}};
+    EXPECT_EQ(neighborhood.value().rows, expected);
+}
+
+TEST_F(TraversalTest, PathEnumeratorReportsEveryPathOnce) {
+    // Every ordered pair of 6 nodes is linked, plus a self-loop and a parallel edge
+    constexpr size_t NODES = 6;
+    std::vector<NodeId> ids;
+    for (size_t i = 0; i < NODES; ++i) {
+        ids.push_back(store_->create_node({}).value());
+    }
+    for (NodeId from : ids) {
+        for (NodeId to : ids) {
+            if (from != to) {
+                ASSERT_TRUE(store_->create_edge(from, to, "LINKS", {}).has_value());
+            }
+        }
+    }
+    ASSERT_TRUE(store_->create_edge(ids[0], ids[0], "LINKS", {}).has_value());
+    ASSERT_TRUE(store_->create_edge(ids[0], ids[1], "LINKS", {}).has_value());
+    const PathEnumerator::ExpandFn expand = [&](NodeId node_id, std::vector<PathEnumerator::Step>& steps) {
+        const auto edge_ids = store_->get_outgoing_edges(node_id).value();
+        for (EdgeId edge_id : edge_ids) {
+            steps.emplace_back(edge_id, store_->get_edge(edge_id).value().first.to_node);
+        }
+    };
+
+    PathEnumerator::Options options;
+    options.min_hops = 1;
+    options.max_hops = 3;
+    PathEnumerator paths(options);
+    paths.reset(ids[0]);
+    std::map<size_t, size_t> by_length;
+    std::set<std::vector<EdgeId>> seen;
+    size_t previous_hops = 0;
+    while (paths.next(expand)) {
+        ASSERT_EQ(paths.nodes().size(), paths.hops() + 1);
+        EXPECT_EQ(paths.nodes().front(), ids[0]);
+        EXPECT_LE(paths.hops(), previous_hops + 1);  // Depth first: a path comes before its extensions
+        EXPECT_TRUE(seen.insert(paths.edges()).second);
+        std::set<NodeId> distinct(paths.nodes().begin(), paths.nodes().end());
+        EXPECT_EQ(distinct.size(), paths.nodes().size());
+        previous_hops = paths.hops();
+        ++by_length[paths.hops()];
+    }
+    // 5 neighbours (one reached twice), then 4 and 3 fresh nodes per step
+    EXPECT_EQ(by_length, (std::map<size_t, size_t>{{1, 6}, {2, 6 * 4}, {3, 6 * 4 * 3}}));
+    EXPECT_FALSE(paths.next(expand));
+
+    // Edge uniqueness lets nodes repeat, so the self-loop and returns to the start count
+    options.uniqueness = PathEnumerator::Uniqueness::EDGES;
+    options.min_hops = 2;
+    options.max_hops = 2;
+    PathEnumerator walks(options);
+    walks.reset(ids[0]);
+    size_t two_hop_walks = 0;
+    while (walks.next(expand)) {
+        ++two_hop_walks;
+    }
+    // First hop: 7 edges; then every edge out of the reached node except the one just used
+    EXPECT_EQ(two_hop_walks, (7 - 1) + 2 * 5 + 4 * 5);
+
+    // A target ends paths early and filters the rest
+    options = {};
+    options.max_hops = 4;
+    options.target = ids[1];
+    PathEnumerator targeted(options);
+    targeted.reset(ids[0]);
+    size_t to_target = 0;
+    while (targeted.next(expand)) {
+        EXPECT_EQ(targeted.nodes().back(), ids[1]);
+        EXPECT_EQ(std::count(targeted.nodes().begin(), targeted.nodes().end(), ids[1]), 1);
+        ++to_target;
+    }
+    // Direct (twice), then through 1, 2 or 3 of the 4 other nodes
+    EXPECT_EQ(to_target, 2u + 4 + 4 * 3 + 4 * 3 * 2);
+
+    targeted.clear();
+    EXPECT_FALSE(targeted.next(expand));
+}
+
+TEST_F(TraversalTest, FindPathsWithLengthListsSimplePaths) {
+    // A square a-b-c-d-a with a diagonal a-c
+    std::vector<NodeId> ids;
+    for (int i = 0; i < 4; ++i) {
+        ids.push_back(store_->create_node({}).value());
+    }
+    for (auto [from, to] : {std::pair{0, 1}, {1, 2}, {2, 3}, {3, 0}, {0, 2}}) {
+        ASSERT_TRUE(store_->create_edge(ids[from], ids[to], "NEXT", {}).has_value());
+    }
+
+    QueryExecutor executor(store_, nullptr);
+    auto result = executor.find_paths_with_length(ids[0], ids[2], 2);
+    ASSERT_TRUE(result.has_value());
+    std::vector<std::string> paths;
+    for (const auto& row : result.value().rows) {
+        paths.push_back(row[0] + ":" + row[1]);
+    }
+    std::sort(paths.begin(), paths.end());
+    const auto name = [&](int i) { return std::to_string(ids[i]); };
+    EXPECT_EQ(paths, (std::vector<std::string>{"1:" + name(0) + " -> " + name(2),
+                                               "2:" + name(0) + " -> " + name(1) + " -> " + name(2),
+                                               "2:" + name(0) + " -> " + name(3) + " -> " + name(2)}));
+
+}
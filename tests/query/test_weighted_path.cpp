@@ -0,0 +1,305 @@
+#include <gtest/gtest.h>
+#include "../../src/query/executor.h"
+#include "../../src/query/weighted_path.h"
+#include "../../src/storage/graph_store.h"
+#include "../../src/storage/memory_page_store.h"
+#include "../../src/storage/record.h"
+#include <map>
+#include <queue>
+#include <random>
+
+using namespace loredb::query;
+using namespace loredb::storage;
+
+namespace {
+
+class WeightedPathTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        store_ = std::make_shared<GraphStore>(std::make_unique<MemoryPageStore>());
+    }
+
+    // Random connected graph: a chain through every node plus random chords,
+    // weights in [1, 10) stored after an unrelated property
+    std::vector<NodeId> random_graph(size_t nodes, size_t chords, uint32_t seed) {
+        std::vector<NodeId> ids;
+        for (size_t i = 0; i < nodes; ++i) {
+            ids.push_back(store_->create_node({}).value());
+        }
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<size_t> pick(0, nodes - 1);
+        std::uniform_real_distribution<double> weight(1.0, 10.0);
+        auto link = [&](NodeId from, NodeId to) {
+            const double w = weight(rng);
+            EXPECT_TRUE(store_->create_edge(from, to, "LINKS",
+                                            {{"note", PropertyValue{std::string("some text to step over")}},
+                                             {"weight", PropertyValue{w}}}).has_value());
+        };
+        for (size_t i = 1; i < nodes; ++i) {
+            link(ids[i - 1], ids[i]);
+        }
+        for (size_t i = 0; i < chords; ++i) {
+            link(ids[pick(rng)], ids[pick(rng)]);
+        }
+        return ids;
+    }
+
+    // Plain Dijkstra over full edge records, ignoring edge direction
+    std::map<NodeId, double> reference_distances(NodeId source) {
+        std::map<NodeId, double> distances{{source, 0.0}};
+        using Entry = std::pair<double, NodeId>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+        queue.emplace(0.0, source);
+        while (!queue.empty()) {
+            auto [distance, node] = queue.top();
+            queue.pop();
+            if (distance > distances[node]) {
+                continue;
+            }
+            for (bool outgoing : {true, false}) {
+                const auto edge_ids = outgoing ? store_->get_outgoing_edges(node).value()
+                                               : store_->get_incoming_edges(node).value();
+                for (EdgeId edge_id : edge_ids) {
+                    const auto [record, properties] = store_->get_edge(edge_id).value();
+                    double weight = WeightedPathFinder::DEFAULT_WEIGHT;
+                    for (const auto& property : properties) {
+                        if (property.key == "weight") {
+                            weight = std::get<double>(property.value);
+                        }
+                    }
+                    const NodeId neighbor = outgoing ? record.to_node : record.from_node;
+                    auto it = distances.find(neighbor);
+                    if (it == distances.end() || distance + weight < it->second) {
+                        distances[neighbor] = distance + weight;
+                        queue.emplace(distance + weight, neighbor);
+                    }
+                }
+            }
+        }
+        return distances;
+    }
+
+    // Re-adds the weights along a found path and checks its shape
+    void expect_valid_path(const WeightedPathFinder::Result& path, NodeId from, NodeId to) {
+        ASSERT_TRUE(path.found());
+        ASSERT_EQ(path.nodes.size(), path.edges.size() + 1);
+        EXPECT_EQ(path.nodes.front(), from);
+        EXPECT_EQ(path.nodes.back(), to);
+        double total = 0.0;
+        for (size_t i = 0; i < path.edges.size(); ++i) {
+            const auto record = store_->get_edge(path.edges[i]).value().first;
+            const bool forward = record.from_node == path.nodes[i] && record.to_node == path.nodes[i + 1];
+            const bool backward = record.to_node == path.nodes[i] && record.from_node == path.nodes[i + 1];
+            EXPECT_TRUE(forward || backward);
+            total += std::get<double>(*store_->get_edge_property(path.edges[i], "weight").value());
+        }
+        EXPECT_NEAR(total, path.total_weight, 1e-9);
+    }
+
+    std::shared_ptr<GraphStore> store_;
+};
+
+}  // namespace
+
+TEST_F(WeightedPathTest, EdgePropertyIsReadWithoutDecodingTheRecord) {
+    auto a = store_->create_node({}).value();
+    auto b = store_->create_node({}).value();
+    std::vector<Property> properties = {{"label", PropertyValue{std::string("x")}},
+                                        {"vector", PropertyValue{std::vector<float>{1.0f, 2.0f}}},
+                                        {"bytes", PropertyValue{std::vector<uint8_t>{1, 2, 3}}},
+                                        {"flag", PropertyValue{true}},
+                                        {"ratio", PropertyValue{0.5}},
+                                        {"strength", PropertyValue{int64_t{-7}}}};
+    auto edge = store_->create_edge(a, b, "LINKS", properties).value();
+    for (const auto& property : properties) {
+        auto value = store_->get_edge_property(edge, property.key);
+        ASSERT_TRUE(value.has_value());
+        ASSERT_TRUE(value.value().has_value());
+        EXPECT_EQ(*value.value(), property.value);
+    }
+    EXPECT_FALSE(store_->get_edge_property(edge, "missing").value().has_value());
+    EXPECT_FALSE(store_->get_edge_property(edge + 100, "ratio").has_value());
+
+    // Truncated data is reported rather than read past
+    auto bytes = RecordSerializer::serialize_properties(properties);
+    bytes.resize(bytes.size() - 3);
+    EXPECT_FALSE(RecordSerializer::find_property(bytes, PropertyKey("strength").id()).has_value());
+}
+
+TEST_F(WeightedPathTest, DijkstraAndLandmarkSearchFindShortestPaths) {
+    auto ids = random_graph(400, 600, 11);
+    // A second component, unreachable from the first
+    auto island = store_->create_node({}).value();
+    auto shore = store_->create_node({}).value();
+    ASSERT_TRUE(store_->create_edge(island, shore, "LINKS", {{"weight", PropertyValue{2.0}}}).has_value());
+
+    WeightedPathFinder finder(store_, "weight");
+    auto landmarks = LandmarkIndex::build(finder, *store_, 6);
+    ASSERT_TRUE(landmarks.has_value());
+    ASSERT_EQ(landmarks.value().landmarks().size(), 6u);
+    // Each component gets a landmark before any gets a second
+    const auto& chosen = landmarks.value().landmarks();
+    EXPECT_TRUE(std::find_if(chosen.begin(), chosen.end(),
+                             [&](NodeId id) { return id == island || id == shore; }) != chosen.end());
+
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<size_t> pick(0, ids.size() - 1);
+    for (int query = 0; query < 30; ++query) {
+        const NodeId from = ids[pick(rng)];
+        const NodeId to = ids[pick(rng)];
+        const double expected = reference_distances(from).at(to);
+        const LandmarkIndex* guided = &landmarks.value();
+        for (const LandmarkIndex* index : {static_cast<const LandmarkIndex*>(nullptr), guided}) {
+            auto path = index ? finder.find(from, to, *index) : finder.find(from, to);
+            ASSERT_TRUE(path.has_value());
+            EXPECT_NEAR(path.value().total_weight, expected, 1e-9) << from << " -> " << to;
+            expect_valid_path(path.value(), from, to);
+            EXPECT_LE(landmarks.value().lower_bound(from, to), expected + 1e-9);
+        }
+    }
+
+    EXPECT_FALSE(finder.find(ids[0], island).value().found());
+    EXPECT_FALSE(finder.find(ids[0], island, landmarks.value()).value().found());
+    EXPECT_EQ(landmarks.value().lower_bound(ids[0], island), WeightedPathFinder::UNREACHABLE);
+    auto same = finder.find(ids[5], ids[5]);
+    ASSERT_TRUE(same.value().found());
+    EXPECT_EQ(same.value().total_weight, 0.0);
+    EXPECT_EQ(same.value().nodes, std::vector<NodeId>{ids[5]});
+}
+
+TEST_F(WeightedPathTest, ExecutorReportsPathsAndRejectsBadWeights) {
+    // a -1- b -1- c and a -5- c; the edge c-d has no weight and costs 1
+    std::vector<NodeId> ids;
+    for (int i = 0; i < 4; ++i) {
+        ids.push_back(store_->create_node({}).value());
+    }
+    auto edge = [&](int from, int to, std::vector<Property> properties) {
+        return store_->create_edge(ids[from], ids[to], "LINKS", properties).value();
+    };
+    edge(0, 1, {{"strength", PropertyValue{int64_t{1}}}});
+    edge(1, 2, {{"strength", PropertyValue{1.0}}});
+    edge(2, 0, {{"strength", PropertyValue{5.0}}});
+    edge(2, 3, {});
+
+    QueryExecutor executor(store_, nullptr);
+    const std::string path = std::to_string(ids[0]) + " -> " + std::to_string(ids[1]) + " -> " +
+                             std::to_string(ids[2]) + " -> " + std::to_string(ids[3]);
+    auto result = executor.find_weighted_shortest_path(ids[0], ids[3], "strength");
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    EXPECT_EQ(result.value().rows[0], (std::vector<std::string>{"3", "3", path}));
+
+    auto built = executor.build_path_landmarks("strength", 2);
+    ASSERT_TRUE(built.has_value());
+    EXPECT_EQ(built.value().rows.size(), 2u);
+    result = executor.find_weighted_shortest_path(ids[0], ids[3], "strength");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result.value().rows[0], (std::vector<std::string>{"3", "3", path}));
+
+    // An unused key gives every edge the default weight
+    result = executor.find_weighted_shortest_path(ids[0], ids[3], "never_used_weight_key");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result.value().rows[0][0], "2");
+
+    auto isolated = store_->create_node({}).value();
+    result = executor.find_weighted_shortest_path(ids[0], isolated, "strength");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result.value().rows[0], (std::vector<std::string>{"", "0", "No path found"}));
+    EXPECT_EQ(executor.find_weighted_shortest_path(ids[0], 1000000, "strength").error().code, ErrorCode::NOT_FOUND);
+
+    edge(3, 1, {{"strength", PropertyValue{-2.0}}});
+    result = executor.find_weighted_shortest_path(ids[0], ids[3], "strength");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, ErrorCode::INVALID_ARGUMENT);
+}
+
+TEST_F(WeightedPathTest, LandmarksNarrowTheSearchOnGrids) {
+    // A 30 x 30 grid with random weights, the shape of a road network
+    constexpr size_t SIDE = 30;
+    std::vector<NodeId> ids;
+    for (size_t i = 0; i < SIDE * SIDE; ++i) {
+        ids.push_back(store_->create_node({}).value());
+    }
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<double> weight(1.0, 2.0);
+    for (size_t row = 0; row < SIDE; ++row) {
+        for (size_t col = 0; col < SIDE; ++col) {
+            const NodeId node = ids[row * SIDE + col];
+            if (col + 1 < SIDE) {
+                store_->create_edge(node, ids[row * SIDE + col + 1], "ROAD", {{"weight", PropertyValue{weight(rng)}}});
+            }
+            if (row + 1 < SIDE) {
+                store_->create_edge(node, ids[(row + 1) * SIDE + col], "ROAD", {{"weight", PropertyValue{weight(rng)}}});
+            }
+        }
+    }
+
+    WeightedPathFinder finder(store_, "weight");
+    auto landmarks = LandmarkIndex::build(finder, *store_);
+    ASSERT_TRUE(landmarks.has_value());
+    std::uniform_int_distribution<size_t> pick(0, ids.size() - 1);
+    size_t dijkstra_settled = 0;
+    size_t astar_settled = 0;
+    for (int query = 0; query < 20; ++query) {
+        const NodeId from = ids[pick(rng)];
+        const NodeId to = ids[pick(rng)];
+        auto dijkstra = finder.find(from, to);
+        auto astar = finder.find(from, to, landmarks.value());
+        ASSERT_TRUE(dijkstra.has_value() && astar.has_value());
+        EXPECT_NEAR(astar.value().total_weight, dijkstra.value().total_weight, 1e-9);
+        dijkstra_settled += dijkstra.value().settled;
+        astar_settled += astar.value().settled;
+    }
+    // The landmark bounds steer A* past most of the grid
+    EXPECT_LT(astar_settled * 2, dijkstra_settled);
+}
+
+TEST_F(WeightedPathTest, LandmarksAreBypassedAfterEdgesChange) {
+    // Two chains a0 - a1 - a2 and b0 - b1 - b2 with unit weights
+    std::vector<NodeId> a;
+    std::vector<NodeId> b;
+    for (int i = 0; i < 3; ++i) {
+        a.push_back(store_->create_node({}).value());
+        b.push_back(store_->create_node({}).value());
+    }
+    std::vector<EdgeId> a_edges;
+    for (int i = 1; i < 3; ++i) {
+        a_edges.push_back(store_->create_edge(a[i - 1], a[i], "ROAD", {{"weight", PropertyValue{1.0}}}).value());
+        store_->create_edge(b[i - 1], b[i], "ROAD", {{"weight", PropertyValue{1.0}}});
+    }
+
+    QueryExecutor executor(store_, nullptr);
+    ASSERT_TRUE(executor.build_path_landmarks("weight", 2).has_value());
+    WeightedPathFinder finder(store_, "weight");
+    auto landmarks = LandmarkIndex::build(finder, *store_, 2);
+    ASSERT_TRUE(landmarks.has_value());
+    EXPECT_TRUE(landmarks.value().is_current(*store_));
+    auto result = executor.find_weighted_shortest_path(a[0], b[2], "weight");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result.value().rows[0][2], "No path found");
+
+    // A new edge joins the components the landmarks saw as separate
+    store_->create_edge(a[2], b[0], "ROAD", {{"weight", PropertyValue{1.0}}});
+    EXPECT_FALSE(landmarks.value().is_current(*store_));
+    result = executor.find_weighted_shortest_path(a[0], b[2], "weight");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result.value().rows[0][0], "5");
+
+    // A heavier weight and a removed edge are picked up too
+    ASSERT_TRUE(executor.build_path_landmarks("weight", 2).has_value());
+    ASSERT_TRUE(store_->update_edge(a_edges[0], {{"weight", PropertyValue{4.0}}}).has_value());
+    result = executor.find_weighted_shortest_path(a[0], b[2], "weight");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result.value().rows[0][0], "8");
+
+    ASSERT_TRUE(executor.build_path_landmarks("weight", 2).has_value());
+    ASSERT_TRUE(store_->delete_edge(a_edges[1]).has_value());
+    result = executor.find_weighted_shortest_path(a[0], b[2], "weight");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result.value().rows[0][2], "No path found");
+
+    // Rebuilt landmarks are current again and guide A* to the same answer
+    ASSERT_TRUE(executor.build_path_landmarks("weight", 2).has_value());
+    result = executor.find_weighted_shortest_path(a[2], b[2], "weight");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result.value().rows[0][0], "3");
+}
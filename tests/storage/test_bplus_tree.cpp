@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "../../src/storage/bplus_tree.h"
+#include "../../src/storage/composite_index.h"
+#include "../../src/storage/memory_page_store.h"
+#include "../../src/storage/range_index.h"
+#include <algorithm>
+#include <random>
+
+using namespace loredb::storage;
+
+namespace {
+
+std::vector<std::pair<std::string, uint64_t>> scan_all(const BPlusTree& tree, std::string_view lower = "") {
+    std::vector<std::pair<std::string, uint64_t>> entries;
+    auto result = tree.scan(lower, [&](std::string_view key, uint64_t value) {
+        entries.emplace_back(std::string(key), value);
+        return true;
+    });
+    EXPECT_TRUE(result.has_value());
+    return entries;
+}
+
+std::vector<NodeId> sorted(std::vector<NodeId> ids) {
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+}  // namespace
+
+TEST(BPlusTreeTest, SplitsKeepEntriesOrdered) {
+    MemoryPageStore pages;
+    BPlusTree tree(pages);
+    EXPECT_EQ(tree.root(), INVALID_PAGE_ID);
+
+    std::vector<std::pair<std::string, uint64_t>> expected;
+    for (uint64_t i = 0; i < 5000; ++i) {
+        expected.emplace_back("key" + std::to_string(i % 1000), i);
+    }
+    auto shuffled = expected;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+    for (const auto& [key, value] : shuffled) {
+        ASSERT_TRUE(tree.insert(key, value).has_value());
+    }
+    // Re-inserting an entry is a no-op
+    ASSERT_TRUE(tree.insert("key7", 7).has_value());
+
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(scan_all(tree), expected);
+    EXPECT_GT(pages.get_allocated_pages(), 10u);
+
+    // Scans start at the first entry >= lower and stop when the visitor says so
+    std::vector<uint64_t> values;
+    ASSERT_TRUE(tree.scan("key500", [&](std::string_view key, uint64_t value) {
+        if (key != "key500") {
+            return false;
+        }
+        values.push_back(value);
+        return true;
+    }).has_value());
+    EXPECT_EQ(values, (std::vector<uint64_t>{500, 1500, 2500, 3500, 4500}));
+
+    // Reopening from the root sees the same tree
+    BPlusTree reopened(pages, tree.root());
+    EXPECT_EQ(scan_all(reopened).size(), 5000u);
+}
+
+TEST(BPlusTreeTest, LargeKeysEraseAndDestroy) {
+    MemoryPageStore pages;
+    BPlusTree tree(pages);
+    for (uint64_t i = 0; i < 300; ++i) {
+        std::string key(BPlusTree::MAX_KEY_SIZE, 'a' + static_cast<char>(i % 26));
+        key += std::to_string(i);
+        key.resize(BPlusTree::MAX_KEY_SIZE);
+        ASSERT_TRUE(tree.insert(key, i).has_value());
+    }
+    EXPECT_FALSE(tree.insert(std::string(BPlusTree::MAX_KEY_SIZE + 1, 'x'), 1).has_value());
+
+    auto entries = scan_all(tree);
+    ASSERT_EQ(entries.size(), 300u);
+    for (size_t i = 0; i < entries.size(); i += 2) {
+        auto erased = tree.erase(entries[i].first, entries[i].second);
+        ASSERT_TRUE(erased.has_value());
+        EXPECT_TRUE(erased.value());
+    }
+    auto missing = tree.erase(entries[0].first, entries[0].second);
+    ASSERT_TRUE(missing.has_value());
+    EXPECT_FALSE(missing.value());
+    EXPECT_EQ(scan_all(tree).size(), 150u);
+
+    ASSERT_TRUE(tree.destroy().has_value());
+    EXPECT_EQ(tree.root(), INVALID_PAGE_ID);
+    EXPECT_EQ(pages.get_allocated_pages(), 0u);
+}
+
+TEST(BPlusTreeTest, RangeIndexOrdersTypedValues) {
+    MemoryPageStore pages;
+    PropertyRangeIndex index(pages);
+    const std::vector<PropertyValue> numbers = {int64_t(-20), -3.5, int64_t(0), 0.0, 2.25, int64_t(10), int64_t(1) << 40};
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        ASSERT_TRUE(index.insert(numbers[i], i + 1).has_value());
+    }
+
+    auto range = index.find_range(PropertyValue(int64_t(-4)), PropertyValue(10.0));
+    ASSERT_TRUE(range.has_value() && range.value().has_value());
+    EXPECT_EQ(sorted(*range.value()), (std::vector<NodeId>{2, 3, 4, 5, 6}));
+    auto open_upper = index.find_range(PropertyValue(int64_t(3)), std::nullopt);
+    ASSERT_TRUE(open_upper.has_value() && open_upper.value().has_value());
+    EXPECT_EQ(sorted(*open_upper.value()), (std::vector<NodeId>{6, 7}));
+
+    // Mixed-type bounds compare as strings in Cypher, so the index declines them
+    auto mixed = index.find_range(PropertyValue(int64_t(1)), PropertyValue(std::string("z")));
+    ASSERT_TRUE(mixed.has_value());
+    EXPECT_FALSE(mixed.value().has_value());
+
+    MemoryPageStore string_pages;
+    PropertyRangeIndex slugs(string_pages);
+    const std::vector<std::string> values = {"alpha", "beta", "betamax", "bet", "gamma"};
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_TRUE(slugs.insert(PropertyValue(values[i]), i + 1).has_value());
+    }
+    auto prefixed = slugs.find_prefix("beta");
+    ASSERT_TRUE(prefixed.has_value());
+    EXPECT_EQ(sorted(prefixed.value()), (std::vector<NodeId>{2, 3}));
+    auto between = slugs.find_range(PropertyValue(std::string("b")), PropertyValue(std::string("beta")));
+    ASSERT_TRUE(between.has_value() && between.value().has_value());
+    EXPECT_EQ(sorted(*between.value()), (std::vector<NodeId>{2, 4}));
+
+    // Once a number is posted, string ranges can no longer be answered
+    ASSERT_TRUE(slugs.insert(PropertyValue(int64_t(5)), 9).has_value());
+    auto declined = slugs.find_range(PropertyValue(std::string("b")), std::nullopt);
+    ASSERT_TRUE(declined.has_value());
+    EXPECT_FALSE(declined.value().has_value());
+}
+
+TEST(BPlusTreeTest, CompositeIndexMatchesLeadingKeys) {
+    MemoryPageStore pages;
+    PropertyCompositeIndex index(pages, {"workspace", "slug"});
+    using Values = std::vector<std::optional<std::string>>;
+    ASSERT_TRUE(index.insert(Values{"w1", "page"}, 1).has_value());
+    ASSERT_TRUE(index.insert(Values{"w1", "page2"}, 2).has_value());
+    ASSERT_TRUE(index.insert(Values{"w2", "page"}, 3).has_value());
+    ASSERT_TRUE(index.insert(Values{"w1", std::nullopt}, 4).has_value());
+    // Without the leading key a node is not posted
+    ASSERT_TRUE(index.insert(Values{std::nullopt, "page"}, 5).has_value());
+    // Embedded NULs must not let one component run into the next
+    ASSERT_TRUE(index.insert(Values{std::string("w1\0page", 7), "x"}, 6).has_value());
+
+    auto point = index.find({"w1", "page"});
+    ASSERT_TRUE(point.has_value());
+    EXPECT_EQ(sorted(point.value()), (std::vector<NodeId>{1}));
+
+    auto leading = index.find({"w1"});
+    ASSERT_TRUE(leading.has_value());
+    EXPECT_EQ(sorted(leading.value()), (std::vector<NodeId>{1, 2, 4}));
+
+    ASSERT_TRUE(index.erase(Values{"w1", "page2"}, 2).has_value());
+    auto after_erase = index.find({"w1"});
+    ASSERT_TRUE(after_erase.has_value());
+    EXPECT_EQ(sorted(after_erase.value()), (std::vector<NodeId>{1, 4}));
+
+    EXPECT_FALSE(index.find({}).has_value());
+    EXPECT_FALSE(index.find({"a", "b", "c"}).has_value());
+}
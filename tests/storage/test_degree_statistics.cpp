@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "../../src/storage/degree_statistics.h"
+#include "../../src/storage/graph_store.h"
+#include "../../src/storage/memory_page_store.h"
+#include <algorithm>
+#include <map>
+#include <random>
+
+using namespace loredb::storage;
+
+TEST(DegreeStatisticsTest, BucketsAreExactForSmallDegreesAndLogLinearAbove) {
+    DegreeStatistics stats;
+    EXPECT_EQ(stats.max_degree(DegreeDirection::BOTH), 0u);
+    EXPECT_EQ(stats.percentile(DegreeDirection::BOTH, 50), 0u);
+    EXPECT_EQ(stats.mean_degree(DegreeDirection::BOTH), 0.0);
+
+    // Node i ends with out-degree i
+    const std::vector<uint64_t> degrees = {0, 3, 15, 16, 17, 18, 100, 1000, 1000000};
+    for (size_t i = 0; i < degrees.size(); ++i) {
+        stats.add_node();
+        stats.update(i + 1, 0, 0, 0, degrees[i]);
+    }
+    EXPECT_EQ(stats.node_count(), degrees.size());
+    EXPECT_EQ(stats.min_degree(DegreeDirection::OUT), 0u);
+    EXPECT_EQ(stats.max_degree(DegreeDirection::IN), 0u);
+    EXPECT_EQ(stats.max_degree(DegreeDirection::BOTH), 1000000u);  // Exact from the hubs
+    EXPECT_LE(stats.max_degree(DegreeDirection::OUT), 1000000u);
+    EXPECT_GT(stats.max_degree(DegreeDirection::OUT), 1000000u * 7 / 8);
+    uint64_t sum = 0;
+    for (auto degree : degrees) {
+        sum += degree;
+    }
+    EXPECT_DOUBLE_EQ(stats.mean_degree(DegreeDirection::OUT), static_cast<double>(sum) / degrees.size());
+    EXPECT_EQ(stats.mean_degree(DegreeDirection::IN), 0.0);
+
+    auto histogram = stats.histogram(DegreeDirection::OUT);
+    uint64_t nodes = 0;
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        const auto& bucket = histogram[i];
+        nodes += bucket.nodes;
+        EXPECT_LE(bucket.min_degree, bucket.max_degree);
+        EXPECT_LE(bucket.max_degree - bucket.min_degree, bucket.min_degree / 8);
+        if (i > 0) {
+            EXPECT_GT(bucket.min_degree, histogram[i - 1].max_degree);
+        }
+    }
+    EXPECT_EQ(nodes, degrees.size());
+    // 16 and 17 share a bucket; 18 starts the next
+    ASSERT_GE(histogram.size(), 5u);
+    EXPECT_EQ(histogram[2].min_degree, 15u);
+    EXPECT_EQ(histogram[2].max_degree, 15u);
+    EXPECT_EQ(histogram[3].min_degree, 16u);
+    EXPECT_EQ(histogram[3].max_degree, 17u);
+    EXPECT_EQ(histogram[3].nodes, 2u);
+    EXPECT_EQ(histogram[4].min_degree, 18u);
+
+    EXPECT_EQ(stats.percentile(DegreeDirection::OUT, 0), 0u);
+    EXPECT_EQ(stats.percentile(DegreeDirection::OUT, 50), 16u);
+    EXPECT_GT(stats.percentile(DegreeDirection::OUT, 100), 1000000u * 7 / 8);
+
+    // Degrees shrink back; the node with no edges is dropped
+    stats.update(9, 0, 1000000, 0, 2);
+    stats.remove_node(1, 0, 0);
+    EXPECT_EQ(stats.node_count(), degrees.size() - 1);
+    EXPECT_EQ(stats.max_degree(DegreeDirection::BOTH), 1000u);
+    EXPECT_EQ(stats.min_degree(DegreeDirection::OUT), 2u);
+}
+
+TEST(DegreeStatisticsTest, GraphStoreMaintainsDegreesOnEdgeChanges) {
+    GraphStore store(std::make_unique<MemoryPageStore>());
+    constexpr size_t NODES = 300;
+    std::vector<NodeId> ids;
+    for (size_t i = 0; i < NODES; ++i) {
+        ids.push_back(store.create_node({{"i", PropertyValue{static_cast<int64_t>(i)}}}).value());
+    }
+
+    // Skewed random graph: low ids attract most edges, some are self-loops
+    std::mt19937 rng(9);
+    std::geometric_distribution<size_t> skewed(0.02);
+    std::uniform_int_distribution<size_t> uniform(0, NODES - 1);
+    std::vector<EdgeId> edges;
+    for (size_t i = 0; i < 3000; ++i) {
+        const NodeId from = ids[uniform(rng)];
+        const NodeId to = ids[std::min(skewed(rng), NODES - 1)];
+        edges.push_back(store.create_edge(from, to, "LINKS", {}).value());
+    }
+    // Delete a few, including edges of the hubs
+    std::shuffle(edges.begin(), edges.end(), rng);
+    for (size_t i = 0; i < 500; ++i) {
+        ASSERT_TRUE(store.delete_edge(edges[i]).has_value());
+    }
+
+    const auto& stats = store.degree_statistics();
+    EXPECT_EQ(stats.node_count(), NODES);
+    std::map<uint64_t, uint64_t> total_degrees;
+    std::vector<DegreeStatistics::Hub> expected_hubs;
+    uint64_t max_in = 0;
+    for (NodeId id : ids) {
+        const uint64_t in = store.get_incoming_edges(id).value().size();
+        const uint64_t out = store.get_outgoing_edges(id).value().size();
+        auto node = store.get_node(id);
+        ASSERT_TRUE(node.has_value());
+        EXPECT_EQ(node.value().first.in_degree, in);
+        EXPECT_EQ(node.value().first.out_degree, out);
+        ++total_degrees[in + out];
+        expected_hubs.push_back({id, in, out});
+        max_in = std::max(max_in, in);
+    }
+    EXPECT_DOUBLE_EQ(stats.mean_degree(DegreeDirection::BOTH), 2.0 * 2500 / NODES);
+    EXPECT_DOUBLE_EQ(stats.mean_degree(DegreeDirection::IN), 2500.0 / NODES);
+    EXPECT_LE(stats.max_degree(DegreeDirection::IN), max_in);
+    EXPECT_GE(stats.max_degree(DegreeDirection::IN), max_in * 7 / 8);
+    EXPECT_EQ(stats.min_degree(DegreeDirection::BOTH), total_degrees.begin()->first);
+
+    uint64_t bucketed = 0;
+    for (const auto& bucket : stats.histogram(DegreeDirection::BOTH)) {
+        uint64_t expected = 0;
+        for (auto it = total_degrees.lower_bound(bucket.min_degree);
+             it != total_degrees.end() && it->first <= bucket.max_degree; ++it) {
+            expected += it->second;
+        }
+        EXPECT_EQ(bucket.nodes, expected) << bucket.min_degree;
+        bucketed += bucket.nodes;
+    }
+    EXPECT_EQ(bucketed, NODES);
+
+    // The graph is dominated by a few hubs far above the tracked floor, so
+    // deletions have not displaced any of the leaders
+    std::sort(expected_hubs.begin(), expected_hubs.end(), [](const auto& a, const auto& b) {
+        return a.degree() != b.degree() ? a.degree() > b.degree() : a.node_id < b.node_id;
+    });
+    const auto hubs = stats.top_hubs(5);
+    ASSERT_EQ(hubs.size(), 5u);
+    for (size_t i = 0; i < hubs.size(); ++i) {
+        EXPECT_EQ(hubs[i].node_id, expected_hubs[i].node_id);
+        EXPECT_EQ(hubs[i].in_degree, expected_hubs[i].in_degree);
+        EXPECT_EQ(hubs[i].out_degree, expected_hubs[i].out_degree);
+    }
+    EXPECT_EQ(stats.max_degree(DegreeDirection::BOTH), expected_hubs[0].degree());
+
+    // A property update keeps the maintained degrees
+    ASSERT_TRUE(store.update_node(hubs[0].node_id, {{"i", PropertyValue{int64_t{-1}}}}).has_value());
+    EXPECT_EQ(store.get_node(hubs[0].node_id).value().first.in_degree, hubs[0].in_degree);
+}
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 #include "../../src/storage/simple_index_manager.h"
+#include "../../src/storage/file_page_store.h"
+#include "../../src/storage/graph_store.h"
+#include <algorithm>
+#include <filesystem>
+#include <unistd.h>
 #include <thread>
 #include <vector>
 #include <atomic>
@@ -272,5 +277,133 @@ TEST_F(IndexManagerTest, ConcurrentAdjacencyOperations) {
     ASSERT_EQ(total_edges, num_threads * edges_per_thread);
 }
 
+TEST_F(IndexManagerTest, DeclaredNodePropertyIndexes) {
+    EXPECT_FALSE(index_manager_->has_node_property_index("slug"));
+
+    index_manager_->create_node_property_index("slug");
+    index_manager_->create_node_property_index("title");
+    EXPECT_TRUE(index_manager_->has_node_property_index("slug"));
+    EXPECT_EQ(index_manager_->get_node_property_indexes(), (std::vector<std::string>{"slug", "title"}));
+
+    index_manager_->drop_node_property_index("title");
+    EXPECT_FALSE(index_manager_->has_node_property_index("title"));
+
+    // Counts match the lookups for declared and ad-hoc keys alike
+    for (NodeId node_id = 1; node_id <= 5; ++node_id) {
+        index_manager_->index_node_property(node_id, "slug", node_id % 2 ? "odd" : "even");
+        index_manager_->index_node_property(node_id, "tag", node_id % 2 ? "odd" : "even");
+    }
+    for (const std::string key : {"slug", "tag"}) {
+        EXPECT_EQ(index_manager_->count_nodes_by_property(key, "odd"), 3u);
+        EXPECT_EQ(index_manager_->count_nodes_by_property(key, "even"),
+                  index_manager_->find_nodes_by_property(key, "even").size());
+        EXPECT_EQ(index_manager_->count_nodes_by_property(key, "none"), 0u);
+    }
+
+    // Clearing postings also forgets declarations, which would otherwise claim completeness
+    index_manager_->clear_all_indexes();
+    EXPECT_FALSE(index_manager_->has_node_property_index("slug"));
+}
+
+TEST_F(IndexManagerTest, CatalogReopensIndexesWithoutRebuild) {
+    const std::string path = "/tmp/test_index_catalog_" + std::to_string(getpid()) + ".db";
+    std::filesystem::remove(path);
+    auto sorted = [](std::vector<NodeId> ids) {
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+
+    PageId head = INVALID_PAGE_ID;
+    {
+        auto store = std::make_shared<FilePageStore>(path);
+        SimpleIndexManager indexes(store);
+        indexes.create_node_property_index("slug");
+        indexes.create_node_range_index("rank");
+        indexes.create_node_composite_index({"workspace", "slug"});
+        for (NodeId id = 1; id <= 2000; ++id) {
+            const std::string slug = "page" + std::to_string(id % 100);
+            const std::string workspace = "w" + std::to_string(id % 3);
+            ASSERT_TRUE(indexes.index_node_property(id, "slug", slug).has_value());
+            ASSERT_TRUE(indexes.index_node_range(id, "rank", PropertyValue(static_cast<int64_t>(id))).has_value());
+            ASSERT_TRUE(indexes.index_node_composites(id, {{"workspace", workspace}, {"slug", slug}}).has_value());
+        }
+        // Ad-hoc postings on undeclared keys stay in memory
+        ASSERT_TRUE(indexes.index_node_property(1, "title", "t").has_value());
+
+        ASSERT_TRUE(indexes.persist_catalog().has_value());
+        head = indexes.catalog_page();
+        ASSERT_NE(head, INVALID_PAGE_ID);
+        ASSERT_TRUE(store->sync().has_value());
+    }
+
+    auto store = std::make_shared<FilePageStore>(path);
+    SimpleIndexManager reopened(store);
+    ASSERT_TRUE(reopened.load_catalog(head).has_value());
+    EXPECT_EQ(reopened.get_node_property_indexes(), (std::vector<std::string>{"slug"}));
+    EXPECT_TRUE(reopened.has_node_range_index("rank"));
+    EXPECT_TRUE(reopened.has_node_composite_index({"workspace", "slug"}));
+    EXPECT_TRUE(reopened.find_nodes_by_property("title", "t").empty());
+
+    // Pages allocated after reopening must not overwrite the persisted trees
+    for (NodeId id = 2001; id <= 2500; ++id) {
+        ASSERT_TRUE(reopened.index_node_property(id, "slug", "fresh").has_value());
+    }
+    EXPECT_EQ(reopened.find_nodes_by_property("slug", "fresh").size(), 500u);
+    EXPECT_EQ(sorted(reopened.find_nodes_by_property("slug", "page7")).size(), 20u);
+    auto ranked = reopened.find_nodes_in_range("rank", PropertyValue(int64_t(10)), PropertyValue(int64_t(12)));
+    ASSERT_TRUE(ranked.has_value() && ranked.value().has_value());
+    EXPECT_EQ(sorted(*ranked.value()), (std::vector<NodeId>{10, 11, 12}));
+    auto composite = reopened.find_nodes_by_composite({"workspace", "slug"}, {"w1", "page7"});
+    ASSERT_TRUE(composite.has_value() && composite.value().has_value());
+    EXPECT_EQ(sorted(*composite.value()), (std::vector<NodeId>{7, 307, 607, 907, 1207, 1507, 1807}));
+
+    // Reloading a page that is not a catalog leaves the indexes alone
+    EXPECT_FALSE(reopened.load_catalog(1).has_value());
+    EXPECT_TRUE(reopened.has_node_range_index("rank"));
+
+    store->close();
+    std::filesystem::remove(path);
+}
+
+TEST_F(IndexManagerTest, GraphStorePersistsTheAttachedCatalog) {
+    const std::string path = "/tmp/test_index_catalog_graph_" + std::to_string(getpid()) + ".db";
+    std::filesystem::remove(path);
+    {
+        GraphStore graph(std::make_unique<FilePageStore>(path));
+        auto indexes = std::make_shared<SimpleIndexManager>(graph.page_store());
+        ASSERT_TRUE(graph.attach_index_manager(indexes).has_value());
+        indexes->create_node_property_index("slug");
+        indexes->create_node_range_index("rank");
+        for (int64_t i = 1; i <= 50; ++i) {
+            const std::string slug = "page" + std::to_string(i % 5);
+            auto node = graph.create_node({{"slug", slug}, {"rank", i}});
+            ASSERT_TRUE(node.has_value());
+            ASSERT_TRUE(indexes->index_node_property(node.value(), "slug", slug).has_value());
+            ASSERT_TRUE(indexes->index_node_range(node.value(), "rank", PropertyValue(i)).has_value());
+        }
+    }  // Closing the graph syncs it, catalog included
+
+    GraphStore graph(std::make_unique<FilePageStore>(path));
+    auto indexes = std::make_shared<SimpleIndexManager>(graph.page_store());
+    ASSERT_TRUE(graph.attach_index_manager(indexes).has_value());
+    EXPECT_TRUE(indexes->has_node_property_index("slug"));
+    EXPECT_TRUE(indexes->has_node_range_index("rank"));
+
+    auto pages = indexes->find_nodes_by_property("slug", "page3");
+    ASSERT_EQ(pages.size(), 10u);
+    for (NodeId id : pages) {
+        auto node = graph.get_node(id);
+        ASSERT_TRUE(node.has_value());
+        EXPECT_EQ(std::get<std::string>(node.value().second[0].value), "page3");
+    }
+    auto ranked = indexes->find_nodes_in_range("rank", PropertyValue(int64_t(10)), PropertyValue(int64_t(12)));
+    ASSERT_TRUE(ranked.has_value() && ranked.value().has_value());
+    EXPECT_EQ(ranked.value()->size(), 3u);
+
+    // Trees kept elsewhere could not be reopened from this graph's pages
+    EXPECT_FALSE(graph.attach_index_manager(std::make_shared<SimpleIndexManager>()).has_value());
+    std::filesystem::remove(path);
+}
+
 // Lock-free adjacency list tests removed (depends on removed IndexManager)
 // SimpleIndexManager uses regular mutexes instead
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "../../src/storage/file_page_store.h"
+#include "../../src/storage/graph_store.h"
+#include "../../src/storage/label_index.h"
+#include <filesystem>
+#include <unistd.h>
+
+using namespace loredb::storage;
+
+class LabelIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        db_path_ = "/tmp/test_label_index_" + std::to_string(getpid()) + ".db";
+        std::filesystem::remove(db_path_);
+        graph_store_ = std::make_unique<GraphStore>(std::make_unique<FilePageStore>(db_path_));
+    }
+
+    void TearDown() override {
+        graph_store_.reset();
+        std::filesystem::remove(db_path_);
+    }
+
+    std::string db_path_;
+    std::unique_ptr<GraphStore> graph_store_;
+};
+
+TEST_F(LabelIndexTest, DictionaryAssignsDenseIds) {
+    LabelDictionary dictionary;
+    EXPECT_EQ(dictionary.intern(""), NO_LABEL);
+    EXPECT_EQ(dictionary.intern("Document"), 1u);
+    EXPECT_EQ(dictionary.intern("LINKS"), 2u);
+    EXPECT_EQ(dictionary.intern("Document"), 1u);
+    EXPECT_EQ(dictionary.size(), 2u);
+    EXPECT_EQ(dictionary.name(2), "LINKS");
+    EXPECT_EQ(dictionary.name(NO_LABEL), "");
+    EXPECT_FALSE(dictionary.find("Person").has_value());
+
+    LabelDictionary restored;
+    ASSERT_TRUE(restored.load(dictionary.serialize()).has_value());
+    EXPECT_EQ(restored.find("Document"), 1u);
+    EXPECT_EQ(restored.find("LINKS"), 2u);
+    EXPECT_EQ(restored.intern("Person"), 3u);
+
+    auto truncated = dictionary.serialize();
+    truncated.pop_back();
+    EXPECT_FALSE(restored.load(truncated).has_value());
+}
+
+TEST_F(LabelIndexTest, NodesAndEdgesArePostedByLabel) {
+    auto doc1 = graph_store_->create_node({Property("title", std::string("a"))}, {"Document", "Page"}).value();
+    auto doc2 = graph_store_->create_node({}, {"Document"}).value();
+    auto plain = graph_store_->create_node({}).value();
+    auto links = graph_store_->create_edge(doc1, doc2, "LINKS", {}).value();
+    auto untyped = graph_store_->create_edge(doc2, plain, "", {}).value();
+
+    const auto& dictionary = graph_store_->label_dictionary();
+    const LabelId document = dictionary.find("Document").value();
+    EXPECT_EQ(graph_store_->find_nodes_by_label(document), (std::vector<NodeId>{doc1, doc2}));
+    EXPECT_EQ(graph_store_->count_nodes_by_label(dictionary.find("Page").value()), 1u);
+    EXPECT_FALSE(graph_store_->node_has_label(plain, document));
+
+    // Edge records carry the dense id instead of a hash of the type
+    auto edge = graph_store_->get_edge(links).value().first;
+    EXPECT_EQ(dictionary.name(edge.label_id), "LINKS");
+    EXPECT_TRUE(graph_store_->edge_has_label(links, edge.label_id));
+    EXPECT_EQ(graph_store_->find_edges_by_label(NO_LABEL), (std::vector<EdgeId>{untyped}));
+
+    // Labels live in the node record, survive updates and leave the postings on delete
+    ASSERT_TRUE(graph_store_->update_node(doc1, {Property("title", std::string("b"))}).has_value());
+    EXPECT_EQ(graph_store_->get_node_labels(doc1).value(), (std::vector<std::string>{"Document", "Page"}));
+    EXPECT_EQ(std::get<std::string>(graph_store_->get_node(doc1).value().second[0].value), "b");
+    ASSERT_TRUE(graph_store_->delete_edge(links).has_value());
+    ASSERT_TRUE(graph_store_->delete_edge(untyped).has_value());
+    ASSERT_TRUE(graph_store_->delete_node(doc1).has_value());
+    EXPECT_EQ(graph_store_->find_nodes_by_label(document), (std::vector<NodeId>{doc2}));
+    EXPECT_EQ(graph_store_->count_edges_by_label(edge.label_id), 0u);
+}
+
+TEST_F(LabelIndexTest, DictionaryIsPersistedInMetadataPages) {
+    EXPECT_EQ(graph_store_->label_dictionary_page(), INVALID_PAGE_ID);
+
+    // Enough long names to span several pages
+    for (int i = 0; i < 200; ++i) {
+        graph_store_->create_node({}, {std::string(40, 'a' + i % 26) + std::to_string(i)});
+    }
+    ASSERT_TRUE(graph_store_->sync().has_value());
+    const PageId head = graph_store_->label_dictionary_page();
+    ASSERT_NE(head, INVALID_PAGE_ID);
+
+    graph_store_->create_node({}, {"Late"});
+    ASSERT_TRUE(graph_store_->sync().has_value());
+    EXPECT_EQ(graph_store_->label_dictionary_page(), head);
+
+    const auto expected = graph_store_->label_dictionary().serialize();
+    ASSERT_TRUE(graph_store_->load_label_dictionary(head).has_value());
+    EXPECT_EQ(graph_store_->label_dictionary().serialize(), expected);
+    EXPECT_EQ(graph_store_->label_dictionary().find("Late"), 201u);
+}
+
+TEST_F(LabelIndexTest, ReopeningRestoresLabelsAndTopology) {
+    auto doc1 = graph_store_->create_node({}, std::vector<std::string>{"Document", "Page"}).value();
+    auto doc2 = graph_store_->create_node({}, {"Document"}).value();
+    auto gone = graph_store_->create_node({}, {"Draft"}).value();
+    auto links = graph_store_->create_edge(doc1, doc2, "LINKS", {}).value();
+    auto cites = graph_store_->create_edge(doc2, doc1, "CITES", {}).value();
+    auto dropped = graph_store_->create_edge(doc1, doc2, "CITES", {}).value();
+    // Updates rewrite records in place and deletes free them, so neither reappears
+    ASSERT_TRUE(graph_store_->update_node(doc2, {}).has_value());
+    ASSERT_TRUE(graph_store_->delete_edge(dropped).has_value());
+    ASSERT_TRUE(graph_store_->delete_node(gone).has_value());
+    graph_store_.reset();
+
+    graph_store_ = std::make_unique<GraphStore>(std::make_unique<FilePageStore>(db_path_));
+    const auto& dictionary = graph_store_->label_dictionary();
+    ASSERT_TRUE(dictionary.find("Document").has_value());
+    ASSERT_TRUE(dictionary.find("CITES").has_value());
+    EXPECT_EQ(graph_store_->find_nodes_by_label(*dictionary.find("Document")), (std::vector<NodeId>{doc1, doc2}));
+    EXPECT_TRUE(graph_store_->node_has_label(doc1, *dictionary.find("Page")));
+    EXPECT_TRUE(graph_store_->find_nodes_by_label(*dictionary.find("Draft")).empty());
+    EXPECT_EQ(graph_store_->find_edges_by_label(*dictionary.find("CITES")), (std::vector<EdgeId>{cites}));
+    EXPECT_EQ(graph_store_->get_node_labels(doc1).value(), (std::vector<std::string>{"Document", "Page"}));
+
+    EXPECT_EQ(graph_store_->get_node_count(), 2u);
+    EXPECT_EQ(graph_store_->get_edge_count(), 2u);
+    EXPECT_EQ(graph_store_->get_node_ids(), (std::vector<NodeId>{doc1, doc2}));
+    EXPECT_EQ(graph_store_->get_outgoing_edges(doc1).value(), (std::vector<EdgeId>{links}));
+    EXPECT_EQ(graph_store_->get_incoming_neighbors(doc1).value(), (std::vector<NodeId>{doc2}));
+    EXPECT_EQ(graph_store_->degree_statistics().top_hubs(1).front().degree(), 2u);
+
+    // Ids keep counting past those handed out before the reopen, deleted or not
+    EXPECT_GT(graph_store_->create_node({}, {"Document"}).value(), gone);
+    EXPECT_GT(graph_store_->create_edge(doc1, doc2, "LINKS", {}).value(), dropped);
+}
+
+TEST_F(LabelIndexTest, OpeningAPageStoreWithoutSuperblockFails) {
+    graph_store_.reset();
+    std::filesystem::remove(db_path_);
+    {
+        FilePageStore pages(db_path_);
+        auto page = pages.allocate_page().value();
+        ASSERT_TRUE(pages.write_page(page, std::vector<uint8_t>(PAGE_SIZE, 0)).has_value());
+    }
+    EXPECT_THROW(GraphStore(std::make_unique<FilePageStore>(db_path_)), std::runtime_error);
+}
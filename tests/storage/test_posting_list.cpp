@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../../src/storage/posting_list.h"
+#include "../../src/storage/simple_index_manager.h"
+#include <algorithm>
+#include <random>
+#include <set>
+
+using namespace loredb::storage;
+
+TEST(PostingListTest, MatchesSetAcrossContainerConversions) {
+    PostingList list;
+    std::set<uint64_t> expected;
+    std::mt19937_64 rng(7);
+
+    // Dense ids in one container cross ARRAY_MAX both ways; sparse ids spread
+    // over many containers, including ids beyond 32 bits
+    for (int round = 0; round < 20000; ++round) {
+        const uint64_t id = round % 3 == 0 ? (rng() & 0xFFFFFFFFFFull) : (rng() % 6000);
+        const bool insert = rng() % 3 != 0;
+        if (insert) {
+            EXPECT_EQ(list.add(id), expected.insert(id).second);
+        } else {
+            EXPECT_EQ(list.remove(id), expected.erase(id) == 1);
+        }
+    }
+    EXPECT_EQ(list.size(), expected.size());
+    EXPECT_EQ(list.ids(), std::vector<uint64_t>(expected.begin(), expected.end()));
+    for (uint64_t id = 0; id < 6000; ++id) {
+        ASSERT_EQ(list.contains(id), expected.count(id) == 1) << id;
+    }
+
+    for (uint64_t id : expected) {
+        EXPECT_TRUE(list.remove(id));
+    }
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(list.ids().empty());
+}
+
+TEST(PostingListTest, IndexManagerRemovesFrequentlyUpdatedPostings) {
+    SimpleIndexManager manager;
+    constexpr NodeId NODES = 20000;
+    for (NodeId id = 1; id <= NODES; ++id) {
+        ASSERT_TRUE(manager.index_node_property(id, "status", "open").has_value());
+    }
+    // Flip every node's status; each move is one remove and one add
+    for (NodeId id = 1; id <= NODES; ++id) {
+        ASSERT_TRUE(manager.remove_node_property_index(id, "status", "open").has_value());
+        ASSERT_TRUE(manager.index_node_property(id, "status", id % 2 ? "closed" : "open").has_value());
+    }
+    EXPECT_EQ(manager.find_nodes_by_property("status", "open").size(), NODES / 2);
+    EXPECT_EQ(manager.find_nodes_by_property("status", "closed").size(), NODES / 2);
+
+    for (NodeId id = 2; id <= NODES; id += 2) {
+        ASSERT_TRUE(manager.remove_node_property_index(id, "status", "open").has_value());
+    }
+    // Emptied postings are dropped rather than kept as empty lists
+    EXPECT_TRUE(manager.find_nodes_by_property("status", "open").empty());
+    EXPECT_EQ(manager.get_node_property_index_size(), 1u);
+}
+
+TEST(PostingListTest, SetAlgebraMatchesSortedSets) {
+    std::mt19937_64 rng(11);
+    // Pairs mixing array and bitmap containers, with partly shared container keys
+    auto random_ids = [&rng](size_t count, uint64_t span) {
+        std::vector<uint64_t> ids;
+        for (size_t i = 0; i < count; ++i) {
+            ids.push_back(rng() % span);
+        }
+        return ids;
+    };
+    const std::vector<std::pair<std::vector<uint64_t>, std::vector<uint64_t>>> cases = {
+        {random_ids(50, 1 << 18), random_ids(60000, 1 << 17)},
+        {random_ids(30000, 1 << 17), random_ids(40000, 1 << 17)},
+        {random_ids(3000, 1 << 16), random_ids(3500, 1 << 16)},
+        {random_ids(10, 1 << 16), random_ids(4000, 1 << 16)},
+        {random_ids(20000, 1 << 20), {}},
+    };
+
+    for (const auto& [a_ids, b_ids] : cases) {
+        const auto a = PostingList::from_ids(a_ids);
+        const auto b = PostingList::from_ids(b_ids);
+        const std::set<uint64_t> a_set(a_ids.begin(), a_ids.end());
+        const std::set<uint64_t> b_set(b_ids.begin(), b_ids.end());
+        ASSERT_EQ(a.ids(), std::vector<uint64_t>(a_set.begin(), a_set.end()));
+
+        std::vector<uint64_t> expected;
+        std::set_intersection(a_set.begin(), a_set.end(), b_set.begin(), b_set.end(), std::back_inserter(expected));
+        EXPECT_EQ((a & b).ids(), expected);
+        EXPECT_EQ((b & a).ids(), expected);
+        EXPECT_EQ((a & b).size(), expected.size());
+
+        expected.clear();
+        std::set_union(a_set.begin(), a_set.end(), b_set.begin(), b_set.end(), std::back_inserter(expected));
+        EXPECT_EQ((a | b).ids(), expected);
+        EXPECT_EQ((a | b).size(), expected.size());
+
+        expected.clear();
+        std::set_difference(a_set.begin(), a_set.end(), b_set.begin(), b_set.end(), std::back_inserter(expected));
+        EXPECT_EQ((a - b).ids(), expected);
+        EXPECT_EQ((a - b).size(), expected.size());
+
+        // Results stay usable for point updates
+        auto both = a & b;
+        for (uint64_t id : a_ids) {
+            both.add(id);
+        }
+        EXPECT_EQ(both, a);
+    }
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "../../src/storage/file_page_store.h"
+#include "../../src/storage/graph_store.h"
+#include "../../src/storage/key_mapping.h"
+#include "../../src/storage/property_key.h"
+#include "../../src/storage/record.h"
+#include <filesystem>
+#include <unistd.h>
+
+using namespace loredb::storage;
+
+TEST(PropertyKeyTest, KeysAreInternedOnce) {
+    PropertyKey a("property_key_test_title");
+    PropertyKey b(std::string("property_key_test_title"));
+    EXPECT_EQ(a.id(), b.id());
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a, "property_key_test_title");
+    EXPECT_EQ(a.str(), "property_key_test_title");
+    EXPECT_NE(a, PropertyKey("property_key_test_body"));
+
+    // Lookups never grow the dictionary
+    const size_t size = PropertyKey::dictionary().size();
+    EXPECT_FALSE(PropertyKey::find("property_key_test_never_stored").has_value());
+    EXPECT_EQ(PropertyKey::dictionary().size(), size);
+    EXPECT_EQ(PropertyKey::find("property_key_test_title"), a);
+}
+
+TEST(PropertyKeyTest, RecordsStoreKeyIds) {
+    const std::string long_key(200, 'k');
+    std::vector<Property> properties = {{long_key, int64_t(7)}, {"property_key_test_flag", true}};
+
+    auto data = RecordSerializer::serialize_properties(properties);
+    EXPECT_LT(data.size(), long_key.size());
+
+    auto decoded = RecordSerializer::deserialize_properties(data);
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded.value().size(), 2u);
+    EXPECT_EQ(decoded.value()[0].key, long_key);
+    EXPECT_EQ(std::get<int64_t>(decoded.value()[0].value), 7);
+    EXPECT_EQ(decoded.value()[1].key, "property_key_test_flag");
+
+    // An id the dictionary never assigned is corruption, not an empty key
+    std::vector<uint8_t> bad = {1, static_cast<uint8_t>(PropertyKey::dictionary().size() + 1), 0};
+    EXPECT_FALSE(RecordSerializer::deserialize_properties(bad).has_value());
+}
+
+TEST(PropertyKeyTest, DictionaryIsPersistedAndMerged) {
+    const std::string path = "/tmp/test_property_key_" + std::to_string(getpid()) + ".db";
+    std::filesystem::remove(path);
+    {
+        GraphStore store(std::make_unique<FilePageStore>(path));
+        ASSERT_TRUE(store.create_node({{"property_key_test_persisted", std::string("x")}}).has_value());
+        ASSERT_TRUE(store.sync().has_value());
+        const PageId head = store.key_dictionary_page();
+        ASSERT_NE(head, INVALID_PAGE_ID);
+
+        // Loading a prefix of the live dictionary keeps every id
+        const auto id = PropertyKey::find("property_key_test_persisted")->id();
+        ASSERT_TRUE(store.load_key_dictionary(head).has_value());
+        EXPECT_EQ(PropertyKey::find("property_key_test_persisted")->id(), id);
+    }
+    std::filesystem::remove(path);
+
+    StringDictionary other;
+    other.intern("something_else");
+    StringDictionary conflicting;
+    conflicting.intern("different");
+    EXPECT_FALSE(conflicting.load(other.serialize()).has_value());
+    EXPECT_EQ(conflicting.find("different"), 1u);
+}
+
+TEST(PropertyKeyTest, ReopenedStoreReadsPropertiesBack) {
+    const std::string path = "/tmp/test_property_key_reopen_" + std::to_string(getpid()) + ".db";
+    const std::string other_path = path + ".other";
+    std::filesystem::remove(path);
+    std::filesystem::remove(other_path);
+
+    NodeId node = 0;
+    EdgeId edge = 0;
+    {
+        GraphStore store(std::make_unique<FilePageStore>(path));
+        GraphStore other(std::make_unique<FilePageStore>(other_path));
+        ASSERT_TRUE(other.create_node({{"property_key_test_other_store", int64_t(1)}}).has_value());
+        node = store.create_node({{"property_key_test_name", std::string("n")},
+                                  {"property_key_test_rank", int64_t(3)}}).value();
+        edge = store.create_edge(node, node, "SELF", {{"property_key_test_weight", 2.5}}).value();
+
+        // Each store persists only the keys it used
+        EXPECT_EQ(store.key_dictionary().size(), 3u);
+        EXPECT_FALSE(store.key_dictionary().find("property_key_test_other_store").has_value());
+    }
+
+    // Keys interned in between shift process ids away from the stored ones
+    PropertyKey late("property_key_test_interned_between");
+    GraphStore reopened(std::make_unique<FilePageStore>(path));
+    auto stored = reopened.get_node(node);
+    ASSERT_TRUE(stored.has_value());
+    const auto& properties = stored.value().second;
+    ASSERT_EQ(properties.size(), 2u);
+    EXPECT_EQ(properties[0].key, "property_key_test_name");
+    EXPECT_EQ(std::get<std::string>(properties[0].value), "n");
+    EXPECT_EQ(properties[1].key, "property_key_test_rank");
+    EXPECT_EQ(std::get<int64_t>(properties[1].value), 3);
+
+    auto weight = reopened.get_edge_property(edge, "property_key_test_weight");
+    ASSERT_TRUE(weight.has_value() && weight.value().has_value());
+    EXPECT_EQ(std::get<double>(*weight.value()), 2.5);
+    auto missing = reopened.get_edge_property(edge, late);
+    ASSERT_TRUE(missing.has_value());
+    EXPECT_FALSE(missing.value().has_value());
+
+    ASSERT_TRUE(reopened.create_node({{late, true}}).has_value());
+    EXPECT_EQ(reopened.key_dictionary().find("property_key_test_interned_between"), 4u);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(other_path);
+}
+
+TEST(PropertyKeyTest, KeyMappingLoadsDictionariesNumberedDifferently) {
+    StringDictionary persisted;
+    persisted.intern("property_key_test_mapped_b");
+    persisted.intern("property_key_test_mapped_a");
+    PropertyKey a("property_key_test_mapped_a");
+
+    KeyMapping keys;
+    ASSERT_TRUE(keys.load(persisted.serialize()).has_value());
+    EXPECT_EQ(keys.from_stored(1), PropertyKey::find("property_key_test_mapped_b"));
+    EXPECT_EQ(keys.from_stored(2), a);
+    EXPECT_FALSE(keys.from_stored(3).has_value());
+    EXPECT_EQ(keys.to_stored(a), 2u);
+    EXPECT_FALSE(keys.find_stored("property_key_test_mapped_c").has_value());
+    EXPECT_EQ(keys.to_stored("property_key_test_mapped_c"), 3u);
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include "../../src/storage/memory_page_store.h"
+#include "../../src/storage/simple_index_manager.h"
+#include "../../src/storage/vector_index.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+
+using namespace loredb::storage;
+
+namespace {
+
+// Points around a few random centres, like topic embeddings
+std::vector<std::vector<float>> clustered_vectors(size_t count, size_t dimensions, std::mt19937& rng) {
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<std::vector<float>> centres(8, std::vector<float>(dimensions));
+    for (auto& centre : centres) {
+        for (float& x : centre) {
+            x = noise(rng);
+        }
+    }
+    std::vector<std::vector<float>> vectors;
+    for (size_t i = 0; i < count; ++i) {
+        auto vector = centres[i % centres.size()];
+        for (float& x : vector) {
+            x += 0.5f * noise(rng);
+        }
+        vectors.push_back(std::move(vector));
+    }
+    return vectors;
+}
+
+std::vector<NodeId> brute_force(const std::vector<std::vector<float>>& vectors, const std::vector<float>& query,
+                                size_t k) {
+    auto cosine = [](const std::vector<float>& a, const std::vector<float>& b) {
+        double dot = 0, na = 0, nb = 0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            dot += double{a[i]} * b[i];
+            na += double{a[i]} * a[i];
+            nb += double{b[i]} * b[i];
+        }
+        return dot / std::sqrt(na * nb);
+    };
+    std::vector<std::pair<double, NodeId>> scored;
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        scored.emplace_back(cosine(vectors[i], query), i + 1);
+    }
+    std::partial_sort(scored.begin(), scored.begin() + k, scored.end(), std::greater<>());
+    std::vector<NodeId> ids;
+    for (size_t i = 0; i < k; ++i) {
+        ids.push_back(scored[i].second);
+    }
+    return ids;
+}
+
+}  // namespace
+
+TEST(VectorIndexTest, DotMatchesScalarForEveryTailLength) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    for (size_t n = 0; n <= 67; ++n) {
+        std::vector<float> a(n), b(n);
+        double expected = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = value(rng);
+            b[i] = value(rng);
+            expected += double{a[i]} * b[i];
+        }
+        EXPECT_NEAR(HnswIndex::dot(a.data(), b.data(), n), expected, 1e-4) << n;
+    }
+}
+
+TEST(VectorIndexTest, SearchRecallsBruteForceNeighbours) {
+    constexpr size_t COUNT = 2000;
+    constexpr size_t DIMENSIONS = 48;
+    constexpr size_t K = 10;
+    std::mt19937 rng(17);
+    const auto vectors = clustered_vectors(COUNT, DIMENSIONS, rng);
+
+    HnswIndex index;
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        ASSERT_TRUE(index.insert(i + 1, vectors[i]).has_value());
+    }
+    EXPECT_EQ(index.size(), COUNT);
+    EXPECT_EQ(index.dimensions(), DIMENSIONS);
+
+    const auto queries = clustered_vectors(100, DIMENSIONS, rng);
+    size_t found = 0;
+    for (const auto& query : queries) {
+        const auto expected = brute_force(vectors, query, K);
+        const std::set<NodeId> truth(expected.begin(), expected.end());
+        const auto hits = index.search(query, K);
+        ASSERT_EQ(hits.size(), K);
+        for (size_t i = 0; i < hits.size(); ++i) {
+            found += truth.count(hits[i].node_id);
+            if (i > 0) {
+                EXPECT_GE(hits[i - 1].similarity, hits[i].similarity);
+            }
+        }
+    }
+    EXPECT_GE(static_cast<double>(found) / (queries.size() * K), 0.9);
+}
+
+TEST(VectorIndexTest, ReplacesRemovesAndExcludesVectors) {
+    HnswIndex index;
+    EXPECT_TRUE(index.search(std::vector<float>{1, 0}, 3).empty());
+    EXPECT_FALSE(index.insert(1, std::vector<float>{0, 0}).has_value());
+
+    ASSERT_TRUE(index.insert(1, std::vector<float>{1, 0}).has_value());
+    ASSERT_TRUE(index.insert(2, std::vector<float>{0, 1}).has_value());
+    ASSERT_TRUE(index.insert(3, std::vector<float>{1, 1}).has_value());
+    auto mismatch = index.insert(4, std::vector<float>{1, 0, 0});
+    ASSERT_FALSE(mismatch.has_value());
+    EXPECT_EQ(mismatch.error().code, ErrorCode::INVALID_ARGUMENT);
+
+    auto hits = index.search(std::vector<float>{2, 0}, 3);
+    ASSERT_EQ(hits.size(), 3u);
+    EXPECT_EQ(hits[0].node_id, 1u);
+    EXPECT_NEAR(hits[0].similarity, 1.0f, 1e-6);
+    EXPECT_EQ(hits[2].node_id, 2u);
+
+    // A replaced vector only answers for its new direction
+    ASSERT_TRUE(index.insert(1, std::vector<float>{0, 3}).has_value());
+    EXPECT_EQ(index.size(), 3u);
+    EXPECT_EQ(index.search(std::vector<float>{1, 0}, 1)[0].node_id, 3u);
+    EXPECT_NEAR((*index.vector_of(1))[1], 1.0f, 1e-6);
+
+    index.remove(3);
+    PostingList exclude;
+    exclude.add(2);
+    hits = index.search(std::vector<float>{1, 0}, 3, exclude);
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0].node_id, 1u);
+    EXPECT_FALSE(index.vector_of(3).has_value());
+
+    // Churn through many replacements; tombstones are compacted away
+    for (int round = 0; round < 50; ++round) {
+        for (NodeId id = 1; id <= 20; ++id) {
+            const float angle = static_cast<float>(round * 20 + id);
+            ASSERT_TRUE(index.insert(id, std::vector<float>{std::cos(angle), std::sin(angle)}).has_value());
+        }
+    }
+    EXPECT_EQ(index.size(), 20u);
+    EXPECT_EQ(index.search(std::vector<float>{1, 0}, 50).size(), 20u);
+}
+
+TEST(VectorIndexTest, PersistsThroughIndexCatalog) {
+    std::mt19937 rng(5);
+    const auto vectors = clustered_vectors(500, 16, rng);
+    auto store = std::make_shared<MemoryPageStore>();
+
+    PageId head = INVALID_PAGE_ID;
+    std::vector<HnswIndex::Hit> before;
+    {
+        SimpleIndexManager indexes(store);
+        indexes.create_vector_index("embedding");
+        for (size_t i = 0; i < vectors.size(); ++i) {
+            ASSERT_TRUE(indexes.index_node_vector(i + 1, "embedding", vectors[i]).has_value());
+        }
+        // Keys without a declared index are ignored
+        ASSERT_TRUE(indexes.index_node_vector(1, "other", vectors[0]).has_value());
+        EXPECT_FALSE(indexes.has_vector_index("other"));
+
+        auto hits = indexes.search_vectors("embedding", vectors[7], 5);
+        ASSERT_TRUE(hits.has_value());
+        before = *hits;
+        ASSERT_TRUE(indexes.persist_catalog().has_value());
+        head = indexes.catalog_page();
+    }
+
+    SimpleIndexManager reopened(store);
+    ASSERT_TRUE(reopened.load_catalog(head).has_value());
+    EXPECT_EQ(reopened.get_vector_indexes(), (std::vector<std::string>{"embedding"}));
+    auto after = reopened.search_vectors("embedding", vectors[7], 5);
+    ASSERT_TRUE(after.has_value());
+    ASSERT_EQ(after->size(), before.size());
+    for (size_t i = 0; i < before.size(); ++i) {
+        EXPECT_EQ((*after)[i].node_id, before[i].node_id);
+        EXPECT_FLOAT_EQ((*after)[i].similarity, before[i].similarity);
+    }
+    EXPECT_FALSE(reopened.search_vectors("missing", vectors[7], 5).has_value());
+
+    // The reopened graph keeps taking inserts
+    ASSERT_TRUE(reopened.index_node_vector(1000, "embedding", vectors[7]).has_value());
+    auto nearest = reopened.search_vectors("embedding", vectors[7], 2);
+    ASSERT_TRUE(nearest.has_value() && nearest->size() == 2);
+    EXPECT_EQ(std::min((*nearest)[0].node_id, (*nearest)[1].node_id), 8u);
+    EXPECT_EQ(std::max((*nearest)[0].node_id, (*nearest)[1].node_id), 1000u);
+
+    // A truncated blob is rejected and leaves the index as it was
+    HnswIndex index;
+    ASSERT_TRUE(index.insert(1, std::vector<float>{1, 2}).has_value());
+    auto blob = index.serialize();
+    blob.pop_back();
+    EXPECT_FALSE(index.load(blob).has_value());
+    EXPECT_EQ(index.size(), 1u);
+}
@@ -153,4 +153,47 @@ TEST_F(WALManagerTest, ForceSync) {
     // Test that force_sync doesn't fail
     auto result = wal_manager_->force_sync();
     EXPECT_TRUE(result.has_value());
-}
\ No newline at end of file
+}
+
+TEST_F(WALManagerTest, PropertyKeysAreLoggedAsIds) {
+    TransactionId tx_id = 7;
+    std::vector<Property> props = {{"wal_key_name", std::string("a")}, {"wal_key_rank", int64_t(1)}};
+    ASSERT_TRUE(wal_manager_->log_create_node(tx_id, 1, props).has_value());
+    ASSERT_TRUE(wal_manager_->log_create_node(tx_id, 2, props).has_value());
+    ASSERT_TRUE(wal_manager_->log_create_edge(tx_id, 3, 1, 2, "LINKS", props).has_value());
+    ASSERT_TRUE(wal_manager_->log_delete_node(tx_id, 2).has_value());
+    wal_manager_->force_sync();
+    const auto first_session = std::filesystem::file_size(wal_file_);
+
+    // A new session defines its keys again before using them
+    wal_manager_.reset();
+    wal_manager_ = std::make_unique<WALManager>(wal_file_);
+    ASSERT_TRUE(wal_manager_->log_update_node(tx_id, 1, props).has_value());
+    wal_manager_->force_sync();
+    EXPECT_GT(std::filesystem::file_size(wal_file_), first_session);
+
+    std::vector<WALRecord> records;
+    auto result = wal_manager_->recover_from_log([&](const WALRecord& record) -> loredb::util::expected<void, Error> {
+        records.push_back(record);
+        return {};
+    });
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(records.size(), 5u);
+
+    using NodeData = std::pair<NodeId, std::vector<Property>>;
+    using EdgeData = std::tuple<EdgeId, NodeId, NodeId, std::string, std::vector<Property>>;
+    for (size_t i : {0u, 1u, 4u}) {
+        const auto& [node_id, logged] = std::get<NodeData>(records[i].data);
+        ASSERT_EQ(logged.size(), 2u);
+        EXPECT_EQ(logged[0].key, props[0].key);
+        EXPECT_EQ(logged[1].key, "wal_key_rank");
+    }
+    EXPECT_EQ(records[2].type, WALRecordType::CREATE_EDGE);
+    const auto& [edge_id, from, to, label, edge_props] = std::get<EdgeData>(records[2].data);
+    EXPECT_EQ(edge_id, 3u);
+    EXPECT_EQ(to, 2u);
+    EXPECT_EQ(label, "LINKS");
+    ASSERT_EQ(edge_props.size(), 2u);
+    EXPECT_EQ(edge_props[1].key, "wal_key_rank");
+    EXPECT_EQ(records[3].type, WALRecordType::DELETE_NODE);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "../../src/transaction/commit_log.h"
+#include "../../src/transaction/mvcc_manager.h"
+#include "../../src/transaction/mvcc.h"
+
+using namespace loredb::transaction;
+
+TEST(CommitLogTest, UnknownByDefault) {
+    CommitLog clog;
+    EXPECT_EQ(clog.get_status(1), CommitStatus::UNKNOWN);
+    EXPECT_EQ(clog.get_status(1'000'000), CommitStatus::UNKNOWN);
+    EXPECT_EQ(clog.get_segment_count(), 0u);
+}
+
+TEST(CommitLogTest, SetAndGetStatus) {
+    CommitLog clog;
+    clog.set_status(1, CommitStatus::IN_PROGRESS);
+    clog.set_status(2, CommitStatus::COMMITTED);
+    clog.set_status(3, CommitStatus::ABORTED);
+    EXPECT_EQ(clog.get_status(1), CommitStatus::IN_PROGRESS);
+    EXPECT_EQ(clog.get_status(2), CommitStatus::COMMITTED);
+    EXPECT_EQ(clog.get_status(3), CommitStatus::ABORTED);
+
+    // Neighbouring entries in the same word are unaffected
+    clog.set_status(1, CommitStatus::COMMITTED);
+    EXPECT_EQ(clog.get_status(1), CommitStatus::COMMITTED);
+    EXPECT_EQ(clog.get_status(2), CommitStatus::COMMITTED);
+    EXPECT_EQ(clog.get_status(3), CommitStatus::ABORTED);
+    EXPECT_EQ(clog.get_status(4), CommitStatus::UNKNOWN);
+}
+
+TEST(CommitLogTest, TruncateDropsSegmentsAndReportsCommitted) {
+    CommitLog clog;
+    const TransactionId per_seg = CommitLog::TXNS_PER_SEGMENT;
+    clog.set_status(5, CommitStatus::ABORTED);
+    clog.set_status(per_seg + 5, CommitStatus::IN_PROGRESS);
+    clog.set_status(2 * per_seg + 5, CommitStatus::ABORTED);
+    EXPECT_EQ(clog.get_segment_count(), 3u);
+
+    clog.truncate(2 * per_seg + 1);  // Rounds down to a segment boundary
+    EXPECT_EQ(clog.get_horizon(), 2 * per_seg);
+    EXPECT_EQ(clog.get_segment_count(), 1u);
+    EXPECT_EQ(clog.get_status(5), CommitStatus::COMMITTED);
+    EXPECT_EQ(clog.get_status(per_seg + 5), CommitStatus::COMMITTED);
+    EXPECT_EQ(clog.get_status(2 * per_seg + 5), CommitStatus::ABORTED);
+
+    // Writes below the horizon are ignored; truncation never moves backwards
+    clog.set_status(7, CommitStatus::ABORTED);
+    EXPECT_EQ(clog.get_status(7), CommitStatus::COMMITTED);
+    clog.truncate(0);
+    EXPECT_EQ(clog.get_horizon(), 2 * per_seg);
+}
+
+TEST(CommitLogTest, SegmentsAreRecycledAcrossLongRuns) {
+    CommitLog clog;
+    const TransactionId per_seg = CommitLog::TXNS_PER_SEGMENT;
+    // Sliding window of two live segments over many segments: memory stays bounded
+    for (TransactionId seg = 0; seg < 64; ++seg) {
+        clog.set_status(seg * per_seg + 1, CommitStatus::COMMITTED);
+        clog.set_status(seg * per_seg + 2, CommitStatus::ABORTED);
+        if (seg >= 1) {
+            clog.truncate((seg - 1) * per_seg);
+        }
+        EXPECT_LE(clog.get_segment_count(), 2u);
+        EXPECT_EQ(clog.get_status(seg * per_seg + 2), CommitStatus::ABORTED);
+        EXPECT_EQ(clog.get_status(seg * per_seg + 3), CommitStatus::UNKNOWN);
+    }
+}
+
+TEST(CommitLogTest, DirectoryGrowsForWideLiveRange) {
+    CommitLog clog;
+    const TransactionId per_seg = CommitLog::TXNS_PER_SEGMENT;
+    const size_t live = CommitLog::INITIAL_DIRECTORY_SLOTS * 3;
+    for (TransactionId seg = 0; seg < live; ++seg) {
+        clog.set_status(seg * per_seg + seg, CommitStatus::ABORTED);
+    }
+    for (TransactionId seg = 0; seg < live; ++seg) {
+        EXPECT_EQ(clog.get_status(seg * per_seg + seg), CommitStatus::ABORTED);
+    }
+    EXPECT_EQ(clog.get_segment_count(), live);
+}
+
+TEST(CommitLogTest, TransactionManagerTracksLifecycle) {
+    TransactionManager txn_mgr;
+    auto t1 = txn_mgr.begin_transaction();
+    auto t2 = txn_mgr.begin_transaction();
+    EXPECT_FALSE(txn_mgr.is_transaction_committed(t1->id));
+    EXPECT_EQ(txn_mgr.get_oldest_active_transaction_id(), t1->id);
+
+    txn_mgr.commit_transaction(t1);
+    txn_mgr.abort_transaction(t2);
+    EXPECT_TRUE(txn_mgr.is_transaction_committed(t1->id));
+    EXPECT_FALSE(txn_mgr.is_transaction_committed(t2->id));
+    EXPECT_TRUE(txn_mgr.is_transaction_aborted(t2->id));
+    EXPECT_EQ(txn_mgr.get_oldest_active_transaction_id(), t2->id + 1);
+
+    // IDs the manager never issued keep the legacy "old and committed" semantics
+    EXPECT_TRUE(txn_mgr.is_transaction_committed(t2->id + 100));
+}
+
+TEST(CommitLogTest, TruncationIsClampedToOldestActive) {
+    TransactionManager txn_mgr;
+    auto active = txn_mgr.begin_transaction();
+    txn_mgr.truncate_commit_log(10 * CommitLog::TXNS_PER_SEGMENT);
+    EXPECT_EQ(txn_mgr.get_commit_log().get_horizon(), 0u);
+    EXPECT_FALSE(txn_mgr.is_transaction_committed(active->id));
+    txn_mgr.commit_transaction(active);
+}
+
+TEST(CommitLogTest, GarbageCollectResolvesAbortedVersions) {
+    auto txn_mgr = std::make_shared<TransactionManager>();
+    MVCCManager mvcc(txn_mgr);
+
+    auto writer = txn_mgr->begin_transaction();
+    Version v1{writer->id, 0, loredb::storage::NodeRecord{}, {}};
+    ASSERT_TRUE(mvcc.write_version(7, v1).has_value());
+    txn_mgr->commit_transaction(writer);
+
+    // An aborted update marks v1 deleted and leaves a dead version behind
+    auto updater = txn_mgr->begin_transaction();
+    Version v2{updater->id, 0, loredb::storage::NodeRecord{}, {}};
+    ASSERT_TRUE(mvcc.write_version(7, v2).has_value());
+    txn_mgr->abort_transaction(updater);
+
+    mvcc.garbage_collect(txn_mgr->get_oldest_active_transaction_id());
+
+    auto reader = txn_mgr->begin_transaction();
+    auto res = mvcc.read_version(7, reader->id);
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res.value().created_tx_id, writer->id);
+    EXPECT_EQ(res.value().deleted_tx_id, 0u);
+    txn_mgr->commit_transaction(reader);
+}
+
+TEST(CommitLogTest, GarbageCollectKeepsVersionsActiveReadersSee) {
+    auto txn_mgr = std::make_shared<TransactionManager>();
+    MVCCManager mvcc(txn_mgr);
+
+    auto writer = txn_mgr->begin_transaction();
+    Version v1{writer->id, 0, loredb::storage::NodeRecord{}, {}};
+    ASSERT_TRUE(mvcc.write_version(7, v1).has_value());
+    txn_mgr->commit_transaction(writer);
+
+    // The reader starts before the update commits, so it must keep seeing v1
+    auto reader = txn_mgr->begin_transaction();
+    auto updater = txn_mgr->begin_transaction();
+    Version v2{updater->id, 0, loredb::storage::NodeRecord{}, {}};
+    ASSERT_TRUE(mvcc.write_version(7, v2).has_value());
+    txn_mgr->commit_transaction(updater);
+
+    // A caller-supplied bound past the reader is clamped to the oldest active transaction
+    mvcc.garbage_collect(updater->id + 1);
+
+    auto res = mvcc.read_version(7, reader->id);
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res.value().created_tx_id, writer->id);
+    txn_mgr->commit_transaction(reader);
+}
+
+TEST(CommitLogTest, CommitsTruncateTheLogAsTheOldestActiveAdvances) {
+    auto txn_mgr = std::make_shared<TransactionManager>();
+    MVCCManager mvcc(txn_mgr);
+    const TransactionId per_seg = CommitLog::TXNS_PER_SEGMENT;
+
+    auto writer = txn_mgr->begin_transaction();
+    Version v1{writer->id, 0, loredb::storage::NodeRecord{}, {}};
+    ASSERT_TRUE(mvcc.write_version(7, v1).has_value());
+    txn_mgr->commit_transaction(writer);
+
+    // Several segments of aborted updates and commits; garbage_collect() is never called
+    for (TransactionId i = 0; i < 3 * per_seg; ++i) {
+        auto txn = txn_mgr->begin_transaction();
+        if (i % 1000 == 0) {
+            Version dead{txn->id, 0, loredb::storage::NodeRecord{}, {}};
+            ASSERT_TRUE(mvcc.write_version(7, dead).has_value());
+            txn_mgr->abort_transaction(txn);
+        } else {
+            txn_mgr->commit_transaction(txn);
+        }
+        // The sweep runs off the commit path; once it catches up the log stays small
+        txn_mgr->wait_for_horizon_sweep();
+        EXPECT_LE(txn_mgr->get_commit_log().get_segment_count(), 2u);
+    }
+    EXPECT_GE(txn_mgr->get_commit_log().get_horizon(), 2 * per_seg);
+
+    // The aborted versions went with their statuses, so v1 is still the visible one
+    auto reader = txn_mgr->begin_transaction();
+    auto res = mvcc.read_version(7, reader->id);
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res.value().created_tx_id, writer->id);
+    txn_mgr->commit_transaction(reader);
+
+    // A long-running transaction holds the horizon back
+    auto pinned = txn_mgr->begin_transaction();
+    const TransactionId horizon = txn_mgr->get_commit_log().get_horizon();
+    for (TransactionId i = 0; i < 2 * per_seg; ++i) {
+        txn_mgr->commit_transaction(txn_mgr->begin_transaction());
+    }
+    txn_mgr->wait_for_horizon_sweep();
+    EXPECT_EQ(txn_mgr->get_commit_log().get_horizon(), horizon);
+    txn_mgr->abort_transaction(pinned);
+    txn_mgr->wait_for_horizon_sweep();
+    EXPECT_GT(txn_mgr->get_commit_log().get_horizon(), horizon);
+}
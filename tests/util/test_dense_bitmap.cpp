@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include "../../src/util/dense_bitmap.h"
+
+using namespace loredb;
+
+TEST(DenseBitmapTest, SetsTestsAndGrows) {
+    util::DenseBitmap bitmap(100);
+    EXPECT_EQ(bitmap.size(), 100u);
+    EXPECT_FALSE(bitmap.test(0));
+    EXPECT_TRUE(bitmap.set(0));
+    EXPECT_FALSE(bitmap.set(0));
+    EXPECT_TRUE(bitmap.set(63));
+    EXPECT_TRUE(bitmap.set(64));
+    EXPECT_TRUE(bitmap.test(63));
+    EXPECT_TRUE(bitmap.test(64));
+    EXPECT_FALSE(bitmap.test(65));
+    EXPECT_FALSE(bitmap.test(100000));
+
+    // Bits past the end grow the bitmap and keep the ones already set
+    EXPECT_TRUE(bitmap.set(1000));
+    EXPECT_GE(bitmap.size(), 1001u);
+    EXPECT_TRUE(bitmap.test(1000));
+    EXPECT_TRUE(bitmap.test(64));
+    EXPECT_EQ(bitmap.count(), 4u);
+
+    bitmap.reset(63);
+    EXPECT_FALSE(bitmap.test(63));
+    bitmap.clear();
+    EXPECT_EQ(bitmap.count(), 0u);
+    EXPECT_FALSE(bitmap.test(1000));
+}
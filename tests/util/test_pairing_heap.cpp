@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../../src/util/pairing_heap.h"
+#include <algorithm>
+#include <random>
+
+using namespace loredb;
+
+TEST(PairingHeapTest, PopsInKeyOrderWithDecreasedKeys) {
+    util::PairingHeap<double, int> heap;
+    EXPECT_TRUE(heap.empty());
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> keys(0.0, 1000.0);
+    std::vector<double> current;
+    std::vector<util::PairingHeap<double, int>::Handle> handles;
+    for (int i = 0; i < 2000; ++i) {
+        current.push_back(keys(rng));
+        handles.push_back(heap.push(current.back(), i));
+    }
+    EXPECT_EQ(heap.size(), 2000u);
+
+    // Interleave pops with key decreases, as Dijkstra does
+    std::vector<bool> popped(current.size(), false);
+    double last = -1.0;
+    size_t pops = 0;
+    while (!heap.empty()) {
+        const int value = heap.top_value();
+        EXPECT_EQ(heap.top_key(), current[value]);
+        EXPECT_GE(heap.top_key(), last);
+        for (int i = 0; i < static_cast<int>(current.size()); ++i) {
+            if (!popped[i]) {
+                ASSERT_LE(heap.top_key(), current[i]);
+            }
+        }
+        last = heap.top_key();
+        popped[value] = true;
+        heap.pop();
+        ++pops;
+
+        for (int j = 0; j < 3; ++j) {
+            const int candidate = static_cast<int>(rng() % current.size());
+            if (!popped[candidate]) {
+                current[candidate] = std::max(last, current[candidate] - keys(rng) / 4);
+                heap.decrease_key(handles[candidate], current[candidate]);
+                EXPECT_EQ(heap.key(handles[candidate]), current[candidate]);
+            }
+        }
+    }
+    EXPECT_EQ(pops, 2000u);
+    EXPECT_EQ(heap.size(), 0u);
+
+    heap.clear();
+    heap.push(2.0, 2);
+    auto one = heap.push(5.0, 1);
+    heap.decrease_key(one, 1.0);
+    EXPECT_EQ(heap.top_value(), 1);
+}